@@ -0,0 +1,109 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/http/FlatHeaderCollection.h>
+#include <aws/core/http/standard/StandardHttpRequest.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <cstring>
+
+using namespace Aws::Http;
+using namespace Aws::Utils;
+
+TEST(FlatHeaderCollectionTest, TestNamesAreCaseInsensitive)
+{
+    FlatHeaderCollection headers;
+    headers.Set("X-Amz-Date", "20200101T000000Z");
+    headers.Set("x-custom-header", "first");
+    headers.Set("X-CUSTOM-HEADER", "second");
+
+    ASSERT_EQ(2u, headers.size());
+    ASSERT_TRUE(headers.Has("x-amz-date"));
+    ASSERT_EQ("20200101T000000Z", *headers.Find("X-AMZ-DATE"));
+    ASSERT_EQ("second", *headers.Find("X-Custom-Header"));
+    ASSERT_EQ(nullptr, headers.Find("x-custom"));
+
+    const char* names[] = { "x-amz-date", "x-custom-header" };
+    size_t i = 0;
+    for (const auto& header : headers)
+    {
+        ASSERT_STREQ(names[i++], header.GetName());
+    }
+
+    ASSERT_TRUE(headers.Erase("X-Custom-Header"));
+    ASSERT_FALSE(headers.Erase("x-custom-header"));
+    ASSERT_EQ(1u, headers.size());
+}
+
+TEST(FlatHeaderCollectionTest, TestCommonNamesAreInterned)
+{
+    FlatHeaderCollection first;
+    FlatHeaderCollection second;
+    first.Set("Authorization", "first");
+    second.Set("authorization", "second");
+    first.Set("x-not-interned", "value");
+    second.Set("x-not-interned", "value");
+
+    ASSERT_EQ(first.begin()->GetName(), second.begin()->GetName());
+    ASSERT_NE((first.begin() + 1)->GetName(), (second.begin() + 1)->GetName());
+}
+
+TEST(FlatHeaderCollectionTest, TestIterationMatchesHeaderValueCollectionBeyondInlineCapacity)
+{
+    FlatHeaderCollection headers;
+    HeaderValueCollection expected;
+    for (size_t i = 0; i < FlatHeaderCollection::INLINE_CAPACITY * 3; ++i)
+    {
+        // not inserted in order, some of them interned
+        Aws::String name = i % 5 == 0 ? Aws::String("Host") : "X-Header-" + StringUtils::to_string((i * 7) % 31);
+        Aws::String value = StringUtils::to_string(i);
+        headers.Set(name, value);
+        expected[StringUtils::ToLower(name.c_str())] = value;
+    }
+    headers.Set("host", "example.com");
+    expected["host"] = "example.com";
+
+    for (const char* name : { "x-header-3", "X-Header-17", "missing" })
+    {
+        headers.Erase(name);
+        expected.erase(StringUtils::ToLower(name));
+    }
+
+    ASSERT_EQ(expected.size(), headers.size());
+    ASSERT_EQ(expected, headers.ToHeaderValueCollection());
+    auto expectedHeader = expected.cbegin();
+    for (const auto& header : headers)
+    {
+        ASSERT_EQ(expectedHeader->first, Aws::String(header.GetName(), header.GetNameLength()));
+        ASSERT_EQ(expectedHeader->second, header.GetValue());
+        ++expectedHeader;
+    }
+
+    headers.Clear();
+    ASSERT_TRUE(headers.empty());
+    ASSERT_EQ(headers.begin(), headers.end());
+    headers.Set("host", "example.com");
+    ASSERT_EQ("example.com", *headers.Find("Host"));
+}
+
+TEST(FlatHeaderCollectionTest, TestStandardHttpRequestTrimsValuesAndExposesItsHeaders)
+{
+    Standard::StandardHttpRequest request(URI("https://example.amazonaws.com/path"), HttpMethod::HTTP_GET);
+    request.SetHeaderValue("X-Amz-Date", "  20200101T000000Z \t");
+    request.SetHeaderValue(Aws::String("Content-Type"), "application/json");
+
+    const FlatHeaderCollection* headers = request.GetFlatHeaders();
+    ASSERT_NE(nullptr, headers);
+    ASSERT_EQ(3u, headers->size());
+    ASSERT_EQ("20200101T000000Z", request.GetHeaderValue("x-amz-date"));
+    ASSERT_EQ("example.amazonaws.com", request.GetHeaderValue("Host"));
+    ASSERT_EQ(headers->ToHeaderValueCollection(), request.GetHeaders());
+
+    request.DeleteHeader("content-type");
+    ASSERT_FALSE(request.HasHeader("Content-Type"));
+    ASSERT_EQ(static_cast<int64_t>(strlen("host") + strlen("example.amazonaws.com") + strlen("x-amz-date") + strlen("20200101T000000Z")),
+        request.GetSize());
+}
@@ -8,16 +8,40 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/HttpClient.h>
+#include <aws/core/http/BufferResponseBodySink.h>
 #include <aws/core/http/standard/StandardHttpRequest.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <future>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 
 using namespace Aws::Http;
 using namespace Aws::Utils;
 using namespace Aws::Client;
 
+TEST(HttpClientTest, TestBufferResponseBodySinkWritesAtOffsets)
+{
+    unsigned char buffer[8];
+    BufferResponseBodySink bufferSink(buffer, sizeof(buffer));
+    ResponseBodySink sink = bufferSink.GetSink();
+
+    ASSERT_TRUE(sink("abc", 3, 0));
+    ASSERT_TRUE(sink("defgh", 5, 3));
+    ASSERT_EQ(8u, bufferSink.GetLength());
+    ASSERT_EQ(0, memcmp("abcdefgh", buffer, 8));
+
+    // a retried request starts over
+    ASSERT_TRUE(sink("xy", 2, 0));
+    ASSERT_EQ(2u, bufferSink.GetLength());
+    ASSERT_EQ(0, memcmp("xycdefgh", buffer, 8));
+
+    ASSERT_FALSE(sink("overflow", 8, 2));
+    ASSERT_FALSE(sink("z", 1, 9));
+}
+
 #ifndef NO_HTTP_CLIENT
 static void makeRandomHttpRequest(std::shared_ptr<HttpClient> httpClient)
 {
@@ -46,6 +70,8 @@ TEST(HttpClientTest, TestRandomURL)
 
 // TODO: Pending Fix on Windows.
 #if ENABLE_CURL_CLIENT
+#include <aws/core/http/curl/CurlHandleContainer.h>
+
 TEST(HttpClientTest, TestRandomURLMultiThreaded)
 {
     const int threadCount = 50;
@@ -80,6 +106,129 @@ TEST(HttpClientTest, TestRandomURLMultiThreaded)
     }
     ASSERT_FALSE(hasPendingTasks);
 }
+
+TEST(HttpClientTest, TestRandomURLCurlMulti)
+{
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    auto httpClient = CreateHttpClient(config);
+    makeRandomHttpRequest(httpClient);
+}
+
+TEST(HttpClientTest, TestRandomURLCurlMultiHttp2)
+{
+    for (auto version : {Version::HTTP_VERSION_1_1, Version::HTTP_VERSION_2TLS, Version::HTTP_VERSION_2_PRIOR_KNOWLEDGE})
+    {
+        Aws::Client::ClientConfiguration config;
+        config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+        config.version = version;
+        config.http2MaxConcurrentStreams = 10;
+        auto httpClient = CreateHttpClient(config);
+        makeRandomHttpRequest(httpClient);
+    }
+}
+
+TEST(HttpClientTest, TestRandomURLCurlMultiAsync)
+{
+    const int requestCount = 50;
+    const int timeoutSecs = 5;
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    auto httpClient = CreateHttpClient(config);
+
+    std::mutex completedLock;
+    std::condition_variable completedSignal;
+    int completedCount = 0;
+    int clientErrorCount = 0;
+    for (int i = 0; i < requestCount; ++i)
+    {
+        auto request = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+                                         HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        httpClient->MakeRequestAsync(request, [&](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+            {
+                std::lock_guard<std::mutex> locker(completedLock);
+                ++completedCount;
+                if (response->HasClientError())
+                {
+                    ++clientErrorCount;
+                }
+                completedSignal.notify_one();
+            });
+    }
+
+    std::unique_lock<std::mutex> locker(completedLock);
+    ASSERT_TRUE(completedSignal.wait_for(locker, std::chrono::seconds(timeoutSecs), [&]() { return completedCount == requestCount; }));
+    locker.unlock();
+
+    // Destroying the client drains the event loop; every request has already completed.
+    httpClient = nullptr;
+    ASSERT_EQ(requestCount, completedCount);
+    ASSERT_TRUE(clientErrorCount == 0 || clientErrorCount == requestCount);
+}
+
+// A handler runs on the event loop, so a synchronous request made from it fails instead of waiting forever.
+TEST(HttpClientTest, TestCurlMultiSyncRequestFromHandlerFails)
+{
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    auto httpClient = CreateHttpClient(config);
+
+    std::promise<std::shared_ptr<HttpResponse>> nestedResponsePromise;
+    auto request = CreateHttpRequest(Aws::String("http://some.unknown1234xxx.test.aws"),
+                                     HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    httpClient->MakeRequestAsync(request, [&](const std::shared_ptr<HttpRequest>& originalRequest, const std::shared_ptr<HttpResponse>&)
+        {
+            nestedResponsePromise.set_value(httpClient->MakeRequest(originalRequest));
+        });
+
+    auto nestedResponse = nestedResponsePromise.get_future();
+    ASSERT_EQ(std::future_status::ready, nestedResponse.wait_for(std::chrono::seconds(5)));
+    ASSERT_EQ(CoreErrors::INVALID_ACTION, nestedResponse.get()->GetClientErrorType());
+}
+
+TEST(HttpClientTest, TestCurlHandleContainerPrefersSameAuthority)
+{
+    using Aws::Http::CurlHandleContainer;
+    const Aws::String firstBucket = CurlHandleContainer::GetAuthorityKey("https", "first.s3.amazonaws.com", 443);
+    const Aws::String secondBucket = CurlHandleContainer::GetAuthorityKey("https", "second.s3.amazonaws.com", 443);
+    ASSERT_STREQ("https://first.s3.amazonaws.com:443", firstBucket.c_str());
+
+    CurlHandleContainer container(2);
+    CURL* first = container.AcquireCurlHandle(firstBucket);
+    CURL* second = container.AcquireCurlHandle(secondBucket);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    ASSERT_NE(first, second);
+    container.ReleaseCurlHandle(first, firstBucket);
+    container.ReleaseCurlHandle(second, secondBucket);
+
+    ASSERT_EQ(second, container.AcquireCurlHandle(secondBucket));
+    ASSERT_EQ(first, container.AcquireCurlHandle(firstBucket));
+    ASSERT_EQ(nullptr, container.TryAcquireCurlHandle(firstBucket));
+    container.ReleaseCurlHandle(first, firstBucket);
+
+    // Once the pool is at its maximum, an idle handle of another authority is handed out rather than waiting.
+    ASSERT_EQ(first, container.TryAcquireCurlHandle(secondBucket));
+    container.ReleaseCurlHandle(first, secondBucket);
+    container.ReleaseCurlHandle(second, secondBucket);
+}
+
+TEST(HttpClientTest, TestCurlHandleContainerBlocksUntilHandleIsReleased)
+{
+    Aws::Http::CurlHandleContainer container(1);
+    CURL* handle = container.AcquireCurlHandle();
+    ASSERT_NE(nullptr, handle);
+
+    auto waiter = std::async(std::launch::async, [&container]() { return container.AcquireCurlHandle(); });
+    ASSERT_EQ(std::future_status::timeout, waiter.wait_for(std::chrono::milliseconds(50)));
+
+    // Destroying the handle frees its slot, the waiting thread gets a new one.
+    container.DestroyCurlHandle(handle);
+    ASSERT_EQ(std::future_status::ready, waiter.wait_for(std::chrono::seconds(5)));
+    CURL* replacement = waiter.get();
+    ASSERT_NE(nullptr, replacement);
+    container.ReleaseCurlHandle(replacement);
+}
 #endif // ENABLE_CURL_CLIENT
 
 // Test Http Client timeout
@@ -317,6 +466,112 @@ TEST(CURLHttpClientTest, TestHttpRequestWorksFine)
     EXPECT_EQ(Aws::Http::HttpResponseCode::OK, response->GetResponseCode());
     EXPECT_EQ("", response->GetClientErrorMessage());
 }
+
+TEST(CURLHttpClientTest, TestResponseBodySinkBypassesResponseStream)
+{
+    const char expectedBody[] = "<html><body><h1>hi!</h1></body></html>";
+    unsigned char buffer[sizeof(expectedBody)];
+    BufferResponseBodySink bufferSink(buffer, sizeof(buffer));
+
+    auto request = CreateHttpRequest(Aws::String("http://127.0.0.1:8778"),
+                                     HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    request->SetResponseBodySink(bufferSink.GetSink());
+    auto httpClient = CreateHttpClient(Aws::Client::ClientConfiguration());
+    auto response = httpClient->MakeRequest(request);
+    ASSERT_NE(nullptr, response);
+    ASSERT_FALSE(response->HasClientError());
+    ASSERT_EQ(Aws::Http::HttpResponseCode::OK, response->GetResponseCode());
+    ASSERT_EQ(strlen(expectedBody), bufferSink.GetLength());
+    ASSERT_EQ(0, memcmp(expectedBody, buffer, bufferSink.GetLength()));
+    ASSERT_EQ(EOF, response->GetResponseBody().peek());
+
+    // the sink fails the request if the body doesn't fit
+    unsigned char smallBuffer[4];
+    BufferResponseBodySink smallSink(smallBuffer, sizeof(smallBuffer));
+    request = CreateHttpRequest(Aws::String("http://127.0.0.1:8778"),
+                                HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    request->SetResponseBodySink(smallSink.GetSink());
+    response = httpClient->MakeRequest(request);
+    ASSERT_NE(nullptr, response);
+    ASSERT_TRUE(response->HasClientError());
+}
+
+// Run "scripts/dummy_h2_web_server.py -l localhost -p 8779" to setup a dummy HTTP/2 web server first.
+static bool CurlSupportsHttp2()
+{
+    return (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) != 0;
+}
+
+TEST(CURLHttpClientTest, TestCurlMultiMultiplexesConcurrentRequestsOverOneConnection)
+{
+    if (!CurlSupportsHttp2())
+    {
+        return;
+    }
+    const unsigned requestCount = 8;
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    config.version = Version::HTTP_VERSION_2TLS;
+    // the server certificate is self-signed
+    config.verifySSL = false;
+    config.maxConnections = requestCount;
+    config.http2MaxConcurrentStreams = requestCount;
+    auto httpClient = CreateHttpClient(config);
+
+    std::mutex completedLock;
+    std::condition_variable completedSignal;
+    Aws::Vector<std::shared_ptr<HttpResponse>> responses;
+    for (unsigned i = 0; i < requestCount; ++i)
+    {
+        // the server holds every stream for a while, so the requests are in flight together
+        auto request = CreateHttpRequest(Aws::String("https://127.0.0.1:8779"),
+                                         HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        httpClient->MakeRequestAsync(request, [&](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+            {
+                std::lock_guard<std::mutex> locker(completedLock);
+                responses.push_back(response);
+                completedSignal.notify_one();
+            });
+    }
+
+    std::unique_lock<std::mutex> locker(completedLock);
+    ASSERT_TRUE(completedSignal.wait_for(locker, std::chrono::seconds(10), [&]() { return responses.size() == requestCount; }));
+    for (const auto& response : responses)
+    {
+        ASSERT_FALSE(response->HasClientError()) << response->GetClientErrorMessage();
+        ASSERT_EQ(HttpResponseCode::OK, response->GetResponseCode());
+        // every stream was served on the first connection although up to requestCount could have been opened
+        ASSERT_EQ(responses.front()->GetHeader("x-connection-id"), response->GetHeader("x-connection-id"));
+    }
+}
+
+TEST(CURLHttpClientTest, TestCurlMultiStopsOfferingHttp2ToHttp1Endpoints)
+{
+    if (!CurlSupportsHttp2())
+    {
+        return;
+    }
+    Aws::Client::ClientConfiguration config;
+    config.httpLibOverride = TransferLibType::CURL_MULTI_CLIENT;
+    config.version = Version::HTTP_VERSION_2_0;
+    auto httpClient = CreateHttpClient(config);
+
+    // without TLS, HTTP/2 is offered by asking to upgrade, which the server ignores
+    auto request = CreateHttpRequest(Aws::String("http://127.0.0.1:8779"),
+                                     HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto response = httpClient->MakeRequest(request);
+    ASSERT_NE(nullptr, response);
+    ASSERT_FALSE(response->HasClientError()) << response->GetClientErrorMessage();
+    ASSERT_EQ("h2c", response->GetHeader("x-upgrade"));
+
+    // the authority is remembered as HTTP/1.1 only
+    request = CreateHttpRequest(Aws::String("http://127.0.0.1:8779"),
+                                HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    response = httpClient->MakeRequest(request);
+    ASSERT_NE(nullptr, response);
+    ASSERT_FALSE(response->HasClientError()) << response->GetClientErrorMessage();
+    ASSERT_EQ("none", response->GetHeader("x-upgrade"));
+}
 #endif // ENABLE_CURL_CLIENT
 #endif // ENABLE_HTTP_CLIENT_TESTING
 #endif // NO_HTTP_CLIENT
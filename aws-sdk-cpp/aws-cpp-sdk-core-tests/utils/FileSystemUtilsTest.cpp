@@ -7,7 +7,9 @@
 #include <aws/core/utils/FileSystemUtils.h>
 #include <aws/core/utils/memory/stl/AWSSet.h>
 #include <aws/external/gtest.h>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #if defined(HAS_PATHCONF)
 #include <unistd.h>
 #include <climits>
@@ -58,6 +60,57 @@ TEST(FileTest, TempFile)
     ASSERT_FALSE(testIn.good());
 }
 
+TEST(FileTest, TestMapFile)
+{
+    TempFile tempFile(std::ios_base::out | std::ios_base::trunc);
+    tempFile.close();
+    ASSERT_EQ(nullptr, Aws::FileSystem::MapFile(tempFile.GetFileName(), Aws::FileSystem::MappedFileAccess::ReadOnly));
+    ASSERT_EQ(nullptr, Aws::FileSystem::MapFile(tempFile.GetFileName() + "missing", Aws::FileSystem::MappedFileAccess::ReadOnly));
+
+    const uint64_t size = 3 * 4096 + 100;
+    {
+        auto mappedFile = Aws::FileSystem::MapFile(tempFile.GetFileName(), Aws::FileSystem::MappedFileAccess::ReadWrite, size);
+        ASSERT_NE(nullptr, mappedFile);
+        ASSERT_EQ(size, mappedFile->GetSize());
+        for (uint64_t i = 0; i < size; ++i)
+        {
+            mappedFile->GetData()[i] = static_cast<unsigned char>(i % 251);
+        }
+    }
+
+    std::ifstream testIn(tempFile.GetFileName().c_str(), std::ios_base::in | std::ios_base::binary);
+    Aws::String written((std::istreambuf_iterator<char>(testIn)), std::istreambuf_iterator<char>());
+    testIn.close();
+    ASSERT_EQ(size, written.size());
+    ASSERT_EQ(static_cast<char>(200), written[200]);
+
+    auto mappedFile = Aws::FileSystem::MapFile(tempFile.GetFileName(), Aws::FileSystem::MappedFileAccess::ReadOnly);
+    ASSERT_NE(nullptr, mappedFile);
+    ASSERT_EQ(size, mappedFile->GetSize());
+    // hints accept any range, including unaligned and out of bounds ones
+    mappedFile->WillNeed(4097, size);
+    mappedFile->DontNeed(size, 10);
+    mappedFile->DontNeed(1, 4096);
+    ASSERT_EQ(0, memcmp(written.c_str(), mappedFile->GetData(), static_cast<size_t>(size)));
+}
+
+TEST(FileTest, TestGetFileInfo)
+{
+    auto before = Aws::Utils::DateTime::Now().Millis() / 1000 * 1000;
+    TempFile tempFile(std::ios_base::out | std::ios_base::trunc);
+    tempFile << "0123456789";
+    tempFile.close();
+
+    auto entry = Aws::FileSystem::GetFileInfo(tempFile.GetFileName());
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(Aws::FileSystem::FileType::File, entry.fileType);
+    ASSERT_EQ(10, entry.fileSize);
+    ASSERT_GE(entry.lastModified.Millis(), before);
+    ASSERT_LE(entry.lastModified.Millis(), Aws::Utils::DateTime::Now().Millis());
+
+    ASSERT_FALSE(Aws::FileSystem::GetFileInfo(tempFile.GetFileName() + "missing"));
+}
+
 class DirectoryTreeTest : public ::testing::Test
 {
 public:
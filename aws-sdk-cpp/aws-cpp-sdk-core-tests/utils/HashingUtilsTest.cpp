@@ -6,6 +6,9 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/HashingUtils.h>
+#include <aws/core/utils/crypto/MD5.h>
+#include <aws/core/utils/crypto/CRC32.h>
+#include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 
 
@@ -311,3 +314,89 @@ TEST(HashingUtilsTest, TestMD5FromStream)
     TestMD5FromStream( "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "V+30oivjyVWsSdouIQe2eg==" );
 }
 
+
+TEST(HashingUtilsTest, TestIncrementalHashEqualsCalculate)
+{
+    Aws::String input = "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+    Crypto::Sha256 sha256;
+    Crypto::MD5 md5;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        // feeding the input in pieces gives the digest of the whole, and GetHash leaves the hash ready for the next input.
+        sha256.Update(reinterpret_cast<const unsigned char*>(input.c_str()), 7);
+        sha256.Update(reinterpret_cast<const unsigned char*>(input.c_str()) + 7, input.size() - 7);
+        auto sha256Result = sha256.GetHash();
+        ASSERT_TRUE(sha256Result.IsSuccess());
+        ASSERT_EQ(HashingUtils::CalculateSHA256(input), sha256Result.GetResult());
+
+        md5.Update(reinterpret_cast<const unsigned char*>(input.c_str()), input.size());
+        auto md5Result = md5.GetHash();
+        ASSERT_TRUE(md5Result.IsSuccess());
+        ASSERT_STREQ("V+30oivjyVWsSdouIQe2eg==", HashingUtils::Base64Encode(md5Result.GetResult()).c_str());
+    }
+
+    auto emptyResult = sha256.GetHash();
+    ASSERT_TRUE(emptyResult.IsSuccess());
+    ASSERT_EQ(HashingUtils::CalculateSHA256(""), emptyResult.GetResult());
+}
+
+TEST(HashingUtilsTest, TestCalculateHashesInOnePass)
+{
+    Aws::String input(100000, 'x');
+    Aws::StringStream stream(input);
+    stream.seekg(10);
+
+    Crypto::Sha256 sha256;
+    Crypto::MD5 md5;
+    ASSERT_TRUE(HashingUtils::CalculateHashes(stream, {&sha256, &md5}));
+    ASSERT_EQ(10, stream.tellg());
+
+    auto sha256Result = sha256.GetHash();
+    auto md5Result = md5.GetHash();
+    ASSERT_TRUE(sha256Result.IsSuccess());
+    ASSERT_TRUE(md5Result.IsSuccess());
+    ASSERT_EQ(HashingUtils::CalculateSHA256(input), sha256Result.GetResult());
+    ASSERT_EQ(HashingUtils::CalculateMD5(input), md5Result.GetResult());
+}
+
+TEST(HashingUtilsTest, TestCRC32)
+{
+    // check values of the two polynomials
+    ASSERT_STREQ("cbf43926", HashingUtils::HexEncode(HashingUtils::CalculateCRC32("123456789")).c_str());
+    ASSERT_STREQ("e3069283", HashingUtils::HexEncode(HashingUtils::CalculateCRC32C("123456789")).c_str());
+    ASSERT_STREQ("00000000", HashingUtils::HexEncode(HashingUtils::CalculateCRC32C("")).c_str());
+
+    Aws::StringStream stream("xx123456789");
+    stream.seekg(2);
+    ASSERT_EQ(HashingUtils::CalculateCRC32("xx123456789"), HashingUtils::CalculateCRC32(stream));
+    ASSERT_EQ(HashingUtils::CalculateCRC32C("xx123456789"), HashingUtils::CalculateCRC32C(stream));
+    ASSERT_EQ(2, stream.tellg());
+
+    Crypto::CRC32C crc32c;
+    crc32c.Update(reinterpret_cast<const unsigned char*>("1234"), 4);
+    crc32c.Update(reinterpret_cast<const unsigned char*>("56789"), 5);
+    ASSERT_EQ(HashingUtils::CalculateCRC32C("123456789"), crc32c.GetHash().GetResult());
+    ASSERT_EQ(HashingUtils::CalculateCRC32C(""), crc32c.GetHash().GetResult());
+}
+
+TEST(HashingUtilsTest, TestCRC32Combine)
+{
+    Aws::String data;
+    for (int i = 0; i < 100000; ++i)
+    {
+        data.push_back(static_cast<char>((i * 31 + i / 7) & 0xFF));
+    }
+    auto bytes = reinterpret_cast<const unsigned char*>(data.c_str());
+
+    uint32_t crc32 = Crypto::CRC32::Checksum(bytes, data.size());
+    uint32_t crc32c = Crypto::CRC32C::Checksum(bytes, data.size());
+    for (size_t split : {size_t(0), size_t(1), size_t(4095), size_t(65536), data.size() - 1, data.size()})
+    {
+        size_t lengthB = data.size() - split;
+        ASSERT_EQ(crc32, Crypto::CRC32::Combine(Crypto::CRC32::Checksum(bytes, split),
+            Crypto::CRC32::Checksum(bytes + split, lengthB), lengthB));
+        ASSERT_EQ(crc32c, Crypto::CRC32C::Combine(Crypto::CRC32C::Checksum(bytes, split),
+            Crypto::CRC32C::Checksum(bytes + split, lengthB), lengthB));
+    }
+}
@@ -709,4 +709,45 @@ TEST(CryptoStreamsTest, TestLiveSymmetricCipher)
     }
 }
 
+TEST(CryptoStreamsTest, TestLiveSymmetricCipherLargeBuffers)
+{
+    // several 64kb blocks, then a part of a block.
+    const size_t bufferSize = 64 * 1024;
+    CryptoBuffer plainText(3 * bufferSize + 100);
+    for (size_t i = 0; i < plainText.GetLength(); ++i)
+    {
+        plainText[i] = static_cast<unsigned char>(i * 31);
+    }
+
+    CryptoBuffer key = SymmetricCipher::GenerateKey();
+    CryptoBuffer iv = SymmetricCipher::GenerateIV(16);
+    auto cipher = Aws::Utils::Crypto::CreateAES_CBCImplementation(key, iv);
+    auto part1 = cipher->EncryptBuffer(plainText);
+    auto part2 = cipher->FinalizeEncryption();
+    CryptoBuffer expected({&part1, &part2});
+
+    Aws::String encrypted;
+    {
+        cipher = Aws::Utils::Crypto::CreateAES_CBCImplementation(key, iv);
+        std::stringstream is;
+        is.write((const char*)plainText.GetUnderlyingData(), plainText.GetLength());
+        SymmetricCryptoStream stream((std::istream&)is, CipherMode::Encrypt, *cipher, bufferSize);
+        encrypted.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        ASSERT_TRUE(*cipher);
+    }
+    ASSERT_EQ(expected.GetLength(), encrypted.length());
+    ASSERT_EQ(0, memcmp(expected.GetUnderlyingData(), encrypted.c_str(), encrypted.length()));
+
+    {
+        cipher = Aws::Utils::Crypto::CreateAES_CBCImplementation(key, iv);
+        std::ostringstream os;
+        SymmetricCryptoStream outputStream(os, CipherMode::Decrypt, *cipher, bufferSize);
+        outputStream.write(encrypted.c_str(), encrypted.length());
+        outputStream.Finalize();
+        ASSERT_TRUE(*cipher);
+        ASSERT_EQ(plainText.GetLength(), os.str().length());
+        ASSERT_EQ(0, memcmp(plainText.GetUnderlyingData(), os.str().c_str(), plainText.GetLength()));
+    }
+}
+
 #endif // NO_SYMMETRIC_ENCRYPTION
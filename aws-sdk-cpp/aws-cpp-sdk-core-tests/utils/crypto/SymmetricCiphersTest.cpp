@@ -235,6 +235,53 @@ TEST(AES_CTR_TEST, Test_Generated_KEY_AND_IV)
     ASSERT_STREQ(data_raw.c_str(), (const char*)plainText.GetUnderlyingData());
 }
 
+TEST(AES_CTR_TEST, TestInPlaceMatchesEncryptBuffer)
+{
+    CryptoBuffer key = SymmetricCipher::GenerateKey();
+    Aws::String data_raw(TEST_ENCRYPTION_STRING);
+    CryptoBuffer plainText((unsigned char*)data_raw.c_str(), data_raw.length());
+
+    auto cipher = CreateAES_CTRImplementation(key);
+    auto expected = cipher->EncryptBuffer(plainText);
+    ASSERT_EQ(0u, cipher->FinalizeEncryption().GetLength());
+
+    cipher->Reset();
+    CryptoBuffer inPlace(plainText);
+    ASSERT_TRUE(cipher->EncryptInPlace(inPlace.GetUnderlyingData(), inPlace.GetLength()));
+    cipher->FinalizeEncryption();
+    ASSERT_EQ(expected, inPlace);
+
+    cipher->Reset();
+    ASSERT_TRUE(cipher->DecryptInPlace(inPlace.GetUnderlyingData(), inPlace.GetLength()));
+    cipher->FinalizeDecryption();
+    ASSERT_TRUE(*cipher);
+    ASSERT_EQ(plainText, inPlace);
+}
+
+TEST(AES_CBC_TEST, TestEncryptBufferToHoldsBackPartialBlock)
+{
+    CryptoBuffer key = SymmetricCipher::GenerateKey();
+    Aws::String data_raw(TEST_ENCRYPTION_STRING);
+    CryptoBuffer plainText((unsigned char*)data_raw.c_str(), data_raw.length());
+
+    auto cipher = CreateAES_CBCImplementation(key);
+    auto part1 = cipher->EncryptBuffer(plainText);
+    auto part2 = cipher->FinalizeEncryption();
+    CryptoBuffer expected({&part1, &part2});
+
+    // output is written in whole blocks, with room for one block more than the input.
+    cipher->Reset();
+    CryptoBuffer output(plainText.GetLength() + MAX_CIPHER_BLOCK_SIZE);
+    size_t written = cipher->EncryptBufferTo(plainText.GetUnderlyingData(), 100, output.GetUnderlyingData());
+    ASSERT_EQ(96u, written);
+    written += cipher->EncryptBufferTo(plainText.GetUnderlyingData() + 100, plainText.GetLength() - 100, output.GetUnderlyingData() + written);
+    auto finalBlock = cipher->FinalizeEncryption();
+    ASSERT_TRUE(*cipher);
+    ASSERT_EQ(expected.GetLength(), written + finalBlock.GetLength());
+    ASSERT_EQ(0, memcmp(expected.GetUnderlyingData(), output.GetUnderlyingData(), written));
+    ASSERT_EQ(0, memcmp(expected.GetUnderlyingData() + written, finalBlock.GetUnderlyingData(), finalBlock.GetLength()));
+}
+
 TEST(AES_GCM_TEST, TestBadTagCausesFailure)
 {
     Aws::String iv_raw = "4742357c335913153ff0eb0f";
@@ -525,4 +525,140 @@ namespace
         ASSERT_EQ(EventStreamErrors::EVENT_STREAM_PRELUDE_CHECKSUM_FAILURE, handler.m_error);
         ASSERT_TRUE(handler.m_errorMessage.find("CRC Mismatch.") == 0);
     }
+
+    TEST(EventStreamDecoderTest, BorrowedMessageTest)
+    {
+        MockEventStreamHandler handler(true /*borrowMessages*/);
+        MockEventStreamDecoder decoder(&handler);
+
+        aws_event_stream_message recordsMessage;
+        Aws::Http::HeaderValueCollection headers;
+        headers.insert(Aws::Http::HeaderValuePair(":event-type", "Records"));
+        headers.insert(Aws::Http::HeaderValuePair(":content-type", "application/octet-stream"));
+        headers.insert(Aws::Http::HeaderValuePair(":message-type", "event"));
+        Aws::String payload = "Records";
+        GenerateEventStreamMessage(&recordsMessage, headers, payload.c_str());
+
+        const uint8_t* data_raw = aws_event_stream_message_buffer(&recordsMessage);
+        ByteBuffer data(data_raw, static_cast<size_t>(aws_event_stream_message_total_length(&recordsMessage)));
+        decoder.Pump(data);
+
+        ASSERT_EQ(1u, handler.m_onCompletePayloadCount);
+        ASSERT_EQ(3u, handler.m_onHeaderReceivedCount);
+        ASSERT_EQ(1u, handler.m_onRecordsCount);
+        ASSERT_EQ(0u, handler.m_internalErrorsCount);
+        ASSERT_EQ(payload, handler.m_lastPayload);
+        // The payload arrived in a single segment, so it was read in place from the pumped buffer.
+        ASSERT_TRUE(handler.m_lastPayloadData >= data.GetUnderlyingData());
+        ASSERT_TRUE(handler.m_lastPayloadData < data.GetUnderlyingData() + data.GetLength());
+        ASSERT_TRUE(handler.GetEventHeaders().empty());
+
+        aws_event_stream_message_clean_up(&recordsMessage);
+    }
+
+    TEST(EventStreamDecoderTest, BorrowedIncompleteAndMultipleMessagesTest)
+    {
+        MockEventStreamHandler handler(true /*borrowMessages*/);
+        MockEventStreamDecoder decoder(&handler);
+
+        aws_event_stream_message recordsMessage;
+        Aws::Http::HeaderValueCollection headers;
+        headers.insert(Aws::Http::HeaderValuePair(":event-type", "Records"));
+        headers.insert(Aws::Http::HeaderValuePair(":content-type", "application/octet-stream"));
+        headers.insert(Aws::Http::HeaderValuePair(":message-type", "event"));
+        Aws::String payload = "Records";
+        GenerateEventStreamMessage(&recordsMessage, headers, payload.c_str());
+
+        aws_event_stream_message endMessage;
+        headers.clear();
+        headers.insert(Aws::Http::HeaderValuePair(":event-type", "End"));
+        headers.insert(Aws::Http::HeaderValuePair(":message-type", "event"));
+        GenerateEventStreamMessage(&endMessage, headers);
+
+        // Split the first message in the middle of its payload, the view has to put the payload back together.
+        const uint8_t* data_raw = aws_event_stream_message_buffer(&recordsMessage);
+        size_t totalLength = aws_event_stream_message_total_length(&recordsMessage);
+        size_t partialMessageLength = totalLength - 4/*message crc*/ - aws_event_stream_message_payload_len(&recordsMessage) / 2;
+        ByteBuffer data(data_raw, partialMessageLength);
+        decoder.Pump(data);
+
+        ASSERT_EQ(1u, handler.m_onPayloadSegmentCount);
+        ASSERT_EQ(0u, handler.m_onRecordsCount);
+
+        data = ByteBuffer(data_raw + partialMessageLength, totalLength - partialMessageLength);
+        decoder.Pump(data);
+
+        ASSERT_EQ(2u, handler.m_onPayloadSegmentCount);
+        ASSERT_EQ(1u, handler.m_onRecordsCount);
+        ASSERT_EQ(payload, handler.m_lastPayload);
+
+        // Header storage is reused for the next message.
+        data_raw = aws_event_stream_message_buffer(&endMessage);
+        data = ByteBuffer(data_raw, aws_event_stream_message_total_length(&endMessage));
+        decoder.Pump(data);
+
+        ASSERT_EQ(3u + 2u, handler.m_onHeaderReceivedCount);
+        ASSERT_EQ(1u, handler.m_onRecordsCount);
+        ASSERT_EQ(1u, handler.m_onEndCount);
+        ASSERT_EQ("", handler.m_lastPayload);
+        ASSERT_EQ(0u, handler.m_internalErrorsCount);
+
+        aws_event_stream_message_clean_up(&recordsMessage);
+        aws_event_stream_message_clean_up(&endMessage);
+    }
+
+    TEST(EventStreamDecoderTest, EventMessageViewTest)
+    {
+        aws_array_list headers;
+        aws_event_stream_header_value_pair eventHeader;
+        EventMessageView view;
+
+        // No Reserve() beforehand, so adding headers grows the storage the earlier views point into.
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_headers_list_init(&headers, Aws::get_aws_allocator()));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_add_string_header(&headers, ":message-type", 13, "event", 5, 0/*no copy*/));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_array_list_get_at(&headers, &eventHeader, 0));
+        view.AddHeader(&eventHeader);
+        aws_event_stream_headers_list_cleanup(&headers);
+
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_headers_list_init(&headers, Aws::get_aws_allocator()));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_add_int32_header(&headers, "count", 5, static_cast<int32_t>(10000)));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_array_list_get_at(&headers, &eventHeader, 0));
+        view.AddHeader(&eventHeader);
+        aws_event_stream_headers_list_cleanup(&headers);
+
+        Aws::String longValue(300, 'x');
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_headers_list_init(&headers, Aws::get_aws_allocator()));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_event_stream_add_string_header(&headers, "long", 4, longValue.c_str(), static_cast<uint16_t>(longValue.size()), 0/*no copy*/));
+        ASSERT_EQ(AWS_OP_SUCCESS, aws_array_list_get_at(&headers, &eventHeader, 0));
+        view.AddHeader(&eventHeader);
+        aws_event_stream_headers_list_cleanup(&headers);
+
+        ASSERT_EQ(3u, view.GetHeaders().size());
+        const auto* messageTypeHeader = view.FindHeader(MESSAGE_TYPE_HEADER);
+        ASSERT_NE(nullptr, messageTypeHeader);
+        ASSERT_STREQ(":message-type", messageTypeHeader->GetName());
+        ASSERT_TRUE(messageTypeHeader->ValueEquals("event"));
+        ASSERT_FALSE(messageTypeHeader->ValueEquals("even"));
+        ASSERT_EQ("event", messageTypeHeader->GetValueAsString());
+        ASSERT_EQ(static_cast<int32_t>(10000), view.FindHeader("count")->GetValueAsInt32());
+        ASSERT_EQ(longValue, view.FindHeader("long")->GetValueAsString());
+        ASSERT_EQ("event", view.GetHeaders()[0].ToEventHeaderValue().GetEventHeaderValueAsString());
+        ASSERT_EQ(nullptr, view.FindHeader(EVENT_TYPE_HEADER));
+
+        // A payload delivered in one segment is borrowed, one delivered in several is accumulated.
+        const unsigned char payload[] = "payload";
+        view.Reserve(0, 7);
+        view.WritePayload(payload, 7);
+        ASSERT_EQ(payload, view.GetPayload());
+        ASSERT_EQ("payload", view.GetPayloadAsString());
+
+        view.Reset();
+        ASSERT_TRUE(view.GetHeaders().empty());
+        view.Reserve(0, 7);
+        view.WritePayload(payload, 3);
+        view.WritePayload(payload + 3, 4);
+        ASSERT_NE(payload, view.GetPayload());
+        ASSERT_EQ(7u, view.GetPayloadLength());
+        ASSERT_EQ("payload", view.GetPayloadAsString());
+    }
 }
@@ -283,4 +283,144 @@ namespace
         ASSERT_EQ(2u, handler.m_payloads.size());
         ASSERT_STREQ(payloadString, handler.m_payloads[1].c_str());
     }
+
+    TEST_F(EventStreamTest, WriteEventsDecodesCorrectly)
+    {
+        struct MockHandler : Aws::Utils::Event::EventStreamHandler
+        {
+            void OnEvent() override { m_payloads.push_back(GetEventPayloadAsString()); }
+
+            Aws::Vector<Aws::String> m_payloads;
+        };
+
+        Aws::Client::AWSNullSigner nullSigner;
+        EventEncoderStream io;
+        io.SetSigner(&nullSigner);
+        io.SetSignatureSeed("deadbeef");
+        const char* payloads[] = { "Amazon", "Web", "Services" };
+        Aws::Vector<Event::Message> msgs;
+        for (const auto payload : payloads)
+        {
+            Event::Message msg;
+            msg.InsertEventHeader(":message-type", Aws::String("event"));
+            msg.WriteEventPayload(payload);
+            msgs.push_back(std::move(msg));
+        }
+        io.WriteEvents(msgs);
+
+        io.flush();
+        ASSERT_TRUE(io);
+
+        char output[1024];
+        io.readsome(output, sizeof(output));
+        io.Close();
+        ASSERT_TRUE(io.eof());
+
+        MockHandler handler;
+        EventStreamDecoder decoder(&handler);
+        EventDecoderStream s(decoder);
+        s.write(output, io.gcount());
+        s.flush();
+        ASSERT_EQ(3u, handler.m_payloads.size()); // one signed message per event
+        for (size_t i = 0; i < 3; ++i)
+        {
+            s.write(handler.m_payloads[i].data(), handler.m_payloads[i].length());
+            s.flush();
+        }
+        ASSERT_EQ(6u, handler.m_payloads.size());
+        ASSERT_STREQ(payloads[0], handler.m_payloads[3].c_str());
+        ASSERT_STREQ(payloads[1], handler.m_payloads[4].c_str());
+        ASSERT_STREQ(payloads[2], handler.m_payloads[5].c_str());
+    }
+
+    TEST_F(EventStreamTest, EncodingEventsSignedInPlace)
+    {
+        // Signs encoded messages in place, the encoder frames the signature and date headers around them.
+        struct EncodedMessageSigner : Aws::Client::AWSNullSigner
+        {
+            bool SignEventMessage(Event::Message&, Aws::String&) const override { return false; }
+
+            bool SignEncodedEventMessage(const unsigned char*, size_t, Aws::String& priorSignature,
+                int64_t& signingTimeMillis, ByteBuffer& signature) const override
+            {
+                priorSignature = "abababab";
+                signingTimeMillis = 1234567890;
+                signature = ByteBuffer(32);
+                memset(signature.GetUnderlyingData(), 0xab, signature.GetLength());
+                return true;
+            }
+        };
+
+        struct MockHandler : Aws::Utils::Event::EventStreamHandler
+        {
+            void OnEvent() override
+            {
+                m_payloads.push_back(GetEventPayloadAsString());
+                m_headers.push_back(GetEventHeaders());
+            }
+
+            Aws::Vector<Aws::String> m_payloads;
+            Aws::Vector<EventHeaderValueCollection> m_headers;
+        };
+
+        EncodedMessageSigner signer;
+        EventStreamEncoder encoder(&signer);
+        Event::Message msg;
+        msg.InsertEventHeader(":message-type", Aws::String("event"));
+        msg.InsertEventHeader("count", EventHeaderValue(static_cast<int32_t>(42)));
+        msg.WriteEventPayload("Amazon Web Services, Inc.");
+        Aws::Vector<unsigned char> output;
+        ASSERT_TRUE(encoder.EncodeAndSign(msg, output));
+        const size_t signedLength = output.size();
+        ASSERT_TRUE(encoder.EncodeAndSign(msg, output));
+        ASSERT_EQ(2 * signedLength, output.size());
+
+        MockHandler handler;
+        EventStreamDecoder decoder(&handler);
+        decoder.Pump(output.data(), output.size());
+        ASSERT_EQ(2u, handler.m_payloads.size());
+        for (const auto& headers : handler.m_headers)
+        {
+            ASSERT_EQ(2u, headers.size());
+            ASSERT_EQ(1234567890, headers.at(":date").GetEventHeaderValueAsTimestamp());
+            ASSERT_EQ(32u, headers.at(":chunk-signature").GetEventHeaderValueAsBytebuf().GetLength());
+            ASSERT_EQ(0xab, headers.at(":chunk-signature").GetEventHeaderValueAsBytebuf()[31]);
+        }
+
+        decoder.Pump(reinterpret_cast<const unsigned char*>(handler.m_payloads[0].data()), handler.m_payloads[0].length());
+        ASSERT_EQ(3u, handler.m_payloads.size());
+        ASSERT_STREQ("Amazon Web Services, Inc.", handler.m_payloads[2].c_str());
+        ASSERT_EQ(42, handler.m_headers[2].at("count").GetEventHeaderValueAsInt32());
+        ASSERT_EQ("event", handler.m_headers[2].at(":message-type").GetEventHeaderValueAsString());
+    }
+
+    TEST_F(EventStreamTest, EncodingEventsWithUnexpectedSignatureLength)
+    {
+        // A signature of the wrong length must not be retried with SignEventMessage(), the seed has already moved on.
+        struct ShortSignatureSigner : Aws::Client::AWSNullSigner
+        {
+            bool SignEventMessage(Event::Message&, Aws::String&) const override { ++m_signEventMessageCalls; return true; }
+
+            bool SignEncodedEventMessage(const unsigned char*, size_t, Aws::String& priorSignature,
+                int64_t& signingTimeMillis, ByteBuffer& signature) const override
+            {
+                priorSignature = "abab";
+                signingTimeMillis = 1234567890;
+                signature = ByteBuffer(16);
+                return true;
+            }
+
+            mutable int m_signEventMessageCalls = 0;
+        };
+
+        ShortSignatureSigner signer;
+        EventStreamEncoder encoder(&signer);
+        Event::Message msg;
+        msg.InsertEventHeader(":message-type", Aws::String("event"));
+        msg.WriteEventPayload("Amazon Web Services, Inc.");
+        Aws::Vector<unsigned char> output(3, 'x');
+        ASSERT_FALSE(encoder.EncodeAndSign(msg, output));
+        ASSERT_EQ(3u, output.size());
+        ASSERT_EQ(0, signer.m_signEventMessageCalls);
+    }
 }
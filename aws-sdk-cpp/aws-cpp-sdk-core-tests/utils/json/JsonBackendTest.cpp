@@ -0,0 +1,143 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/json/JsonBackend.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <cmath>
+
+using namespace Aws::Utils::Json;
+
+namespace
+{
+    Aws::String PrintWithCJson(const cJSON* item, bool formatted)
+    {
+        char* printed = formatted ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+        Aws::String out(printed ? printed : "");
+        cJSON_free(printed);
+        return out;
+    }
+
+    // Parses input with both the backend and cJSON and checks they agree on validity and on the printed documents.
+    void AssertMatchesCJson(const Aws::String& input)
+    {
+        const char* errorPosition = nullptr;
+        cJSON* parsed = Backend::Parse(input.c_str(), input.size(), &errorPosition);
+        cJSON* expected = cJSON_ParseWithOpts(input.c_str(), nullptr, 1);
+
+        ASSERT_EQ(expected != nullptr, parsed != nullptr) << input;
+        if (expected)
+        {
+            ASSERT_EQ(PrintWithCJson(expected, false), Backend::Print(parsed, false)) << input;
+            ASSERT_EQ(PrintWithCJson(expected, true), Backend::Print(parsed, true)) << input;
+            ASSERT_EQ(PrintWithCJson(expected, false), Backend::Print(expected, false)) << input;
+        }
+        else
+        {
+            ASSERT_NE(nullptr, errorPosition);
+        }
+        cJSON_Delete(parsed);
+        cJSON_Delete(expected);
+    }
+}
+
+TEST(JsonBackendTest, TestDocumentsMatchCJson)
+{
+    const char* documents[] = {
+        R"({})", R"([])", R"("")", R"(0)", R"(-0)", R"(true)", R"(false)", R"(null)", " \t\r\n {  } \n",
+        R"({"a": 1, "b": [1, 2.5, -3e10, 1E-7, 0.1, 123456789012345678, -2147483649, 2147483647, 9007199254740993]})",
+        R"({"nested": {"deeper": {"deepest": [[], [{}], [[[1]]]]}}, "empty": {}, "list": [{"a": null}, {"b": false}]})",
+        R"({"escapes": "\" \\ \/ \b \f \n \r \t \u0001 \u001f \u00e9 \u20ac \ud83d\ude00 \u0000x"})",
+        "{\"raw control\": \"tab\there\x01\"}",
+        R"({"dup": 1, "dup": 2, "": ""})",
+        R"([1.7976931348623157e308, 5e-324, 3.141592653589793, 1e15, 123456789012345, -1e14, 0.30000000000000004])",
+        "\xEF\xBB\xBF{\"bom\": true}",
+        R"({"backslashes": "\\\\", "more": "a\\\"b\\\\\"c\\"})",
+        // malformed
+        "", " ", R"({)", R"({"a")", R"({"a":})", R"({"a" 1})", R"({"a": 1,})", R"([1,])", R"([1 2])", R"({"a": tru})",
+        R"({"a": truex})", R"({"a": nul})", R"("unterminated)", R"({"a": "\q"})", R"({"a": "\u12"})", R"({"a": "\ud83d"})",
+        R"({"a": "\ude00"})", R"(01x)", R"(+1)", R"(.5)", R"(1.2.3)", R"({} {})", R"([] x)", R"({"a": 1}})", R"(])",
+        R"({1: 2})", R"(["a" "b"])", R"({"a": [1}])", R"(-)", R"(--1)", R"(1e)", "{\"a\": 1}\x01",
+    };
+    for (const char* document : documents)
+    {
+        AssertMatchesCJson(document);
+    }
+
+    // strings and escapes straddling the 64 byte blocks of the structural index
+    for (size_t padding = 0; padding < 130; ++padding)
+    {
+        Aws::String filler(padding, 'x');
+        AssertMatchesCJson("[\"" + filler + "\\\\\", \"" + filler + "\\\"\\\\\\\"\", " + filler.substr(0, padding % 7) + "]");
+        AssertMatchesCJson("{\"" + filler + "\": \"" + filler + "\\u00e9\", \"n\": " + Aws::String(padding % 20 + 1, '7') + "}");
+    }
+
+    // a number is at most 63 characters, as with cJSON, and integers out of int range keep their literal
+    const Aws::String longest(63, '1');
+    JsonValue longNumber("[" + longest + "]");
+    ASSERT_TRUE(longNumber.WasParseSuccessful());
+    ASSERT_EQ("[" + longest + "]", longNumber.View().WriteCompact());
+    ASSERT_FALSE(JsonValue("[" + longest + "1]").WasParseSuccessful());
+}
+
+TEST(JsonBackendTest, TestNestingLimit)
+{
+    Aws::String deepest(CJSON_NESTING_LIMIT, '[');
+    deepest += Aws::String(CJSON_NESTING_LIMIT, ']');
+    AssertMatchesCJson(deepest);
+
+    Aws::String tooDeep(CJSON_NESTING_LIMIT + 1, '[');
+    tooDeep += Aws::String(CJSON_NESTING_LIMIT + 1, ']');
+    AssertMatchesCJson(tooDeep);
+}
+
+TEST(JsonBackendTest, TestPrintMatchesCJsonForBuiltDocuments)
+{
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddItemToObject(root, "nan", cJSON_CreateNumber(std::nan("")));
+    cJSON_AddItemToObject(root, "inf", cJSON_CreateNumber(HUGE_VAL));
+    cJSON_AddItemToObject(root, "negativeZero", cJSON_CreateNumber(-0.0));
+    cJSON_AddItemToObject(root, "third", cJSON_CreateNumber(1.0 / 3));
+    cJSON_AddItemToObject(root, "big", cJSON_CreateNumber(1e300));
+    cJSON_AddItemToObject(root, "raw", cJSON_CreateRaw("[1, 2]"));
+    cJSON_AddItemToObject(root, "emptyArray", cJSON_CreateArray());
+    cJSON_AddItemToObject(root, "emptyObject", cJSON_CreateObject());
+
+    ASSERT_EQ(PrintWithCJson(root, false), Backend::Print(root, false));
+    ASSERT_EQ(PrintWithCJson(root, true), Backend::Print(root, true));
+    cJSON_Delete(root);
+}
+
+TEST(JsonBackendTest, TestParsedDocumentsCanBeModified)
+{
+    JsonValue parsed(Aws::String(R"({"keep": {"list": [1, "two", {"three": 3}]}, "replace": "old", "big": 12345678901234567890})"));
+    ASSERT_TRUE(parsed.WasParseSuccessful());
+
+    JsonValue copy(parsed);
+    JsonValue keep = parsed.View().GetObject("keep").Materialize();
+    parsed.WithString("replace", "new").WithObject("keep", JsonValue().WithInteger("x", 1)).WithString("added", "value");
+
+    ASSERT_EQ(R"({"keep":{"x":1},"replace":"new","big":12345678901234567890,"added":"value"})", parsed.View().WriteCompact());
+    ASSERT_EQ(R"({"keep":{"list":[1,"two",{"three":3}]},"replace":"old","big":12345678901234567890})", copy.View().WriteCompact());
+    ASSERT_EQ(R"({"list":[1,"two",{"three":3}]})", keep.View().WriteCompact());
+
+    JsonValue holder;
+    holder.WithObject("moved", std::move(copy));
+    ASSERT_EQ("two", holder.View().GetObject("moved").GetObject("keep").GetArray("list")[1].AsString());
+}
+
+TEST(JsonBackendTest, TestParseFromStream)
+{
+    Aws::StringStream stream(R"({"a": [true, "b"]})");
+    JsonValue fromStream(stream);
+    ASSERT_TRUE(fromStream.WasParseSuccessful());
+    ASSERT_EQ("b", fromStream.View().GetArray("a")[1].AsString());
+
+    Aws::StringStream badStream(R"({"a": [true, "b"})");
+    JsonValue malformed(badStream);
+    ASSERT_FALSE(malformed.WasParseSuccessful());
+    ASSERT_FALSE(malformed.GetErrorMessage().empty());
+}
@@ -0,0 +1,185 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/json/JsonReader.h>
+#include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <cstring>
+
+using namespace Aws::Utils::Json;
+
+TEST(JsonReaderTest, TestReadNestedDocument)
+{
+    Aws::String input = R"({"Count": 3, "Items": [{"Name": "a\"b\\c\n", "Size": 1.5e3}, {"Name": "\u00e9\ud83d\ude00"}, {}],
+        "Flags": {"on": true, "off": false}, "Big": 9007199254740993, "Unknown": {"x": [1, {"y": null}]}, "Last": "end"})";
+    Aws::StringStream stream(input);
+    JsonReader reader(stream);
+
+    int count = 0;
+    long long big = 0;
+    Aws::Vector<Aws::String> names;
+    double size = 0;
+    Aws::Map<Aws::String, bool> flags;
+    Aws::String last;
+
+    ASSERT_EQ(JsonTokenType::Object, reader.PeekType());
+    ASSERT_TRUE(reader.BeginObject());
+    while (reader.NextMember())
+    {
+        const auto& name = reader.GetMemberName();
+        if (name == "Count")
+        {
+            count = reader.ReadInteger();
+        }
+        else if (name == "Items")
+        {
+            ASSERT_TRUE(reader.BeginArray());
+            while (reader.NextElement())
+            {
+                ASSERT_TRUE(reader.BeginObject());
+                while (reader.NextMember())
+                {
+                    if (reader.GetMemberName() == "Name")
+                    {
+                        names.push_back(reader.ReadString());
+                    }
+                    else if (reader.GetMemberName() == "Size")
+                    {
+                        size = reader.ReadDouble();
+                    }
+                }
+            }
+        }
+        else if (name == "Flags")
+        {
+            ASSERT_TRUE(reader.BeginObject());
+            while (reader.NextMember())
+            {
+                Aws::String key = reader.GetMemberName();
+                flags[key] = reader.ReadBool();
+            }
+        }
+        else if (name == "Big")
+        {
+            big = reader.ReadInt64();
+        }
+        else if (name == "Last")
+        {
+            last = reader.ReadString();
+        }
+        // "Unknown" is left unread and skipped by the next NextMember call.
+    }
+
+    ASSERT_TRUE(reader.WasParseSuccessful());
+    ASSERT_EQ(JsonTokenType::End, reader.PeekType());
+    ASSERT_EQ(3, count);
+    ASSERT_EQ(9007199254740993LL, big);
+    ASSERT_EQ(2u, names.size());
+    ASSERT_EQ("a\"b\\c\n", names[0]);
+    ASSERT_EQ("\xc3\xa9\xf0\x9f\x98\x80", names[1]);
+    ASSERT_DOUBLE_EQ(1500, size);
+    ASSERT_TRUE(flags["on"]);
+    ASSERT_FALSE(flags["off"]);
+    ASSERT_EQ("end", last);
+}
+
+TEST(JsonReaderTest, TestMismatchedTypesReadAsDefaults)
+{
+    Aws::String input = R"({"a": "text", "b": 12, "c": [1, 2], "d": null, "e": {"f": 1}})";
+    JsonReader reader(input.c_str(), input.size());
+
+    ASSERT_TRUE(reader.BeginObject());
+    ASSERT_TRUE(reader.NextMember());
+    ASSERT_EQ(0, reader.ReadInteger());
+    ASSERT_TRUE(reader.NextMember());
+    ASSERT_EQ("", reader.ReadString());
+    ASSERT_TRUE(reader.NextMember());
+    ASSERT_FALSE(reader.BeginObject());
+    ASSERT_TRUE(reader.NextMember());
+    ASSERT_EQ(JsonTokenType::Null, reader.PeekType());
+    ASSERT_FALSE(reader.BeginArray());
+    ASSERT_TRUE(reader.NextMember());
+    ASSERT_EQ("e", reader.GetMemberName());
+    ASSERT_EQ(R"({"f":1})", reader.ReadRawValue());
+    ASSERT_FALSE(reader.NextMember());
+    ASSERT_TRUE(reader.WasParseSuccessful());
+}
+
+TEST(JsonReaderTest, TestRawValueMatchesDom)
+{
+    Aws::String input = R"([{"k": "v\u0041", "n": [true, false, null, -1.25e-2]}, "s"])";
+    JsonReader reader(input.c_str(), input.size());
+
+    JsonValue fromRaw(reader.ReadRawValue());
+    ASSERT_TRUE(reader.WasParseSuccessful());
+    ASSERT_TRUE(fromRaw.WasParseSuccessful());
+    ASSERT_EQ(JsonValue(input), fromRaw);
+}
+
+TEST(JsonReaderTest, TestValuesSpanningReadBuffers)
+{
+    // long enough for strings and numbers to straddle the reader's internal buffer.
+    Aws::String longString(40000, 'x');
+    Aws::StringStream input;
+    input << "[";
+    for (int i = 0; i < 5000; ++i)
+    {
+        input << (i ? "," : "") << "{\"i\":" << i << ",\"s\":\"" << longString.substr(0, i % 37) << "\\u00e9\"}";
+    }
+    input << ",\"" << longString << "\"]";
+
+    JsonReader reader(input);
+    ASSERT_TRUE(reader.BeginArray());
+    int expected = 0;
+    Aws::String lastString;
+    while (reader.NextElement())
+    {
+        if (reader.PeekType() == JsonTokenType::String)
+        {
+            lastString = reader.ReadString();
+            continue;
+        }
+
+        ASSERT_TRUE(reader.BeginObject());
+        while (reader.NextMember())
+        {
+            if (reader.GetMemberName() == "i")
+            {
+                ASSERT_EQ(expected, reader.ReadInteger());
+            }
+            else
+            {
+                ASSERT_EQ(longString.substr(0, expected % 37) + "\xc3\xa9", reader.ReadString());
+            }
+        }
+        ++expected;
+    }
+
+    ASSERT_TRUE(reader.WasParseSuccessful());
+    ASSERT_EQ(5000, expected);
+    ASSERT_EQ(longString, lastString);
+}
+
+TEST(JsonReaderTest, TestMalformedDocuments)
+{
+    for (const char* input : {R"({"a": 1)", R"({"a" 1})", R"({"a": [1,}]})", R"({"a": tru})", R"({"a": "\q"})", R"({"a": 1 "b": 2})"})
+    {
+        JsonReader reader(input, strlen(input));
+        ASSERT_TRUE(reader.BeginObject());
+        while (reader.NextMember())
+        {
+            reader.SkipValue();
+        }
+        ASSERT_FALSE(reader.WasParseSuccessful()) << input;
+        ASSERT_FALSE(reader.GetErrorMessage().empty());
+        ASSERT_EQ(JsonTokenType::Error, reader.PeekType());
+        ASSERT_EQ("", reader.ReadString());
+    }
+
+    JsonReader empty("", 0);
+    ASSERT_FALSE(empty.BeginObject());
+    ASSERT_TRUE(empty.WasParseSuccessful());
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/logging/AsyncLogSystem.h>
+#include <aws/core/utils/logging/LogField.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/StringUtils.h>
+
+#include <cstdio>
+#include <thread>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "AsyncLogSystemTest";
+
+namespace
+{
+    // message of a logged line, after the "[LEVEL] date time tag [threadid] " prefix
+    Aws::String GetLoggedMessage(const Aws::String& line)
+    {
+        size_t threadIdEnd = line.find("] ", line.find(" ["));
+        return threadIdEnd == Aws::String::npos ? "" : line.substr(threadIdEnd + 2);
+    }
+}
+
+TEST(AsyncLogSystemTest, TestLinesMatchFormattedLogSystem)
+{
+    auto stream = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    {
+        AsyncLogSystem logSystem(LogLevel::Trace, stream);
+        logSystem.Log(LogLevel::Error, "TestTag", "number %d", 42);
+        Aws::OStringStream message;
+        message << "stream " << 1.5;
+        logSystem.LogStream(LogLevel::Debug, "OtherTag", message);
+        logSystem.Flush();
+
+        auto lines = StringUtils::SplitOnLine(stream->str());
+        ASSERT_EQ(2u, lines.size());
+        // [ERROR] 2020-01-02 03:04:05.678 TestTag [140000000000] number 42
+        ASSERT_EQ(0u, lines[0].find("[ERROR] "));
+        ASSERT_EQ(' ', lines[0][18]);
+        ASSERT_EQ('.', lines[0][27]);
+        ASSERT_EQ(" TestTag [", lines[0].substr(31, 10));
+        ASSERT_EQ("number 42", GetLoggedMessage(lines[0]));
+        ASSERT_EQ(0u, lines[1].find("[DEBUG] "));
+        ASSERT_NE(Aws::String::npos, lines[1].find(" OtherTag ["));
+        ASSERT_EQ("stream 1.5", GetLoggedMessage(lines[1]));
+    }
+    ASSERT_EQ('\n', stream->str().back());
+}
+
+TEST(AsyncLogSystemTest, TestDeferredFormattingMatchesPrintf)
+{
+    auto stream = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    AsyncLogSystem logSystem(LogLevel::Trace, stream);
+    Aws::Vector<Aws::String> expected;
+    char printed[256];
+
+#define CHECK_FORMAT(...) \
+    logSystem.Log(LogLevel::Info, "Format", __VA_ARGS__); \
+    snprintf(printed, sizeof(printed), __VA_ARGS__); \
+    expected.push_back(printed);
+
+    char localText[] = "not a literal";
+    CHECK_FORMAT("plain text with no conversions");
+    CHECK_FORMAT("%d %i %+d % d %05d %-5d| %x %X %#o %u", -12, 34, 5, 6, -7, 8, 0xBEEFu, 0xCAFEu, 8u, 4000000000u);
+    CHECK_FORMAT("%hhd %hd %ld %lld %hhu %hu %lu %llu", 300, 70000, -123456789L, -1234567890123LL, 300, 70000, 123456789UL, 12345678901234ULL);
+    CHECK_FORMAT("%zu %zx %jd %td", static_cast<size_t>(99), static_cast<size_t>(255), static_cast<intmax_t>(-5), static_cast<ptrdiff_t>(-6));
+    CHECK_FORMAT("%f %.2f %10.3e %g %G %a %Lf", 3.14159, 2.71828, 12345.678, 0.0001, 1e20, 1.0, 2.5L);
+    CHECK_FORMAT("%s|%10s|%-10s|%.3s|%*s|%-*.*s|", "abc", "right", "left", "truncated", 6, "star", 8, 2, "precision");
+    CHECK_FORMAT("%s %c%c %%d %% %5c", localText, 'o', 'k', 'x');
+#undef CHECK_FORMAT
+
+    logSystem.Flush();
+    auto lines = StringUtils::SplitOnLine(stream->str());
+    ASSERT_EQ(expected.size(), lines.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(expected[i], GetLoggedMessage(lines[i]));
+    }
+
+    const char* nullString = nullptr;
+    logSystem.Log(LogLevel::Info, "Format", "%s|", nullString);
+    logSystem.Flush();
+    ASSERT_EQ("(null)|", GetLoggedMessage(StringUtils::SplitOnLine(stream->str()).back()));
+
+    void* pointer = &logSystem;
+    snprintf(printed, sizeof(printed), "%p", pointer);
+    logSystem.Log(LogLevel::Info, "Format", "%p", pointer);
+    logSystem.Flush();
+    ASSERT_EQ(printed, GetLoggedMessage(StringUtils::SplitOnLine(stream->str()).back()));
+}
+
+TEST(AsyncLogSystemTest, TestDeferredFieldsMatchAppendLogFields)
+{
+    auto stream = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    AsyncLogSystem logSystem(LogLevel::Trace, stream);
+    Aws::String uri = "/bucket/a key";
+    const char rawBytes[] = { 'a', '\0', 'b' };
+    const LogField fields[] = { {"attempt", -2}, {"bytes", static_cast<uint64_t>(1) << 40}, {"latency", 0.25}, {"retry", false},
+        {"uri", uri}, {"raw", rawBytes, sizeof(rawBytes)}, {"empty", ""}, {"level", LogLevel::Debug} };
+
+    Aws::String expected;
+    AppendLogFields(expected, "Request sent", strlen("Request sent"), fields, sizeof(fields) / sizeof(fields[0]));
+    ASSERT_EQ("Request sent attempt=-2 bytes=1099511627776 latency=0.25 retry=false uri=\"/bucket/a key\" raw=\"a\\x00b\" empty=\"\" level=5", expected);
+
+    logSystem.LogFields(LogLevel::Info, "Fields", "Request sent", fields, sizeof(fields) / sizeof(fields[0]));
+    logSystem.LogFields(LogLevel::Info, "Fields", "No fields", nullptr, 0);
+    logSystem.Flush();
+
+    auto lines = StringUtils::SplitOnLine(stream->str());
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ(0u, lines[0].find("[INFO] "));
+    ASSERT_EQ(expected, GetLoggedMessage(lines[0]));
+    ASSERT_EQ("No fields", GetLoggedMessage(lines[1]));
+}
+
+TEST(AsyncLogSystemTest, TestStatementsOfManyThreads)
+{
+    static const int THREADS = 8;
+    static const int STATEMENTS = 2000;
+    auto stream = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    {
+        AsyncLogSystem logSystem(LogLevel::Trace, stream, 1024 * 1024);
+        Aws::Vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&logSystem, t]()
+            {
+                for (int i = 0; i < STATEMENTS; ++i)
+                {
+                    logSystem.Log(LogLevel::Debug, "Thread", "thread %d statement %d %s", t, i, "text");
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        // buffers of exited threads are still written out
+        logSystem.Flush();
+        ASSERT_EQ(0u, logSystem.GetDroppedStatementCount());
+    }
+
+    auto lines = StringUtils::SplitOnLine(stream->str());
+    ASSERT_EQ(static_cast<size_t>(THREADS * STATEMENTS), lines.size());
+    Aws::Vector<int> next(THREADS, 0);
+    for (const auto& line : lines)
+    {
+        int thread = -1;
+        int statement = -1;
+        ASSERT_EQ(2, sscanf(GetLoggedMessage(line).c_str(), "thread %d statement %d text", &thread, &statement)) << line;
+        ASSERT_EQ(next[thread]++, statement);
+    }
+}
+
+TEST(AsyncLogSystemTest, TestFullBufferDropsStatements)
+{
+    static const int STATEMENTS = 5000;
+    auto stream = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    uint64_t dropped = 0;
+    {
+        AsyncLogSystem logSystem(LogLevel::Trace, stream, 4096);
+        Aws::String longText(300, 'x');
+        for (int i = 0; i < STATEMENTS; ++i)
+        {
+            logSystem.Log(LogLevel::Info, "Drop", "%d %s", i, longText.c_str());
+        }
+        Aws::OStringStream tooLong;
+        tooLong << Aws::String(10000, 'y');
+        logSystem.LogStream(LogLevel::Info, "Drop", tooLong);
+        logSystem.Flush();
+        dropped = logSystem.GetDroppedStatementCount();
+    }
+
+    ASSERT_LT(0u, dropped);
+    auto lines = StringUtils::SplitOnLine(stream->str());
+    size_t written = 0;
+    uint64_t reported = 0;
+    bool sawTruncated = false;
+    for (const auto& line : lines)
+    {
+        Aws::String message = GetLoggedMessage(line);
+        if (message.find("Dropped ") == 0)
+        {
+            reported += StringUtils::ConvertToInt64(message.substr(8).c_str());
+        }
+        else if (message[0] == 'y')
+        {
+            // too long for the buffer, truncated to half its size
+            sawTruncated = message.size() < 2048 && message.find_first_not_of('y') == Aws::String::npos;
+        }
+        else
+        {
+            ++written;
+        }
+    }
+    ASSERT_EQ(dropped, reported);
+    ASSERT_EQ(static_cast<uint64_t>(STATEMENTS), written + dropped - (sawTruncated ? 0 : 1));
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+// compiles the statements of this file as if the SDK was built with MINIMUM_COMPILED_LOG_LEVEL=WARN
+#undef AWS_MINIMUM_COMPILED_LOG_LEVEL
+#define AWS_MINIMUM_COMPILED_LOG_LEVEL 3
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/logging/DefaultLogSystem.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/StringUtils.h>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "CompiledLogLevelTest";
+
+namespace
+{
+    int Evaluate(int& evaluations)
+    {
+        return ++evaluations;
+    }
+}
+
+TEST(CompiledLogLevelTest, TestLevelsAboveMinimumAreCompiledOut)
+{
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    int evaluations = 0;
+    {
+        Aws::Utils::Logging::PushLogger(Aws::MakeShared<DefaultLogSystem>(AllocationTag, LogLevel::Trace, ss));
+
+        AWS_LOG_ERROR("CompiledLogLevelTest", "error %d", Evaluate(evaluations));
+        AWS_LOGSTREAM_WARN("CompiledLogLevelTest", "warn " << Evaluate(evaluations));
+        AWS_LOG_KV_WARN("CompiledLogLevelTest", "warn fields", {"evaluations", Evaluate(evaluations)});
+        AWS_LOG_INFO("CompiledLogLevelTest", "info %d", Evaluate(evaluations));
+        AWS_LOGSTREAM_DEBUG("CompiledLogLevelTest", "debug " << Evaluate(evaluations));
+        AWS_LOG_KV_TRACE("CompiledLogLevelTest", "trace fields", {"evaluations", Evaluate(evaluations)});
+        AWS_LOG(LogLevel::Info, "CompiledLogLevelTest", "generic info %d", Evaluate(evaluations));
+        AWS_LOGSTREAM(LogLevel::Error, "CompiledLogLevelTest", "generic error " << Evaluate(evaluations));
+
+        Aws::Utils::Logging::PopLogger();
+    }
+
+    ASSERT_EQ(4, evaluations);
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+    ASSERT_EQ(4u, loggedStatements.size());
+    ASSERT_NE(Aws::String::npos, loggedStatements[0].find("] error 1"));
+    ASSERT_NE(Aws::String::npos, loggedStatements[1].find("] warn 2"));
+    ASSERT_NE(Aws::String::npos, loggedStatements[2].find("] warn fields evaluations=3"));
+    ASSERT_NE(Aws::String::npos, loggedStatements[3].find("] generic error 4"));
+}
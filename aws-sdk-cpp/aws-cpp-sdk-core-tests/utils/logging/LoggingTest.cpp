@@ -8,6 +8,7 @@
 #include <aws/external/gtest.h>
 
 #include <aws/core/utils/logging/DefaultLogSystem.h>
+#include <aws/core/utils/logging/LogField.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/StringUtils.h>
@@ -132,3 +133,58 @@ TEST(LoggingTest, testTraceLogLevel)
 {
     DoLogTest(LogLevel::Trace, "LoggingTest_testTraceLogLevel");    
 }
+
+class StreamCapturingLogSystem : public LogSystemInterface
+{
+public:
+    LogLevel GetLogLevel(void) const override { return LogLevel::Info; }
+    void Log(LogLevel, const char*, const char*, ...) override {}
+    void LogStream(LogLevel, const char*, const Aws::OStringStream& messageStream) override { messages.push_back(messageStream.str()); }
+    void Flush() override {}
+
+    Aws::Vector<Aws::String> messages;
+};
+
+void LogStructuredStatements(const char* tag)
+{
+    Aws::String uri = "/bucket/a key";
+    AWS_LOG_KV_INFO(tag, "Request sent", {"attempt", 2}, {"bytes", static_cast<size_t>(1024)}, {"latency", 1.5}, {"retry", true},
+        {"uri", uri}, {"host", "s3.amazonaws.com"}, {"empty", ""}, {"quote", "say \"hi\"\n"}, {"offset", static_cast<int64_t>(-7)});
+    AWS_LOG_KV_DEBUG(tag, "Filtered out", {"attempt", 3});
+    AWS_LOG_KV(LogLevel::Warn, tag, "Generic", {"level", LogLevel::Warn});
+}
+
+static const char* EXPECTED_STRUCTURED_STATEMENT = "Request sent attempt=2 bytes=1024 latency=1.5 retry=true uri=\"/bucket/a key\" host=s3.amazonaws.com "
+    "empty=\"\" quote=\"say \\\"hi\\\"\\n\" offset=-7";
+
+TEST(LoggingTest, testStructuredLogFields)
+{
+    auto ss = Aws::MakeShared<Aws::StringStream>(AllocationTag);
+    {
+        ScopedLogger loggingScope(Aws::MakeShared<DefaultLogSystem>(AllocationTag, LogLevel::Info, ss));
+        LogStructuredStatements("LoggingTest_testStructuredLogFields");
+    }
+
+    Aws::Vector<Aws::String> loggedStatements = StringUtils::SplitOnLine(ss->str());
+    ASSERT_EQ(2u, loggedStatements.size());
+    ASSERT_EQ(0u, loggedStatements[0].find("[INFO] "));
+    ASSERT_NE(Aws::String::npos, loggedStatements[0].find(" LoggingTest_testStructuredLogFields ["));
+    ASSERT_NE(Aws::String::npos, loggedStatements[0].find(Aws::String("] ") + EXPECTED_STRUCTURED_STATEMENT));
+    ASSERT_EQ(loggedStatements[0].size(), loggedStatements[0].find(EXPECTED_STRUCTURED_STATEMENT) + strlen(EXPECTED_STRUCTURED_STATEMENT));
+    ASSERT_EQ(0u, loggedStatements[1].find("[WARN] "));
+    ASSERT_NE(Aws::String::npos, loggedStatements[1].find("] Generic level=3"));
+}
+
+TEST(LoggingTest, testStructuredLogFieldsOfCustomLogSystem)
+{
+    auto logSystem = Aws::MakeShared<StreamCapturingLogSystem>(AllocationTag);
+    {
+        ScopedLogger loggingScope(logSystem);
+        LogStructuredStatements("LoggingTest_testStructuredLogFieldsOfCustomLogSystem");
+    }
+
+    ASSERT_EQ(2u, logSystem->messages.size());
+    ASSERT_EQ(EXPECTED_STRUCTURED_STATEMENT, logSystem->messages[0]);
+    ASSERT_EQ("Generic level=3", logSystem->messages[1]);
+}
+
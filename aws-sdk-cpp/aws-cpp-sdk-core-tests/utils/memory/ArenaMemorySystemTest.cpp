@@ -0,0 +1,181 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Aws::Utils::Memory;
+
+namespace
+{
+    class CountingMemorySystem : public MemorySystemInterface
+    {
+    public:
+        CountingMemorySystem() : allocations(0), outstanding(0) {}
+
+        void Begin() override {}
+        void End() override {}
+
+        void* AllocateMemory(std::size_t blockSize, std::size_t, const char*) override
+        {
+            ++allocations;
+            ++outstanding;
+            return malloc(blockSize);
+        }
+
+        void FreeMemory(void* memoryPtr) override
+        {
+            --outstanding;
+            free(memoryPtr);
+        }
+
+        size_t allocations;
+        size_t outstanding;
+    };
+}
+
+TEST(ArenaMemorySystemTest, TestAllocationsOutsideOfAScopeComeFromUpstream)
+{
+    CountingMemorySystem upstream;
+    ArenaMemorySystem memorySystem(&upstream);
+
+    void* first = memorySystem.AllocateMemory(10, 1);
+    void* second = memorySystem.AllocateMemory(100, 1);
+    ASSERT_EQ(2u, upstream.allocations);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(first) % 16);
+    memset(first, 1, 10);
+    memset(second, 2, 100);
+
+    memorySystem.FreeMemory(first);
+    memorySystem.FreeMemory(second);
+    memorySystem.FreeMemory(nullptr);
+    ASSERT_EQ(0u, upstream.outstanding);
+}
+
+TEST(ArenaMemorySystemTest, TestScopeAllocatesFromBlocksReleasedInOneShot)
+{
+    CountingMemorySystem upstream;
+    ArenaMemorySystem memorySystem(&upstream, 4096);
+    std::vector<void*> allocations;
+    {
+        RequestArenaScope scope;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            void* memory = memorySystem.AllocateMemory(1 + i % 40, 1);
+            ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(memory) % 16);
+            memset(memory, static_cast<int>(i), 1 + i % 40);
+            allocations.push_back(memory);
+        }
+        // 100 allocations of at most 64 bytes with their headers fit in a few blocks
+        ASSERT_GE(3u, upstream.allocations);
+
+        // too big for the arena
+        void* large = memorySystem.AllocateMemory(2048, 1);
+        ASSERT_EQ(upstream.allocations, upstream.outstanding);
+        memorySystem.FreeMemory(large);
+    }
+
+    size_t blocks = upstream.outstanding;
+    ASSERT_LT(0u, blocks);
+    for (size_t i = 0; i < allocations.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<unsigned char>(i), *static_cast<unsigned char*>(allocations[i]));
+    }
+    for (size_t i = 0; i + 1 < allocations.size(); ++i)
+    {
+        memorySystem.FreeMemory(allocations[i]);
+    }
+    // the block of the last allocation is still referenced
+    ASSERT_EQ(1u, upstream.outstanding);
+    memorySystem.FreeMemory(allocations.back());
+    ASSERT_EQ(0u, upstream.outstanding);
+}
+
+TEST(ArenaMemorySystemTest, TestAllocationsOutliveTheScopeAndAreFreedOnAnotherThread)
+{
+    CountingMemorySystem upstream;
+    ArenaMemorySystem memorySystem(&upstream);
+    std::vector<char*> allocations;
+    {
+        RequestArenaScope scope;
+        for (int i = 0; i < 10; ++i)
+        {
+            char* memory = static_cast<char*>(memorySystem.AllocateMemory(32, 1));
+            memset(memory, 'a' + i, 32);
+            allocations.push_back(memory);
+        }
+    }
+    ASSERT_EQ(1u, upstream.outstanding);
+
+    std::thread freeingThread([&]()
+    {
+        for (size_t i = 0; i < allocations.size(); ++i)
+        {
+            ASSERT_EQ(static_cast<char>('a' + i), allocations[i][31]);
+            memorySystem.FreeMemory(allocations[i]);
+        }
+    });
+    freeingThread.join();
+    ASSERT_EQ(0u, upstream.outstanding);
+}
+
+TEST(ArenaMemorySystemTest, TestNestedScopesUseTheirOwnBlocks)
+{
+    CountingMemorySystem upstream;
+    ArenaMemorySystem memorySystem;
+    ArenaMemorySystem countedMemorySystem(&upstream);
+
+    void* outer = nullptr;
+    void* inner = nullptr;
+    {
+        RequestArenaScope outerScope;
+        outer = countedMemorySystem.AllocateMemory(16, 1);
+        {
+            RequestArenaScope innerScope;
+            inner = countedMemorySystem.AllocateMemory(16, 1);
+            // the default upstream is malloc
+            memorySystem.FreeMemory(memorySystem.AllocateMemory(16, 1));
+        }
+        ASSERT_EQ(2u, upstream.outstanding);
+        countedMemorySystem.FreeMemory(inner);
+        ASSERT_EQ(1u, upstream.outstanding);
+    }
+    ASSERT_EQ(1u, upstream.outstanding);
+    countedMemorySystem.FreeMemory(outer);
+    ASSERT_EQ(0u, upstream.outstanding);
+}
+
+TEST(ArenaMemorySystemTest, TestSuspendedScopeLetsAllocationsOutliveItsBlocks)
+{
+    CountingMemorySystem upstream;
+    ArenaMemorySystem memorySystem(&upstream);
+
+    void* kept = nullptr;
+    {
+        RequestArenaScope scope;
+        memorySystem.FreeMemory(memorySystem.AllocateMemory(16, 1));
+        ASSERT_EQ(1u, upstream.outstanding);
+        {
+            RequestArenaSuspension suspension;
+            kept = memorySystem.AllocateMemory(16, 1);
+            ASSERT_EQ(2u, upstream.outstanding);
+        }
+        // the scope is back in use after the suspension
+        void* scoped = memorySystem.AllocateMemory(16, 1);
+        ASSERT_EQ(2u, upstream.outstanding);
+        memorySystem.FreeMemory(scoped);
+    }
+    // the block is released with the scope, only the allocation kept from upstream is left
+    ASSERT_EQ(1u, upstream.outstanding);
+    memorySystem.FreeMemory(kept);
+    ASSERT_EQ(0u, upstream.outstanding);
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/stream/ConcurrentStreamBuf.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <algorithm>
+#include <thread>
+
+using namespace Aws::Utils::Stream;
+
+const char concurrentBufferStr[] = "This is an internal buffer.";
+
+TEST(ConcurrentStreamBufTest, TestWriteThenRead)
+{
+    ConcurrentStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream.write(concurrentBufferStr, sizeof(concurrentBufferStr));
+    ioStream.flush();
+    ASSERT_EQ(static_cast<std::streamsize>(sizeof(concurrentBufferStr)), ioStream.rdbuf()->in_avail());
+
+    char output[64];
+    ioStream.readsome(output, sizeof(output));
+    ASSERT_EQ(static_cast<std::streamsize>(sizeof(concurrentBufferStr)), ioStream.gcount());
+    ASSERT_STREQ(concurrentBufferStr, output);
+    ASSERT_EQ(0, ioStream.rdbuf()->in_avail());
+}
+
+// Unflushed bytes are not visible to the reader.
+TEST(ConcurrentStreamBufTest, TestReadBeforeFlush)
+{
+    ConcurrentStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream.write(concurrentBufferStr, sizeof(concurrentBufferStr));
+    ASSERT_EQ(0, ioStream.rdbuf()->in_avail());
+
+    ioStream.flush();
+    ASSERT_EQ(static_cast<std::streamsize>(sizeof(concurrentBufferStr)), ioStream.rdbuf()->in_avail());
+}
+
+// Data that wraps around the end of the ring is read back in order.
+TEST(ConcurrentStreamBufTest, TestWrapAround)
+{
+    ConcurrentStreamBuf streamBuf(10);
+    Aws::IOStream ioStream(&streamBuf);
+    char output[16];
+    for (int i = 0; i < 10; ++i)
+    {
+        ioStream.write("abcdefg", 7);
+        ioStream.flush();
+        ASSERT_EQ(7, ioStream.rdbuf()->sgetn(output, 7));
+        ASSERT_EQ(Aws::String("abcdefg"), Aws::String(output, 7));
+    }
+}
+
+TEST(ConcurrentStreamBufTest, TestReadRemainingAfterEof)
+{
+    ConcurrentStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    ioStream.write(concurrentBufferStr, sizeof(concurrentBufferStr));
+    ioStream.flush();
+    streamBuf.SetEof();
+
+    char output[64];
+    ioStream.read(output, sizeof(output));
+    ASSERT_EQ(static_cast<std::streamsize>(sizeof(concurrentBufferStr)), ioStream.gcount());
+    ASSERT_STREQ(concurrentBufferStr, output);
+    ASSERT_TRUE(ioStream.eof());
+}
+
+// A reader blocked on an empty buffer is released by SetEof().
+TEST(ConcurrentStreamBufTest, TestEofReleasesReader)
+{
+    ConcurrentStreamBuf streamBuf;
+    Aws::IOStream ioStream(&streamBuf);
+    std::thread reader([&ioStream] {
+        char output[8];
+        ioStream.read(output, sizeof(output));
+    });
+    streamBuf.SetEof();
+    reader.join();
+    ASSERT_TRUE(ioStream.eof());
+}
+
+// The writer blocks on a full ring until the reader frees up space, the reader gets every byte in order.
+TEST(ConcurrentStreamBufTest, TestConcurrentReaderAndWriter)
+{
+    const size_t totalLength = 1024 * 1024;
+    ConcurrentStreamBuf streamBuf(61);
+    Aws::IOStream ioStream(&streamBuf);
+
+    std::thread writer([&ioStream, &streamBuf, totalLength] {
+        char chunk[97];
+        for (size_t written = 0; written < totalLength; written += sizeof(chunk))
+        {
+            const size_t length = (std::min)(sizeof(chunk), totalLength - written);
+            for (size_t i = 0; i < length; ++i)
+            {
+                chunk[i] = static_cast<char>((written + i) % 251);
+            }
+            ioStream.write(chunk, length);
+        }
+        ioStream.flush();
+        streamBuf.SetEof();
+    });
+
+    size_t read = 0;
+    bool inOrder = true;
+    char output[53];
+    std::streamsize length = 0;
+    while ((length = streamBuf.sgetn(output, sizeof(output))) > 0)
+    {
+        for (std::streamsize i = 0; i < length; ++i)
+        {
+            inOrder = inOrder && output[i] == static_cast<char>((read + i) % 251);
+        }
+        read += static_cast<size_t>(length);
+    }
+    writer.join();
+
+    ASSERT_TRUE(inOrder);
+    ASSERT_EQ(totalLength, read);
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/BoundedThreadExecutor.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace Aws::Utils::Threading;
+
+TEST(BoundedThreadExecutor, GrowsLazilyUpToMaxThreads)
+{
+    BoundedThreadExecutor exec(2, 0);
+    ASSERT_EQ(0u, exec.GetMetrics().threadCount);
+
+    Semaphore blocked(0, 4);
+    Semaphore started(0, 4);
+    std::atomic<int> running(0);
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(exec.Submit([&] { running++; started.Release(); blocked.WaitOne(); running--; }));
+    }
+
+    started.WaitOne();
+    started.WaitOne();
+    auto metrics = exec.GetMetrics();
+    ASSERT_EQ(2u, metrics.threadCount);
+    ASSERT_EQ(2u, metrics.queueDepth);
+    ASSERT_EQ(2, running.load());
+
+    blocked.ReleaseAll();
+    started.WaitOne();
+    started.WaitOne();
+    blocked.ReleaseAll();
+}
+
+TEST(BoundedThreadExecutor, RejectsWhenQueueIsFull)
+{
+    Semaphore blocked(0, 1);
+    Semaphore started(0, 1);
+    std::atomic<int> completed(0);
+    {
+        BoundedThreadExecutor exec(1, 2, QueueFullPolicy::REJECT);
+        ASSERT_TRUE(exec.Submit([&] { started.Release(); blocked.WaitOne(); }));
+        started.WaitOne();
+
+        ASSERT_TRUE(exec.Submit([&] { completed++; }));
+        ASSERT_TRUE(exec.Submit([&] { completed++; }));
+        ASSERT_FALSE(exec.Submit([&] { completed++; }));
+        ASSERT_EQ(1u, exec.GetMetrics().rejectedTasks);
+        blocked.Release();
+    }
+    //queued tasks run before the executor goes away
+    ASSERT_EQ(2, completed.load());
+}
+
+TEST(BoundedThreadExecutor, BlocksWhenQueueIsFull)
+{
+    Semaphore blocked(0, 1);
+    Semaphore started(0, 1);
+    std::atomic<int> completed(0);
+    std::atomic<bool> submitted(false);
+
+    BoundedThreadExecutor exec(1, 1, QueueFullPolicy::BLOCK);
+    ASSERT_TRUE(exec.Submit([&] { started.Release(); blocked.WaitOne(); }));
+    started.WaitOne();
+    ASSERT_TRUE(exec.Submit([&] { completed++; }));
+
+    std::thread submitter([&] {
+        exec.Submit([&] { completed++; });
+        submitted = true;
+    });
+
+    while (exec.GetMetrics().blockedSubmissions == 0)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(submitted.load());
+
+    blocked.Release();
+    submitter.join();
+    ASSERT_TRUE(submitted.load());
+
+    while (exec.GetMetrics().completedTasks < 3)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(2, completed.load());
+    ASSERT_EQ(0u, exec.GetMetrics().queueDepth);
+}
+
+TEST(BoundedThreadExecutor, NestedSubmissionsDoNotBlock)
+{
+    Semaphore done(0, 1);
+    std::atomic<int> completed(0);
+    BoundedThreadExecutor exec(1, 1, QueueFullPolicy::BLOCK);
+    ASSERT_TRUE(exec.Submit([&] {
+        //the only thread submits more than the queue holds, blocking here would deadlock
+        for (int i = 0; i < 3; ++i)
+        {
+            exec.Submit([&] {
+                if (++completed == 3)
+                {
+                    done.Release();
+                }
+            });
+        }
+    }));
+    done.WaitOne();
+    ASSERT_EQ(3, completed.load());
+    ASSERT_EQ(3u, exec.GetMetrics().peakQueueDepth);
+}
+
+TEST(BoundedThreadExecutor, NestedWaitsDoNotDeadlock)
+{
+    const int taskCount = 4;
+    Semaphore done(0, taskCount);
+    BoundedThreadExecutor exec(2, 0);
+    for (int i = 0; i < taskCount; ++i)
+    {
+        //like a handler waiting on the future of a Callable operation, with more of them than there are threads
+        ASSERT_TRUE(exec.Submit([&] {
+            auto inner = std::make_shared<std::promise<void>>();
+            exec.Submit([inner] { inner->set_value(); });
+            inner->get_future().wait();
+            done.Release();
+        }));
+    }
+    for (int i = 0; i < taskCount; ++i)
+    {
+        done.WaitOne();
+    }
+
+    //the extra threads go away with the work they were started for
+    while (exec.GetMetrics().threadCount > 2)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(static_cast<uint64_t>(2 * taskCount), exec.GetMetrics().submittedTasks);
+}
+
+TEST(BoundedThreadExecutor, LastReferenceReleasedByTask)
+{
+    Semaphore done(0, 1);
+    std::atomic<int> completed(0);
+    auto exec = Aws::MakeShared<BoundedThreadExecutor>("BoundedThreadExecutorTest", 1);
+    Semaphore blocked(0, 1);
+    ASSERT_TRUE(exec->Submit([&blocked] { blocked.WaitOne(); }));
+    ASSERT_TRUE(exec->Submit([exec, &completed] { completed++; }));
+    ASSERT_TRUE(exec->Submit([&completed, &done] { completed++; done.Release(); }));
+    //the second task now holds the only reference, the executor is destroyed on its own thread once it's done
+    exec = nullptr;
+    blocked.Release();
+    done.WaitOne();
+    ASSERT_EQ(2, completed.load());
+}
+
+TEST(BoundedThreadExecutor, ClientConfigurationsShareDefaultExecutor)
+{
+    Aws::Client::ClientConfiguration first;
+    Aws::Client::ClientConfiguration second;
+    ASSERT_NE(nullptr, first.executor);
+    ASSERT_EQ(first.executor, second.executor);
+    ASSERT_EQ(first.executor, GetDefaultExecutor());
+}
@@ -0,0 +1,116 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/threading/WorkStealingThreadExecutor.h>
+#include <aws/core/utils/threading/Semaphore.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <atomic>
+#include <thread>
+
+using namespace Aws::Utils::Threading;
+
+static const char* ALLOCATION_TAG = "WorkStealingThreadExecutorTest";
+
+TEST(WorkStealingThreadExecutor, RunsAllTasksFromManyProducers)
+{
+    static const int PRODUCERS = 8;
+    static const int TASKS_PER_PRODUCER = 5000;
+    std::atomic<int> completed(0);
+    Semaphore done(0, 1);
+    {
+        WorkStealingThreadExecutor exec(4, OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS, 64);
+        Aws::Vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&] {
+                for (int i = 0; i < TASKS_PER_PRODUCER; ++i)
+                {
+                    ASSERT_TRUE(exec.Submit([&] {
+                        if (++completed == PRODUCERS * TASKS_PER_PRODUCER)
+                        {
+                            done.Release();
+                        }
+                    }));
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        done.WaitOne();
+    }
+    ASSERT_EQ(PRODUCERS * TASKS_PER_PRODUCER, completed.load());
+}
+
+TEST(WorkStealingThreadExecutor, NestedSubmissionsAreStolenByIdleWorkers)
+{
+    static const int CHILDREN = 64;
+    std::atomic<int> completed(0);
+    Semaphore done(0, 1);
+
+    WorkStealingThreadExecutor exec(4);
+    exec.Submit([&] {
+        for (int i = 0; i < CHILDREN; ++i)
+        {
+            exec.Submit([&] {
+                if (++completed == CHILDREN)
+                {
+                    done.Release();
+                }
+            });
+        }
+        //keep the parent's worker busy so that its deque can only be drained by the other workers
+        while (completed.load() < CHILDREN)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    done.WaitOne();
+    ASSERT_EQ(CHILDREN, completed.load());
+}
+
+TEST(WorkStealingThreadExecutor, RejectsWhenQueuesAreFull)
+{
+    Semaphore blocked(0, 1);
+    Semaphore started(0, 1);
+    std::atomic<int> completed(0);
+    {
+        WorkStealingThreadExecutor exec(1, OverflowPolicy::REJECT_IMMEDIATELY, 4);
+        ASSERT_TRUE(exec.Submit([&] { started.Release(); blocked.WaitOne(); }));
+        started.WaitOne();
+
+        int accepted = 0;
+        while (exec.Submit([&] { completed++; }))
+        {
+            ASSERT_LT(++accepted, 1000);
+        }
+        ASSERT_EQ(4, accepted);
+        blocked.Release();
+    }
+    ASSERT_LE(completed.load(), 4);
+}
+
+TEST(WorkStealingThreadExecutor, DiscardsPendingTasksOnDestruction)
+{
+    Semaphore blocked(0, 1);
+    Semaphore started(0, 1);
+    auto counter = Aws::MakeShared<int>(ALLOCATION_TAG, 0);
+    {
+        WorkStealingThreadExecutor exec(1);
+        exec.Submit([&] { started.Release(); blocked.WaitOne(); });
+        started.WaitOne();
+        for (int i = 0; i < 100; ++i)
+        {
+            exec.Submit([counter] { (*counter)++; });
+        }
+        ASSERT_EQ(101, counter.use_count());
+        blocked.Release();
+    }
+    //every captured copy has been released, whether the task ran or not
+    ASSERT_EQ(1, counter.use_count());
+}
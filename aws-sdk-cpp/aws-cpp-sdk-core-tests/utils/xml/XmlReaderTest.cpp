@@ -0,0 +1,175 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/external/gtest.h>
+#include <aws/core/utils/xml/XmlReader.h>
+#include <aws/core/utils/xml/XmlSerializer.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/StringUtils.h>
+#include <cstring>
+
+using namespace Aws::Utils::Xml;
+
+TEST(XmlReaderTest, TestReadListingDocument)
+{
+    Aws::String input = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- listing -->
+<ListBucketResult xmlns="http://s3.amazonaws.com/doc/2006-03-01/">
+  <Name>bucket</Name>
+  <IsTruncated> true </IsTruncated>
+  <Contents><Key>a&amp;b &lt;c&gt; &#233;&#x1F600;</Key><Size>12</Size><Owner><ID>x</ID></Owner></Contents>
+  <Contents><Key><![CDATA[<raw> & ]]]]><![CDATA[>]]></Key><Unknown attr="1"><Deep/></Unknown><Size>3</Size></Contents>
+  <Empty/>
+  <Prefix></Prefix>
+</ListBucketResult>)";
+    Aws::StringStream stream(input);
+    XmlReader reader(stream);
+
+    Aws::String name;
+    Aws::String truncated;
+    Aws::Vector<Aws::String> keys;
+    Aws::Vector<int> sizes;
+    Aws::String owner;
+    Aws::String prefix = "unset";
+
+    ASSERT_TRUE(reader.NextChildElement());
+    ASSERT_EQ("ListBucketResult", reader.GetElementName());
+    ASSERT_EQ("http://s3.amazonaws.com/doc/2006-03-01/", reader.GetAttributeValue("xmlns"));
+    ASSERT_TRUE(reader.EnterElement());
+    while (reader.NextChildElement())
+    {
+        const auto& elementName = reader.GetElementName();
+        if (elementName == "Name")
+        {
+            name = reader.ReadElementText();
+        }
+        else if (elementName == "IsTruncated")
+        {
+            truncated = reader.ReadElementText(true);
+        }
+        else if (elementName == "Contents")
+        {
+            ASSERT_TRUE(reader.EnterElement());
+            while (reader.NextChildElement())
+            {
+                if (reader.GetElementName() == "Key")
+                {
+                    keys.push_back(reader.ReadElementText());
+                }
+                else if (reader.GetElementName() == "Size")
+                {
+                    sizes.push_back(Aws::Utils::StringUtils::ConvertToInt32(reader.ReadElementText(true).c_str()));
+                }
+                else if (reader.GetElementName() == "Owner")
+                {
+                    ASSERT_TRUE(reader.EnterElement());
+                    while (reader.NextChildElement())
+                    {
+                        owner = reader.ReadElementText();
+                    }
+                }
+                // Unknown is skipped by the next NextChildElement call.
+            }
+        }
+        else if (elementName == "Empty")
+        {
+            ASSERT_TRUE(reader.EnterElement());
+            ASSERT_FALSE(reader.NextChildElement());
+        }
+        else if (elementName == "Prefix")
+        {
+            prefix = reader.ReadElementText();
+        }
+    }
+
+    ASSERT_FALSE(reader.NextChildElement());
+    ASSERT_TRUE(reader.WasParseSuccessful());
+    ASSERT_EQ("bucket", name);
+    ASSERT_EQ("true", truncated);
+    ASSERT_EQ(2u, keys.size());
+    ASSERT_EQ("a&b <c> \xc3\xa9\xf0\x9f\x98\x80", keys[0]);
+    ASSERT_EQ("<raw> & ]]>", keys[1]);
+    ASSERT_EQ(12, sizes[0]);
+    ASSERT_EQ(3, sizes[1]);
+    ASSERT_EQ("x", owner);
+    ASSERT_EQ("", prefix);
+}
+
+TEST(XmlReaderTest, TestTextMatchesDom)
+{
+    Aws::String input = "<a b='1 &quot;2&quot;'>line\r\nend &unknown; &amp;amp; <i>skipped</i>tail</a>";
+    XmlReader reader(input.c_str(), input.size());
+
+    ASSERT_TRUE(reader.NextChildElement());
+    ASSERT_EQ("1 \"2\"", reader.GetAttributeValue("b"));
+    ASSERT_EQ("", reader.GetAttributeValue("c"));
+    ASSERT_EQ("line\nend &unknown; &amp; tail", reader.ReadElementText());
+    ASSERT_TRUE(reader.WasParseSuccessful());
+
+    auto document = XmlDocument::CreateFromXmlString("<a>x &amp;amp; &lt;y&gt;</a>");
+    XmlReader fromText("<a>x &amp;amp; &lt;y&gt;</a>", strlen("<a>x &amp;amp; &lt;y&gt;</a>"));
+    ASSERT_TRUE(fromText.NextChildElement());
+    ASSERT_EQ(DecodeEscapedXmlText(document.GetRootElement().GetText()), fromText.ReadElementText());
+}
+
+TEST(XmlReaderTest, TestElementsSpanningReadBuffers)
+{
+    // long enough for names, text and references to straddle the reader's internal buffer.
+    Aws::String longText(40000, 'x');
+    Aws::StringStream input;
+    input << "<Root>";
+    for (int i = 0; i < 5000; ++i)
+    {
+        input << "<Item index=\"" << i << "\"><Value>" << longText.substr(0, i % 37) << "&amp;&#233;</Value></Item>";
+    }
+    input << "<Last>" << longText << "</Last></Root>";
+
+    XmlReader reader(input);
+    ASSERT_TRUE(reader.NextChildElement());
+    ASSERT_TRUE(reader.EnterElement());
+    int expected = 0;
+    Aws::String last;
+    while (reader.NextChildElement())
+    {
+        if (reader.GetElementName() == "Last")
+        {
+            last = reader.ReadElementText();
+            continue;
+        }
+
+        ASSERT_EQ(expected, Aws::Utils::StringUtils::ConvertToInt32(reader.GetAttributeValue("index").c_str()));
+        ASSERT_TRUE(reader.EnterElement());
+        ASSERT_TRUE(reader.NextChildElement());
+        ASSERT_EQ(longText.substr(0, expected % 37) + "&\xc3\xa9", reader.ReadElementText());
+        ASSERT_FALSE(reader.NextChildElement());
+        ++expected;
+    }
+
+    ASSERT_TRUE(reader.WasParseSuccessful());
+    ASSERT_EQ(5000, expected);
+    ASSERT_EQ(longText, last);
+}
+
+TEST(XmlReaderTest, TestMalformedDocuments)
+{
+    for (const char* input : {"<a><b></a>", "<a><b>text</b>", "<a b=1></a>", "<a><!-- open </a>", "<a><![CDATA[x</a>", "<a></b>"})
+    {
+        XmlReader reader(input, strlen(input));
+        if (reader.NextChildElement() && reader.EnterElement())
+        {
+            while (reader.NextChildElement())
+            {
+            }
+        }
+        ASSERT_FALSE(reader.WasParseSuccessful()) << input;
+        ASSERT_FALSE(reader.GetErrorMessage().empty());
+        ASSERT_FALSE(reader.NextChildElement());
+        ASSERT_EQ("", reader.ReadElementText());
+    }
+
+    XmlReader empty("", 0);
+    ASSERT_FALSE(empty.NextChildElement());
+    ASSERT_TRUE(empty.WasParseSuccessful());
+}
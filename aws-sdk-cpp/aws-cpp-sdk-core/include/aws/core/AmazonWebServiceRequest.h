@@ -97,6 +97,15 @@ namespace Aws
          * Set the response stream factory.
          */
         void SetResponseStreamFactory(const Aws::IOStreamFactory& factory) { m_responseStreamFactory = factory; }
+        /**
+         * Set the closure the body of a successful response is handed to as it arrives, instead of the response stream.
+         * Only for operations whose response body isn't parsed, e.g. S3 GetObject: the body of the result is then empty.
+         */
+        void SetResponseBodySink(const Aws::Http::ResponseBodySink& sink) { m_responseBodySink = sink; }
+        /**
+         * Retrieves the closure the body of a successful response is handed to, empty by default.
+         */
+        const Aws::Http::ResponseBodySink& GetResponseBodySink() const { return m_responseBodySink; }
         /**
          * Register closure for data received event.
          */
@@ -161,6 +170,7 @@ namespace Aws
 
     private:
         Aws::IOStreamFactory m_responseStreamFactory;
+        Aws::Http::ResponseBodySink m_responseBodySink;
 
         Aws::Http::DataReceivedEventHandler m_onDataReceived;
         Aws::Http::DataSentEventHandler m_onDataSent;
@@ -10,6 +10,7 @@
 #include <aws/core/utils/crypto/Factories.h>
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/monitoring/MonitoringManager.h>
+#include <aws/core/utils/threading/BoundedThreadExecutor.h>
 #include <aws/core/Core_EXPORTS.h>
 
 namespace Aws
@@ -147,6 +148,36 @@ namespace Aws
     };
 
 
+    /**
+     * SDK wide options for the executor clients use to run their *Async and *Callable operations when ClientConfiguration::executor is not set.
+     */
+    struct ExecutorOptions
+    {
+        ExecutorOptions() : maxThreads(0),
+            maxQueuedTasks(Aws::Utils::Threading::BoundedThreadExecutor::DEFAULT_MAX_QUEUED_TASKS),
+            queueFullPolicy(Aws::Utils::Threading::QueueFullPolicy::BLOCK)
+        { }
+
+        /**
+         * Maximum number of threads of the executor shared by all clients. Threads are started on demand.
+         * Defaults to 0, which picks BoundedThreadExecutor::GetDefaultMaxThreads().
+         */
+        size_t maxThreads;
+        /**
+         * Number of tasks allowed to wait for a thread before queueFullPolicy kicks in. 0 means no limit.
+         */
+        size_t maxQueuedTasks;
+        /**
+         * Whether async operations block or fail while the queue is full. Defaults to BLOCK.
+         */
+        Aws::Utils::Threading::QueueFullPolicy queueFullPolicy;
+        /**
+         * If set, called every time a ClientConfiguration is constructed instead of handing out the shared executor, the options above are then ignored.
+         * E.g. return Aws::MakeShared<Aws::Utils::Threading::DefaultExecutor>("ALLOC_TAG") to get back one thread per async call.
+         */
+        std::function<std::shared_ptr<Aws::Utils::Threading::Executor>()> defaultExecutor_create_fn;
+    };
+
     /**
      * You may notice that instead of taking pointers directly to your factories, we take a closure. This is because
      * if you have installed custom memory management, the allocation for your factories needs to happen after
@@ -212,6 +243,11 @@ namespace Aws
          * Basic usage can be found in aws-cpp-sdk-core-tests/monitoring/MonitoringTest.cpp
          */
         MonitoringOptions monitoringOptions;
+
+        /**
+         * SDK wide options for the default executor
+         */
+        ExecutorOptions executorOptions;
     };
 
     /*
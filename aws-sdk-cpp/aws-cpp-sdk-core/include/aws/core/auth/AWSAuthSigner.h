@@ -10,15 +10,18 @@
 #include <aws/core/Region.h>
 #include <aws/core/utils/memory/AWSMemory.h>
 #include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/DateTime.h>
 #include <aws/core/utils/Array.h>
 #include <aws/core/utils/threading/ReaderWriterLock.h>
 #include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/crypto/Sha256HMAC.h>
+#include <aws/core/utils/stream/AwsChunkedStream.h>
 
 #include <memory>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 
 namespace Aws
 {
@@ -42,6 +45,8 @@ namespace Aws
         class AWSCredentialsProvider;
         AWS_CORE_API extern const char SIGV4_SIGNER[];
         AWS_CORE_API extern const char EVENTSTREAM_SIGV4_SIGNER[];
+        AWS_CORE_API extern const char EVENTSTREAM_SIGNATURE_HEADER[];
+        AWS_CORE_API extern const char EVENTSTREAM_DATE_HEADER[];
         AWS_CORE_API extern const char SIGNATURE[];
         AWS_CORE_API extern const char NULL_SIGNER[];
     } // namespace Auth
@@ -117,6 +122,19 @@ namespace Aws
              */
             virtual bool SignEventMessage(Aws::Utils::Event::Message&, Aws::String& /* priorSignature */) const { return false; }
 
+            /**
+             * Signs an event message that is already encoded, in place and without copying it.
+             * On success 'signingTimeMillis' and 'signature' hold the values of the date and signature headers the
+             * caller frames around the encoded message, and 'priorSignature' is updated as in SignEventMessage().
+             *
+             * Returns false if the signer doesn't support this, callers then fall back to SignEventMessage().
+             */
+            virtual bool SignEncodedEventMessage(const unsigned char* /* encodedMessage */, size_t /* encodedMessageLength */,
+                    Aws::String& /* priorSignature */, int64_t& /* signingTimeMillis */, Aws::Utils::ByteBuffer& /* signature */) const
+            {
+                return false;
+            }
+
             /**
              * Takes a request and signs the URI based on the HttpMethod, URI and other info from the request.
              * The URI can then be used in a normal HTTP call until expiration.
@@ -279,12 +297,24 @@ namespace Aws
 
         protected:
             bool m_includeSha256HashHeader;
+            /**
+             * Size of the chunks a PUT body is signed in with STREAMING-AWS4-HMAC-SHA256-PAYLOAD (aws-chunked content encoding),
+             * for services that support it, instead of hashing the whole body before the request is sent.
+             * Bodies smaller than one chunk are hashed up front. 0 disables streaming signing.
+             */
+            size_t m_streamingPayloadChunkSize;
 
         private:
 
             Aws::String GenerateSignature(const Aws::Auth::AWSCredentials& credentials,
                     const Aws::String& stringToSign, const Aws::String& simpleDate, const Aws::String& region,
                     const Aws::String& serviceName) const;
+            Aws::Utils::ByteBuffer GetSigningKey(const Aws::String& secretKey, const Aws::String& simpleDate,
+                    const Aws::String& region, const Aws::String& serviceName) const;
+            bool ServiceSupportsStreamingPayload(const Aws::String& serviceName) const;
+            bool PrepareStreamingPayload(Aws::Http::HttpRequest& request, const Aws::String& serviceName) const;
+            static Aws::Utils::Stream::ChunkSigner CreateChunkSigner(const Aws::Utils::ByteBuffer& signingKey,
+                    const Aws::String& stringToSignPrefix);
 
             Aws::String GenerateSignature(const Aws::String& stringToSign, const Aws::Utils::ByteBuffer& key) const;
             bool ServiceRequireUnsignedPayload(const Aws::String& serviceName) const;
@@ -305,13 +335,19 @@ namespace Aws
 
             Aws::Set<Aws::String> m_unsignedHeaders;
 
-            //these next four fields are ONLY for caching purposes and do not change
+            //these next six fields are ONLY for caching purposes and do not change
             //the logical state of the signer. They are marked mutable so the
             //interface can remain const.
+            //m_partialSignature is the signing key derived from the other four, it is only recomputed when one of them changes.
             mutable Aws::Utils::ByteBuffer m_partialSignature;
             mutable Aws::String m_currentDateStr;
             mutable Aws::String m_currentSecretKey;
+            mutable Aws::String m_currentRegion;
+            mutable Aws::String m_currentServiceName;
             mutable Utils::Threading::ReaderWriterLock m_partialSignatureLock;
+            //scratch buffers canonical requests are assembled in, reused so that signing doesn't allocate for them.
+            mutable std::mutex m_canonicalRequestBuffersLock;
+            mutable Aws::Vector<Aws::String> m_canonicalRequestBuffers;
             PayloadSigningPolicy m_payloadSigningPolicy;
             bool m_urlEscapePath;
         };
@@ -326,6 +362,9 @@ namespace Aws
 
             bool SignEventMessage(Aws::Utils::Event::Message&, Aws::String& priorSignature) const override;
 
+            bool SignEncodedEventMessage(const unsigned char* encodedMessage, size_t encodedMessageLength,
+                    Aws::String& priorSignature, int64_t& signingTimeMillis, Aws::Utils::ByteBuffer& signature) const override;
+
             bool SignRequest(Aws::Http::HttpRequest& request) const override
             {
                 return SignRequest(request, m_region.c_str(), m_serviceName.c_str(), true);
@@ -377,6 +416,8 @@ namespace Aws
             mutable Aws::Utils::ByteBuffer m_derivedKey;
             mutable Aws::String m_currentDateStr;
             mutable Aws::String m_currentSecretKey;
+            mutable std::mutex m_canonicalRequestBuffersLock;
+            mutable Aws::Vector<Aws::String> m_canonicalRequestBuffers;
             Aws::Vector<Aws::String> m_unsignedHeaders;
             std::shared_ptr<Auth::AWSCredentialsProvider> m_credentialsProvider;
         };
@@ -290,9 +290,20 @@ namespace Aws
              * return true if signer's clock is adjusted, false otherwise.
              */
             bool AdjustClockSkew(HttpResponseOutcome& outcome, const char* signerName) const;
+            /**
+             * Bodies of the AttemptExhaustively overloads, which call them in a RequestArenaScope.
+             */
+            HttpResponseOutcome DoAttemptExhaustively(const Aws::Http::URI& uri, const Aws::AmazonWebServiceRequest& request, Http::HttpMethod httpMethod,
+                    const char* signerName, const char* signerRegionOverride, const char* signerServiceNameOverride) const;
+            HttpResponseOutcome DoAttemptExhaustively(const Aws::Http::URI& uri, Http::HttpMethod httpMethod, const char* signerName,
+                    const char* requestName, const char* signerRegionOverride, const char* signerServiceNameOverride) const;
             void AddHeadersToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const Http::HeaderValueCollection& headerValues) const;
+            /**
+             * needsContentSha256 tells that the payload is likely going to be signed, if Content-MD5 has to be computed as well the sha256
+             * is computed in the same pass over the body and recorded on the request for the signer.
+             */
             void AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest, const std::shared_ptr<Aws::IOStream>& body,
-                                         bool needsContentMd5 = false, bool isChunked = false) const;
+                                         bool needsContentMd5 = false, bool isChunked = false, bool needsContentSha256 = false) const;
             void AddCommonHeaders(Aws::Http::HttpRequest& httpRequest) const;
             void InitializeGlobalStatics();
             std::shared_ptr<Aws::Http::HttpRequest> ConvertToRequestForPresigning(const Aws::AmazonWebServiceRequest& request, Aws::Http::URI& uri,
@@ -165,7 +165,8 @@ namespace Aws
             */
             Aws::String proxySSLKeyPassword;
             /**
-            * Threading Executor implementation. Default uses std::thread::detach()
+            * Threading Executor implementation. Defaults to a bounded thread pool shared by all clients, see Aws::Utils::Threading::GetDefaultExecutor()
+            * and SDKOptions::executorOptions. Since the pool outlives the client, don't destroy a client while its async calls are still running.
             */
             std::shared_ptr<Aws::Utils::Threading::Executor> executor;
             /**
@@ -195,8 +196,22 @@ namespace Aws
             std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface> readRateLimiter;
             /**
              * Override the http implementation the default factory returns.
+             * With Curl, set this to TransferLibType::CURL_MULTI_CLIENT to have all requests driven by a single curl_multi event loop
+             * instead of one blocking transfer per calling thread.
              */
             Aws::Http::TransferLibType httpLibOverride;
+            /**
+             * HTTP version to request. Default HTTP_VERSION_2_0: HTTP/2 where the endpoint negotiates it, HTTP/1.1 otherwise.
+             * Only honoured by the Curl clients; Curl builds without HTTP/2 support always use HTTP/1.1.
+             * With TransferLibType::CURL_MULTI_CLIENT and an HTTP/2 version, concurrent requests to the same endpoint are multiplexed
+             * as streams over shared connections, and endpoints that answer with HTTP/1.1 are remembered and no longer offered HTTP/2.
+             */
+            Aws::Http::Version version;
+            /**
+             * Maximum number of concurrent HTTP/2 streams per connection when requests are multiplexed, see version.
+             * Default 0, which keeps libcurl's default of 100.
+             */
+            unsigned http2MaxConcurrentStreams;
             /**
              * Sets the behavior how http stack handles 30x redirect codes.
              */
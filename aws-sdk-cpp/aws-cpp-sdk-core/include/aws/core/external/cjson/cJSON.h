@@ -48,6 +48,12 @@ extern "C"
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+/* Items parsed by the SDK's json backend are allocated together in one block per document, the root item heading it.
+ * cJSON_ArenaValue: the item's valuestring is part of the block, it isn't freed on its own.
+ * cJSON_ArenaItem: the item itself is part of the block (all items but the root), it isn't freed on its own.
+ * Keys in the block are marked cJSON_StringIsConst. */
+#define cJSON_ArenaValue 1024
+#define cJSON_ArenaItem 2048
 
 /* The cJSON structure: */
 typedef struct cJSON
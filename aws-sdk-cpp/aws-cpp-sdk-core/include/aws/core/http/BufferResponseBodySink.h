@@ -0,0 +1,50 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/http/HttpRequest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Http
+    {
+        /**
+         * Lands the body of a response straight into a caller supplied buffer, e.g. a preallocated array or a mapped file region,
+         * without going through a response stream. Pass GetSink() to SetResponseBodySink() of the request.
+         * The request fails if the body is bigger than the buffer. If the request is retried, the body is written again from the start.
+         */
+        class AWS_CORE_API BufferResponseBodySink
+        {
+        public:
+            BufferResponseBodySink(unsigned char* buffer, size_t capacity);
+
+            BufferResponseBodySink(const BufferResponseBodySink&) = delete;
+            BufferResponseBodySink& operator=(const BufferResponseBodySink&) = delete;
+
+            /**
+             * The closure writing into the buffer. It refers to this object, which must outlive the request.
+             */
+            ResponseBodySink GetSink();
+
+            /**
+             * Number of bytes of the body written so far.
+             */
+            size_t GetLength() const { return m_length; }
+
+        private:
+            bool Write(const char* data, size_t length, uint64_t offset);
+
+            unsigned char* m_buffer;
+            size_t m_capacity;
+            size_t m_length;
+        };
+    } // namespace Http
+} // namespace Aws
@@ -0,0 +1,105 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/http/HttpTypes.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Http
+    {
+        /**
+         * Http headers kept in a flat array sorted by name, the first INLINE_CAPACITY ones inside the collection itself.
+         * Names are case insensitive and stored lower cased; lookups compare a hash of the name before the name itself.
+         * The names of common headers (host, authorization, x-amz-date, ...) are interned: they point to a static string
+         * rather than being copied in every collection.
+         *
+         * Iterating yields the headers in the same order as a HeaderValueCollection of the same headers.
+         */
+        class AWS_CORE_API FlatHeaderCollection
+        {
+        public:
+            static const size_t INLINE_CAPACITY = 12;
+
+            class Entry
+            {
+            public:
+                Entry() : m_hash(0), m_internedName(nullptr), m_internedNameLength(0) {}
+
+                /**
+                 * Lower case name, null terminated.
+                 */
+                const char* GetName() const { return m_internedName ? m_internedName : m_name.c_str(); }
+                size_t GetNameLength() const { return m_internedName ? m_internedNameLength : m_name.size(); }
+                const Aws::String& GetValue() const { return m_value; }
+
+            private:
+                friend class FlatHeaderCollection;
+
+                uint32_t m_hash;
+                const char* m_internedName;
+                size_t m_internedNameLength;
+                Aws::String m_name;
+                Aws::String m_value;
+            };
+
+            typedef const Entry* const_iterator;
+
+            FlatHeaderCollection() : m_size(0) {}
+
+            /**
+             * Sets the value of the header named name, in any case, adding it if needed.
+             */
+            void Set(const char* name, size_t nameLength, const char* value, size_t valueLength);
+            void Set(const char* name, const Aws::String& value);
+            void Set(const Aws::String& name, const Aws::String& value) { Set(name.c_str(), name.size(), value.c_str(), value.size()); }
+
+            /**
+             * Returns the value of the header named name, in any case, or nullptr if there is no such header.
+             */
+            const Aws::String* Find(const char* name, size_t nameLength) const;
+            const Aws::String* Find(const char* name) const;
+
+            bool Has(const char* name) const { return Find(name) != nullptr; }
+
+            /**
+             * Removes the header named name, in any case, returns false if there was no such header.
+             */
+            bool Erase(const char* name);
+
+            void Clear();
+
+            size_t size() const { return m_size; }
+            bool empty() const { return m_size == 0; }
+            const_iterator begin() const { return Data(); }
+            const_iterator end() const { return Data() + m_size; }
+
+            /**
+             * Copies the headers into a HeaderValueCollection.
+             */
+            HeaderValueCollection ToHeaderValueCollection() const;
+
+        private:
+            const Entry* Data() const { return m_spilled.empty() ? m_inline : m_spilled.data(); }
+            Entry* Data() { return m_spilled.empty() ? m_inline : m_spilled.data(); }
+            //index of the header, size() if there is none.
+            size_t Lookup(uint32_t hash, const char* name, size_t nameLength) const;
+            Entry& Insert(uint32_t hash, const char* name, size_t nameLength);
+
+            Entry m_inline[INLINE_CAPACITY];
+            //once there are more than INLINE_CAPACITY headers, all of them move here.
+            Aws::Vector<Entry> m_spilled;
+            size_t m_size;
+        };
+    } // namespace Http
+} // namespace Aws
@@ -8,6 +8,7 @@
 #include <aws/core/Core_EXPORTS.h>
 
 #include <memory>
+#include <functional>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -27,6 +28,11 @@ namespace Aws
         class HttpRequest;
         class HttpResponse;
 
+        /**
+         * Invoked once the response for an asynchronously issued request is complete (or has failed with a client error).
+         */
+        typedef std::function<void(const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>&)> HttpResponseReceivedHandler;
+
         /**
           * Abstract HttpClient. All it does is make HttpRequests and return their response.
           */
@@ -43,6 +49,16 @@ namespace Aws
                 Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
                 Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const = 0;
 
+            /**
+             * Takes an http request, makes it, and hands the newly allocated HttpResponse to handler once it is complete.
+             * The default implementation makes the request synchronously on the calling thread and then invokes handler;
+             * clients with their own event loop override this to return immediately.
+             */
+            virtual void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request,
+                const HttpResponseReceivedHandler& handler,
+                Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+                Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const;
+
             /**
              * If yes, the http client supports transfer-encoding:chunked.
              */
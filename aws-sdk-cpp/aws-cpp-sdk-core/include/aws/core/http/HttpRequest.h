@@ -45,6 +45,7 @@ namespace Aws
 
         class HttpRequest;
         class HttpResponse;
+        class FlatHeaderCollection;
 
         /**
          * closure type for receiving notifications that data has been received.
@@ -58,6 +59,12 @@ namespace Aws
          * Closure type for handling whether or not a request should be canceled.
          */
         typedef std::function<bool(const HttpRequest*)> ContinueRequestHandler;
+        /**
+         * Closure receiving the body of a successful (2xx) response slice by slice as it arrives, in place of the response stream.
+         * offset is the position of the slice in the body, a retried request starts again from 0.
+         * The slices are only valid during the call. Return false to abort the request.
+         */
+        typedef std::function<bool(const char* data, size_t length, uint64_t offset)> ResponseBodySink;
 
         /**
           * Abstract class for representing an HttpRequest.
@@ -78,6 +85,11 @@ namespace Aws
              * Get All headers for this request.
              */
             virtual HeaderValueCollection GetHeaders() const = 0;
+            /**
+             * Gets the headers of this request without copying them, if the implementation keeps them in a FlatHeaderCollection.
+             * Returns nullptr otherwise, use GetHeaders() then.
+             */
+            virtual const FlatHeaderCollection* GetFlatHeaders() const { return nullptr; }
             /**
              * Get the value for a Header based on its name. (in default StandardHttpRequest implementation, an empty string will be returned if headerName doesn't exist)
              */
@@ -479,6 +491,21 @@ namespace Aws
 
             inline const ContinueRequestHandler& GetContinueRequestHandler() const { return m_continueRequest; }
 
+            /**
+             * Sets the closure the body of a successful response is handed to, bypassing the response stream which then stays empty.
+             * The body of an error response still goes to the response stream, for the error to be parsed.
+             * Only meant for responses that aren't parsed by the client: streaming bodies (e.g. S3 GetObject) and event streams.
+             */
+            inline void SetResponseBodySink(const ResponseBodySink& responseBodySink) { m_responseBodySink = responseBodySink; }
+            /**
+             * Sets the closure the body of a successful response is handed to, bypassing the response stream which then stays empty.
+             */
+            inline void SetResponseBodySink(ResponseBodySink&& responseBodySink) { m_responseBodySink = std::move(responseBodySink); }
+            /**
+             * Gets the closure the body of a successful response is handed to, empty if the body goes to the response stream.
+             */
+            inline const ResponseBodySink& GetResponseBodySink() const { return m_responseBodySink; }
+
             /**
              * Gets the AWS Access Key if this HttpRequest is signed with Aws Access Key
              */
@@ -523,6 +550,16 @@ namespace Aws
             Aws::String GetResolvedRemoteHost() const { return m_resolvedRemoteHost; }
             void SetResolvedRemoteHost(const Aws::String& ip) { m_resolvedRemoteHost = ip; }
 
+            /**
+             * Hex encoded SHA256 of the content body, if it was computed before signing (e.g. in the same pass over the body as Content-MD5).
+             * Signers use it instead of reading the body again. Empty if it hasn't been computed.
+             */
+            inline const Aws::String& GetContentSha256() const { return m_contentSha256; }
+            /**
+             * Sets the hex encoded SHA256 of the content body, it must be reset if the content body is replaced.
+             */
+            inline void SetContentSha256(const Aws::String& contentSha256) { m_contentSha256 = contentSha256; }
+
             bool IsEventStreamRequest() { return m_isEvenStreamRequest; }
             void SetEventStreamRequest(bool eventStreamRequest) { m_isEvenStreamRequest = eventStreamRequest; }
         private:
@@ -532,9 +569,11 @@ namespace Aws
             DataReceivedEventHandler m_onDataReceived;
             DataSentEventHandler m_onDataSent;
             ContinueRequestHandler m_continueRequest;
+            ResponseBodySink m_responseBodySink;
             Aws::String m_signingRegion;
             Aws::String m_signingAccessKey;
             Aws::String m_resolvedRemoteHost;
+            Aws::String m_contentSha256;
             Aws::Monitoring::HttpClientMetricsCollection m_httpRequestMetrics;
         };
 
@@ -156,6 +156,11 @@ namespace Aws
              * Get the headers from this response
              */
             virtual HeaderValueCollection GetHeaders() const = 0;
+            /**
+             * Gets the headers of this response without copying them, if the implementation keeps them in a FlatHeaderCollection.
+             * Returns nullptr otherwise, use GetHeaders() then.
+             */
+            virtual const FlatHeaderCollection* GetFlatHeaders() const { return nullptr; }
             /**
              * Returns true if the response contains a header by headerName
              */
@@ -38,7 +38,33 @@ namespace Aws
             DEFAULT_CLIENT = 0,
             CURL_CLIENT,
             WIN_INET_CLIENT,
-            WIN_HTTP_CLIENT
+            WIN_HTTP_CLIENT,
+            CURL_MULTI_CLIENT
+        };
+
+        /**
+         * HTTP protocol version a client asks for. Implementations that can't honour it use the closest version they support.
+         */
+        enum class Version
+        {
+            /**
+             * Let the http library pick.
+             */
+            HTTP_VERSION_NONE,
+            HTTP_VERSION_1_0,
+            HTTP_VERSION_1_1,
+            /**
+             * HTTP/2 negotiated through ALPN over TLS and through an Upgrade over plain text, HTTP/1.1 otherwise.
+             */
+            HTTP_VERSION_2_0,
+            /**
+             * HTTP/2 negotiated through ALPN over TLS, HTTP/1.1 over plain text.
+             */
+            HTTP_VERSION_2TLS,
+            /**
+             * HTTP/2 without negotiation, only use it with endpoints known to speak HTTP/2.
+             */
+            HTTP_VERSION_2_PRIOR_KNOWLEDGE
         };
 
         namespace HttpMethodMapper
@@ -5,9 +5,14 @@
 
 #pragma once
 
-#include <aws/core/utils/ResourceManager.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
 
 #include <utility>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <curl/curl.h>
 
 namespace Aws
@@ -16,16 +21,22 @@ namespace Http
 {
 
 /**
-  * Simple Connection pool manager for Curl. It maintains connections in a thread safe manner. You
+  * Connection pool manager for Curl. It maintains connections in a thread safe manner. You
   * can call into acquire a handle, then put it back when finished. It is assumed that reusing an already
-  * initialized handle is preferable (especially for synchronous clients). The pool doubles in capacity as
-  * needed up to the maximum amount of connections.
+  * initialized handle is preferable (especially for synchronous clients). The pool grows as needed up to the
+  * maximum amount of connections.
+  *
+  * Idle handles are kept in striped free lists, one stripe per group of threads, and within a stripe by the authority
+  * (scheme, host and port) they last talked to. Acquiring for an authority prefers a handle whose keep-alive connection
+  * and TLS session still point at that host, then a new handle while the pool may grow, and only then an idle handle
+  * of another host. All handles share a CURLSH for the DNS cache and the TLS session cache. Connections themselves stay
+  * with their handle because libcurl does not support sharing a connection cache between concurrent threads.
   */
 class CurlHandleContainer
 {
 public:
     /**
-      * Initializes an empty stack of CURL handles. If you are only making synchronous calls via your http client
+      * Initializes an empty pool of CURL handles. If you are only making synchronous calls via your http client
       * then a small size is best. For async support, a good value would be 6 * number of Processors.   *
       */
     CurlHandleContainer(unsigned maxSize = 50, long httpRequestTimeout = 0, long connectTimeout = 1000, bool tcpKeepAlive = true,
@@ -34,30 +45,56 @@ public:
 
     /**
       * Blocks until a curl handle from the pool is available for use.
+      * authority is the key returned by GetAuthorityKey() for the request the handle is acquired for, if any.
       */
-    CURL* AcquireCurlHandle();
+    CURL* AcquireCurlHandle(const Aws::String& authority = "");
+    /**
+      * Returns a handle from the pool if one is idle or the pool can still grow, otherwise returns nullptr without blocking.
+      */
+    CURL* TryAcquireCurlHandle(const Aws::String& authority = "");
     /**
       * Returns a handle to the pool for reuse. It is imperative that this is called
-      * after you are finished with the handle.
+      * after you are finished with the handle. authority should be the one it was acquired for.
       */
-    void ReleaseCurlHandle(CURL* handle);
+    void ReleaseCurlHandle(CURL* handle, const Aws::String& authority = "");
 
     /**
      * When the handle has bad DNS entries, problematic live connections, we need to destory the handle from pool.
      */
     void DestroyCurlHandle(CURL* handle);
 
+    /**
+     * Builds the key idle handles are grouped by, e.g. "https://bucket.s3.amazonaws.com:443".
+     */
+    static Aws::String GetAuthorityKey(const char* scheme, const Aws::String& host, uint16_t port);
+
 private:
     CurlHandleContainer(const CurlHandleContainer&) = delete;
     const CurlHandleContainer& operator = (const CurlHandleContainer&) = delete;
     CurlHandleContainer(const CurlHandleContainer&&) = delete;
     const CurlHandleContainer& operator = (const CurlHandleContainer&&) = delete;
 
-    CURL* CreateCurlHandleInPool();
-    bool CheckAndGrowPool();
+    struct FreeListStripe
+    {
+        FreeListStripe() : idleCount(0) {}
+
+        std::mutex lock;
+        Aws::Map<Aws::String, Aws::Vector<CURL*>> idleHandlesByAuthority;
+        std::atomic<size_t> idleCount;
+    };
+
+    CURL* TryAcquireIdleCurlHandle(const Aws::String& authority, bool matchAuthority);
+    CURL* TryGrowPool();
+    CURL* CreateCurlHandle();
     void SetDefaultOptionsOnHandle(CURL* handle);
+    FreeListStripe& GetHomeStripe();
+
+    static void LockShareData(CURL* handle, curl_lock_data data, curl_lock_access access, void* userData);
+    static void UnlockShareData(CURL* handle, curl_lock_data data, void* userData);
 
-    Aws::Utils::ExclusiveOwnershipResourceManager<CURL*> m_handleContainer;
+    Aws::Vector<FreeListStripe*> m_stripes;
+    CURLSH* m_share;
+    std::mutex m_shareLocks[CURL_LOCK_DATA_LAST];
     unsigned m_maxPoolSize;
     unsigned long m_httpRequestTimeout;
     unsigned long m_connectTimeout;
@@ -65,8 +102,11 @@ private:
     unsigned long m_tcpKeepAliveIntervalMs;
     unsigned long m_lowSpeedTime;
     unsigned long m_lowSpeedLimit;
-    unsigned m_poolSize;
-    std::mutex m_containerLock;
+    std::atomic<unsigned> m_poolSize;
+    std::atomic<unsigned> m_idleCount;
+    std::atomic<unsigned> m_waitingThreads;
+    std::mutex m_waitLock;
+    std::condition_variable m_handleAvailable;
 };
 
 } // namespace Http
@@ -11,6 +11,7 @@
 #include <aws/core/http/curl/CurlHandleContainer.h>
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/DateTime.h>
 #include <atomic>
 
 namespace Aws
@@ -22,7 +23,54 @@ namespace Standard
     class StandardHttpResponse;
 }
 
-//Curl implementation of an http client. Right now it is only synchronous.
+class CurlHttpClient;
+
+/**
+ * State handed to the curl write and header callbacks. Must outlive the transfer it is attached to.
+ */
+struct CurlWriteCallbackContext
+{
+    CurlWriteCallbackContext(const CurlHttpClient* client,
+                             HttpRequest* request,
+                             HttpResponse* response,
+                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
+        m_client(client),
+        m_request(request),
+        m_response(response),
+        m_rateLimiter(rateLimiter),
+        m_numBytesResponseReceived(0),
+        m_connectionHandle(nullptr)
+    {}
+
+    const CurlHttpClient* m_client;
+    HttpRequest* m_request;
+    HttpResponse* m_response;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    int64_t m_numBytesResponseReceived;
+    //set when the context is attached to a handle, to get the response code of the body being received.
+    CURL* m_connectionHandle;
+};
+
+/**
+ * State handed to the curl read and seek callbacks. Must outlive the transfer it is attached to.
+ */
+struct CurlReadCallbackContext
+{
+    CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
+        m_client(client),
+        m_rateLimiter(limiter),
+        m_request(request),
+        m_connectionHandle(nullptr)
+    {}
+
+    const CurlHttpClient* m_client;
+    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
+    HttpRequest* m_request;
+    //set when the context is attached to a handle.
+    CURL* m_connectionHandle;
+};
+
+//Curl implementation of an http client. Requests are made synchronously on the calling thread, see CurlMultiHttpClient for an event loop based client.
 class AWS_CORE_API CurlHttpClient: public HttpClient
 {
 public:
@@ -40,6 +88,13 @@ public:
     static void InitGlobalState();
     static void CleanupGlobalState();
 
+    /**
+     * Charges cost bytes received (direction CURLPAUSE_RECV) or sent (CURLPAUSE_SEND) on connectionHandle to rateLimiter.
+     * Called from the curl callbacks; this client sleeps the calling thread until the cost is paid.
+     */
+    virtual void PayForTransferCost(Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter, int64_t cost,
+        CURL* connectionHandle, int direction) const;
+
 protected:
     /**
      * Override any configuration on CURL handle for each request before sending.
@@ -47,6 +102,30 @@ protected:
      */
     virtual void OverrideOptionsOnConnectionHandle(CURL*) const {}
 
+    /**
+     * Builds the curl header list for request. The caller owns the list and must free it with curl_slist_free_all
+     * once the transfer is finished.
+     */
+    struct curl_slist* CreateCurlHeaderList(const std::shared_ptr<HttpRequest>& request) const;
+
+    /**
+     * Applies the url, method, headers, callbacks, TLS and proxy settings for request to connectionHandle.
+     */
+    void ConfigureConnectionHandle(CURL* connectionHandle, const std::shared_ptr<HttpRequest>& request, struct curl_slist* headers,
+        CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const;
+
+    /**
+     * Fills in the response code, client errors and request metrics once curl is done with connectionHandle.
+     */
+    void CompleteResponse(CURL* connectionHandle, CURLcode curlResponseCode, const std::shared_ptr<HttpRequest>& request,
+        const std::shared_ptr<HttpResponse>& response, const CurlWriteCallbackContext& writeContext,
+        const Aws::Utils::DateTime& startTransmissionTime) const;
+
+    /**
+     * Key under which the connection handle used for request is pooled, see CurlHandleContainer::GetAuthorityKey().
+     */
+    static Aws::String GetConnectionAuthority(const HttpRequest& request);
+
 private:
     mutable CurlHandleContainer m_curlHandleContainer;
     bool m_isUsingProxy;
@@ -65,6 +144,7 @@ private:
     Aws::String m_caFile;
     bool m_disableExpectHeader;
     bool m_allowRedirects;
+    Aws::Http::Version m_version;
     static std::atomic<bool> isInit;
 };
 
@@ -0,0 +1,120 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/http/curl/CurlHandleContainer.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSSet.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace Aws
+{
+namespace Http
+{
+
+/**
+ * Curl implementation of an http client driven by a single curl_multi event loop.
+ * Requests are handed to a dedicated I/O thread and completed through HttpResponseReceivedHandler, so the number of
+ * requests in flight is no longer bounded by the number of calling threads. Connections are shared between transfers
+ * through the multi handle's connection cache and capped at ClientConfiguration::maxConnections.
+ *
+ * When ClientConfiguration::version asks for HTTP/2, transfers to the same endpoint are multiplexed as streams over shared
+ * connections, at most ClientConfiguration::http2MaxConcurrentStreams per connection. Endpoints that answer with HTTP/1.1
+ * are remembered and get one connection per transfer from then on.
+ *
+ * Event stream requests need a blocking body reader and are therefore made synchronously on the calling thread.
+ *
+ * Rate limited transfers never sleep on the event loop: a transfer that goes over its limit has its direction paused and
+ * the loop resumes it once the delay has passed, while the other transfers keep going.
+ *
+ * Response handlers are invoked on the event loop thread, so they must not block on other requests made with this client.
+ * MakeRequest() fails with INVALID_ACTION when called from a handler, since the loop could never complete it.
+ */
+class AWS_CORE_API CurlMultiHttpClient: public CurlHttpClient
+{
+public:
+
+    using Base = CurlHttpClient;
+
+    /**
+     * Creates the multi handle and starts the event loop thread.
+     * maxRequestsInFlight bounds the number of transfers (and curl easy handles) attached to the multi handle at once;
+     * requests submitted beyond that are queued in submission order until a transfer finishes.
+     */
+    CurlMultiHttpClient(const Aws::Client::ClientConfiguration& clientConfig, unsigned maxRequestsInFlight = DEFAULT_MAX_REQUESTS_IN_FLIGHT);
+
+    /**
+     * Stops the event loop. Transfers still in flight are completed with a USER_CANCELLED client error.
+     */
+    ~CurlMultiHttpClient();
+
+    //Submits request to the event loop and blocks until it completes
+    std::shared_ptr<HttpResponse> MakeRequest(const std::shared_ptr<HttpRequest>& request,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    //Submits request to the event loop and returns immediately; handler is invoked on the event loop thread
+    void MakeRequestAsync(const std::shared_ptr<HttpRequest>& request,
+        const HttpResponseReceivedHandler& handler,
+        Aws::Utils::RateLimits::RateLimiterInterface* readLimiter = nullptr,
+        Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter = nullptr) const override;
+
+    //Pauses the direction of the transfer instead of sleeping when called on the event loop thread
+    void PayForTransferCost(Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter, int64_t cost,
+        CURL* connectionHandle, int direction) const override;
+
+    static const unsigned DEFAULT_MAX_REQUESTS_IN_FLIGHT = 4096;
+
+private:
+    struct CurlMultiTransfer;
+
+    // Directions of a transfer paused by its rate limiter and when each of them may resume.
+    struct PausedTransfer
+    {
+        PausedTransfer() : directions(0) {}
+
+        int directions;
+        std::chrono::steady_clock::time_point recvResumeTime;
+        std::chrono::steady_clock::time_point sendResumeTime;
+    };
+
+    CurlMultiHttpClient(const CurlMultiHttpClient&) = delete;
+    CurlMultiHttpClient& operator=(const CurlMultiHttpClient&) = delete;
+
+    void EventLoop();
+    void AddPendingTransfers();
+    void ProcessCompletedTransfers();
+    void FinishTransfer(CurlMultiTransfer* transfer, CURLcode curlResponseCode);
+    void CancelTransfer(CurlMultiTransfer* transfer) const;
+    void WakeEventLoop() const;
+    bool IsEventLoopThread() const;
+    int ResumePausedTransfers();
+
+    CURLM* m_multiHandle;
+    CurlHandleContainer m_transferHandles;
+    mutable std::mutex m_pendingTransfersLock;
+    mutable Aws::Deque<CurlMultiTransfer*> m_pendingTransfers;
+    mutable std::condition_variable m_pendingTransfersSignal;
+    Aws::Deque<CurlMultiTransfer*> m_queuedTransfers;
+    Aws::UnorderedMap<CURL*, CurlMultiTransfer*> m_activeTransfers;
+    bool m_multiplexing;
+    // Authorities that did not negotiate HTTP/2, only touched by the event loop thread.
+    Aws::Set<Aws::String> m_http1Authorities;
+    // Transfers paused by their rate limiters, only touched by the event loop thread.
+    mutable Aws::Map<CURL*, PausedTransfer> m_pausedTransfers;
+    std::atomic<bool> m_continue;
+    std::thread m_eventLoopThread;
+};
+
+} // namespace Http
+} // namespace Aws
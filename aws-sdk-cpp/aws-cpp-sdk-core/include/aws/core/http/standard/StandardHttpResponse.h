@@ -8,7 +8,7 @@
 #include <aws/core/Core_EXPORTS.h>
 
 #include <aws/core/http/HttpResponse.h>
-#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/http/FlatHeaderCollection.h>
 #include <aws/core/utils/stream/ResponseStream.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 
@@ -38,6 +38,10 @@ namespace Aws
                  * Get the headers from this response
                  */
                 HeaderValueCollection GetHeaders() const;
+                /**
+                 * Get the headers from this response, without copying them
+                 */
+                const FlatHeaderCollection* GetFlatHeaders() const override { return &headerMap; }
                 /**
                  * Returns true if the response contains a header by headerName
                  */
@@ -63,7 +67,8 @@ namespace Aws
             private:
                 StandardHttpResponse(const StandardHttpResponse&);
 
-                Aws::Map<Aws::String, Aws::String> headerMap;
+                FlatHeaderCollection headerMap;
+                Aws::String m_emptyHeader;
                 Utils::Stream::ResponseStream bodyStream;
             };
 
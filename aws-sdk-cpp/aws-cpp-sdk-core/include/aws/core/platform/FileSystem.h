@@ -8,6 +8,7 @@
 #include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/DateTime.h>
 #include <functional>
 
 namespace Aws
@@ -77,6 +78,11 @@ namespace FileSystem
      */
     AWS_CORE_API Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::String& relativePath = "");
 
+    /**
+     * Returns the type, size and last modified time of the file or directory at path. The entry is false if nothing can be found at path.
+     */
+    AWS_CORE_API DirectoryEntry GetFileInfo(const Aws::String& path);
+
     /**
      * Joins the leftSegment and rightSegment of a path together using platform specific delimiter.
      * e.g. C:\users\name\ and .aws becomes C:\users\name\.aws
@@ -110,6 +116,7 @@ namespace FileSystem
         Aws::String relativePath;
         FileType fileType;
         int64_t fileSize;
+        Aws::Utils::DateTime lastModified;
     };
 
     /**
@@ -222,5 +229,60 @@ namespace FileSystem
         Aws::UniquePtr<Directory> m_dir;
     };
 
+    /**
+     * Access requested when mapping a file into memory.
+     */
+    enum class MappedFileAccess
+    {
+        ReadOnly,
+        ReadWrite
+    };
+
+    /**
+     * A file mapped into the address space of the process. The mapping is released when this object is destroyed.
+     * Use MapFile() to create one.
+     */
+    class AWS_CORE_API MappedFile
+    {
+    public:
+        virtual ~MappedFile() = default;
+
+        /**
+         * First byte of the mapping. Only writable for a ReadWrite mapping.
+         */
+        unsigned char* GetData() const { return m_data; }
+
+        /**
+         * Size of the mapping, i.e. of the file, in bytes.
+         */
+        uint64_t GetSize() const { return m_size; }
+
+        /**
+         * Hints that [offset, offset + length) will be accessed soon, so that the OS can start reading it ahead.
+         */
+        virtual void WillNeed(uint64_t offset, uint64_t length) = 0;
+
+        /**
+         * Hints that [offset, offset + length) will not be accessed again soon, so that its pages can be released.
+         * Only meant for ReadOnly mappings.
+         */
+        virtual void DontNeed(uint64_t offset, uint64_t length) = 0;
+
+    protected:
+        MappedFile(unsigned char* data, uint64_t size) : m_data(data), m_size(size) {}
+
+        unsigned char* m_data;
+        uint64_t m_size;
+    };
+
+    /**
+     * Maps the file at path into memory.
+     * ReadOnly maps the whole existing file and ignores size. ReadWrite creates the file if needed, resizes it to size bytes first,
+     * keeping its existing content up to size, and allocates its blocks on disk so that writing to the mapping can't run out of space.
+     * Returns nullptr if the file could not be opened, resized, allocated (e.g. the disk is full) or mapped, or if it is empty.
+     * Accessing the mapping after the file was truncated by someone else is undefined behavior (SIGBUS on POSIX).
+     */
+    AWS_CORE_API Aws::UniquePtr<MappedFile> MapFile(const Aws::String& path, MappedFileAccess access, uint64_t size = 0);
+
 } // namespace FileSystem
 } // namespace Aws
@@ -10,11 +10,17 @@
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/Array.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 
 namespace Aws
 {
     namespace Utils
     {
+        namespace Crypto
+        {
+            class Hash;
+        }
+
 
         /**
         * Generic utils for hashing strings
@@ -77,6 +83,33 @@ namespace Aws
             */
             static ByteBuffer CalculateMD5(Aws::IOStream& stream);
 
+            /**
+            * Calculates a CRC32 checksum, 4 bytes in big endian order
+            */
+            static ByteBuffer CalculateCRC32(const Aws::String& str);
+
+            /**
+            * Calculates a CRC32 checksum, 4 bytes in big endian order
+            */
+            static ByteBuffer CalculateCRC32(Aws::IOStream& stream);
+
+            /**
+            * Calculates a CRC32C checksum, 4 bytes in big endian order
+            */
+            static ByteBuffer CalculateCRC32C(const Aws::String& str);
+
+            /**
+            * Calculates a CRC32C checksum, 4 bytes in big endian order
+            */
+            static ByteBuffer CalculateCRC32C(Aws::IOStream& stream);
+
+            /**
+            * Feeds the entire stream to each of the hashes in a single read, so that several digests of a large body don't cost a
+            * read each. The stream position is restored afterwards. Each digest is then available from the hash's GetHash().
+            * Returns false if the stream couldn't be read to the end.
+            */
+            static bool CalculateHashes(Aws::IOStream& stream, const Aws::Vector<Crypto::Hash*>& hashes);
+
             static int HashString(const char* strToHash);
 
         };
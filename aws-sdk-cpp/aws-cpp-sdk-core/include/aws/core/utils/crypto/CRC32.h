@@ -0,0 +1,100 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/crypto/Hash.h>
+#include <aws/core/utils/Outcome.h>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Crypto
+        {
+            /**
+             * CRC32 (the zlib/ethernet polynomial) checksum, backed by aws-checksums which uses the hardware crc instructions
+             * (PCLMUL on x86, the ARMv8 crc extension) where available.
+             * The hash result is the 4 byte checksum in big endian order, as S3 expects it.
+             */
+            class AWS_CORE_API CRC32 : public Hash
+            {
+            public:
+                CRC32() : m_crc(0) {}
+
+                /**
+                 * Calculates the CRC32 of a string.
+                 */
+                HashResult Calculate(const Aws::String& str) override;
+
+                /**
+                 * Calculates the CRC32 of a stream (the entire stream is read, its position is restored afterward).
+                 */
+                HashResult Calculate(Aws::IStream& stream) override;
+
+                void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                HashResult GetHash() override;
+
+                /**
+                 * CRC32 of length bytes of data, continuing from previousCrc, the CRC32 of the bytes that came before them.
+                 */
+                static uint32_t Checksum(const unsigned char* data, size_t length, uint32_t previousCrc = 0);
+
+                /**
+                 * CRC32 of the concatenation of A and B from the CRC32 of A, the CRC32 of B and the length of B.
+                 * Lets the parts of an object be checksummed in parallel and the results combined into the object's checksum.
+                 */
+                static uint32_t Combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB);
+
+            private:
+                uint32_t m_crc;
+            };
+
+            /**
+             * CRC32C (Castagnoli polynomial) checksum, backed by aws-checksums which uses the hardware crc instructions
+             * (SSE4.2 on x86, the ARMv8 crc extension) where available.
+             * The hash result is the 4 byte checksum in big endian order, as S3 expects it.
+             */
+            class AWS_CORE_API CRC32C : public Hash
+            {
+            public:
+                CRC32C() : m_crc(0) {}
+
+                /**
+                 * Calculates the CRC32C of a string.
+                 */
+                HashResult Calculate(const Aws::String& str) override;
+
+                /**
+                 * Calculates the CRC32C of a stream (the entire stream is read, its position is restored afterward).
+                 */
+                HashResult Calculate(Aws::IStream& stream) override;
+
+                void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                HashResult GetHash() override;
+
+                /**
+                 * CRC32C of length bytes of data, continuing from previousCrc, the CRC32C of the bytes that came before them.
+                 */
+                static uint32_t Checksum(const unsigned char* data, size_t length, uint32_t previousCrc = 0);
+
+                /**
+                 * CRC32C of the concatenation of A and B from the CRC32C of A, the CRC32C of B and the length of B.
+                 * Lets the parts of an object be checksummed in parallel and the results combined into the object's checksum.
+                 */
+                static uint32_t Combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB);
+
+            private:
+                uint32_t m_crc;
+            };
+
+        } // namespace Crypto
+    } // namespace Utils
+} // namespace Aws
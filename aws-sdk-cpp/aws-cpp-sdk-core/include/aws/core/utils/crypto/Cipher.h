@@ -17,6 +17,8 @@ namespace Aws
         {
             static const size_t SYMMETRIC_KEY_LENGTH = 32;
             static const size_t MIN_IV_LENGTH = 12;
+            // the largest block of the symmetric ciphers, AES.
+            static const size_t MAX_CIPHER_BLOCK_SIZE = 16;
 
             AWS_CORE_API CryptoBuffer IncrementCTRCounter(const CryptoBuffer& counter, uint32_t numberOfBlocks);
 
@@ -123,6 +125,31 @@ namespace Aws
                  */
                 virtual CryptoBuffer FinalizeDecryption () = 0;
 
+                /**
+                 * Encrypts length bytes of data into output, which must have room for length + MAX_CIPHER_BLOCK_SIZE bytes, and returns how many
+                 * bytes were written. Calls produce sequential output just like EncryptBuffer(), which they can be mixed with, but without
+                 * allocating a buffer for each call in the implementations that override this.
+                 * output may be data itself when the cipher writes as much as it is given, as AES in CTR or GCM mode does.
+                 * Returns 0, and the cipher fails, if the data can not be encrypted.
+                 */
+                virtual size_t EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output);
+
+                /**
+                 * Decrypts length bytes of data into output, see EncryptBufferTo().
+                 */
+                virtual size_t DecryptBufferTo(const unsigned char* data, size_t length, unsigned char* output);
+
+                /**
+                 * Encrypts length bytes of data in place, for a cipher that writes as much as it is given, as AES in CTR or GCM mode does.
+                 * Returns false if the cipher fails or writes a different amount.
+                 */
+                inline bool EncryptInPlace(unsigned char* data, size_t length) { return EncryptBufferTo(data, length, data) == length && Good(); }
+
+                /**
+                 * Decrypts length bytes of data in place, see EncryptInPlace().
+                 */
+                inline bool DecryptInPlace(unsigned char* data, size_t length) { return DecryptBufferTo(data, length, data) == length && Good(); }
+
                 virtual void Reset() = 0;
 
                 /**
@@ -58,7 +58,8 @@ namespace Aws
                  * stream to src from
                  * cipher to encrypt or decrypt the src stream with
                  * mode to use cipher in. Encryption or Decryption
-                 * buffersize, the size of the src buffers to read at a time. Defaults to 1kb
+                 * buffersize, the size of the src buffers to read at a time. Defaults to 1kb. Each block read goes through the cipher in one call,
+                 * straight into the buffer of this streambuf, so large buffers (e.g. 64kb) let the cipher run at full speed.
                  */
                 SymmetricCryptoBufSrc(Aws::IStream& stream, SymmetricCipher& cipher, CipherMode cipherMode, size_t bufferSize = DEFAULT_BUF_SIZE);
 
@@ -85,8 +86,14 @@ namespace Aws
                 int_type underflow() override;
                 off_type ComputeAbsSeekPosition(off_type, std::ios_base::seekdir,  std::fpos<FPOS_TYPE>);
                 void FinalizeCipher();
+                /**
+                 * Reads up to readSize bytes of the source stream through the cipher into m_isBuf, after the put back area, finalizing the cipher
+                 * at the end of the stream. Returns how many bytes it holds, 0 once the cipher is finalized or fails.
+                 */
+                size_t FillBuffer(size_t readSize);
 
                 CryptoBuffer m_isBuf;
+                CryptoBuffer m_readBuf;
                 SymmetricCipher& m_cipher;
                 Aws::IStream& m_stream;
                 CipherMode m_cipherMode;
@@ -109,7 +116,7 @@ namespace Aws
                  * stream, sink to push the encrypted or decrypted data to.
                  * cipher, symmetric cipher to use to transform the input before sending it to the sink.
                  * cipherMode, encrypt or decrypt
-                 * bufferSize, amount of data to encrypt/decrypt at a time.
+                 * bufferSize, amount of data to encrypt/decrypt at a time, see SymmetricCryptoBufSrc.
                  */
                 SymmetricCryptoBufSink(Aws::OStream& stream, SymmetricCipher& cipher, CipherMode cipherMode, size_t bufferSize = DEFAULT_BUF_SIZE, int16_t blockOffset = 0);
                 SymmetricCryptoBufSink(const SymmetricCryptoBufSink&) = delete;
@@ -136,8 +143,10 @@ namespace Aws
                 int_type overflow(int_type ch) override;
                 int sync() override;
                 bool writeOutput(bool finalize);
+                void WriteToSink(const unsigned char* data, size_t length);
 
                 CryptoBuffer m_osBuf;
+                CryptoBuffer m_cipherBuf;
                 SymmetricCipher& m_cipher;
                 Aws::OStream& m_stream;
                 CipherMode m_cipherMode;
@@ -36,6 +36,17 @@ namespace Aws
                 */
                 virtual HashResult Calculate(Aws::IStream& stream) = 0;
 
+                /**
+                * Adds bufferSize bytes of buffer to a digest that is computed incrementally. Call GetHash() once all the data has been added.
+                * The incremental digest is independent of Calculate(), but it is state on this instance: don't update it from several threads.
+                */
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) = 0;
+
+                /**
+                * Returns the digest of everything passed to Update() since the last call to GetHash() and starts a new incremental digest.
+                */
+                virtual HashResult GetHash() = 0;
+
                 // when hashing streams, this is the size of our internal buffer we read the stream into
                 static const uint32_t INTERNAL_HASH_STREAM_BUFFER_SIZE = 8192;
             };
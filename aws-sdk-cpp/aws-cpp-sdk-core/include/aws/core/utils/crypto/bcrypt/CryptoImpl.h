@@ -68,10 +68,19 @@ namespace Aws
                  * Calculates a Hash on the stream without loading the entire stream into memory at once.
                  */
                 HashResult Calculate(Aws::IStream& stream);
+                /**
+                 * Adds data to the incremental hash, which is started by the first call.
+                 */
+                void Update(const unsigned char* buffer, size_t bufferSize);
+                /**
+                 * Finishes the incremental hash and returns its digest.
+                 */
+                HashResult GetHash();
 
             private:
 
                 bool IsValid() const;
+                bool StartIncrementalHash();
 
                 HashResult HashData(const BCryptHashContext& context, PBYTE data, ULONG dataLength);
                 bool HashStream(Aws::IStream& stream);
@@ -84,6 +93,11 @@ namespace Aws
                 DWORD m_hashObjectLength;
                 PBYTE m_hashObject;
 
+                //the incremental hash has its own hash object so that it can span calls to Calculate()
+                BCryptHashContext* m_incrementalContext;
+                PBYTE m_incrementalHashObject;
+                bool m_incrementalHashFailed;
+
                 //I'm 99% sure the algorithm handle for windows is not thread safe, but I can't
                 //prove or disprove that theory. Therefore, we have to lock to be safe.
                 std::mutex m_algorithmMutex;
@@ -110,6 +124,10 @@ namespace Aws
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                virtual HashResult GetHash() override;
+
             private:
                 BCryptHashImpl m_impl;
             };
@@ -135,6 +153,10 @@ namespace Aws
                  */
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                virtual HashResult GetHash() override;
+
             private:
                 BCryptHashImpl m_impl;
             };
@@ -59,28 +59,43 @@ namespace Aws
             {
             public:
 
-                MD5OpenSSLImpl()
+                MD5OpenSSLImpl() : m_ctx(nullptr)
                 { }
 
-                virtual ~MD5OpenSSLImpl() = default;
+                virtual ~MD5OpenSSLImpl();
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
 
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                //context of the incremental digest, created by the first Update()
+                EVP_MD_CTX* m_ctx;
             };
 
             class Sha256OpenSSLImpl : public Hash
             {
             public:
-                Sha256OpenSSLImpl()
+                Sha256OpenSSLImpl() : m_ctx(nullptr)
                 { }
 
-                virtual ~Sha256OpenSSLImpl() = default;
+                virtual ~Sha256OpenSSLImpl();
 
                 virtual HashResult Calculate(const Aws::String& str) override;
 
                 virtual HashResult Calculate(Aws::IStream& stream) override;
+
+                virtual void Update(const unsigned char* buffer, size_t bufferSize) override;
+
+                virtual HashResult GetHash() override;
+
+            private:
+                //context of the incremental digest, created by the first Update()
+                EVP_MD_CTX* m_ctx;
             };
 
             class Sha256HMACOpenSSLImpl : public HMAC
@@ -161,6 +176,16 @@ namespace Aws
                  */
                 CryptoBuffer FinalizeDecryption() override;
 
+                /**
+                 * Encrypts straight into output, without allocating.
+                 */
+                size_t EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output) override;
+
+                /**
+                 * Decrypts straight into output, without allocating.
+                 */
+                size_t DecryptBufferTo(const unsigned char* data, size_t length, unsigned char* output) override;
+
                 void Reset() override;
 
             protected:
@@ -350,6 +375,12 @@ namespace Aws
                 CryptoBuffer DecryptBuffer(const CryptoBuffer&) override;
                 CryptoBuffer FinalizeDecryption() override;
 
+                /**
+                 * Key wrap works on the whole key at once, these go through EncryptBuffer() and DecryptBuffer().
+                 */
+                size_t EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output) override { return SymmetricCipher::EncryptBufferTo(data, length, output); }
+                size_t DecryptBufferTo(const unsigned char* data, size_t length, unsigned char* output) override { return SymmetricCipher::DecryptBufferTo(data, length, output); }
+
                 void Reset() override;
 
             protected:
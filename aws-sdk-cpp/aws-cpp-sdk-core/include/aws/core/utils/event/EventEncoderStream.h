@@ -47,6 +47,12 @@ namespace Aws
                  */
                 EventEncoderStream& WriteEvent(const Aws::Utils::Event::Message& msg);
 
+                /**
+                 * Writes a batch of event-stream messages to the underlying buffer.
+                 * The messages are signed and framed back to back, then handed to the buffer in a single write.
+                 */
+                EventEncoderStream& WriteEvents(const Aws::Vector<Aws::Utils::Event::Message>& msgs);
+
                 /**
                  * Sets the signer implementation used for every event.
                  */
@@ -63,6 +69,7 @@ namespace Aws
             private:
                 Stream::ConcurrentStreamBuf m_streambuf;
                 EventStreamEncoder m_encoder;
+                Aws::Vector<unsigned char> m_encodedEvents; // reused across writes to frame events into
             };
         }
     }
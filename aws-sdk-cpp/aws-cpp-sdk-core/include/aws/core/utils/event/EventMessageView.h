@@ -0,0 +1,142 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/event/EventHeader.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Event
+        {
+            /**
+             * Non-owning view of a single header of an event stream message.
+             * Name and string values are null terminated and point into storage owned by the EventMessageView,
+             * they are only valid until the message view is reset.
+             */
+            class AWS_CORE_API EventHeaderView
+            {
+            public:
+                EventHeaderView() :
+                    m_name(nullptr), m_nameLength(0), m_type(EventHeaderValue::EventHeaderType::UNKNOWN),
+                    m_value(nullptr), m_valueLength(0), m_staticValue(0)
+                {}
+
+                inline const char* GetName() const { return m_name; }
+                inline size_t GetNameLength() const { return m_nameLength; }
+                inline EventHeaderValue::EventHeaderType GetType() const { return m_type; }
+
+                /**
+                 * Compare the header name against a null terminated string without allocating.
+                 */
+                bool IsNamed(const char* name) const;
+
+                /**
+                 * Raw bytes of a STRING, BYTE_BUF or UUID header value, nullptr for other types.
+                 */
+                inline const unsigned char* GetValue() const { return m_value; }
+                inline size_t GetValueLength() const { return m_valueLength; }
+
+                /**
+                 * Compare a STRING header value against a null terminated string without allocating.
+                 */
+                bool ValueEquals(const char* value) const;
+
+                /**
+                 * Copy the STRING header value out of the view.
+                 * Log error if the header is of another type.
+                 */
+                Aws::String GetValueAsString() const;
+
+                bool GetValueAsBoolean() const;
+                uint8_t GetValueAsByte() const;
+                int16_t GetValueAsInt16() const;
+                int32_t GetValueAsInt32() const;
+                int64_t GetValueAsInt64() const;
+                int64_t GetValueAsTimestamp() const;
+
+                /**
+                 * Copy this view into an owning EventHeaderValue.
+                 */
+                EventHeaderValue ToEventHeaderValue() const;
+
+            private:
+                friend class EventMessageView;
+
+                const char* m_name;
+                size_t m_nameLength;
+                EventHeaderValue::EventHeaderType m_type;
+                const unsigned char* m_value;
+                size_t m_valueLength;
+                int64_t m_staticValue;
+            };
+
+            /**
+             * Borrowed view of the message the decoder is currently delivering.
+             * Headers are kept in a flat array with their names and values packed into a single buffer, and the payload
+             * points straight into the buffer pumped into the decoder whenever it arrives in one segment.
+             * Storage is reused from one message to the next, so nothing obtained from the view may be retained after
+             * EventStreamHandler::OnEvent() returns; copy it out instead.
+             */
+            class AWS_CORE_API EventMessageView
+            {
+            public:
+                EventMessageView();
+
+                /**
+                 * Linear lookup of a header by name, returns nullptr if the message doesn't carry it.
+                 * Messages carry a handful of headers, so this is cheaper than any map.
+                 */
+                const EventHeaderView* FindHeader(const char* name) const;
+
+                inline const Aws::Vector<EventHeaderView>& GetHeaders() const { return m_headers; }
+
+                inline const unsigned char* GetPayload() const { return m_payload; }
+                inline size_t GetPayloadLength() const { return m_payloadLength; }
+
+                /**
+                 * Copy the payload out of the view.
+                 */
+                Aws::String GetPayloadAsString() const;
+                Aws::Vector<unsigned char> CopyPayload() const;
+
+                /**
+                 * Forget the current message, keeping the storage allocated for the next one.
+                 */
+                void Reset();
+
+                /**
+                 * Size the header storage for the message about to be decoded.
+                 */
+                void Reserve(size_t headersLength, size_t payloadLength);
+
+                /**
+                 * Copy the header handed out by the decoder, whose name and value are only valid during the header callback.
+                 */
+                void AddHeader(aws_event_stream_header_value_pair* header);
+
+                /**
+                 * Borrow the payload segment if it holds the whole payload, otherwise accumulate it.
+                 */
+                void WritePayload(const unsigned char* data, size_t length);
+
+            private:
+                char* AppendHeaderBytes(const void* data, size_t length);
+
+                Aws::Vector<EventHeaderView> m_headers;
+                Aws::Vector<char> m_headerBytes;
+                const unsigned char* m_payload;
+                size_t m_payloadLength;
+                size_t m_expectedPayloadLength;
+                Aws::Vector<unsigned char> m_payloadBuffer;
+            };
+        }
+    }
+}
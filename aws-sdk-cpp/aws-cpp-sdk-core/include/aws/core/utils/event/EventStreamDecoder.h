@@ -33,6 +33,10 @@ namespace Aws
                  */
                 void Pump(const ByteBuffer& data);
                 void Pump(const ByteBuffer& data, size_t length);
+                /**
+                 * Pass data to the underlying decoder without copying it, e.g. straight from a response body sink.
+                 */
+                void Pump(const unsigned char* data, size_t length);
 
                 /**
                  * Reset decoder and it's handler.
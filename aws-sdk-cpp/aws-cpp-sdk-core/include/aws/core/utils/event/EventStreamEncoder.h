@@ -6,6 +6,8 @@
 #pragma once
 
 #include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/event/EventMessage.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/event-stream/event_stream.h>
 
@@ -40,9 +42,22 @@ namespace Aws
                  * The signing is done via the signer member.
                  */
                 Aws::Vector<unsigned char> EncodeAndSign(const Aws::Utils::Event::Message& msg);
+
+                /**
+                 * Encodes and signs the input message, appending the signed frame to 'output'.
+                 * The message is framed directly inside the region reserved for the signed frame, so consecutive calls
+                 * lay frames out back to back in one contiguous buffer without intermediate copies.
+                 * Returns false, leaving 'output' untouched, if the message couldn't be signed.
+                 */
+                bool EncodeAndSign(const Aws::Utils::Event::Message& msg, Aws::Vector<unsigned char>& output);
+
+                /**
+                 * Encodes and signs a batch of messages in order, appending their signed frames to 'output'.
+                 * Stops at the first message that can't be signed and returns false, frames of the messages before it
+                 * are kept as the signature chain has already moved past them.
+                 */
+                bool EncodeAndSign(const Aws::Vector<Aws::Utils::Event::Message>& msgs, Aws::Vector<unsigned char>& output);
             private:
-                aws_event_stream_message Encode(const Aws::Utils::Event::Message& msg);
-                aws_event_stream_message Sign(aws_event_stream_message* msg);
                 Aws::Client::AWSAuthSigner* m_signer;
                 Aws::String m_signatureSeed;
             };
@@ -9,6 +9,7 @@
 #include <aws/core/http/HttpTypes.h>
 #include <aws/core/utils/event/EventHeader.h>
 #include <aws/core/utils/event/EventMessage.h>
+#include <aws/core/utils/event/EventMessageView.h>
 #include <aws/core/utils/event/EventStreamErrors.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
@@ -29,7 +30,8 @@ namespace Aws
             {
             public:
                 EventStreamHandler() :
-                    m_failure(false), m_internalError(EventStreamErrors::EVENT_STREAM_NO_ERROR), m_headersBytesReceived(0), m_payloadBytesReceived(0)
+                    m_failure(false), m_internalError(EventStreamErrors::EVENT_STREAM_NO_ERROR), m_headersBytesReceived(0), m_payloadBytesReceived(0),
+                    m_borrowMessages(false)
                 {}
 
                 virtual ~EventStreamHandler() = default;
@@ -55,6 +57,7 @@ namespace Aws
                     m_payloadBytesReceived = 0;
 
                     m_message.Reset();
+                    m_messageView.Reset();
                 }
 
                 /**
@@ -89,7 +92,15 @@ namespace Aws
                  */
                 inline virtual void SetMessageMetadata(size_t totalLength, size_t headersLength, size_t payloadLength)
                 {
-                    m_message.SetTotalLength(totalLength);
+                    if (m_borrowMessages)
+                    {
+                        // The payload is borrowed from the decoder, don't reserve room to copy it.
+                        m_messageView.Reserve(headersLength, payloadLength);
+                    }
+                    else
+                    {
+                        m_message.SetTotalLength(totalLength);
+                    }
                     m_message.SetHeadersLength(headersLength);
                     m_message.SetPayloadLength(payloadLength);
                     assert(totalLength == 12/*prelude length*/ + headersLength + payloadLength + 4/*message crc length*/);
@@ -104,19 +115,36 @@ namespace Aws
                  */
                 inline virtual void WriteMessageEventPayload(const unsigned char* data, size_t dataLength)
                 {
-                    m_message.WriteEventPayload(data, dataLength);
+                    if (m_borrowMessages)
+                    {
+                        m_messageView.WritePayload(data, dataLength);
+                    }
+                    else
+                    {
+                        m_message.WriteEventPayload(data, dataLength);
+                    }
                     m_payloadBytesReceived += dataLength;
                 }
                 
                 /**
                  * Get underlying byte array of the message just received.
                  */
-                inline virtual Aws::Vector<unsigned char>&& GetEventPayloadWithOwnership() { return m_message.GetEventPayloadWithOwnership(); }
+                inline virtual Aws::Vector<unsigned char>&& GetEventPayloadWithOwnership()
+                {
+                    if (m_borrowMessages)
+                    {
+                        m_message.GetEventPayload() = m_messageView.CopyPayload();
+                    }
+                    return m_message.GetEventPayloadWithOwnership();
+                }
 
                 /**
                  * Convert underlying byte array to string without transferring ownership.
                  */
-                inline virtual Aws::String GetEventPayloadAsString() { return m_message.GetEventPayloadAsString(); }
+                inline virtual Aws::String GetEventPayloadAsString()
+                {
+                    return m_borrowMessages ? m_messageView.GetPayloadAsString() : m_message.GetEventPayloadAsString();
+                }
 
                 /**
                  * Insert event header to a underlying event header value map, and update headers bytes received.
@@ -127,20 +155,53 @@ namespace Aws
                     m_headersBytesReceived += eventHeaderLength;
                 }
 
+                /**
+                 * Record a header straight from the decoder into the message view, and update headers bytes received.
+                 * Used instead of InsertMessageEventHeader() when the handler borrows messages.
+                 */
+                inline virtual void InsertMessageEventHeaderView(aws_event_stream_header_value_pair* header, size_t eventHeaderLength)
+                {
+                    m_messageView.AddHeader(header);
+                    m_headersBytesReceived += eventHeaderLength;
+                }
+
+                /**
+                 * Headers inserted by InsertMessageEventHeader(), always empty when the handler borrows messages.
+                 */
                 inline virtual const Aws::Utils::Event::EventHeaderValueCollection& GetEventHeaders() { return m_message.GetEventHeaders(); }
 
+                /**
+                 * Whether headers and payload are delivered through GetEventMessageView() instead of being copied into the message.
+                 */
+                inline bool IsBorrowingMessages() const { return m_borrowMessages; }
+
+                /**
+                 * View of the message being delivered when the handler borrows messages.
+                 * Only valid for the duration of OnEvent().
+                 */
+                inline const Aws::Utils::Event::EventMessageView& GetEventMessageView() const { return m_messageView; }
+
                 /**
                  * Entry point of all callback functions.
                  * Will trigger associated functions based on m_message.
                  */ 
                 virtual void OnEvent() = 0;
 
+            protected:
+                /**
+                 * Have the decoder hand headers and payload to this handler as views into its own buffers,
+                 * rather than copying each message into a map of headers and an owned payload.
+                 */
+                inline void SetBorrowMessages(bool borrowMessages) { m_borrowMessages = borrowMessages; }
+
             private:
                 bool m_failure;
                 EventStreamErrors m_internalError;
                 size_t m_headersBytesReceived;
                 size_t m_payloadBytesReceived;
                 Aws::Utils::Event::Message m_message;
+                bool m_borrowMessages;
+                Aws::Utils::Event::EventMessageView m_messageView;
             };
         }
     }
@@ -0,0 +1,49 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/external/cjson/cJSON.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Json
+        {
+            /**
+             * Parsing and printing of the cJSON documents behind JsonValue and JsonView.
+             *
+             * By default the SDK's own backend is used: the input is first scanned for its structural characters, 64 bytes at a
+             * time with SSE2 where available, and the document is then built from that index in a single allocation, items and
+             * strings alike. Building with ENABLE_CJSON_BACKEND uses cJSON's parser and printer instead.
+             * Either way the documents are regular cJSON documents, released with cJSON_Delete.
+             */
+            namespace Backend
+            {
+                /**
+                 * Name of the backend compiled in, "aws" or "cjson".
+                 */
+                AWS_CORE_API const char* GetName();
+
+                /**
+                 * Parses length bytes of JSON text, which must be followed by a null character as Aws::String::c_str() is.
+                 * Returns nullptr if the text isn't a single well formed JSON value, in which case errorPosition (if not null)
+                 * points at where parsing stopped.
+                 */
+                AWS_CORE_API cJSON* Parse(const char* json, size_t length, const char** errorPosition);
+
+                /**
+                 * Prints item as JSON text, compact or in cJSON_Print's tab indented layout.
+                 * The output is the same as cJSON's for both backends.
+                 */
+                AWS_CORE_API Aws::String Print(const cJSON* item, bool formatted);
+            } // namespace Backend
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
@@ -0,0 +1,183 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Json
+        {
+            /**
+             * Kind of the next value in the document.
+             */
+            enum class JsonTokenType
+            {
+                Object,
+                Array,
+                String,
+                Number,
+                Bool,
+                Null,
+                /**
+                 * The end of the enclosing object or array, or of the document.
+                 */
+                End,
+                Error
+            };
+
+            /**
+             * Forward only, pull style JSON reader. The document is tokenized as it is read from the stream, a chunk at a time,
+             * and values are handed straight to the caller, so deserializing a large document doesn't build an intermediate DOM
+             * or copy its strings more than once.
+             *
+             * Reading follows the structure of the document:
+             *
+             *     if (reader.BeginObject())
+             *     {
+             *         while (reader.NextMember())
+             *         {
+             *             if (reader.GetMemberName() == "Count") count = reader.ReadInteger();
+             *             else reader.SkipValue();
+             *         }
+             *     }
+             *
+             * Like JsonView, reading a value of a different type than the one expected is not an error: the value is skipped and
+             * a default is returned. Malformed JSON stops the reader, every following read returns a default and
+             * WasParseSuccessful() returns false.
+             */
+            class AWS_CORE_API JsonReader
+            {
+            public:
+                /**
+                 * Reads the document from stream, which must outlive the reader.
+                 */
+                JsonReader(Aws::IStream& stream);
+
+                /**
+                 * Reads the document from a buffer, which must outlive the reader.
+                 */
+                JsonReader(const char* data, size_t length);
+
+                JsonReader(const JsonReader&) = delete;
+                JsonReader& operator=(const JsonReader&) = delete;
+
+                /**
+                 * Type of the next value, without consuming it.
+                 */
+                JsonTokenType PeekType();
+
+                /**
+                 * Enters the next value if it is an object and returns true. Otherwise skips the value and returns false,
+                 * as it does for an empty document.
+                 */
+                bool BeginObject();
+
+                /**
+                 * Moves to the next member of the current object, whose name is then available from GetMemberName() and whose
+                 * value is read next. Returns false, leaving the object, once all its members have been read.
+                 * A member value that wasn't read is skipped.
+                 */
+                bool NextMember();
+
+                /**
+                 * Name of the member NextMember() moved to.
+                 */
+                const Aws::String& GetMemberName() const { return m_memberName; }
+
+                /**
+                 * Enters the next value if it is an array and returns true. Otherwise skips the value and returns false.
+                 */
+                bool BeginArray();
+
+                /**
+                 * Moves to the next element of the current array, which is read next. Returns false, leaving the array, once
+                 * all its elements have been read. An element that wasn't read is skipped.
+                 */
+                bool NextElement();
+
+                /**
+                 * Reads a string value, other values read as an empty string.
+                 */
+                Aws::String ReadString();
+
+                /**
+                 * Reads a number value as an int, other values read as 0.
+                 */
+                int ReadInteger();
+
+                /**
+                 * Reads a number value as a 64 bit integer, other values read as 0.
+                 */
+                long long ReadInt64();
+
+                /**
+                 * Reads a number value as a double, other values read as 0.
+                 */
+                double ReadDouble();
+
+                /**
+                 * Reads a bool value, other values read as false.
+                 */
+                bool ReadBool();
+
+                /**
+                 * Reads the next value, whatever its type, and returns its JSON text, e.g. to build a JsonValue from it.
+                 */
+                Aws::String ReadRawValue();
+
+                /**
+                 * Skips the next value, including all of its members or elements.
+                 */
+                void SkipValue();
+
+                bool WasParseSuccessful() const { return m_errorMessage.empty(); }
+
+                const Aws::String& GetErrorMessage() const { return m_errorMessage; }
+
+            private:
+                enum class Scope : char
+                {
+                    Object,
+                    Array
+                };
+
+                bool Fill();
+                bool SkipWhitespace();
+                bool AtValue();
+                bool Expect(char c);
+                void SetError(const char* message);
+                void ConsumeValue(Aws::String* raw);
+                bool ParseString(Aws::String& out, Aws::String* raw);
+                bool ParseNumber(Aws::String& out);
+                bool ParseLiteral(const char* literal, Aws::String* raw);
+                bool ParseHex4(unsigned& value, Aws::String* raw);
+                bool NextInScope(Scope scope, char close);
+
+                Aws::IStream* m_stream;
+                Aws::Vector<char> m_buffer;
+                const char* m_cursor;
+                const char* m_end;
+                Aws::Vector<Scope> m_scopes;
+                //whether the current object or array has had a member or element yet, one entry per scope
+                Aws::Vector<bool> m_scopeHasItems;
+                //NextMember/NextElement returned true and the value after it hasn't been read yet
+                bool m_valuePending;
+                bool m_started;
+                Aws::String m_memberName;
+                Aws::String m_scratch;
+                Aws::String m_errorMessage;
+            };
+
+        } // namespace Json
+    } // namespace Utils
+} // namespace Aws
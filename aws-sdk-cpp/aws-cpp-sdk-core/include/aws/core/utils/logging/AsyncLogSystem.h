@@ -0,0 +1,127 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/logging/LogLevel.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Logging
+        {
+            /**
+             * Logger for high volume logging. Every thread that logs gets its own lock free ring buffer, and a statement is
+             * only copied into it: its tag, a timestamp and, for Log(), the format string with its arguments in binary form.
+             * A background thread formats the statements into the same [LEVEL] timestamp tag [threadid] message lines as
+             * FormattedLogSystem and writes them out. A thread whose buffer is full drops its statements rather than waiting,
+             * the drops are counted and reported in the log.
+             *
+             * To use it, return one from SDKOptions::loggingOptions.logger_create_fn.
+             */
+            class AWS_CORE_API AsyncLogSystem : public LogSystemInterface
+            {
+            public:
+                static const size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+
+                /**
+                 * Initialize the logging system to write to the supplied logfile output. Creates logging thread on construction.
+                 * bufferSize is the size in bytes of the buffer of each thread that logs, rounded up to a power of two.
+                 */
+                AsyncLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+                /**
+                 * Initialize the logging system to write to a computed file path filenamePrefix + "timestamp.log". Creates logging thread
+                 * on construction. The file is rolled every hour, like DefaultLogSystem does.
+                 */
+                AsyncLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+                virtual ~AsyncLogSystem();
+
+                AsyncLogSystem(const AsyncLogSystem&) = delete;
+                AsyncLogSystem& operator=(const AsyncLogSystem&) = delete;
+
+                /**
+                 * Gets the currently configured log level.
+                 */
+                LogLevel GetLogLevel(void) const override { return m_logLevel; }
+                /**
+                 * Set a new log level. This has the immediate effect of changing the log output to the new level.
+                 */
+                void SetLogLevel(LogLevel logLevel) { m_logLevel.store(logLevel); }
+
+                /**
+                 * Captures the printf style statement, it is formatted on the logging thread. %n is not supported.
+                 */
+                void Log(LogLevel logLevel, const char* tag, const char* formatStr, ...) override;
+
+                /**
+                 * Captures the text of the stream.
+                 */
+                void LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream& messageStream) override;
+
+                /**
+                 * Captures the message and the fields in binary form, they are formatted on the logging thread.
+                 */
+                void LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount) override;
+
+                /**
+                 * Blocks until the statements logged before the call are written out.
+                 */
+                void Flush() override;
+
+                /**
+                 * Number of statements dropped so far because the buffer of the thread logging them was full.
+                 */
+                uint64_t GetDroppedStatementCount() const { return m_droppedStatements.load(std::memory_order_relaxed); }
+
+            private:
+                class ThreadBuffer;
+                struct ThreadBufferCache;
+
+                static ThreadBufferCache& GetThreadBufferCache();
+                ThreadBuffer* GetThreadBuffer();
+                void DropStatement();
+                void WriteLogs(std::shared_ptr<Aws::OStream> logFile, const Aws::String& filenamePrefix, bool rollLog);
+                void AppendPrefix(Aws::String& line, LogLevel logLevel, int64_t timestamp, const char* tag, size_t tagLength, const Aws::String& threadId);
+
+                std::atomic<LogLevel> m_logLevel;
+                const uint64_t m_id;
+                const size_t m_bufferSize;
+                std::atomic<uint64_t> m_droppedStatements;
+
+                std::mutex m_mutex;
+                std::condition_variable m_wakeSignal;
+                std::condition_variable m_flushSignal;
+                //buffers of the threads that started logging since the logging thread last looked
+                Aws::Vector<std::shared_ptr<ThreadBuffer>> m_newBuffers;
+                uint64_t m_flushRequested;
+                uint64_t m_flushCompleted;
+                bool m_stopLogging;
+                bool m_loggingStopped;
+
+                //used by the logging thread only
+                Aws::Vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+                int64_t m_cachedSecond;
+                char m_cachedSecondText[32];
+
+                std::thread m_loggingThread;
+            };
+
+        } // namespace Logging
+    } // namespace Utils
+} // namespace Aws
@@ -50,6 +50,11 @@ namespace Aws
                  */
                 virtual void LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream &messageStream) override;
 
+                /**
+                 * Writes the message and its fields to ProcessFormattedStatement.
+                 */
+                virtual void LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount) override;
+
             protected:
                 /**
                  * This is the method that most logger implementations will want to override.
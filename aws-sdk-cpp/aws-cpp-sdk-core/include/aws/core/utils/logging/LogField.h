@@ -0,0 +1,101 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Logging
+        {
+            /**
+             * A key and a value of a structured log statement, see the AWS_LOG_KV_* macros. The field only refers to its key
+             * and to a string value, both have to stay valid until the statement is logged.
+             */
+            class AWS_CORE_API LogField
+            {
+            public:
+                enum class Type
+                {
+                    Signed,
+                    Unsigned,
+                    Double,
+                    Bool,
+                    String
+                };
+
+                LogField(const char* key, bool value) : m_key(key), m_type(Type::Bool), m_string(nullptr), m_stringLength(0) { m_value.boolValue = value; }
+
+                template<typename T, typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value, int>::type = 0>
+                LogField(const char* key, T value) : m_key(key), m_type(Type::Signed), m_string(nullptr), m_stringLength(0) { m_value.signedValue = static_cast<int64_t>(value); }
+
+                template<typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+                LogField(const char* key, T value) : m_key(key), m_type(Type::Unsigned), m_string(nullptr), m_stringLength(0) { m_value.unsignedValue = static_cast<uint64_t>(value); }
+
+                template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+                LogField(const char* key, T value) : m_key(key), m_type(Type::Double), m_string(nullptr), m_stringLength(0) { m_value.doubleValue = static_cast<double>(value); }
+
+                LogField(const char* key, const char* value) : m_key(key), m_type(Type::String), m_string(value ? value : "(null)"), m_stringLength(strlen(m_string)) { m_value.unsignedValue = 0; }
+
+                LogField(const char* key, const char* value, size_t length) : m_key(key), m_type(Type::String), m_string(value), m_stringLength(length) { m_value.unsignedValue = 0; }
+
+                LogField(const char* key, const Aws::String& value) : m_key(key), m_type(Type::String), m_string(value.c_str()), m_stringLength(value.size()) { m_value.unsignedValue = 0; }
+
+                /**
+                 * Any other pointer would silently be logged as a bool.
+                 */
+                LogField(const char* key, const void* value) = delete;
+
+                const char* GetKey() const { return m_key; }
+                Type GetType() const { return m_type; }
+                int64_t GetSigned() const { return m_value.signedValue; }
+                uint64_t GetUnsigned() const { return m_value.unsignedValue; }
+                double GetDouble() const { return m_value.doubleValue; }
+                bool GetBool() const { return m_value.boolValue; }
+                const char* GetString() const { return m_string; }
+                size_t GetStringLength() const { return m_stringLength; }
+
+            private:
+                const char* m_key;
+                Type m_type;
+                union
+                {
+                    int64_t signedValue;
+                    uint64_t unsignedValue;
+                    double doubleValue;
+                    bool boolValue;
+                } m_value;
+                const char* m_string;
+                size_t m_stringLength;
+            };
+
+            /**
+             * Appends message followed by the fields as key=value pairs to line, e.g. `Request sent attempt=2 uri="/a b"`.
+             * A string value is quoted when it is empty or contains a space, a quote, an equals sign or a control character.
+             */
+            AWS_CORE_API void AppendLogFields(Aws::String& line, const char* message, size_t messageLength, const LogField* fields, size_t fieldCount);
+
+            /**
+             * Used by the AWS_LOG_KV_* macros, the temporaries the fields refer to live until the statement is logged.
+             */
+            inline void LogFields(LogSystemInterface& logSystem, LogLevel logLevel, const char* tag, const char* message, std::initializer_list<LogField> fields)
+            {
+                logSystem.LogFields(logLevel, tag, message, fields.begin(), fields.size());
+            }
+
+        } // namespace Logging
+    } // namespace Utils
+} // namespace Aws
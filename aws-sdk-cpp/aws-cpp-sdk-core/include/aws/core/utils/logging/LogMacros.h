@@ -10,6 +10,7 @@
 #include <aws/core/utils/logging/LogLevel.h>
 #include <aws/core/utils/logging/AWSLogging.h>
 #include <aws/core/utils/logging/LogSystemInterface.h>
+#include <aws/core/utils/logging/LogField.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
 
 // While macros are usually grotty, using them here lets us have a simple function call interface for logging that
@@ -17,6 +18,16 @@
 //  (1) Can be compiled out completely, so you don't even have to pay the cost to check the log level (which will be a virtual function call and a std::atomic<> read) if you don't want any AWS logging
 //  (2) If you use logging and the log statement doesn't pass the conditional log filter level, not only do you not pay the cost of building the log string, you don't pay the cost for allocating or
 //      getting any of the values used in building the log string, as they're in a scope (if-statement) that never gets entered.
+//  (3) Statements of the levels above AWS_MINIMUM_COMPILED_LOG_LEVEL (the numeric value of a LogLevel, set by the MINIMUM_COMPILED_LOG_LEVEL
+//      build option) generate no code at all, e.g. with 3 (Warn) the Info, Debug and Trace statements of hot paths cost nothing.
+//
+// The AWS_LOG_KV_* macros log a message followed by key=value fields, e.g. AWS_LOG_KV_DEBUG(tag, "Request sent", {"attempt", retries}, {"uri", uri}).
+// The values are passed to the log system as they are, so a logger that stores them in binary form (AsyncLogSystem) formats them off the
+// thread that logs, without building a stream. Statements without fields use AWS_LOG_*.
+
+#ifndef AWS_MINIMUM_COMPILED_LOG_LEVEL
+    #define AWS_MINIMUM_COMPILED_LOG_LEVEL 6
+#endif
 
 #ifdef DISABLE_AWS_LOGGING
 
@@ -38,6 +49,14 @@
     #define AWS_LOGSTREAM_TRACE(tag, streamExpression)
     #define AWS_LOGSTREAM_FLUSH()
 
+    #define AWS_LOG_KV(level, tag, message, ...)
+    #define AWS_LOG_KV_FATAL(tag, message, ...)
+    #define AWS_LOG_KV_ERROR(tag, message, ...)
+    #define AWS_LOG_KV_WARN(tag, message, ...)
+    #define AWS_LOG_KV_INFO(tag, message, ...)
+    #define AWS_LOG_KV_DEBUG(tag, message, ...)
+    #define AWS_LOG_KV_TRACE(tag, message, ...)
+
 #else
 
     #define AWS_LOG_FLUSH() \
@@ -49,99 +68,141 @@
             } \
         }
 
+    // A statement compiled out by AWS_MINIMUM_COMPILED_LOG_LEVEL is put in a lambda that is never called: no code is generated for it,
+    // but the tags and the variables it uses still count as used.
+    #define AWS_LOG_COMPILED_OUT(...) \
+        { \
+            auto compiledOutStatement = [&]() { __VA_ARGS__; }; \
+            static_cast<void>(compiledOutStatement); \
+        }
+
     #define AWS_LOG(level, tag, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= level ) \
+            if ( logSystem && static_cast<int>(level) <= AWS_MINIMUM_COMPILED_LOG_LEVEL && logSystem->GetLogLevel() >= level ) \
             { \
                 logSystem->Log(level, tag, __VA_ARGS__); \
             } \
         }
 
-    #define AWS_LOG_FATAL(tag, ...) \
+    #define AWS_LOGSTREAM(level, tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Fatal ) \
+            if ( logSystem && static_cast<int>(level) <= AWS_MINIMUM_COMPILED_LOG_LEVEL && logSystem->GetLogLevel() >= level ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Fatal, tag, __VA_ARGS__); \
+                Aws::OStringStream logStream; \
+                logStream << streamExpression; \
+                logSystem->LogStream( level, tag, logStream ); \
             } \
         }
 
-    #define AWS_LOG_ERROR(tag, ...) \
+    #define AWS_LOG_KV(level, tag, message, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Error ) \
+            if ( logSystem && static_cast<int>(level) <= AWS_MINIMUM_COMPILED_LOG_LEVEL && logSystem->GetLogLevel() >= level ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Error, tag, __VA_ARGS__); \
+                Aws::Utils::Logging::LogFields(*logSystem, level, tag, message, { __VA_ARGS__ }); \
             } \
         }
 
-    #define AWS_LOG_WARN(tag, ...) \
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 1
+
+    #define AWS_LOG_FATAL(tag, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Warn ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Fatal ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Warn, tag, __VA_ARGS__); \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Fatal, tag, __VA_ARGS__); \
             } \
         }
 
-    #define AWS_LOG_INFO(tag, ...) \
+    #define AWS_LOGSTREAM_FATAL(tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Info ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Fatal ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Info, tag, __VA_ARGS__); \
+                Aws::OStringStream logStream; \
+                logStream << streamExpression; \
+                logSystem->LogStream( Aws::Utils::Logging::LogLevel::Fatal, tag, logStream ); \
             } \
         }
 
-    #define AWS_LOG_DEBUG(tag, ...) \
+    #define AWS_LOG_KV_FATAL(tag, message, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Debug ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Fatal ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Debug, tag, __VA_ARGS__); \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Fatal, tag, message, { __VA_ARGS__ }); \
             } \
         }
 
-    #define AWS_LOG_TRACE(tag, ...) \
+#else
+
+    #define AWS_LOG_FATAL(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Fatal, tag, __VA_ARGS__))
+
+    #define AWS_LOGSTREAM_FATAL(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Fatal, tag, logStream))
+
+    #define AWS_LOG_KV_FATAL(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Fatal, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 1
+
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 2
+
+    #define AWS_LOG_ERROR(tag, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Trace ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Error ) \
             { \
-                logSystem->Log(Aws::Utils::Logging::LogLevel::Trace, tag, __VA_ARGS__); \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Error, tag, __VA_ARGS__); \
             } \
         }
 
-    #define AWS_LOGSTREAM(level, tag, streamExpression) \
+    #define AWS_LOGSTREAM_ERROR(tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= level ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Error ) \
             { \
                 Aws::OStringStream logStream; \
                 logStream << streamExpression; \
-                logSystem->LogStream( logLevel, tag, logStream ); \
+                logSystem->LogStream( Aws::Utils::Logging::LogLevel::Error, tag, logStream ); \
             } \
         }
 
-    #define AWS_LOGSTREAM_FATAL(tag, streamExpression) \
+    #define AWS_LOG_KV_ERROR(tag, message, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Fatal ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Error ) \
             { \
-                Aws::OStringStream logStream; \
-                logStream << streamExpression; \
-                logSystem->LogStream( Aws::Utils::Logging::LogLevel::Fatal, tag, logStream ); \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Error, tag, message, { __VA_ARGS__ }); \
             } \
         }
 
+#else
+
+    #define AWS_LOG_ERROR(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Error, tag, __VA_ARGS__))
+
     #define AWS_LOGSTREAM_ERROR(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Error, tag, logStream))
+
+    #define AWS_LOG_KV_ERROR(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Error, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 2
+
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 3
+
+    #define AWS_LOG_WARN(tag, ...) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
-            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Error ) \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Warn ) \
             { \
-                Aws::OStringStream logStream; \
-                logStream << streamExpression; \
-                logSystem->LogStream( Aws::Utils::Logging::LogLevel::Error, tag, logStream ); \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Warn, tag, __VA_ARGS__); \
             } \
         }
 
@@ -156,6 +217,40 @@
             } \
         }
 
+    #define AWS_LOG_KV_WARN(tag, message, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Warn ) \
+            { \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Warn, tag, message, { __VA_ARGS__ }); \
+            } \
+        }
+
+#else
+
+    #define AWS_LOG_WARN(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Warn, tag, __VA_ARGS__))
+
+    #define AWS_LOGSTREAM_WARN(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Warn, tag, logStream))
+
+    #define AWS_LOG_KV_WARN(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Warn, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 3
+
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 4
+
+    #define AWS_LOG_INFO(tag, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Info ) \
+            { \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Info, tag, __VA_ARGS__); \
+            } \
+        }
+
     #define AWS_LOGSTREAM_INFO(tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
@@ -167,6 +262,40 @@
             } \
         }
 
+    #define AWS_LOG_KV_INFO(tag, message, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Info ) \
+            { \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Info, tag, message, { __VA_ARGS__ }); \
+            } \
+        }
+
+#else
+
+    #define AWS_LOG_INFO(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Info, tag, __VA_ARGS__))
+
+    #define AWS_LOGSTREAM_INFO(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Info, tag, logStream))
+
+    #define AWS_LOG_KV_INFO(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Info, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 4
+
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 5
+
+    #define AWS_LOG_DEBUG(tag, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Debug ) \
+            { \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Debug, tag, __VA_ARGS__); \
+            } \
+        }
+
     #define AWS_LOGSTREAM_DEBUG(tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
@@ -178,6 +307,40 @@
             } \
         }
 
+    #define AWS_LOG_KV_DEBUG(tag, message, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Debug ) \
+            { \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Debug, tag, message, { __VA_ARGS__ }); \
+            } \
+        }
+
+#else
+
+    #define AWS_LOG_DEBUG(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Debug, tag, __VA_ARGS__))
+
+    #define AWS_LOGSTREAM_DEBUG(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Debug, tag, logStream))
+
+    #define AWS_LOG_KV_DEBUG(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Debug, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 5
+
+#if AWS_MINIMUM_COMPILED_LOG_LEVEL >= 6
+
+    #define AWS_LOG_TRACE(tag, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Trace ) \
+            { \
+                logSystem->Log(Aws::Utils::Logging::LogLevel::Trace, tag, __VA_ARGS__); \
+            } \
+        }
+
     #define AWS_LOGSTREAM_TRACE(tag, streamExpression) \
         { \
             Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
@@ -189,6 +352,29 @@
             } \
         }
 
+    #define AWS_LOG_KV_TRACE(tag, message, ...) \
+        { \
+            Aws::Utils::Logging::LogSystemInterface* logSystem = Aws::Utils::Logging::GetLogSystem(); \
+            if ( logSystem && logSystem->GetLogLevel() >= Aws::Utils::Logging::LogLevel::Trace ) \
+            { \
+                Aws::Utils::Logging::LogFields(*logSystem, Aws::Utils::Logging::LogLevel::Trace, tag, message, { __VA_ARGS__ }); \
+            } \
+        }
+
+#else
+
+    #define AWS_LOG_TRACE(tag, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::GetLogSystem()->Log(Aws::Utils::Logging::LogLevel::Trace, tag, __VA_ARGS__))
+
+    #define AWS_LOGSTREAM_TRACE(tag, streamExpression) \
+        AWS_LOG_COMPILED_OUT(Aws::OStringStream logStream; logStream << streamExpression; \
+            Aws::Utils::Logging::GetLogSystem()->LogStream(Aws::Utils::Logging::LogLevel::Trace, tag, logStream))
+
+    #define AWS_LOG_KV_TRACE(tag, message, ...) \
+        AWS_LOG_COMPILED_OUT(Aws::Utils::Logging::LogFields(*Aws::Utils::Logging::GetLogSystem(), Aws::Utils::Logging::LogLevel::Trace, tag, message, { __VA_ARGS__ }))
+
+#endif // AWS_MINIMUM_COMPILED_LOG_LEVEL >= 6
+
     #define AWS_LOGSTREAM_FLUSH()  AWS_LOG_FLUSH()
 
 #endif // DISABLE_AWS_LOGGING
@@ -17,6 +17,7 @@ namespace Aws
         namespace Logging
         {
             enum class LogLevel : int;
+            class LogField;
 
             /**
              * Interface for logging implementations. If you want to write your own logger, you can start here, though you may have more
@@ -40,6 +41,11 @@ namespace Aws
                 * Writes the stream to the output stream.
                 */
                 virtual void LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream &messageStream) = 0;
+                /**
+                 * Writes message followed by the fields as key=value pairs, see AppendLogFields. The default formats them
+                 * into a stream for LogStream, loggers that can capture the fields as they are override it.
+                 */
+                virtual void LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount);
                 /**
                  * Writes any buffered messages to the underlying device if the logger supports buffering.
                  */
@@ -0,0 +1,111 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/MemorySystemInterface.h>
+
+#include <cstddef>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Memory
+        {
+            class RequestArenaScope;
+
+            /**
+             * Memory system that serves the small allocations a thread makes while a RequestArenaScope is alive from a monotonic
+             * arena: they are carved out of blocks of blockSize bytes and freeing them costs an atomic decrement. A block is given
+             * back to the upstream memory system in one shot once the scope is gone and everything allocated from it is freed,
+             * whichever thread frees it. Allocations made outside of a scope, and the ones bigger than a quarter of a block, fall back
+             * to the upstream memory system.
+             *
+             * AWSClient opens a scope for every request, so the request, its headers, the signer temporaries and the response share a
+             * few blocks that are released when the outcome is destroyed. The arena is only used when the SDK is built with custom
+             * memory management and this is the memory system passed to InitAPI in SDKOptions::memoryManagementOptions.memoryManager.
+             * An object allocated during a request and kept afterwards, e.g. in a cache, would keep its whole block alive, such
+             * allocations are made under a RequestArenaSuspension.
+             *
+             * Allocations are 16 bytes aligned, a bigger alignment isn't supported.
+             */
+            class AWS_CORE_API ArenaMemorySystem : public MemorySystemInterface
+            {
+            public:
+                static const size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+                /**
+                 * upstream is the memory system the blocks and the other allocations come from, nullptr for malloc and free.
+                 */
+                ArenaMemorySystem(MemorySystemInterface* upstream = nullptr, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+                ArenaMemorySystem(const ArenaMemorySystem&) = delete;
+                ArenaMemorySystem& operator=(const ArenaMemorySystem&) = delete;
+
+                void Begin() override;
+                void End() override;
+
+                void* AllocateMemory(std::size_t blockSize, std::size_t alignment, const char* allocationTag = nullptr) override;
+                void FreeMemory(void* memoryPtr) override;
+
+                size_t GetBlockSize() const { return m_blockSize; }
+
+            private:
+                friend class RequestArenaScope;
+
+                void* AllocateUpstream(size_t size, const char* allocationTag);
+                void FreeUpstream(void* memoryPtr);
+                bool NewBlock(RequestArenaScope& scope);
+                static void ReleaseBlock(void* block);
+
+                MemorySystemInterface* m_upstream;
+                const size_t m_blockSize;
+            };
+
+            /**
+             * While it is alive, the allocations the thread makes through an ArenaMemorySystem come from an arena of its own.
+             * Scopes nest, the innermost one is used. Without an ArenaMemorySystem a scope has no effect.
+             */
+            class AWS_CORE_API RequestArenaScope
+            {
+            public:
+                RequestArenaScope();
+                ~RequestArenaScope();
+
+                RequestArenaScope(const RequestArenaScope&) = delete;
+                RequestArenaScope& operator=(const RequestArenaScope&) = delete;
+
+            private:
+                friend class ArenaMemorySystem;
+
+                RequestArenaScope* m_previous;
+                void* m_block;
+                char* m_cursor;
+                char* m_end;
+            };
+
+            /**
+             * While it is alive, the allocations the thread makes go to the upstream memory system even inside a RequestArenaScope.
+             * Used for the objects that outlive the request, like cache entries and pooled connections.
+             */
+            class AWS_CORE_API RequestArenaSuspension
+            {
+            public:
+                RequestArenaSuspension();
+                ~RequestArenaSuspension();
+
+                RequestArenaSuspension(const RequestArenaSuspension&) = delete;
+                RequestArenaSuspension& operator=(const RequestArenaSuspension&) = delete;
+
+            private:
+                RequestArenaScope* m_suspended;
+            };
+
+        } // namespace Memory
+    } // namespace Utils
+} // namespace Aws
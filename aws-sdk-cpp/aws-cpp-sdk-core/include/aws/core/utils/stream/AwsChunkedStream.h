@@ -0,0 +1,119 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <functional>
+#include <memory>
+#include <streambuf>
+#include <istream>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            /**
+             * Computes the signature of the next chunk from the signature of the previous one (the seed signature for the first chunk)
+             * and the chunk's data. The final, empty chunk is signed with length 0. Returns an empty string on failure.
+             */
+            typedef std::function<Aws::String(const Aws::String& priorSignature, const unsigned char* data, size_t length)> ChunkSigner;
+
+            /**
+             * Read only stream buffer that encodes a body with aws-chunked content encoding as it is read, signing every chunk:
+             *
+             *     hex(length);chunk-signature=signature\r\n data \r\n ... 0;chunk-signature=signature\r\n\r\n
+             *
+             * The body is read one chunk at a time, so hashing and signing happen while the data is being sent rather than in a
+             * separate pass over the body beforehand. The body is always encoded from its beginning.
+             * Only seeking back to the beginning (which restarts the signature chain) and querying the current position are supported.
+             */
+            class AWS_CORE_API AwsChunkedStreamBuf : public std::streambuf
+            {
+            public:
+                /**
+                 * body to encode, chunkSigner to sign each chunk with, seedSignature is the signature of the request headers.
+                 * Every chunk but the last holds chunkSize bytes of the body.
+                 */
+                AwsChunkedStreamBuf(const std::shared_ptr<Aws::IOStream>& body, const ChunkSigner& chunkSigner,
+                    const Aws::String& seedSignature, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+                AwsChunkedStreamBuf(const AwsChunkedStreamBuf&) = delete;
+                AwsChunkedStreamBuf& operator=(const AwsChunkedStreamBuf&) = delete;
+
+                const std::shared_ptr<Aws::IOStream>& GetBody() const { return m_body; }
+
+                /**
+                 * Length of a body of decodedLength bytes once encoded, what goes into the content-length header.
+                 */
+                static uint64_t GetEncodedLength(uint64_t decodedLength, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+                /**
+                 * Number of body bytes read out of this buffer, as part of an encoded chunk, since the previous call.
+                 * Lets progress be reported in body bytes rather than encoded bytes. Seeking back to the beginning starts over.
+                 */
+                uint64_t TakeDecodedBytesRead();
+
+                static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+            protected:
+                int_type underflow() override;
+                pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+                pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
+
+            private:
+                bool EncodeNextChunk();
+
+                std::shared_ptr<Aws::IOStream> m_body;
+                ChunkSigner m_chunkSigner;
+                Aws::String m_seedSignature;
+                Aws::String m_priorSignature;
+                size_t m_chunkSize;
+                Aws::Vector<char> m_buffer;
+                uint64_t m_position;
+                //body bytes in the chunks before the current one, and how many of them were already reported
+                uint64_t m_decodedPosition;
+                uint64_t m_decodedReported;
+                const char* m_chunkData;
+                size_t m_chunkDataLength;
+                bool m_finished;
+            };
+
+            /**
+             * IOStream over an AwsChunkedStreamBuf, to be set as the content body of a request.
+             */
+            class AWS_CORE_API AwsChunkedStream : public Aws::IOStream
+            {
+            public:
+                AwsChunkedStream(const std::shared_ptr<Aws::IOStream>& body, const ChunkSigner& chunkSigner,
+                    const Aws::String& seedSignature, size_t chunkSize = AwsChunkedStreamBuf::DEFAULT_CHUNK_SIZE);
+
+                AwsChunkedStream(const AwsChunkedStream&) = delete;
+                AwsChunkedStream& operator=(const AwsChunkedStream&) = delete;
+
+                ~AwsChunkedStream();
+
+                /**
+                 * The stream being encoded.
+                 */
+                const std::shared_ptr<Aws::IOStream>& GetBody() const { return m_chunkedBuf->GetBody(); }
+
+                /**
+                 * See AwsChunkedStreamBuf::TakeDecodedBytesRead().
+                 */
+                uint64_t TakeDecodedBytesRead() { return m_chunkedBuf->TakeDecodedBytesRead(); }
+
+            private:
+                AwsChunkedStreamBuf* m_chunkedBuf;
+            };
+        }
+    }
+}
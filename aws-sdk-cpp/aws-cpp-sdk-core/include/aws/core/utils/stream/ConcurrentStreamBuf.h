@@ -8,6 +8,7 @@
 #include <aws/core/auth/AWSAuthSigner.h>
 #include <aws/common/array_list.h>
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <streambuf>
@@ -22,6 +23,9 @@ namespace Aws
         {
             /**
              * A thread-safe streambuf implementation that allows simultaneous reading and writing.
+             * Bytes are written straight into a ring buffer and read straight out of it, the writer and the reader only
+             * exchange their positions in the ring. Neither side takes a lock unless the ring is full or empty and it
+             * has to wait for the other one.
              * NOTE: iostreams maintain state for readers and writers. This means that you can have at most two
              * concurrent threads, one for reading and one for writing. Multiple readers or multiple writers are not
              * thread-safe and will result in race-conditions.
@@ -39,6 +43,7 @@ namespace Aws
                 std::streampos seekpos(std::streampos pos, std::ios_base::openmode which = std::ios_base::in | std::ios_base::out) override;
 
                 int underflow() override;
+                std::streamsize xsgetn(char* s, std::streamsize n) override;
                 int overflow(int ch) override;
                 int sync() override;
                 std::streamsize showmanyc() override;
@@ -46,12 +51,21 @@ namespace Aws
                 void FlushPutArea();
 
             private:
-                Aws::Vector<unsigned char> m_getArea;
-                Aws::Vector<unsigned char> m_putArea;
-                Aws::Vector<unsigned char> m_backbuf; // used to shuttle data from the put area to the get area
-                std::mutex m_lock; // synchronize access to the common backbuffer
+                void ResetPutArea();
+                void ReleaseGetArea();
+                bool WaitForSpace();
+                void WaitForData();
+                void Notify();
+
+                Aws::Vector<unsigned char> m_buffer; // the ring, both the put area and the get area point into it
+                std::atomic<size_t> m_writePos; // total bytes published by the writer
+                std::atomic<size_t> m_readPos; // total bytes released by the reader
+                size_t m_putPos; // writer only, total position of the put area's start
+                size_t m_getPos; // reader only, total position of the get area's start
+                std::atomic<bool> m_eof;
+                std::atomic<int> m_waiters; // threads parked on m_signal, notifications are skipped when there are none
+                std::mutex m_lock; // only taken to park on, or wake up, m_signal
                 std::condition_variable m_signal;
-                bool m_eof;
             };
         }
     }
@@ -0,0 +1,150 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/memory/stl/AWSDeque.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            /**
+             * What BoundedThreadExecutor does with a submission while its queue is full.
+             */
+            enum class QueueFullPolicy
+            {
+                /**
+                 * The submitting thread waits until a worker takes a task off the queue.
+                 * Submissions made from one of the executor's own threads never wait and are queued beyond the limit instead.
+                 */
+                BLOCK,
+                /**
+                 * SubmitToThread returns false, the calling Async or Callable operation then fails fast.
+                 */
+                REJECT
+            };
+
+            /**
+             * Snapshot of a BoundedThreadExecutor's counters. Latencies are summed over all completed tasks.
+             */
+            struct AWS_CORE_API BoundedThreadExecutorMetrics
+            {
+                BoundedThreadExecutorMetrics() :
+                    threadCount(0), idleThreadCount(0), queueDepth(0), peakQueueDepth(0),
+                    submittedTasks(0), rejectedTasks(0), blockedSubmissions(0), completedTasks(0),
+                    totalQueueLatency(0), maxQueueLatency(0), totalExecutionTime(0)
+                {
+                }
+
+                size_t threadCount;
+                size_t idleThreadCount;
+                size_t queueDepth;
+                size_t peakQueueDepth;
+                uint64_t submittedTasks;
+                uint64_t rejectedTasks;
+                /**
+                 * Number of submissions that had to wait for queue space under QueueFullPolicy::BLOCK.
+                 */
+                uint64_t blockedSubmissions;
+                uint64_t completedTasks;
+                /**
+                 * Time tasks spent queued before a thread picked them up.
+                 */
+                std::chrono::microseconds totalQueueLatency;
+                std::chrono::microseconds maxQueueLatency;
+                std::chrono::microseconds totalExecutionTime;
+            };
+
+            /**
+            * Thread pool executor with a bounded number of threads and a bounded queue.
+            * Threads are only created when a task is submitted and no thread is idle, up to maxThreads, and live until the
+            * executor is destroyed. Once maxQueuedTasks tasks are waiting, further submissions are handled per QueueFullPolicy.
+            *
+            * This is the executor ClientConfiguration uses by default (see GetDefaultExecutor()), shared by all clients of the process.
+            * A task that submits more work while every thread is busy gets an extra thread beyond maxThreads, so it may wait on
+            * what it submitted (e.g. a handler waiting on the future of another Callable operation). Extra threads exit once the
+            * queue is empty.
+            * Tasks that are still queued when the executor is destroyed are run before its threads are joined. When the last
+            * reference is released by one of its own tasks, that thread is detached instead and finishes the queue on its own.
+            */
+            class AWS_CORE_API BoundedThreadExecutor : public Executor
+            {
+            public:
+                /**
+                 * maxThreads of 0 is treated as 1, maxQueuedTasks of 0 means the queue is unbounded.
+                 */
+                BoundedThreadExecutor(size_t maxThreads, size_t maxQueuedTasks = DEFAULT_MAX_QUEUED_TASKS, QueueFullPolicy queueFullPolicy = QueueFullPolicy::BLOCK);
+                ~BoundedThreadExecutor();
+
+                /**
+                * Rule of 5 stuff.
+                * Don't copy or move
+                */
+                BoundedThreadExecutor(const BoundedThreadExecutor&) = delete;
+                BoundedThreadExecutor& operator =(const BoundedThreadExecutor&) = delete;
+                BoundedThreadExecutor(BoundedThreadExecutor&&) = delete;
+                BoundedThreadExecutor& operator =(BoundedThreadExecutor&&) = delete;
+
+                BoundedThreadExecutorMetrics GetMetrics() const;
+
+                /**
+                 * Thread limit used for the shared default executor: four threads per hardware thread, at least 16,
+                 * since SDK tasks spend most of their time waiting on the network.
+                 */
+                static size_t GetDefaultMaxThreads();
+
+                static const size_t DEFAULT_MAX_QUEUED_TASKS = 4096;
+
+            protected:
+                bool SubmitToThread(std::function<void()>&&) override;
+
+            private:
+                struct QueuedTask
+                {
+                    std::function<void()> fn;
+                    std::chrono::steady_clock::time_point enqueueTime;
+                };
+
+                /**
+                 * Everything the threads touch, owned jointly with them so a thread can outlive the executor.
+                 */
+                struct State
+                {
+                    State(size_t maxThreads, size_t maxQueuedTasks, QueueFullPolicy queueFullPolicy);
+
+                    std::mutex lock;
+                    std::condition_variable taskAvailable;
+                    std::condition_variable spaceAvailable;
+                    Aws::Deque<QueuedTask> tasks;
+                    Aws::Vector<std::thread> threads;
+                    size_t maxThreads;
+                    size_t maxQueuedTasks;
+                    QueueFullPolicy queueFullPolicy;
+                    size_t idleThreads;
+                    bool shouldContinue;
+                    BoundedThreadExecutorMetrics metrics;
+                };
+
+                static void WorkerLoop(std::shared_ptr<State> state);
+
+                std::shared_ptr<State> m_state;
+            };
+
+        } // namespace Threading
+    } // namespace Utils
+} // namespace Aws
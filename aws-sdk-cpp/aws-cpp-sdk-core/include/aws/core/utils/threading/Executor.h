@@ -14,6 +14,7 @@
 #include <future>
 #include <mutex>
 #include <atomic>
+#include <memory>
 
 namespace Aws
 {
@@ -113,6 +114,24 @@ namespace Aws
                 friend class ThreadTask;
             };
 
+            /**
+            * Returns the executor ClientConfiguration uses when the application does not set one.
+            * Between Aws::InitAPI() and Aws::ShutdownAPI() this is a single BoundedThreadExecutor shared by every client of the
+            * process, unless SDKOptions::executorOptions installed a create function. Outside of that window an error is logged
+            * and each call returns a new DefaultExecutor.
+            */
+            AWS_CORE_API std::shared_ptr<Executor> GetDefaultExecutor();
+
+            /**
+            * Makes GetDefaultExecutor() return the result of createFn. Called by Aws::InitAPI().
+            */
+            AWS_CORE_API void InitDefaultExecutor(const std::function<std::shared_ptr<Executor>()>& createFn);
+
+            /**
+            * Releases the shared default executor. Clients that still hold it keep it alive until they are destroyed.
+            * Called by Aws::ShutdownAPI().
+            */
+            AWS_CORE_API void CleanupDefaultExecutor();
 
         } // namespace Threading
     } // namespace Utils
@@ -0,0 +1,87 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/memory/stl/AWSQueue.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            /**
+            * Thread pool executor that keeps a set of queues per worker thread instead of a single shared queue.
+            *
+            * Tasks submitted from outside the pool are distributed round robin over bounded, lock-free per-worker inboxes.
+            * Tasks submitted from a worker thread (e.g. continuations of async calls) are pushed onto that worker's own
+            * lock-free deque and run LIFO by the owner. Idle workers steal from the other workers' inboxes and deques,
+            * spin for a short while when no work is found and only then park on a condition variable.
+            * Tasks are stored by value in preallocated queue slots, so submitting does not allocate beyond what the
+            * std::function itself needs.
+            *
+            * OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS spills tasks into a shared overflow queue when every inbox is full,
+            * OverflowPolicy::REJECT_IMMEDIATELY makes SubmitToThread return false instead.
+            * As with PooledThreadExecutor, tasks that have not started when the executor is destroyed are discarded.
+            */
+            class AWS_CORE_API WorkStealingThreadExecutor : public Executor
+            {
+            public:
+                /**
+                 * poolSize is the number of worker threads, queueCapacityPerThread the number of tasks each worker's inbox
+                 * and deque can hold (rounded up to a power of 2).
+                 */
+                WorkStealingThreadExecutor(size_t poolSize,
+                    OverflowPolicy overflowPolicy = OverflowPolicy::QUEUE_TASKS_EVENLY_ACCROSS_THREADS,
+                    size_t queueCapacityPerThread = DEFAULT_QUEUE_CAPACITY_PER_THREAD);
+                ~WorkStealingThreadExecutor();
+
+                /**
+                * Rule of 5 stuff.
+                * Don't copy or move
+                */
+                WorkStealingThreadExecutor(const WorkStealingThreadExecutor&) = delete;
+                WorkStealingThreadExecutor& operator =(const WorkStealingThreadExecutor&) = delete;
+                WorkStealingThreadExecutor(WorkStealingThreadExecutor&&) = delete;
+                WorkStealingThreadExecutor& operator =(WorkStealingThreadExecutor&&) = delete;
+
+                static const size_t DEFAULT_QUEUE_CAPACITY_PER_THREAD = 1024;
+
+            protected:
+                bool SubmitToThread(std::function<void()>&&) override;
+
+            private:
+                struct Worker;
+
+                void WorkerLoop(size_t workerIndex);
+                bool TryRunTask(Worker& worker);
+                bool TryStealTask(Worker& worker, std::function<void()>& task);
+                bool TryPopOverflowTask(std::function<void()>& task);
+                bool HasVisibleTasks() const;
+                void Park();
+                void WakeOne();
+
+                Aws::Vector<Worker*> m_workers;
+                std::atomic<size_t> m_sleepingWorkers;
+                std::atomic<bool> m_continue;
+                std::mutex m_parkLock;
+                std::condition_variable m_parkSignal;
+                std::mutex m_overflowLock;
+                Aws::Queue<std::function<void()>> m_overflowTasks;
+                std::atomic<size_t> m_overflowTaskCount;
+                OverflowPolicy m_overflowPolicy;
+            };
+
+        } // namespace Threading
+    } // namespace Utils
+} // namespace Aws
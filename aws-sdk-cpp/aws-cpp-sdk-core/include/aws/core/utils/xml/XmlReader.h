@@ -0,0 +1,142 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/core/Core_EXPORTS.h>
+
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
+
+#include <utility>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Xml
+        {
+            /**
+             * Forward only, pull style XML reader. The document is parsed as it is read from the stream, a chunk at a time,
+             * and element text is handed to the caller with its entities and character references decoded as it is read, so
+             * deserializing a large response doesn't build an XmlDocument or copy the document as a whole.
+             *
+             * Reading follows the structure of the document:
+             *
+             *     if (reader.NextChildElement() && reader.EnterElement()) // the root element
+             *     {
+             *         while (reader.NextChildElement())
+             *         {
+             *             if (reader.GetElementName() == "Name") name = reader.ReadElementText();
+             *             else if (reader.GetElementName() == "Item") item.ReadXml(reader);
+             *         }
+             *     }
+             *
+             * Comments, processing instructions and the document type declaration are skipped. Malformed XML stops the
+             * reader, every following read returns a default and WasParseSuccessful() returns false.
+             */
+            class AWS_CORE_API XmlReader
+            {
+            public:
+                /**
+                 * Reads the document from stream, which must outlive the reader.
+                 */
+                XmlReader(Aws::IStream& stream);
+
+                /**
+                 * Reads the document from a buffer, which must outlive the reader.
+                 */
+                XmlReader(const char* data, size_t length);
+
+                XmlReader(const XmlReader&) = delete;
+                XmlReader& operator=(const XmlReader&) = delete;
+
+                /**
+                 * Moves to the next child element of the entered element, or to the root element at the start of the document.
+                 * Its name and attributes are then available, and it can be entered, read or skipped. Returns false, leaving
+                 * the entered element, after its last child. A child that wasn't entered or read is skipped.
+                 */
+                bool NextChildElement();
+
+                /**
+                 * Name of the element NextChildElement() moved to.
+                 */
+                const Aws::String& GetElementName() const { return m_elementName; }
+
+                /**
+                 * Value of an attribute of the element NextChildElement() moved to, empty if it has no such attribute.
+                 */
+                Aws::String GetAttributeValue(const char* name) const;
+
+                /**
+                 * Enters the element NextChildElement() moved to, so that its children are iterated next. Returns false if
+                 * the reader isn't at an element.
+                 */
+                bool EnterElement();
+
+                /**
+                 * Reads the text of the element NextChildElement() moved to, including its CDATA sections, and leaves it.
+                 * The text of nested elements is skipped. With trimWhitespace, leading and trailing whitespace is removed.
+                 */
+                Aws::String ReadElementText(bool trimWhitespace = false);
+
+                /**
+                 * Skips the element NextChildElement() moved to, including all of its content.
+                 */
+                void SkipElement();
+
+                bool WasParseSuccessful() const { return m_errorMessage.empty(); }
+
+                const Aws::String& GetErrorMessage() const { return m_errorMessage; }
+
+            private:
+                enum class Markup
+                {
+                    StartTag,
+                    EndTag,
+                    Other,
+                    Error
+                };
+
+                bool Fill();
+                bool Available();
+                bool Expect(char c);
+                void SetError(const char* message);
+                bool ReadText(Aws::String* text);
+                void ReadReference(Aws::String* text);
+                Markup ReadMarkup(Aws::String* text, bool keepElement);
+                bool ReadName(Aws::String& name);
+                bool ReadStartTag(Aws::String& name, bool keepAttributes);
+                bool ReadEndTag();
+                bool SkipWhitespace();
+                bool SkipPast(const char* terminator, Aws::String* text);
+                bool ReadContent(Aws::String* text);
+                void PushElement(const Aws::String& name);
+
+                Aws::IStream* m_stream;
+                Aws::Vector<char> m_buffer;
+                const char* m_cursor;
+                const char* m_end;
+                //names of the elements entered, back to back, and where each of them starts
+                Aws::String m_elementPath;
+                Aws::Vector<size_t> m_elementOffsets;
+                Aws::String m_elementName;
+                Aws::Vector<std::pair<Aws::String, Aws::String>> m_attributes;
+                size_t m_attributeCount;
+                //NextChildElement returned true and the element hasn't been entered, read or skipped yet
+                bool m_elementPending;
+                //the last start tag read was an empty element tag (<a/>)
+                bool m_emptyElement;
+                //an empty element (<a/>) was entered, the next NextChildElement leaves it
+                bool m_enteredEmpty;
+                bool m_rootRead;
+                Aws::String m_scratch;
+                Aws::String m_errorMessage;
+            };
+
+        } // namespace Xml
+    } // namespace Utils
+} // namespace Aws
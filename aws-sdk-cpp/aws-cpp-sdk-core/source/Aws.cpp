@@ -14,6 +14,7 @@
 #include <aws/core/net/Net.h>
 #include <aws/core/config/AWSProfileConfigLoader.h>
 #include <aws/core/internal/AWSHttpResourceClient.h>
+#include <aws/core/utils/threading/BoundedThreadExecutor.h>
 
 namespace Aws
 {
@@ -104,10 +105,23 @@ namespace Aws
         Aws::Net::InitNetwork();
         Aws::Internal::InitEC2MetadataClient();
         Aws::Monitoring::InitMonitoring(options.monitoringOptions.customizedMonitoringFactory_create_fn);
+
+        if(options.executorOptions.defaultExecutor_create_fn)
+        {
+            Aws::Utils::Threading::InitDefaultExecutor(options.executorOptions.defaultExecutor_create_fn);
+        }
+        else
+        {
+            auto maxThreads = options.executorOptions.maxThreads > 0 ? options.executorOptions.maxThreads : Aws::Utils::Threading::BoundedThreadExecutor::GetDefaultMaxThreads();
+            auto sharedExecutor = Aws::MakeShared<Aws::Utils::Threading::BoundedThreadExecutor>(ALLOCATION_TAG,
+                    maxThreads, options.executorOptions.maxQueuedTasks, options.executorOptions.queueFullPolicy);
+            Aws::Utils::Threading::InitDefaultExecutor([sharedExecutor]() -> std::shared_ptr<Aws::Utils::Threading::Executor> { return sharedExecutor; });
+        }
     }
 
     void ShutdownAPI(const SDKOptions& options)
     {
+        Aws::Utils::Threading::CleanupDefaultExecutor();
         Aws::Monitoring::CleanupMonitoring();
         Aws::Internal::CleanupEC2MetadataClient();
         Aws::Net::CleanupNetwork();
@@ -7,6 +7,7 @@
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/http/FlatHeaderCollection.h>
 #include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/DateTime.h>
@@ -15,12 +16,15 @@
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
 #include <aws/core/utils/crypto/Sha256.h>
 #include <aws/core/utils/crypto/Sha256HMAC.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/crypto/Factories.h>
 #include <aws/core/utils/event/EventMessage.h>
 #include <aws/core/utils/event/EventHeader.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <math.h>
@@ -52,6 +56,10 @@ static const char* USER_AGENT = "user-agent";
 static const char* SIGNING_KEY = "AWS4";
 static const char* SIMPLE_DATE_FORMAT_STR = "%Y%m%d";
 static const char* EMPTY_STRING_SHA256 = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+static const char* STREAMING_PAYLOAD_CONTENT_SHA256 = "STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
+static const char* CONTENT_ENCODING = "content-encoding";
+static const char* AWS_CHUNKED = "aws-chunked";
+static const char* X_AMZ_DECODED_CONTENT_LENGTH = "x-amz-decoded-content-length";
 
 static const char v4LogTag[] = "AWSAuthV4Signer";
 static const char v4StreamingLogTag[] = "AWSAuthEventStreamV4Signer";
@@ -69,84 +77,264 @@ namespace Aws
     }
 }
 
-static Aws::String CanonicalizeRequestSigningString(HttpRequest& request, bool urlEscapePath)
+// Canonical requests larger than this (e.g. presigned urls with long query strings) don't keep their buffer alive.
+static const size_t MAX_RETAINED_CANONICAL_REQUEST_CAPACITY = 16 * 1024;
+
+// Most requests are signed by a handful of threads at a time, the pool doesn't keep more buffers than this.
+static const size_t MAX_RETAINED_CANONICAL_REQUEST_BUFFERS = 8;
+
+namespace
+{
+    /**
+     * Scratch buffer for assembling a canonical request, taken from the signer's pool emptied but with its capacity kept
+     * so that signing doesn't allocate for it once a request of similar size was signed, and given back when done.
+     */
+    class CanonicalRequestBuffer
+    {
+    public:
+        CanonicalRequestBuffer(std::mutex& lock, Aws::Vector<Aws::String>& pool) : m_lock(lock), m_pool(pool)
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (!m_pool.empty())
+            {
+                m_buffer.swap(m_pool.back());
+                m_pool.pop_back();
+            }
+            m_acquiredCapacity = m_buffer.capacity();
+        }
+
+        ~CanonicalRequestBuffer()
+        {
+            if (m_buffer.capacity() > MAX_RETAINED_CANONICAL_REQUEST_CAPACITY)
+            {
+                return;
+            }
+            // the pool outlives the request, a buffer grown during it is reallocated outside of its arena
+            Aws::Utils::Memory::RequestArenaSuspension suspension;
+            if (m_buffer.capacity() > m_acquiredCapacity)
+            {
+                Aws::String retained;
+                retained.reserve(m_buffer.capacity());
+                m_buffer.swap(retained);
+            }
+            m_buffer.clear();
+            std::lock_guard<std::mutex> locker(m_lock);
+            if (m_pool.size() < MAX_RETAINED_CANONICAL_REQUEST_BUFFERS)
+            {
+                m_pool.emplace_back();
+                m_pool.back().swap(m_buffer);
+            }
+        }
+
+        CanonicalRequestBuffer(const CanonicalRequestBuffer&) = delete;
+        CanonicalRequestBuffer& operator=(const CanonicalRequestBuffer&) = delete;
+
+        Aws::String& Get() { return m_buffer; }
+
+    private:
+        std::mutex& m_lock;
+        Aws::Vector<Aws::String>& m_pool;
+        Aws::String m_buffer;
+        size_t m_acquiredCapacity;
+    };
+}
+
+static bool IsCanonicalSpace(char ch)
+{
+    // same classification as StringUtils::Trim
+    int value = static_cast<int>(ch);
+    return value >= -1 && value <= 255 && ::isspace(value) != 0;
+}
+
+static void TrimRange(const char*& begin, const char*& end)
+{
+    while (begin < end && IsCanonicalSpace(*begin))
+    {
+        ++begin;
+    }
+    while (end > begin && IsCanonicalSpace(*(end - 1)))
+    {
+        --end;
+    }
+}
+
+/**
+ * Appends the method, path and query string lines of the canonical request, each followed by a newline.
+ */
+static void AppendCanonicalRequestSigningString(HttpRequest& request, bool urlEscapePath, Aws::String& out)
 {
     request.CanonicalizeRequest();
-    Aws::StringStream signingStringStream;
-    signingStringStream << HttpMethodMapper::GetNameForHttpMethod(request.GetMethod());
+    out.append(HttpMethodMapper::GetNameForHttpMethod(request.GetMethod()));
+    out.append(NEWLINE);
 
-    URI uriCpy = request.GetUri();
+    // only the path is needed from the uri, normalize it on a scratch uri rather than copying the request's.
+    URI pathUri;
     // Many AWS services do not decode the URL before calculating SignatureV4 on their end.
     // This results in the signature getting calculated with a double encoded URL.
     // That means we have to double encode it here for the signature to match on the service side.
     if(urlEscapePath)
     {
         // RFC3986 is how we encode the URL before sending it on the wire.
-        auto rfc3986EncodedPath = URI::URLEncodePathRFC3986(uriCpy.GetPath());
-        uriCpy.SetPath(rfc3986EncodedPath);
+        pathUri.SetPath(URI::URLEncodePathRFC3986(request.GetUri().GetPath()));
         // However, SignatureV4 uses this URL encoding scheme
-        signingStringStream << NEWLINE << uriCpy.GetURLEncodedPath() << NEWLINE;
+        out.append(pathUri.GetURLEncodedPath());
     }
     else
     {
         // For the services that DO decode the URL first; we don't need to double encode it.
-        uriCpy.SetPath(uriCpy.GetURLEncodedPath());
-        signingStringStream << NEWLINE << uriCpy.GetPath() << NEWLINE;
+        pathUri.SetPath(request.GetUri().GetURLEncodedPath());
+        out.append(pathUri.GetPath());
     }
+    out.append(NEWLINE);
 
-    if (request.GetQueryString().find('=') != std::string::npos)
+    const Aws::String& queryString = request.GetQueryString();
+    if (queryString.find('=') != std::string::npos)
     {
-        signingStringStream << request.GetQueryString().substr(1) << NEWLINE;
+        out.append(queryString, 1, Aws::String::npos);
     }
-    else if (request.GetQueryString().size() > 1)
+    else if (queryString.size() > 1)
     {
-        signingStringStream << request.GetQueryString().substr(1) << "=" << NEWLINE;
+        out.append(queryString, 1, Aws::String::npos);
+        out.append(EQ);
     }
-    else
+    out.append(NEWLINE);
+}
+
+/**
+ * Appends the canonical form of a header value: trimmed, multiple lines joined with commas and runs of spaces collapsed.
+ */
+static void AppendCanonicalHeaderValue(const Aws::String& value, Aws::String& out)
+{
+    const char* begin = value.c_str();
+    const char* end = begin + value.size();
+    TrimRange(begin, end);
+
+    bool firstLine = true;
+    while (begin < end)
     {
-        signingStringStream << NEWLINE;
+        const char* lineEnd = std::find(begin, end, '\n');
+        const char* lineBegin = begin;
+        begin = lineEnd == end ? end : lineEnd + 1;
+        //empty lines are skipped, the first line is only trimmed as part of the whole value.
+        if (lineBegin == lineEnd)
+        {
+            continue;
+        }
+        if (!firstLine)
+        {
+            TrimRange(lineBegin, lineEnd);
+            out.append(",");
+        }
+        firstLine = false;
+
+        //duplicate spaces need to be converted to one.
+        for (const char* c = lineBegin; c < lineEnd; ++c)
+        {
+            if (*c != ' ' || out.empty() || out.back() != ' ')
+            {
+                out.push_back(*c);
+            }
+        }
     }
+}
 
-    return signingStringStream.str();
+/**
+ * Returns the headers of the request, from the request itself when it keeps them in a FlatHeaderCollection, otherwise copied into copy.
+ */
+static const Http::FlatHeaderCollection& GetFlatHeaders(const HttpRequest& request, Http::FlatHeaderCollection& copy)
+{
+    const Http::FlatHeaderCollection* headers = request.GetFlatHeaders();
+    if (headers)
+    {
+        return *headers;
+    }
+    for (const auto& header : request.GetHeaders())
+    {
+        copy.Set(header.first, header.second);
+    }
+    return copy;
 }
 
-static Http::HeaderValueCollection CanonicalizeHeaders(Http::HeaderValueCollection&& headers)
+/**
+ * Appends "name:value\n" for every header that shouldSign accepts, in header name order.
+ */
+template<typename ShouldSign>
+static void AppendCanonicalHeaders(const Http::FlatHeaderCollection& headers, const ShouldSign& shouldSign, Aws::String& out)
 {
-    Http::HeaderValueCollection canonicalHeaders;
     for (const auto& header : headers)
     {
-        auto trimmedHeaderName = StringUtils::Trim(header.first.c_str());
-        auto trimmedHeaderValue = StringUtils::Trim(header.second.c_str());
-
-        //multiline gets converted to line1,line2,etc...
-        auto headerMultiLine = StringUtils::SplitOnLine(trimmedHeaderValue);
-        Aws::String headerValue = headerMultiLine.size() == 0 ? "" : headerMultiLine[0];
+        if (shouldSign(header))
+        {
+            const char* nameBegin = header.GetName();
+            const char* nameEnd = nameBegin + header.GetNameLength();
+            TrimRange(nameBegin, nameEnd);
+            out.append(nameBegin, nameEnd);
+            out.append(":");
+            AppendCanonicalHeaderValue(header.GetValue(), out);
+            out.append(NEWLINE);
+        }
+    }
+}
 
-        if (headerMultiLine.size() > 1)
+/**
+ * Returns the semicolon separated list of the names of the headers that shouldSign accepts.
+ */
+template<typename ShouldSign>
+static Aws::String GetSignedHeadersValue(const Http::FlatHeaderCollection& headers, const ShouldSign& shouldSign)
+{
+    Aws::String signedHeadersValue;
+    for (const auto& header : headers)
+    {
+        if (shouldSign(header))
         {
-            for(size_t i = 1; i < headerMultiLine.size(); ++i)
+            const char* nameBegin = header.GetName();
+            const char* nameEnd = nameBegin + header.GetNameLength();
+            TrimRange(nameBegin, nameEnd);
+            if (!signedHeadersValue.empty())
             {
-                headerValue += ",";
-                headerValue += StringUtils::Trim(headerMultiLine[i].c_str());
+                signedHeadersValue.append(";");
             }
+            signedHeadersValue.append(nameBegin, nameEnd);
         }
+    }
+    return signedHeadersValue;
+}
 
-        //duplicate spaces need to be converted to one.
-        Aws::String::iterator new_end =
-            std::unique(headerValue.begin(), headerValue.end(),
-                [=](char lhs, char rhs) { return (lhs == rhs) && (lhs == ' '); }
-        );
-        headerValue.erase(new_end, headerValue.end());
-
-        canonicalHeaders[trimmedHeaderName] = headerValue;
+/**
+ * Returns true if name, in any case, is one of the lower case names.
+ */
+template<typename Names>
+static bool ContainsHeaderName(const Names& lowerCaseNames, const char* name, size_t nameLength)
+{
+    for (const auto& lowerCaseName : lowerCaseNames)
+    {
+        if (lowerCaseName.size() == nameLength && std::equal(lowerCaseName.cbegin(), lowerCaseName.cend(), name,
+                [](char lhs, char rhs) { return lhs == static_cast<char>(::tolower(static_cast<unsigned char>(rhs))); }))
+        {
+            return true;
+        }
     }
+    return false;
+}
 
-    return canonicalHeaders;
+/**
+ * Appends the credential scope: date/region/service/aws4_request.
+ */
+static void AppendCredentialScope(const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName, Aws::String& out)
+{
+    out.append(simpleDate);
+    out.append("/");
+    out.append(region);
+    out.append("/");
+    out.append(serviceName);
+    out.append("/");
+    out.append(AWS4_REQUEST);
 }
 
 AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvider>& credentialsProvider,
     const char* serviceName, const Aws::String& region, PayloadSigningPolicy signingPolicy, bool urlEscapePath) :
     m_includeSha256HashHeader(true),
+    m_streamingPayloadChunkSize(Stream::AwsChunkedStreamBuf::DEFAULT_CHUNK_SIZE),
     m_credentialsProvider(credentialsProvider),
     m_serviceName(serviceName),
     m_region(region),
@@ -157,7 +345,11 @@ AWSAuthV4Signer::AWSAuthV4Signer(const std::shared_ptr<Auth::AWSCredentialsProvi
     m_urlEscapePath(urlEscapePath)
 {
     //go ahead and warm up the signing cache.
-    ComputeHash(credentialsProvider->GetAWSCredentials().GetAWSSecretKey(), DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR), region, m_serviceName);
+    m_currentSecretKey = credentialsProvider->GetAWSCredentials().GetAWSSecretKey();
+    m_currentDateStr = DateTime::CalculateGmtTimestampAsString(SIMPLE_DATE_FORMAT_STR);
+    m_currentRegion = m_region;
+    m_currentServiceName = m_serviceName;
+    m_partialSignature = ComputeHash(m_currentSecretKey, m_currentDateStr, m_currentRegion, m_currentServiceName);
 }
 
 AWSAuthV4Signer::~AWSAuthV4Signer()
@@ -168,7 +360,8 @@ AWSAuthV4Signer::~AWSAuthV4Signer()
 
 bool AWSAuthV4Signer::ShouldSignHeader(const Aws::String& header) const
 {
-    return m_unsignedHeaders.find(Aws::Utils::StringUtils::ToLower(header.c_str())) == m_unsignedHeaders.cend();
+    //compare in place rather than lower casing a copy of every header name, m_unsignedHeaders only holds a few entries.
+    return !ContainsHeaderName(m_unsignedHeaders, header.c_str(), header.size());
 }
 
 bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, const char* region, const char* serviceName, bool signBody) const
@@ -201,12 +394,25 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, const char* r
             break;
     }
 
+    Aws::String signingRegion = region ? region : m_region;
+    Aws::String signingServiceName = serviceName ? serviceName : m_serviceName;
+    bool streamingPayload = false;
+
     if(signBody || request.GetUri().GetScheme() != Http::Scheme::HTTPS)
     {
-        payloadHash = ComputePayloadHash(request);
-        if (payloadHash.empty())
+        if (request.GetContentSha256().empty() && PrepareStreamingPayload(request, signingServiceName))
         {
-            return false;
+            //the payload is hashed and signed chunk by chunk while it is sent instead of being read here first.
+            streamingPayload = true;
+            payloadHash = STREAMING_PAYLOAD_CONTENT_SHA256;
+        }
+        else
+        {
+            payloadHash = ComputePayloadHash(request);
+            if (payloadHash.empty())
+            {
+                return false;
+            }
         }
     }
     else
@@ -225,36 +431,22 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, const char* r
     Aws::String dateHeaderValue = now.ToGmtString(DateFormat::ISO_8601_BASIC);
     request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
+    auto shouldSign = [this](const Http::FlatHeaderCollection::Entry& header)
     {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4LogTag, "Canonical Header String: " << canonicalHeadersString);
+        return !ContainsHeaderName(m_unsignedHeaders, header.GetName(), header.GetNameLength());
+    };
+    Http::FlatHeaderCollection copiedHeaders;
+    const Http::FlatHeaderCollection& headers = GetFlatHeaders(request, copiedHeaders);
 
     //calculate signed headers parameter
-    Aws::String signedHeadersValue = signedHeadersStream.str();
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
-
+    Aws::String signedHeadersValue = GetSignedHeadersValue(headers, shouldSign);
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value:" << signedHeadersValue);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
-
-    //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
+    //generate generalized canonicalized request string, followed by the v4 stuff.
+    CanonicalRequestBuffer canonicalRequestBuffer(m_canonicalRequestBuffersLock, m_canonicalRequestBuffers);
+    Aws::String& canonicalRequestString = canonicalRequestBuffer.Get();
+    AppendCanonicalRequestSigningString(request, m_urlEscapePath, canonicalRequestString);
+    AppendCanonicalHeaders(headers, shouldSign, canonicalRequestString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -275,17 +467,62 @@ bool AWSAuthV4Signer::SignRequest(Aws::Http::HttpRequest& request, const char* r
     Aws::String canonicalRequestHash = HashingUtils::HexEncode(sha256Digest);
     Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
 
-    Aws::String signingRegion = region ? region : m_region;
-    Aws::String signingServiceName = serviceName ? serviceName : m_serviceName;
     Aws::String stringToSign = GenerateStringToSign(dateHeaderValue, simpleDate, canonicalRequestHash, signingRegion, signingServiceName);
     auto finalSignature = GenerateSignature(credentials, stringToSign, simpleDate, signingRegion, signingServiceName);
 
-    Aws::StringStream ss;
-    ss << AWS_HMAC_SHA256 << " " << CREDENTIAL << EQ << credentials.GetAWSAccessKeyId() << "/" << simpleDate
-        << "/" << signingRegion << "/" << signingServiceName << "/" << AWS4_REQUEST << ", " << SIGNED_HEADERS << EQ
-        << signedHeadersValue << ", " << SIGNATURE << EQ << finalSignature;
+    if (streamingPayload)
+    {
+        if (finalSignature.empty())
+        {
+            return false;
+        }
+
+        auto signingKey = GetSigningKey(credentials.GetAWSSecretKey(), simpleDate, signingRegion, signingServiceName);
+        Aws::String chunkStringToSignPrefix(EVENT_STREAM_PAYLOAD);
+        chunkStringToSignPrefix.append(NEWLINE);
+        chunkStringToSignPrefix.append(dateHeaderValue);
+        chunkStringToSignPrefix.append(NEWLINE);
+        AppendCredentialScope(simpleDate, signingRegion, signingServiceName, chunkStringToSignPrefix);
+        chunkStringToSignPrefix.append(NEWLINE);
+
+        auto body = request.GetContentBody();
+        auto chunkedBody = std::dynamic_pointer_cast<Stream::AwsChunkedStream>(body);
+        if (!chunkedBody && request.GetDataSentEventHandler())
+        {
+            //report body bytes rather than encoded bytes. Installed once, a re-signed request (retry) already has it.
+            auto onDataSent = request.GetDataSentEventHandler();
+            request.SetDataSentEventHandler([onDataSent](const Http::HttpRequest* sentRequest, long long amountSent)
+            {
+                auto sentBody = std::dynamic_pointer_cast<Stream::AwsChunkedStream>(sentRequest->GetContentBody());
+                long long decodedSent = sentBody ? static_cast<long long>(sentBody->TakeDecodedBytesRead()) : amountSent;
+                if (decodedSent > 0)
+                {
+                    onDataSent(sentRequest, decodedSent);
+                }
+            });
+        }
+        request.AddContentBody(Aws::MakeShared<Stream::AwsChunkedStream>(v4LogTag, chunkedBody ? chunkedBody->GetBody() : body,
+            CreateChunkSigner(signingKey, chunkStringToSignPrefix), finalSignature, m_streamingPayloadChunkSize));
+    }
+
+    Aws::String awsAuthString;
+    awsAuthString.reserve(256 + signedHeadersValue.size());
+    awsAuthString.append(AWS_HMAC_SHA256);
+    awsAuthString.append(" ");
+    awsAuthString.append(CREDENTIAL);
+    awsAuthString.append(EQ);
+    awsAuthString.append(credentials.GetAWSAccessKeyId());
+    awsAuthString.append("/");
+    AppendCredentialScope(simpleDate, signingRegion, signingServiceName, awsAuthString);
+    awsAuthString.append(", ");
+    awsAuthString.append(SIGNED_HEADERS);
+    awsAuthString.append(EQ);
+    awsAuthString.append(signedHeadersValue);
+    awsAuthString.append(", ");
+    awsAuthString.append(SIGNATURE);
+    awsAuthString.append(EQ);
+    awsAuthString.append(finalSignature);
 
-    auto awsAuthString = ss.str();
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signing request with: " << awsAuthString);
     request.SetAwsAuthorization(awsAuthString);
     request.SetSigningAccessKey(credentials.GetAWSAccessKeyId());
@@ -327,50 +564,36 @@ bool AWSAuthV4Signer::PresignRequest(Aws::Http::HttpRequest& request, const char
     Aws::String dateQueryValue = now.ToGmtString(DateFormat::ISO_8601_BASIC);
     request.AddQueryStringParameter(Http::AWS_DATE_HEADER, dateQueryValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
+    auto shouldSign = [this](const Http::FlatHeaderCollection::Entry& header)
     {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4LogTag, "Canonical Header String: " << canonicalHeadersString);
+        return !ContainsHeaderName(m_unsignedHeaders, header.GetName(), header.GetNameLength());
+    };
+    Http::FlatHeaderCollection copiedHeaders;
+    const Http::FlatHeaderCollection& headers = GetFlatHeaders(request, copiedHeaders);
 
     //calculate signed headers parameter
-    Aws::String signedHeadersValue(signedHeadersStream.str());
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
-
+    Aws::String signedHeadersValue = GetSignedHeadersValue(headers, shouldSign);
     request.AddQueryStringParameter(X_AMZ_SIGNED_HEADERS, signedHeadersValue);
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Signed Headers value: " << signedHeadersValue);
 
-    Aws::StringStream ss;
     Aws::String signingRegion = region ? region : m_region;
     Aws::String signingServiceName = serviceName ? serviceName : m_serviceName;
     Aws::String simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
-    ss << credentials.GetAWSAccessKeyId() << "/" << simpleDate
-        << "/" << signingRegion << "/" << signingServiceName << "/" << AWS4_REQUEST;
+    Aws::String credentialValue(credentials.GetAWSAccessKeyId());
+    credentialValue.append("/");
+    AppendCredentialScope(simpleDate, signingRegion, signingServiceName, credentialValue);
 
     request.AddQueryStringParameter(X_AMZ_ALGORITHM, AWS_HMAC_SHA256);
-    request.AddQueryStringParameter(X_AMZ_CREDENTIAL, ss.str());
-    ss.str("");
+    request.AddQueryStringParameter(X_AMZ_CREDENTIAL, credentialValue);
 
     request.SetSigningAccessKey(credentials.GetAWSAccessKeyId());
     request.SetSigningRegion(signingRegion);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, m_urlEscapePath);
-
-    //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
+    //generate generalized canonicalized request string, followed by the v4 stuff.
+    CanonicalRequestBuffer canonicalRequestBuffer(m_canonicalRequestBuffersLock, m_canonicalRequestBuffers);
+    Aws::String& canonicalRequestString = canonicalRequestBuffer.Get();
+    AppendCanonicalRequestSigningString(request, m_urlEscapePath, canonicalRequestString);
+    AppendCanonicalHeaders(headers, shouldSign, canonicalRequestString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -423,16 +646,124 @@ bool AWSAuthV4Signer::ServiceRequireUnsignedPayload(const Aws::String& serviceNa
 Aws::String AWSAuthV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign,
         const Aws::String& simpleDate, const Aws::String& region, const Aws::String& serviceName) const
 {
-    auto key = ComputeHash(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
+    auto key = GetSigningKey(credentials.GetAWSSecretKey(), simpleDate, region, serviceName);
+    if (key.GetLength() == 0)
+    {
+        return {};
+    }
     return GenerateSignature(stringToSign, key);
 }
 
+ByteBuffer AWSAuthV4Signer::GetSigningKey(const Aws::String& secretKey, const Aws::String& simpleDate,
+        const Aws::String& region, const Aws::String& serviceName) const
+{
+    Utils::Threading::ReaderLockGuard guard(m_partialSignatureLock);
+    if (secretKey != m_currentSecretKey || simpleDate != m_currentDateStr || region != m_currentRegion || serviceName != m_currentServiceName)
+    {
+        guard.UpgradeToWriterLock();
+        // the cached key outlives the request, it isn't allocated from its arena
+        Aws::Utils::Memory::RequestArenaSuspension suspension;
+        // double-checked lock to prevent updating twice
+        if (m_currentSecretKey != secretKey || m_currentDateStr != simpleDate || m_currentRegion != region || m_currentServiceName != serviceName)
+        {
+            auto key = ComputeHash(secretKey, simpleDate, region, serviceName);
+            if (key.GetLength() == 0)
+            {
+                return {};
+            }
+            m_currentSecretKey = secretKey;
+            m_currentDateStr = simpleDate;
+            m_currentRegion = region;
+            m_currentServiceName = serviceName;
+            m_partialSignature = std::move(key);
+        }
+    }
+    return m_partialSignature;
+}
+
+bool AWSAuthV4Signer::ServiceSupportsStreamingPayload(const Aws::String& serviceName) const
+{
+    // STREAMING-AWS4-HMAC-SHA256-PAYLOAD (aws-chunked content encoding) is only implemented by S3, see
+    // https://docs.aws.amazon.com/AmazonS3/latest/API/sigv4-streaming.html
+    return "s3" == serviceName;
+}
+
+bool AWSAuthV4Signer::PrepareStreamingPayload(Aws::Http::HttpRequest& request, const Aws::String& serviceName) const
+{
+    if (!m_includeSha256HashHeader || m_streamingPayloadChunkSize == 0 || !ServiceSupportsStreamingPayload(serviceName) ||
+        request.GetMethod() != HttpMethod::HTTP_PUT || !request.GetContentBody() || request.HasHeader(Http::TRANSFER_ENCODING_HEADER))
+    {
+        return false;
+    }
+
+    //a request that was signed before already carries the encoded body, its decoded length is in x-amz-decoded-content-length.
+    bool alreadyChunked = std::dynamic_pointer_cast<Stream::AwsChunkedStream>(request.GetContentBody()) != nullptr;
+    const char* decodedLengthHeader = alreadyChunked ? X_AMZ_DECODED_CONTENT_LENGTH : Http::CONTENT_LENGTH_HEADER;
+    if (!request.HasHeader(decodedLengthHeader))
+    {
+        return false;
+    }
+
+    long long decodedLength = StringUtils::ConvertToInt64(request.GetHeaderValue(decodedLengthHeader).c_str());
+    //small payloads are cheaper to hash up front than to send with the chunk signatures.
+    if (decodedLength < static_cast<long long>(m_streamingPayloadChunkSize))
+    {
+        return false;
+    }
+
+    if (!alreadyChunked)
+    {
+        Aws::String contentEncoding(AWS_CHUNKED);
+        if (request.HasHeader(CONTENT_ENCODING))
+        {
+            contentEncoding.append(",");
+            contentEncoding.append(request.GetHeaderValue(CONTENT_ENCODING));
+        }
+        request.SetHeaderValue(CONTENT_ENCODING, contentEncoding);
+        request.SetHeaderValue(X_AMZ_DECODED_CONTENT_LENGTH, StringUtils::to_string(decodedLength));
+        request.SetContentLength(StringUtils::to_string(
+            Stream::AwsChunkedStreamBuf::GetEncodedLength(static_cast<uint64_t>(decodedLength), m_streamingPayloadChunkSize)));
+    }
+    return true;
+}
+
+Stream::ChunkSigner AWSAuthV4Signer::CreateChunkSigner(const ByteBuffer& signingKey, const Aws::String& stringToSignPrefix)
+{
+    //the body is sent on another thread than the one signing the request, give it its own hash implementations.
+    std::shared_ptr<Crypto::Hash> hash = Crypto::CreateSha256Implementation();
+    std::shared_ptr<Crypto::HMAC> hmac = Crypto::CreateSha256HMACImplementation();
+
+    return [hash, hmac, signingKey, stringToSignPrefix](const Aws::String& priorSignature, const unsigned char* data, size_t length) -> Aws::String
+    {
+        hash->Update(data, length);
+        auto hashResult = hash->GetHash();
+        if (!hashResult.IsSuccess())
+        {
+            AWS_LOGSTREAM_ERROR(v4LogTag, "Failed to hash (sha256) payload chunk");
+            return {};
+        }
+
+        Aws::String stringToSign(stringToSignPrefix);
+        stringToSign.append(priorSignature);
+        stringToSign.append(NEWLINE);
+        stringToSign.append(EMPTY_STRING_SHA256);
+        stringToSign.append(NEWLINE);
+        stringToSign.append(HashingUtils::HexEncode(hashResult.GetResult()));
+
+        auto signatureResult = hmac->Calculate(ByteBuffer((unsigned char*)stringToSign.c_str(), stringToSign.length()), signingKey);
+        if (!signatureResult.IsSuccess())
+        {
+            AWS_LOGSTREAM_ERROR(v4LogTag, "Unable to hmac (sha256) payload chunk string to sign");
+            return {};
+        }
+        return HashingUtils::HexEncode(signatureResult.GetResult());
+    };
+}
+
 Aws::String AWSAuthV4Signer::GenerateSignature(const Aws::String& stringToSign, const ByteBuffer& key) const
 {
     AWS_LOGSTREAM_DEBUG(v4LogTag, "Final String to sign: " << stringToSign);
 
-    Aws::StringStream ss;
-
     auto hashResult = m_HMAC->Calculate(ByteBuffer((unsigned char*)stringToSign.c_str(), stringToSign.length()), key);
     if (!hashResult.IsSuccess())
     {
@@ -458,6 +789,12 @@ Aws::String AWSAuthV4Signer::ComputePayloadHash(Aws::Http::HttpRequest& request)
         return EMPTY_STRING_SHA256;
     }
 
+    if (!request.GetContentSha256().empty())
+    {
+        AWS_LOGSTREAM_DEBUG(v4LogTag, "Using sha256 " << request.GetContentSha256() << " computed along with the request's Content-MD5.");
+        return request.GetContentSha256();
+    }
+
     //compute hash on payload if it exists.
     auto hashResult =  m_hash->Calculate(*request.GetContentBody());
 
@@ -484,12 +821,17 @@ Aws::String AWSAuthV4Signer::GenerateStringToSign(const Aws::String& dateValue,
         const Aws::String& canonicalRequestHash, const Aws::String& region, const Aws::String& serviceName) const
 {
     //generate the actual string we will use in signing the final request.
-    Aws::StringStream ss;
-
-    ss << AWS_HMAC_SHA256 << NEWLINE << dateValue << NEWLINE << simpleDate << "/" << region << "/"
-        << serviceName << "/" << AWS4_REQUEST << NEWLINE << canonicalRequestHash;
-
-    return ss.str();
+    Aws::String stringToSign;
+    stringToSign.reserve(128 + region.size() + serviceName.size());
+    stringToSign.append(AWS_HMAC_SHA256);
+    stringToSign.append(NEWLINE);
+    stringToSign.append(dateValue);
+    stringToSign.append(NEWLINE);
+    AppendCredentialScope(simpleDate, region, serviceName, stringToSign);
+    stringToSign.append(NEWLINE);
+    stringToSign.append(canonicalRequestHash);
+
+    return stringToSign;
 }
 
 Aws::Utils::ByteBuffer AWSAuthV4Signer::ComputeHash(const Aws::String& secretKey,
@@ -566,36 +908,22 @@ bool AWSAuthEventStreamV4Signer::SignRequest(Aws::Http::HttpRequest& request, co
     Aws::String dateHeaderValue = now.ToGmtString(DateFormat::ISO_8601_BASIC);
     request.SetHeaderValue(AWS_DATE_HEADER, dateHeaderValue);
 
-    Aws::StringStream headersStream;
-    Aws::StringStream signedHeadersStream;
-
-    for (const auto& header : CanonicalizeHeaders(request.GetHeaders()))
+    auto shouldSign = [this](const Http::FlatHeaderCollection::Entry& header)
     {
-        if(ShouldSignHeader(header.first))
-        {
-            headersStream << header.first.c_str() << ":" << header.second.c_str() << NEWLINE;
-            signedHeadersStream << header.first.c_str() << ";";
-        }
-    }
-
-    Aws::String canonicalHeadersString = headersStream.str();
-    AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Canonical Header String: " << canonicalHeadersString);
+        return !ContainsHeaderName(m_unsignedHeaders, header.GetName(), header.GetNameLength());
+    };
+    Http::FlatHeaderCollection copiedHeaders;
+    const Http::FlatHeaderCollection& headers = GetFlatHeaders(request, copiedHeaders);
 
     //calculate signed headers parameter
-    Aws::String signedHeadersValue = signedHeadersStream.str();
-    //remove that last semi-colon
-    if (!signedHeadersValue.empty())
-    {
-        signedHeadersValue.pop_back();
-    }
-
+    Aws::String signedHeadersValue = GetSignedHeadersValue(headers, shouldSign);
     AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Signed Headers value:" << signedHeadersValue);
 
-    //generate generalized canonicalized request string.
-    Aws::String canonicalRequestString = CanonicalizeRequestSigningString(request, true/* m_urlEscapePath */);
-
-    //append v4 stuff to the canonical request string.
-    canonicalRequestString.append(canonicalHeadersString);
+    //generate generalized canonicalized request string, followed by the v4 stuff.
+    CanonicalRequestBuffer canonicalRequestBuffer(m_canonicalRequestBuffersLock, m_canonicalRequestBuffers);
+    Aws::String& canonicalRequestString = canonicalRequestBuffer.Get();
+    AppendCanonicalRequestSigningString(request, true/* m_urlEscapePath */, canonicalRequestString);
+    AppendCanonicalHeaders(headers, shouldSign, canonicalRequestString);
     canonicalRequestString.append(NEWLINE);
     canonicalRequestString.append(signedHeadersValue);
     canonicalRequestString.append(NEWLINE);
@@ -649,14 +977,34 @@ bool AWSAuthEventStreamV4Signer::SignEventMessage(Event::Message& message, Aws::
 {
     using Event::EventHeaderValue;
 
-    Aws::StringStream stringToSign;
-    stringToSign << EVENT_STREAM_PAYLOAD << NEWLINE;
+    int64_t signingTimeMillis = 0;
+    ByteBuffer signature;
+    if (!SignEncodedEventMessage(message.GetEventPayload().data(), message.GetEventPayload().size(), priorSignature, signingTimeMillis, signature))
+    {
+        return false;
+    }
+
+    message.InsertEventHeader(EVENTSTREAM_DATE_HEADER, EventHeaderValue(signingTimeMillis, EventHeaderValue::EventHeaderType::TIMESTAMP));
+    message.InsertEventHeader(EVENTSTREAM_SIGNATURE_HEADER, std::move(signature));
+    return true;
+}
+
+bool AWSAuthEventStreamV4Signer::SignEncodedEventMessage(const unsigned char* encodedMessage, size_t encodedMessageLength,
+        Aws::String& priorSignature, int64_t& signingTimeMillis, ByteBuffer& signature) const
+{
+    using Event::EventHeaderValue;
+
     const DateTime now = GetSigningTimestamp();
-    const auto simpleDate = now.ToGmtString(SIMPLE_DATE_FORMAT_STR);
-    stringToSign << now.ToGmtString(DateFormat::ISO_8601_BASIC) << NEWLINE
-        <<  simpleDate << "/" << m_region << "/"
-        << m_serviceName << "/aws4_request" << NEWLINE << priorSignature << NEWLINE;
+    const auto dateValue = now.ToGmtString(DateFormat::ISO_8601_BASIC);
+    // The credential scope date is the leading "%Y%m%d" of the ISO 8601 basic timestamp.
+    const auto simpleDate = dateValue.substr(0, 8);
 
+    Aws::String stringToSign;
+    stringToSign.reserve(256);
+    stringToSign.append(EVENT_STREAM_PAYLOAD).append(NEWLINE);
+    stringToSign.append(dateValue).append(NEWLINE);
+    stringToSign.append(simpleDate).append("/").append(m_region).append("/").append(m_serviceName).append("/aws4_request").append(NEWLINE);
+    stringToSign.append(priorSignature).append(NEWLINE);
 
     Aws::String nonSignatureHeaders;
     nonSignatureHeaders.push_back(char(sizeof(EVENTSTREAM_DATE_HEADER) - 1)); // length of the string
@@ -671,10 +1019,9 @@ bool AWSAuthEventStreamV4Signer::SignEventMessage(Event::Message& message, Aws::
         return false;
     }
 
-    const auto nonSignatureHeadersHash = hashOutcome.GetResult();
-    stringToSign << HashingUtils::HexEncode(nonSignatureHeadersHash) << NEWLINE;
+    stringToSign.append(HashingUtils::HexEncode(hashOutcome.GetResult())).append(NEWLINE);
 
-    if (message.GetEventPayload().empty())
+    if (encodedMessageLength == 0)
     {
         AWS_LOGSTREAM_WARN(v4StreamingLogTag, "Attempting to sign an empty message (no payload and no headers). "
                 "It is unlikely that this is the intended behavior.");
@@ -684,7 +1031,7 @@ bool AWSAuthEventStreamV4Signer::SignEventMessage(Event::Message& message, Aws::
         // use a preallocatedStreamBuf to avoid making a copy.
         // The Hashing API requires either Aws::String or IStream as input.
         // TODO: the hashing API should be accept 'unsigned char*' as input.
-        Utils::Stream::PreallocatedStreamBuf streamBuf(message.GetEventPayload().data(), message.GetEventPayload().size());
+        Utils::Stream::PreallocatedStreamBuf streamBuf(const_cast<unsigned char*>(encodedMessage), encodedMessageLength);
         Aws::IOStream payload(&streamBuf);
         hashOutcome = m_hash.Calculate(payload);
 
@@ -693,26 +1040,22 @@ bool AWSAuthEventStreamV4Signer::SignEventMessage(Event::Message& message, Aws::
             AWS_LOGSTREAM_ERROR(v4StreamingLogTag, "Failed to hash (sha256) non-signature headers.");
             return false;
         }
-        const auto payloadHash = hashOutcome.GetResult();
-        stringToSign << HashingUtils::HexEncode(payloadHash);
-        AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Payload hash  - " << HashingUtils::HexEncode(payloadHash));
+        const auto payloadHash = HashingUtils::HexEncode(hashOutcome.GetResult());
+        stringToSign.append(payloadHash);
+        AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Payload hash  - " << payloadHash);
     }
 
-    Utils::ByteBuffer finalSignatureDigest = GenerateSignature(m_credentialsProvider->GetAWSCredentials(), stringToSign.str(), simpleDate, m_region, m_serviceName);
-    const auto finalSignature = HashingUtils::HexEncode(finalSignatureDigest);
-    AWS_LOGSTREAM_DEBUG(v4StreamingLogTag, "Final computed signing hash: " << finalSignature);
-    priorSignature = finalSignature;
-
-    message.InsertEventHeader(EVENTSTREAM_DATE_HEADER, EventHeaderValue(now.Millis(), EventHeaderValue::EventHeaderType::TIMESTAMP));
-    message.InsertEventHeader(EVENTSTREAM_SIGNATURE_HEADER, std::move(finalSignatureDigest));
+    signature = GenerateSignature(m_credentialsProvider->GetAWSCredentials(), stringToSign, simpleDate, m_region, m_serviceName);
+    priorSignature = HashingUtils::HexEncode(signature);
+    signingTimeMillis = now.Millis();
 
-    AWS_LOGSTREAM_INFO(v4StreamingLogTag, "Event chunk final signature - " << finalSignature);
+    AWS_LOGSTREAM_INFO(v4StreamingLogTag, "Event chunk final signature - " << priorSignature);
     return true;
 }
 
 bool AWSAuthEventStreamV4Signer::ShouldSignHeader(const Aws::String& header) const
 {
-    return std::find(m_unsignedHeaders.cbegin(), m_unsignedHeaders.cend(), Aws::Utils::StringUtils::ToLower(header.c_str())) == m_unsignedHeaders.cend();
+    return !ContainsHeaderName(m_unsignedHeaders, header.c_str(), header.size());
 }
 
 Utils::ByteBuffer AWSAuthEventStreamV4Signer::GenerateSignature(const AWSCredentials& credentials, const Aws::String& stringToSign,
@@ -723,6 +1066,8 @@ Utils::ByteBuffer AWSAuthEventStreamV4Signer::GenerateSignature(const AWSCredent
     if (secretKey != m_currentSecretKey || simpleDate != m_currentDateStr)
     {
         guard.UpgradeToWriterLock();
+        // the cached key outlives the request, it isn't allocated from its arena
+        Aws::Utils::Memory::RequestArenaSuspension suspension;
         // double-checked lock to prevent updating twice
         if (m_currentDateStr != simpleDate || m_currentSecretKey != secretKey)
         {
@@ -23,6 +23,7 @@
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/xml/XmlSerializer.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/Globals.h>
 #include <aws/core/utils/EnumParseOverflowContainer.h>
@@ -213,12 +214,32 @@ bool AWSClient::AdjustClockSkew(HttpResponseOutcome& outcome, const char* signer
     return false;
 }
 
+/**
+ * With an ArenaMemorySystem, the request and its response are allocated from an arena released with the outcome.
+ */
+template<typename Attempt>
+static HttpResponseOutcome InRequestArena(const Attempt& attempt)
+{
+    Aws::Utils::Memory::RequestArenaScope requestArena;
+    return attempt();
+}
+
 HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const Aws::AmazonWebServiceRequest& request,
     HttpMethod method,
     const char* signerName,
     const char* signerRegionOverride,
     const char* signerServiceNameOverride) const
+{
+    return InRequestArena([&]() { return DoAttemptExhaustively(uri, request, method, signerName, signerRegionOverride, signerServiceNameOverride); });
+}
+
+HttpResponseOutcome AWSClient::DoAttemptExhaustively(const Aws::Http::URI& uri,
+    const Aws::AmazonWebServiceRequest& request,
+    HttpMethod method,
+    const char* signerName,
+    const char* signerRegionOverride,
+    const char* signerServiceNameOverride) const
 {
     if (!Aws::Utils::IsValidHost(uri.GetAuthority()))
     {
@@ -344,6 +365,16 @@ HttpResponseOutcome AWSClient::AttemptExhaustively(const Aws::Http::URI& uri,
     const char* requestName,
     const char* signerRegionOverride,
     const char* signerServiceNameOverride) const
+{
+    return InRequestArena([&]() { return DoAttemptExhaustively(uri, method, signerName, requestName, signerRegionOverride, signerServiceNameOverride); });
+}
+
+HttpResponseOutcome AWSClient::DoAttemptExhaustively(const Aws::Http::URI& uri,
+    HttpMethod method,
+    const char* signerName,
+    const char* requestName,
+    const char* signerRegionOverride,
+    const char* signerServiceNameOverride) const
 {
     if (!Aws::Utils::IsValidHost(uri.GetAuthority()))
     {
@@ -604,7 +635,7 @@ void AWSClient::AddHeadersToRequest(const std::shared_ptr<Aws::Http::HttpRequest
 }
 
 void AWSClient::AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpRequest>& httpRequest,
-    const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5, bool isChunked) const
+    const std::shared_ptr<Aws::IOStream>& body, bool needsContentMd5, bool isChunked, bool needsContentSha256) const
 {
     httpRequest->AddContentBody(body);
 
@@ -653,6 +684,28 @@ void AWSClient::AddContentBodyToRequest(const std::shared_ptr<Aws::Http::HttpReq
         AWS_LOGSTREAM_TRACE(AWS_CLIENT_LOG_TAG, "Found body, and content-md5 needs to be set" <<
             ", attempting to compute content-md5");
 
+        if (needsContentSha256)
+        {
+            //the signer is going to hash the payload as well, compute both digests in a single read of the body
+            //and hand the sha256 over to the signer so that it doesn't read the body again.
+            auto md5 = Aws::Utils::Crypto::CreateMD5Implementation();
+            auto sha256 = Aws::Utils::Crypto::CreateSha256Implementation();
+            if (HashingUtils::CalculateHashes(*body, {md5.get(), sha256.get()}))
+            {
+                auto md5HashResult = md5->GetHash();
+                if (md5HashResult.IsSuccess())
+                {
+                    httpRequest->SetHeaderValue(Http::CONTENT_MD5_HEADER, HashingUtils::Base64Encode(md5HashResult.GetResult()));
+                }
+                auto sha256HashResult = sha256->GetHash();
+                if (sha256HashResult.IsSuccess())
+                {
+                    httpRequest->SetContentSha256(HashingUtils::HexEncode(sha256HashResult.GetResult()));
+                }
+            }
+            return;
+        }
+
         //changing the internal state of the hash computation is not a logical state
         //change as far as constness goes for this class. Due to the platform specificness
         //of hash computations, we can't control the fact that computing a hash mutates
@@ -694,13 +747,15 @@ void AWSClient::BuildHttpRequest(const Aws::AmazonWebServiceRequest& request,
     }
     else
     {
-        AddContentBodyToRequest(httpRequest, request.GetBody(), request.ShouldComputeContentMd5(), request.IsStreaming() && request.IsChunked() && m_httpClient->SupportsChunkedTransferEncoding());
+        AddContentBodyToRequest(httpRequest, request.GetBody(), request.ShouldComputeContentMd5(), request.IsStreaming() && request.IsChunked() && m_httpClient->SupportsChunkedTransferEncoding(),
+            request.SignBody() || httpRequest->GetUri().GetScheme() != Http::Scheme::HTTPS);
     }
 
     // Pass along handlers for processing data sent/received in bytes
     httpRequest->SetDataReceivedEventHandler(request.GetDataReceivedEventHandler());
     httpRequest->SetDataSentEventHandler(request.GetDataSentEventHandler());
     httpRequest->SetContinueRequestHandle(request.GetContinueRequestHandler());
+    httpRequest->SetResponseBodySink(request.GetResponseBodySink());
 
     request.AddQueryStringParameters(httpRequest->GetUri());
 }
@@ -47,11 +47,13 @@ ClientConfiguration::ClientConfiguration() :
     lowSpeedLimit(1),
     proxyScheme(Aws::Http::Scheme::HTTP),
     proxyPort(0),
-    executor(Aws::MakeShared<Aws::Utils::Threading::DefaultExecutor>(CLIENT_CONFIG_TAG)),
+    executor(Aws::Utils::Threading::GetDefaultExecutor()),
     verifySSL(true),
     writeRateLimiter(nullptr),
     readRateLimiter(nullptr),
     httpLibOverride(Aws::Http::TransferLibType::DEFAULT_CLIENT),
+    version(Aws::Http::Version::HTTP_VERSION_2_0),
+    http2MaxConcurrentStreams(0),
     followRedirects(FollowRedirectsPolicy::DEFAULT),
     disableExpectHeader(false),
     enableClockSkewAdjustment(true),
@@ -221,7 +221,7 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             cJSON_Delete(item->child);
         }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        if (!(item->type & (cJSON_IsReference | cJSON_ArenaValue)) && (item->valuestring != NULL))
         {
             global_hooks.deallocate(item->valuestring);
         }
@@ -229,7 +229,10 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             global_hooks.deallocate(item->string);
         }
-        global_hooks.deallocate(item);
+        if (!(item->type & cJSON_ArenaItem))
+        {
+            global_hooks.deallocate(item);
+        }
         item = next;
     }
 }
@@ -2617,7 +2620,7 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
         goto fail;
     }
     /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    newitem->type = item->type & (~(cJSON_IsReference | cJSON_ArenaValue | cJSON_ArenaItem));
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring)
@@ -2630,7 +2633,16 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     }
     if (item->string)
     {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        /* a key in an arena goes away with its document, the copy needs its own */
+        if ((item->type & cJSON_StringIsConst) && !(item->type & cJSON_ArenaItem))
+        {
+            newitem->string = item->string;
+        }
+        else
+        {
+            newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+            newitem->type &= ~cJSON_StringIsConst;
+        }
         if (!newitem->string)
         {
             goto fail;
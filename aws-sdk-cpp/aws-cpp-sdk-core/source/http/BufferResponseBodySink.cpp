@@ -0,0 +1,39 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/http/BufferResponseBodySink.h>
+#include <aws/core/utils/logging/LogMacros.h>
+
+#include <cstring>
+
+using namespace Aws::Http;
+
+static const char* LOG_TAG = "BufferResponseBodySink";
+
+BufferResponseBodySink::BufferResponseBodySink(unsigned char* buffer, size_t capacity) :
+    m_buffer(buffer),
+    m_capacity(capacity),
+    m_length(0)
+{
+}
+
+ResponseBodySink BufferResponseBodySink::GetSink()
+{
+    return [this](const char* data, size_t length, uint64_t offset) { return Write(data, length, offset); };
+}
+
+bool BufferResponseBodySink::Write(const char* data, size_t length, uint64_t offset)
+{
+    if (offset > m_capacity || length > m_capacity - offset)
+    {
+        AWS_LOGSTREAM_ERROR(LOG_TAG, "Response body doesn't fit in the " << m_capacity << " bytes of the buffer.");
+        return false;
+    }
+
+    memcpy(m_buffer + offset, data, length);
+    //a retried request writes the body from the start again.
+    m_length = static_cast<size_t>(offset) + length;
+    return true;
+}
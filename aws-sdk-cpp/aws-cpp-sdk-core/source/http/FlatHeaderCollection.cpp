@@ -0,0 +1,267 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/http/FlatHeaderCollection.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace Aws::Http;
+
+namespace
+{
+    inline unsigned char ToLower(char ch)
+    {
+        unsigned char c = static_cast<unsigned char>(ch);
+        return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+    }
+
+    /**
+     * FNV-1a of the lower cased name.
+     */
+    uint32_t HashName(const char* name, size_t nameLength)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < nameLength; ++i)
+        {
+            hash ^= ToLower(name[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * Compares a lower case name with a name in any case, as Aws::String compares the lower cased names.
+     */
+    int CompareNames(const char* lowerCaseName, size_t lowerCaseNameLength, const char* name, size_t nameLength)
+    {
+        size_t length = (std::min)(lowerCaseNameLength, nameLength);
+        for (size_t i = 0; i < length; ++i)
+        {
+            unsigned char lhs = static_cast<unsigned char>(lowerCaseName[i]);
+            unsigned char rhs = ToLower(name[i]);
+            if (lhs != rhs)
+            {
+                return lhs < rhs ? -1 : 1;
+            }
+        }
+        return lowerCaseNameLength == nameLength ? 0 : (lowerCaseNameLength < nameLength ? -1 : 1);
+    }
+
+    struct InternedName
+    {
+        const char* name;
+        size_t length;
+        uint32_t hash;
+    };
+
+    /**
+     * Headers set on most requests or returned with most responses.
+     */
+    const char* const INTERNED_NAMES[] =
+    {
+        "accept",
+        "amz-sdk-invocation-id",
+        "amz-sdk-request",
+        "authorization",
+        "connection",
+        "content-encoding",
+        "content-length",
+        "content-md5",
+        "content-type",
+        "date",
+        "etag",
+        "expect",
+        "host",
+        "server",
+        "transfer-encoding",
+        "user-agent",
+        "x-amz-api-version",
+        "x-amz-content-sha256",
+        "x-amz-date",
+        "x-amz-id-2",
+        "x-amz-request-id",
+        "x-amz-security-token",
+        "x-amz-target",
+        "x-amzn-requestid",
+        "x-amzn-trace-id",
+    };
+
+    const size_t INTERNED_NAME_COUNT = sizeof(INTERNED_NAMES) / sizeof(INTERNED_NAMES[0]);
+
+    class InternedNames
+    {
+    public:
+        InternedNames()
+        {
+            for (size_t i = 0; i < INTERNED_NAME_COUNT; ++i)
+            {
+                m_names[i].name = INTERNED_NAMES[i];
+                m_names[i].length = strlen(INTERNED_NAMES[i]);
+                m_names[i].hash = HashName(m_names[i].name, m_names[i].length);
+            }
+        }
+
+        const InternedName* Find(uint32_t hash, const char* name, size_t nameLength) const
+        {
+            for (size_t i = 0; i < INTERNED_NAME_COUNT; ++i)
+            {
+                if (m_names[i].hash == hash && CompareNames(m_names[i].name, m_names[i].length, name, nameLength) == 0)
+                {
+                    return &m_names[i];
+                }
+            }
+            return nullptr;
+        }
+
+    private:
+        InternedName m_names[INTERNED_NAME_COUNT];
+    };
+
+    const InternedNames& GetInternedNames()
+    {
+        static const InternedNames internedNames;
+        return internedNames;
+    }
+}
+
+void FlatHeaderCollection::Set(const char* name, size_t nameLength, const char* value, size_t valueLength)
+{
+    uint32_t hash = HashName(name, nameLength);
+    size_t index = Lookup(hash, name, nameLength);
+    Entry& entry = index < m_size ? Data()[index] : Insert(hash, name, nameLength);
+    entry.m_value.assign(value, valueLength);
+}
+
+void FlatHeaderCollection::Set(const char* name, const Aws::String& value)
+{
+    Set(name, strlen(name), value.c_str(), value.size());
+}
+
+const Aws::String* FlatHeaderCollection::Find(const char* name, size_t nameLength) const
+{
+    size_t index = Lookup(HashName(name, nameLength), name, nameLength);
+    return index < m_size ? &Data()[index].m_value : nullptr;
+}
+
+const Aws::String* FlatHeaderCollection::Find(const char* name) const
+{
+    return Find(name, strlen(name));
+}
+
+bool FlatHeaderCollection::Erase(const char* name)
+{
+    size_t nameLength = strlen(name);
+    size_t index = Lookup(HashName(name, nameLength), name, nameLength);
+    if (index == m_size)
+    {
+        return false;
+    }
+
+    if (!m_spilled.empty())
+    {
+        m_spilled.erase(m_spilled.begin() + index);
+    }
+    else
+    {
+        Entry* last = m_inline + m_size;
+        std::move(m_inline + index + 1, last, m_inline + index);
+        //the emptied entry keeps the capacity of its strings for the next insertion.
+        Entry& removed = *(last - 1);
+        removed.m_internedName = nullptr;
+        removed.m_name.clear();
+        removed.m_value.clear();
+    }
+    --m_size;
+    return true;
+}
+
+void FlatHeaderCollection::Clear()
+{
+    m_spilled.clear();
+    for (size_t i = 0; i < INLINE_CAPACITY; ++i)
+    {
+        m_inline[i].m_internedName = nullptr;
+        m_inline[i].m_name.clear();
+        m_inline[i].m_value.clear();
+    }
+    m_size = 0;
+}
+
+HeaderValueCollection FlatHeaderCollection::ToHeaderValueCollection() const
+{
+    HeaderValueCollection headers;
+    for (const Entry& entry : *this)
+    {
+        //entries are sorted the way the map sorts them.
+        headers.emplace_hint(headers.end(), Aws::String(entry.GetName(), entry.GetNameLength()), entry.m_value);
+    }
+    return headers;
+}
+
+size_t FlatHeaderCollection::Lookup(uint32_t hash, const char* name, size_t nameLength) const
+{
+    const Entry* entries = Data();
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        if (entries[i].m_hash == hash && CompareNames(entries[i].GetName(), entries[i].GetNameLength(), name, nameLength) == 0)
+        {
+            return i;
+        }
+    }
+    return m_size;
+}
+
+FlatHeaderCollection::Entry& FlatHeaderCollection::Insert(uint32_t hash, const char* name, size_t nameLength)
+{
+    const Entry* entries = Data();
+    size_t position = 0;
+    while (position < m_size && CompareNames(entries[position].GetName(), entries[position].GetNameLength(), name, nameLength) < 0)
+    {
+        ++position;
+    }
+
+    Entry* entry = nullptr;
+    if (m_spilled.empty() && m_size < INLINE_CAPACITY)
+    {
+        std::move_backward(m_inline + position, m_inline + m_size, m_inline + m_size + 1);
+        entry = &m_inline[position];
+    }
+    else
+    {
+        if (m_spilled.empty())
+        {
+            m_spilled.reserve(INLINE_CAPACITY * 2);
+            std::move(m_inline, m_inline + m_size, std::back_inserter(m_spilled));
+            for (size_t i = 0; i < INLINE_CAPACITY; ++i)
+            {
+                m_inline[i].m_name.clear();
+                m_inline[i].m_value.clear();
+            }
+        }
+        entry = &*m_spilled.emplace(m_spilled.begin() + position);
+    }
+    ++m_size;
+
+    entry->m_hash = hash;
+    const InternedName* interned = GetInternedNames().Find(hash, name, nameLength);
+    if (interned)
+    {
+        entry->m_internedName = interned->name;
+        entry->m_internedNameLength = interned->length;
+        entry->m_name.clear();
+    }
+    else
+    {
+        entry->m_internedName = nullptr;
+        entry->m_name.resize(nameLength);
+        for (size_t i = 0; i < nameLength; ++i)
+        {
+            entry->m_name[i] = static_cast<char>(ToLower(name[i]));
+        }
+    }
+    return *entry;
+}
@@ -7,6 +7,7 @@
 
 #if ENABLE_CURL_CLIENT
 #include <aws/core/http/curl/CurlHttpClient.h>
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
 #include <signal.h>
 
 #elif ENABLE_WINDOWS_CLIENT
@@ -94,7 +95,15 @@ namespace Aws
                 }
 #endif // ENABLE_WINDOWS_IXML_HTTP_REQUEST_2_CLIENT
 #elif ENABLE_CURL_CLIENT
-                return Aws::MakeShared<CurlHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
+                switch (clientConfiguration.httpLibOverride)
+                {
+                    case TransferLibType::CURL_MULTI_CLIENT:
+                        AWS_LOGSTREAM_INFO(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, "Creating curl multi http client.");
+                        return Aws::MakeShared<CurlMultiHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
+
+                    default:
+                        return Aws::MakeShared<CurlHttpClient>(HTTP_CLIENT_FACTORY_ALLOCATION_TAG, clientConfiguration);
+                }
 #else
                 // When neither of these clients is enabled, gcc gives a warning (converted
                 // to error by -Werror) about the unused clientConfiguration parameter. We
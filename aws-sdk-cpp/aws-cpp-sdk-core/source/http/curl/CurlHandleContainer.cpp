@@ -5,58 +5,148 @@
 
 #include <aws/core/http/curl/CurlHandleContainer.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
+#include <aws/core/utils/StringUtils.h>
 
 #include <algorithm>
+#include <thread>
 
 using namespace Aws::Utils::Logging;
 using namespace Aws::Http;
 
 static const char* CURL_HANDLE_CONTAINER_TAG = "CurlHandleContainer";
+static const unsigned MAX_FREE_LIST_STRIPES = 16;
+
+//threads are assigned to free list stripes round robin the first time they touch a pool
+static std::atomic<unsigned> s_nextStripeSlot(0);
+static thread_local unsigned s_stripeSlot = s_nextStripeSlot++;
 
 
 CurlHandleContainer::CurlHandleContainer(unsigned maxSize, long httpRequestTimeout, long connectTimeout, bool enableTcpKeepAlive,
                                         unsigned long tcpKeepAliveIntervalMs, long lowSpeedTime, unsigned long lowSpeedLimit) :
-                m_maxPoolSize(maxSize), m_httpRequestTimeout(httpRequestTimeout), m_connectTimeout(connectTimeout), m_enableTcpKeepAlive(enableTcpKeepAlive),
-                m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime), m_lowSpeedLimit(lowSpeedLimit), m_poolSize(0)
+                m_share(curl_share_init()), m_maxPoolSize(maxSize), m_httpRequestTimeout(httpRequestTimeout), m_connectTimeout(connectTimeout),
+                m_enableTcpKeepAlive(enableTcpKeepAlive), m_tcpKeepAliveIntervalMs(tcpKeepAliveIntervalMs), m_lowSpeedTime(lowSpeedTime),
+                m_lowSpeedLimit(lowSpeedLimit), m_poolSize(0), m_idleCount(0), m_waitingThreads(0)
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Initializing CurlHandleContainer with size " << maxSize);
+
+    unsigned stripeCount = (std::max)(1u, (std::min)(std::thread::hardware_concurrency(), MAX_FREE_LIST_STRIPES));
+    stripeCount = (std::min)(stripeCount, (std::max)(1u, maxSize));
+    for (unsigned i = 0; i < stripeCount; ++i)
+    {
+        m_stripes.push_back(Aws::New<FreeListStripe>(CURL_HANDLE_CONTAINER_TAG));
+    }
+
+    if (m_share)
+    {
+        curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, &CurlHandleContainer::LockShareData);
+        curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, &CurlHandleContainer::UnlockShareData);
+        curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+    else
+    {
+        AWS_LOGSTREAM_WARN(CURL_HANDLE_CONTAINER_TAG, "curl_share_init failed, handles will not share DNS and TLS session caches.");
+    }
 }
 
 CurlHandleContainer::~CurlHandleContainer()
 {
     AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Cleaning up CurlHandleContainer.");
-    for (CURL* handle : m_handleContainer.ShutdownAndWait(m_poolSize))
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << handle);
-        curl_easy_cleanup(handle);
+        //wait for all acquired handles to be released.
+        std::unique_lock<std::mutex> locker(m_waitLock);
+        m_waitingThreads++;
+        m_handleAvailable.wait(locker, [this]() { return m_idleCount.load() == m_poolSize.load(); });
+        m_waitingThreads--;
+    }
+
+    for (auto stripe : m_stripes)
+    {
+        for (auto& idleHandles : stripe->idleHandlesByAuthority)
+        {
+            for (CURL* handle : idleHandles.second)
+            {
+                AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Cleaning up " << handle);
+                curl_easy_cleanup(handle);
+            }
+        }
+        Aws::Delete(stripe);
+    }
+
+    //only valid once no easy handle uses the share anymore
+    if (m_share)
+    {
+        curl_share_cleanup(m_share);
     }
 }
 
-CURL* CurlHandleContainer::AcquireCurlHandle()
+CURL* CurlHandleContainer::AcquireCurlHandle(const Aws::String& authority)
 {
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Attempting to acquire curl connection.");
 
-    if(!m_handleContainer.HasResourcesAvailable())
+    for (;;)
+    {
+        CURL* handle = TryAcquireCurlHandle(authority);
+        if (handle)
+        {
+            return handle;
+        }
+
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Waiting for one to be released.");
+        std::unique_lock<std::mutex> locker(m_waitLock);
+        m_waitingThreads++;
+        m_handleAvailable.wait(locker, [this]() { return m_idleCount.load() > 0 || m_poolSize.load() < m_maxPoolSize; });
+        m_waitingThreads--;
+        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
+    }
+}
+
+CURL* CurlHandleContainer::TryAcquireCurlHandle(const Aws::String& authority)
+{
+    // Prefer a handle that already talked to this authority, then a fresh one, then any idle handle.
+    CURL* handle = TryAcquireIdleCurlHandle(authority, true);
+    if (!handle)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "No current connections available in pool. Attempting to create new connections.");
-        CheckAndGrowPool();
+        handle = TryGrowPool();
+    }
+    if (!handle)
+    {
+        handle = TryAcquireIdleCurlHandle(authority, false);
     }
 
-    CURL* handle = m_handleContainer.Acquire();
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Connection has been released. Continuing.");
-    AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Returning connection handle " << handle);
+    if (handle)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Returning connection handle " << handle);
+    }
     return handle;
 }
 
-void CurlHandleContainer::ReleaseCurlHandle(CURL* handle)
+void CurlHandleContainer::ReleaseCurlHandle(CURL* handle, const Aws::String& authority)
 {
     if (handle)
     {
         curl_easy_reset(handle);
         SetDefaultOptionsOnHandle(handle);
         AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Releasing curl handle " << handle);
-        m_handleContainer.Release(handle);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Notified waiting threads.");
+
+        FreeListStripe& stripe = GetHomeStripe();
+        {
+            // the free lists outlive the request the handle was released from
+            Aws::Utils::Memory::RequestArenaSuspension suspension;
+            std::lock_guard<std::mutex> locker(stripe.lock);
+            stripe.idleHandlesByAuthority[authority].push_back(handle);
+            stripe.idleCount++;
+        }
+        m_idleCount++;
+
+        if (m_waitingThreads.load() > 0)
+        {
+            std::lock_guard<std::mutex> locker(m_waitLock);
+            m_handleAvailable.notify_one();
+            AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Notified waiting threads.");
+        }
     }
 }
 
@@ -69,28 +159,92 @@ void CurlHandleContainer::DestroyCurlHandle(CURL* handle)
 
     curl_easy_cleanup(handle);
     AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Destroy curl handle: " << handle);
+
+    // Other threads could be blocked waiting for a handle, the freed slot lets one of them create a new one.
+    m_poolSize--;
+    if (m_waitingThreads.load() > 0)
     {
-        std::lock_guard<std::mutex> locker(m_containerLock);
-        // Other threads could be blocked and waiting on m_handleContainer.Acquire()
-        // If the handle is not released back to the pool, it could create a deadlock
-        // Create a new handle and release that into the pool
-        handle = CreateCurlHandleInPool();
+        std::lock_guard<std::mutex> locker(m_waitLock);
+        m_handleAvailable.notify_one();
     }
-    if (handle)
+}
+
+Aws::String CurlHandleContainer::GetAuthorityKey(const char* scheme, const Aws::String& host, uint16_t port)
+{
+    Aws::String key(scheme);
+    key.append("://").append(host).append(":").append(Aws::Utils::StringUtils::to_string(port));
+    return key;
+}
+
+CURL* CurlHandleContainer::TryAcquireIdleCurlHandle(const Aws::String& authority, bool matchAuthority)
+{
+    if (m_idleCount.load() == 0)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "Created replacement handle and released to pool: " << handle);
+        return nullptr;
     }
+
+    const size_t stripeCount = m_stripes.size();
+    const size_t homeStripe = s_stripeSlot % stripeCount;
+    for (size_t i = 0; i < stripeCount; ++i)
+    {
+        FreeListStripe& stripe = *m_stripes[(homeStripe + i) % stripeCount];
+        if (stripe.idleCount.load() == 0)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> locker(stripe.lock);
+        auto idleHandles = matchAuthority ? stripe.idleHandlesByAuthority.find(authority) : stripe.idleHandlesByAuthority.begin();
+        if (idleHandles == stripe.idleHandlesByAuthority.end())
+        {
+            continue;
+        }
+
+        //lists are erased once empty, so whatever was found has a handle
+        CURL* handle = idleHandles->second.back();
+        idleHandles->second.pop_back();
+        if (idleHandles->second.empty())
+        {
+            stripe.idleHandlesByAuthority.erase(idleHandles);
+        }
+        stripe.idleCount--;
+        m_idleCount--;
+        return handle;
+    }
+
+    return nullptr;
 }
 
+CURL* CurlHandleContainer::TryGrowPool()
+{
+    unsigned poolSize = m_poolSize.load();
+    while (poolSize < m_maxPoolSize)
+    {
+        if (m_poolSize.compare_exchange_weak(poolSize, poolSize + 1))
+        {
+            CURL* handle = CreateCurlHandle();
+            if (!handle)
+            {
+                m_poolSize--;
+                return nullptr;
+            }
+
+            AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown to " << poolSize + 1);
+            return handle;
+        }
+    }
 
-CURL* CurlHandleContainer::CreateCurlHandleInPool()
+    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, already at max size.");
+    return nullptr;
+}
+
+CURL* CurlHandleContainer::CreateCurlHandle()
 {
     CURL* curlHandle = curl_easy_init();
 
     if (curlHandle)
     {
         SetDefaultOptionsOnHandle(curlHandle);
-        m_handleContainer.Release(curlHandle);
     }
     else
     {
@@ -99,39 +253,19 @@ CURL* CurlHandleContainer::CreateCurlHandleInPool()
     return curlHandle;
 }
 
-bool CurlHandleContainer::CheckAndGrowPool()
+CurlHandleContainer::FreeListStripe& CurlHandleContainer::GetHomeStripe()
 {
-    std::lock_guard<std::mutex> locker(m_containerLock);
-    if (m_poolSize < m_maxPoolSize)
-    {
-        unsigned multiplier = m_poolSize > 0 ? m_poolSize : 1;
-        unsigned amountToAdd = (std::min)(multiplier * 2, m_maxPoolSize - m_poolSize);
-        AWS_LOGSTREAM_DEBUG(CURL_HANDLE_CONTAINER_TAG, "attempting to grow pool size by " << amountToAdd);
-
-        unsigned actuallyAdded = 0;
-        for (unsigned i = 0; i < amountToAdd; ++i)
-        {
-            CURL* curlHandle = CreateCurlHandleInPool();
-
-            if (curlHandle)
-            {
-                ++actuallyAdded;
-            }
-            else
-            {
-                break;
-            }
-        }
-
-        AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool grown by " << actuallyAdded);
-        m_poolSize += actuallyAdded;
-
-        return actuallyAdded > 0;
-    }
+    return *m_stripes[s_stripeSlot % m_stripes.size()];
+}
 
-    AWS_LOGSTREAM_INFO(CURL_HANDLE_CONTAINER_TAG, "Pool cannot be grown any further, already at max size.");
+void CurlHandleContainer::LockShareData(CURL*, curl_lock_data data, curl_lock_access, void* userData)
+{
+    static_cast<CurlHandleContainer*>(userData)->m_shareLocks[data].lock();
+}
 
-    return false;
+void CurlHandleContainer::UnlockShareData(CURL*, curl_lock_data data, void* userData)
+{
+    static_cast<CurlHandleContainer*>(userData)->m_shareLocks[data].unlock();
 }
 
 void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
@@ -140,6 +274,10 @@ void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
     //always turn signals off. This also forces dns queries to
     //not be included in the timeout calculations.
     curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    if (m_share)
+    {
+        curl_easy_setopt(handle, CURLOPT_SHARE, m_share);
+    }
     curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, m_httpRequestTimeout);
     curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, m_connectTimeout);
     curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, m_lowSpeedLimit);
@@ -147,7 +285,4 @@ void CurlHandleContainer::SetDefaultOptionsOnHandle(CURL* handle)
     curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, m_enableTcpKeepAlive ? 1L : 0L);
     curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, m_tcpKeepAliveIntervalMs / 1000);
     curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, m_tcpKeepAliveIntervalMs / 1000);
-#ifdef CURL_HAS_H2
-    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
-#endif
 }
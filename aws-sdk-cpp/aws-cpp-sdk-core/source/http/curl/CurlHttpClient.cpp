@@ -8,6 +8,7 @@
 #include <aws/core/http/standard/StandardHttpResponse.h>
 #include <aws/core/utils/StringUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
 #include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
 #include <aws/core/utils/DateTime.h>
 #include <aws/core/monitoring/HttpClientMetrics.h>
@@ -27,9 +28,16 @@ using namespace Aws::Monitoring;
 static const char* MemTag = "libcurl";
 static size_t offset = sizeof(size_t);
 
+// connections, caches and options live as long as libcurl wants them to, not as long as the request being performed
+static void* CurlMalloc(size_t size)
+{
+    Aws::Utils::Memory::RequestArenaSuspension suspension;
+    return Aws::Malloc(MemTag, size);
+}
+
 static void* malloc_callback(size_t size)
 {
-    char* newMem = reinterpret_cast<char*>(Aws::Malloc(MemTag, size + offset));
+    char* newMem = reinterpret_cast<char*>(CurlMalloc(size + offset));
     std::size_t* pointerToSize = reinterpret_cast<std::size_t*>(newMem);
     *pointerToSize = size;
     return reinterpret_cast<void*>(newMem + offset);
@@ -61,7 +69,7 @@ static void* realloc_callback(void* ptr, size_t size)
     char* originalLenCharPtr = reinterpret_cast<char*>(ptr) - offset;
     size_t originalLen = *reinterpret_cast<size_t*>(originalLenCharPtr);
 
-    char* rawMemory = reinterpret_cast<char*>(Aws::Malloc(MemTag, size + offset));
+    char* rawMemory = reinterpret_cast<char*>(CurlMalloc(size + offset));
     if(rawMemory)
     {
         std::size_t* pointerToSize = reinterpret_cast<std::size_t*>(rawMemory);
@@ -86,7 +94,7 @@ static void* realloc_callback(void* ptr, size_t size)
 static void* calloc_callback(size_t nmemb, size_t size)
 {
     size_t dataSize = nmemb * size;
-    char* newMem = reinterpret_cast<char*>(Aws::Malloc(MemTag, dataSize + offset));
+    char* newMem = reinterpret_cast<char*>(CurlMalloc(dataSize + offset));
     std::size_t* pointerToSize = reinterpret_cast<std::size_t*>(newMem);
     *pointerToSize = dataSize;
 #ifdef _MSC_VER
@@ -102,7 +110,7 @@ static char* strdup_callback(const char* str)
 {
     size_t len = strlen(str) + 1;
     size_t newLen = len + offset;
-    char* newMem = reinterpret_cast<char*>(Aws::Malloc(MemTag, newLen));
+    char* newMem = reinterpret_cast<char*>(CurlMalloc(newLen));
 
     if(newMem)
     {
@@ -120,42 +128,18 @@ static char* strdup_callback(const char* str)
 
 #endif
 
-struct CurlWriteCallbackContext
-{
-    CurlWriteCallbackContext(const CurlHttpClient* client,
-                             HttpRequest* request,
-                             HttpResponse* response,
-                             Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter) :
-        m_client(client),
-        m_request(request),
-        m_response(response),
-        m_rateLimiter(rateLimiter),
-        m_numBytesResponseReceived(0)
-    {}
-
-    const CurlHttpClient* m_client;
-    HttpRequest* m_request;
-    HttpResponse* m_response;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    int64_t m_numBytesResponseReceived;
-};
-
-struct CurlReadCallbackContext
-{
-    CurlReadCallbackContext(const CurlHttpClient* client, HttpRequest* request, Aws::Utils::RateLimits::RateLimiterInterface* limiter) :
-        m_client(client),
-        m_rateLimiter(limiter),
-        m_request(request)
-    {}
-
-    const CurlHttpClient* m_client;
-    CURL* m_curlHandle;
-    Aws::Utils::RateLimits::RateLimiterInterface* m_rateLimiter;
-    HttpRequest* m_request;
-};
-
 static const char* CURL_HTTP_CLIENT_TAG = "CurlHttpClient";
 
+/**
+ * True if the body curl is receiving on the handle is the body of a 2xx response.
+ */
+static bool IsSuccessfulResponse(CURL* connectionHandle)
+{
+    long responseCode = 0;
+    return connectionHandle && curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode) == CURLE_OK &&
+        responseCode >= 200 && responseCode < 300;
+}
+
 static size_t WriteData(char* ptr, size_t size, size_t nmemb, void* userdata)
 {
     if (ptr)
@@ -172,13 +156,25 @@ static size_t WriteData(char* ptr, size_t size, size_t nmemb, void* userdata)
         size_t sizeToWrite = size * nmemb;
         if (context->m_rateLimiter)
         {
-            context->m_rateLimiter->ApplyAndPayForCost(static_cast<int64_t>(sizeToWrite));
+            client->PayForTransferCost(context->m_rateLimiter, static_cast<int64_t>(sizeToWrite), context->m_connectionHandle, CURLPAUSE_RECV);
         }
 
-        response->GetResponseBody().write(ptr, static_cast<std::streamsize>(sizeToWrite));
-        if (context->m_request->IsEventStreamRequest())
+        const ResponseBodySink& sink = context->m_request->GetResponseBodySink();
+        if (sink && IsSuccessfulResponse(context->m_connectionHandle))
         {
-            response->GetResponseBody().flush();
+            if (!sink(ptr, sizeToWrite, static_cast<uint64_t>(context->m_numBytesResponseReceived)))
+            {
+                AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Response body sink aborted the request.");
+                return 0;
+            }
+        }
+        else
+        {
+            response->GetResponseBody().write(ptr, static_cast<std::streamsize>(sizeToWrite));
+            if (context->m_request->IsEventStreamRequest())
+            {
+                response->GetResponseBody().flush();
+            }
         }
         auto& receivedHandler = context->m_request->GetDataReceivedEventHandler();
         if (receivedHandler)
@@ -254,7 +250,7 @@ static size_t ReadBody(char* ptr, size_t size, size_t nmemb, void* userdata)
 
         if (context->m_rateLimiter)
         {
-            context->m_rateLimiter->ApplyAndPayForCost(static_cast<int64_t>(amountRead));
+            client->PayForTransferCost(context->m_rateLimiter, static_cast<int64_t>(amountRead), context->m_connectionHandle, CURLPAUSE_SEND);
         }
 
         return amountRead;
@@ -305,6 +301,36 @@ static size_t SeekBody(void* userdata, curl_off_t offset, int origin)
     return CURL_SEEKFUNC_OK;
 }
 
+static long ConvertHttpVersion(Version version)
+{
+    switch (version)
+    {
+        case Version::HTTP_VERSION_1_0:
+            return CURL_HTTP_VERSION_1_0;
+        case Version::HTTP_VERSION_1_1:
+            return CURL_HTTP_VERSION_1_1;
+#ifdef CURL_HAS_H2
+        case Version::HTTP_VERSION_2_0:
+            return CURL_HTTP_VERSION_2_0;
+        case Version::HTTP_VERSION_2TLS:
+#if LIBCURL_VERSION_NUM >= 0x072F00
+            return CURL_HTTP_VERSION_2TLS;
+#else
+            return CURL_HTTP_VERSION_2_0;
+#endif
+        case Version::HTTP_VERSION_2_PRIOR_KNOWLEDGE:
+#if LIBCURL_VERSION_NUM >= 0x073100
+            return CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+#else
+            return CURL_HTTP_VERSION_2_0;
+#endif
+#endif //CURL_HAS_H2
+        default:
+            // without HTTP/2 support in libcurl, let it fall back to what it can do.
+            return CURL_HTTP_VERSION_NONE;
+    }
+}
+
 void SetOptCodeForHttpMethod(CURL* requestHandle, const std::shared_ptr<HttpRequest>& request)
 {
     switch (request->GetMethod())
@@ -385,6 +411,11 @@ void CurlHttpClient::CleanupGlobalState()
     curl_global_cleanup();
 }
 
+void CurlHttpClient::PayForTransferCost(Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter, int64_t cost, CURL*, int) const
+{
+    rateLimiter->ApplyAndPayForCost(cost);
+}
+
 Aws::String CurlInfoTypeToString(curl_infotype type)
 {
     switch(type)
@@ -445,7 +476,8 @@ CurlHttpClient::CurlHttpClient(const ClientConfiguration& clientConfig) :
     m_proxyKeyPasswd(clientConfig.proxySSLKeyPassword),
     m_proxyPort(clientConfig.proxyPort), m_verifySSL(clientConfig.verifySSL), m_caPath(clientConfig.caPath),
     m_caFile(clientConfig.caFile),
-    m_disableExpectHeader(clientConfig.disableExpectHeader)
+    m_disableExpectHeader(clientConfig.disableExpectHeader),
+    m_version(clientConfig.version)
 {
     if (clientConfig.followRedirects == FollowRedirectsPolicy::NEVER ||
        (clientConfig.followRedirects == FollowRedirectsPolicy::DEFAULT && clientConfig.region == Aws::Region::AWS_GLOBAL))
@@ -463,18 +495,62 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
     Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
     Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
 {
-    URI uri = request->GetUri();
-    Aws::String url = uri.GetURIString();
     std::shared_ptr<HttpResponse> response = Aws::MakeShared<StandardHttpResponse>(CURL_HTTP_CLIENT_TAG, request);
 
-    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << url);
-    struct curl_slist* headers = NULL;
+    AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Making request to " << request->GetURIString());
 
     if (writeLimiter != nullptr)
     {
         writeLimiter->ApplyAndPayForCost(request->GetSize());
     }
 
+    struct curl_slist* headers = CreateCurlHeaderList(request);
+
+    Aws::String authority = GetConnectionAuthority(*request);
+    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle(authority);
+
+    if (connectionHandle)
+    {
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
+
+        CurlWriteCallbackContext writeContext(this, request.get(), response.get(), readLimiter);
+        CurlReadCallbackContext readContext(this, request.get(), writeLimiter);
+
+        ConfigureConnectionHandle(connectionHandle, request, headers, writeContext, readContext);
+
+        Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
+        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
+        CompleteResponse(connectionHandle, curlResponseCode, request, response, writeContext, startTransmissionTime);
+
+        if (curlResponseCode != CURLE_OK)
+        {
+            m_curlHandleContainer.DestroyCurlHandle(connectionHandle);
+        }
+        else
+        {
+            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
+            m_curlHandleContainer.ReleaseCurlHandle(connectionHandle, authority);
+        }
+    }
+
+    if (headers)
+    {
+        curl_slist_free_all(headers);
+    }
+
+    return response;
+}
+
+Aws::String CurlHttpClient::GetConnectionAuthority(const HttpRequest& request)
+{
+    const URI& uri = request.GetUri();
+    return CurlHandleContainer::GetAuthorityKey(SchemeMapper::ToString(uri.GetScheme()), uri.GetAuthority(), uri.GetPort());
+}
+
+struct curl_slist* CurlHttpClient::CreateCurlHeaderList(const std::shared_ptr<HttpRequest>& request) const
+{
+    struct curl_slist* headers = NULL;
+
     Aws::StringStream headerStream;
     HeaderValueCollection requestHeaders = request->GetHeaders();
 
@@ -509,214 +585,201 @@ std::shared_ptr<HttpResponse> CurlHttpClient::MakeRequest(const std::shared_ptr<
         headers = curl_slist_append(headers, "Expect:");
     }
 
-    CURL* connectionHandle = m_curlHandleContainer.AcquireCurlHandle();
+    return headers;
+}
 
-    if (connectionHandle)
+void CurlHttpClient::ConfigureConnectionHandle(CURL* connectionHandle, const std::shared_ptr<HttpRequest>& request, struct curl_slist* headers,
+    CurlWriteCallbackContext& writeContext, CurlReadCallbackContext& readContext) const
+{
+    if (headers)
     {
-        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Obtained connection handle " << connectionHandle);
-
-        if (headers)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
-        }
-
-        CurlWriteCallbackContext writeContext(this, request.get(), response.get(), readLimiter);
-        CurlReadCallbackContext readContext(this, request.get(), writeLimiter);
+        curl_easy_setopt(connectionHandle, CURLOPT_HTTPHEADER, headers);
+    }
 
-        SetOptCodeForHttpMethod(connectionHandle, request);
+    SetOptCodeForHttpMethod(connectionHandle, request);
 
-        curl_easy_setopt(connectionHandle, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, WriteData);
-        curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, WriteHeader);
-        curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, &writeContext);
+    curl_easy_setopt(connectionHandle, CURLOPT_URL, request->GetURIString().c_str());
+    curl_easy_setopt(connectionHandle, CURLOPT_HTTP_VERSION, ConvertHttpVersion(m_version));
+    writeContext.m_connectionHandle = connectionHandle;
+    readContext.m_connectionHandle = connectionHandle;
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEFUNCTION, WriteData);
+    curl_easy_setopt(connectionHandle, CURLOPT_WRITEDATA, &writeContext);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERFUNCTION, WriteHeader);
+    curl_easy_setopt(connectionHandle, CURLOPT_HEADERDATA, &writeContext);
 
-        //we only want to override the default path if someone has explicitly told us to.
-        if(!m_caPath.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
-        }
-        if(!m_caFile.empty())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
-        }
+    //we only want to override the default path if someone has explicitly told us to.
+    if(!m_caPath.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, m_caPath.c_str());
+    }
+    if(!m_caFile.empty())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_CAINFO, m_caFile.c_str());
+    }
 
-	// only set by android test builds because the emulator is missing a cert needed for aws services
+// only set by android test builds because the emulator is missing a cert needed for aws services
 #ifdef TEST_CERT_PATH
-	curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
+    curl_easy_setopt(connectionHandle, CURLOPT_CAPATH, TEST_CERT_PATH);
 #endif // TEST_CERT_PATH
 
-        if (m_verifySSL)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
+    if (m_verifySSL)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 2L);
 
 #if LIBCURL_VERSION_MAJOR >= 7
 #if LIBCURL_VERSION_MINOR >= 34
-            curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1);
 #endif //LIBCURL_VERSION_MINOR
 #endif //LIBCURL_VERSION_MAJOR
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
-            curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
-        }
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(connectionHandle, CURLOPT_SSL_VERIFYHOST, 0L);
+    }
 
-        if (m_allowRedirects)
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
-        }
+    if (m_allowRedirects)
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 1L);
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_FOLLOWLOCATION, 0L);
+    }
 
 #ifdef ENABLE_CURL_LOGGING
-        curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
-        curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
+    curl_easy_setopt(connectionHandle, CURLOPT_VERBOSE, 1);
+    curl_easy_setopt(connectionHandle, CURLOPT_DEBUGFUNCTION, CurlDebugCallback);
 #endif
-        if (m_isUsingProxy)
+    if (m_isUsingProxy)
+    {
+        Aws::StringStream ss;
+        ss << m_proxyScheme << "://" << m_proxyHost;
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
+        if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
         {
-            Aws::StringStream ss;
-            ss << m_proxyScheme << "://" << m_proxyHost;
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, ss.str().c_str());
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPORT, (long) m_proxyPort);
-            if (!m_proxyUserName.empty() || !m_proxyPassword.empty())
-            {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
-            }
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYUSERNAME, m_proxyUserName.c_str());
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXYPASSWORD, m_proxyPassword.c_str());
+        }
 #ifdef CURL_HAS_TLS_PROXY
-            if (!m_proxySSLCertPath.empty())
-            {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
-                if (!m_proxySSLCertType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
-                }
-            }
-            if (!m_proxySSLKeyPath.empty())
+        if (!m_proxySSLCertPath.empty())
+        {
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERT, m_proxySSLCertPath.c_str());
+            if (!m_proxySSLCertType.empty())
             {
-                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
-                if (!m_proxySSLKeyType.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
-                }
-                if (!m_proxyKeyPasswd.empty())
-                {
-                    curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
-                }
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLCERTTYPE, m_proxySSLCertType.c_str());
             }
-#endif //CURL_HAS_TLS_PROXY
-        }
-        else
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
         }
-
-        if (request->GetContentBody())
-        {
-            curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
-            curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
-        }
-
-        OverrideOptionsOnConnectionHandle(connectionHandle);
-        Aws::Utils::DateTime startTransmissionTime = Aws::Utils::DateTime::Now();
-        CURLcode curlResponseCode = curl_easy_perform(connectionHandle);
-        bool shouldContinueRequest = ContinueRequest(*request);
-        if (curlResponseCode != CURLE_OK && shouldContinueRequest)
-        {
-            response->SetClientErrorType(CoreErrors::NETWORK_CONNECTION);
-            Aws::StringStream ss;
-            ss << "curlCode: " << curlResponseCode << ", " << curl_easy_strerror(curlResponseCode);
-            response->SetClientErrorMessage(ss.str());
-            AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode
-                    << " - " << curl_easy_strerror(curlResponseCode));
-        }
-        else if(!shouldContinueRequest)
-        {
-            response->SetClientErrorType(CoreErrors::USER_CANCELLED);
-            response->SetClientErrorMessage("Request cancelled by user's continuation handler");
-        }
-        else
+        if (!m_proxySSLKeyPath.empty())
         {
-            long responseCode;
-            curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
-            response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
-
-            char* contentType = nullptr;
-            curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
-            if (contentType)
+            curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEY, m_proxySSLKeyPath.c_str());
+            if (!m_proxySSLKeyType.empty())
             {
-                response->SetContentType(contentType);
-                AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_SSLKEYTYPE, m_proxySSLKeyType.c_str());
             }
-
-            if (request->GetMethod() != HttpMethod::HTTP_HEAD &&
-                writeContext.m_client->IsRequestProcessingEnabled() &&
-                response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
+            if (!m_proxyKeyPasswd.empty())
             {
-                const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
-                int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
-                AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
-                if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
-                {
-                    response->SetClientErrorType(CoreErrors::NETWORK_CONNECTION);
-                    response->SetClientErrorMessage("Response body length doesn't match the content-length header.");
-                    AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
-                }
+                curl_easy_setopt(connectionHandle, CURLOPT_PROXY_KEYPASSWD, m_proxyKeyPasswd.c_str());
             }
-
-            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Releasing curl handle " << connectionHandle);
         }
+#endif //CURL_HAS_TLS_PROXY
+    }
+    else
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_PROXY, "");
+    }
 
-        double timep;
-        CURLcode ret = curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME, &timep); // DNS Resolve Latency, seconds.
-        if (ret == CURLE_OK)
-        {
-            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::DnsLatency), static_cast<int64_t>(timep * 1000));// to milliseconds
-        }
+    if (request->GetContentBody())
+    {
+        curl_easy_setopt(connectionHandle, CURLOPT_READFUNCTION, ReadBody);
+        curl_easy_setopt(connectionHandle, CURLOPT_READDATA, &readContext);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKFUNCTION, SeekBody);
+        curl_easy_setopt(connectionHandle, CURLOPT_SEEKDATA, &readContext);
+    }
 
-        ret = curl_easy_getinfo(connectionHandle, CURLINFO_STARTTRANSFER_TIME, &timep); // Connect Latency
-        if (ret == CURLE_OK)
-        {
-            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectLatency), static_cast<int64_t>(timep * 1000));
-        }
+    OverrideOptionsOnConnectionHandle(connectionHandle);
+}
 
-        ret = curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME, &timep); // Ssl Latency
-        if (ret == CURLE_OK)
+void CurlHttpClient::CompleteResponse(CURL* connectionHandle, CURLcode curlResponseCode, const std::shared_ptr<HttpRequest>& request,
+    const std::shared_ptr<HttpResponse>& response, const CurlWriteCallbackContext& writeContext,
+    const Aws::Utils::DateTime& startTransmissionTime) const
+{
+    bool shouldContinueRequest = ContinueRequest(*request);
+    if (curlResponseCode != CURLE_OK && shouldContinueRequest)
+    {
+        response->SetClientErrorType(CoreErrors::NETWORK_CONNECTION);
+        Aws::StringStream ss;
+        ss << "curlCode: " << curlResponseCode << ", " << curl_easy_strerror(curlResponseCode);
+        response->SetClientErrorMessage(ss.str());
+        AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Curl returned error code " << curlResponseCode
+                << " - " << curl_easy_strerror(curlResponseCode));
+    }
+    else if(!shouldContinueRequest)
+    {
+        response->SetClientErrorType(CoreErrors::USER_CANCELLED);
+        response->SetClientErrorMessage("Request cancelled by user's continuation handler");
+    }
+    else
+    {
+        long responseCode;
+        curl_easy_getinfo(connectionHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+        response->SetResponseCode(static_cast<HttpResponseCode>(responseCode));
+        AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned http response code " << responseCode);
+
+        char* contentType = nullptr;
+        curl_easy_getinfo(connectionHandle, CURLINFO_CONTENT_TYPE, &contentType);
+        if (contentType)
         {
-            request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency), static_cast<int64_t>(timep * 1000));
+            response->SetContentType(contentType);
+            AWS_LOGSTREAM_DEBUG(CURL_HTTP_CLIENT_TAG, "Returned content type " << contentType);
         }
 
-        const char* ip = nullptr;
-        auto curlGetInfoResult = curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip); // Get the IP address of the remote endpoint
-        if (curlGetInfoResult == CURLE_OK && ip)
+        if (request->GetMethod() != HttpMethod::HTTP_HEAD &&
+            writeContext.m_client->IsRequestProcessingEnabled() &&
+            response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
         {
-            request->SetResolvedRemoteHost(ip);
-        }
-        if (curlResponseCode != CURLE_OK)
-        {
-            m_curlHandleContainer.DestroyCurlHandle(connectionHandle);
-        }
-        else
-        {
-            m_curlHandleContainer.ReleaseCurlHandle(connectionHandle);
+            const Aws::String& contentLength = response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER);
+            int64_t numBytesResponseReceived = writeContext.m_numBytesResponseReceived;
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response content-length header: " << contentLength);
+            AWS_LOGSTREAM_TRACE(CURL_HTTP_CLIENT_TAG, "Response body length: " << numBytesResponseReceived);
+            if (StringUtils::ConvertToInt64(contentLength.c_str()) != numBytesResponseReceived)
+            {
+                response->SetClientErrorType(CoreErrors::NETWORK_CONNECTION);
+                response->SetClientErrorMessage("Response body length doesn't match the content-length header.");
+                AWS_LOGSTREAM_ERROR(CURL_HTTP_CLIENT_TAG, "Response body length doesn't match the content-length header.");
+            }
         }
-        //go ahead and flush the response body stream
-        response->GetResponseBody().flush();
-        request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency), (DateTime::Now() - startTransmissionTime).count());
     }
 
-    if (headers)
+    double timep;
+    CURLcode ret = curl_easy_getinfo(connectionHandle, CURLINFO_NAMELOOKUP_TIME, &timep); // DNS Resolve Latency, seconds.
+    if (ret == CURLE_OK)
     {
-        curl_slist_free_all(headers);
+        request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::DnsLatency), static_cast<int64_t>(timep * 1000));// to milliseconds
     }
 
-    return response;
+    ret = curl_easy_getinfo(connectionHandle, CURLINFO_STARTTRANSFER_TIME, &timep); // Connect Latency
+    if (ret == CURLE_OK)
+    {
+        request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::ConnectLatency), static_cast<int64_t>(timep * 1000));
+    }
+
+    ret = curl_easy_getinfo(connectionHandle, CURLINFO_APPCONNECT_TIME, &timep); // Ssl Latency
+    if (ret == CURLE_OK)
+    {
+        request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::SslLatency), static_cast<int64_t>(timep * 1000));
+    }
+
+    const char* ip = nullptr;
+    auto curlGetInfoResult = curl_easy_getinfo(connectionHandle, CURLINFO_PRIMARY_IP, &ip); // Get the IP address of the remote endpoint
+    if (curlGetInfoResult == CURLE_OK && ip)
+    {
+        request->SetResolvedRemoteHost(ip);
+    }
+
+    //go ahead and flush the response body stream
+    response->GetResponseBody().flush();
+    request->AddRequestMetric(GetHttpClientMetricNameByType(HttpClientMetricsType::RequestLatency), (DateTime::Now() - startTransmissionTime).count());
 }
@@ -0,0 +1,465 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/http/curl/CurlMultiHttpClient.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/ratelimiter/RateLimiterInterface.h>
+#include <algorithm>
+#include <future>
+
+using namespace Aws::Client;
+using namespace Aws::Http;
+using namespace Aws::Http::Standard;
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* CURL_MULTI_HTTP_CLIENT_TAG = "CurlMultiHttpClient";
+
+// curl_multi_poll() and curl_multi_wakeup() let the event loop sleep until either a socket is ready or a new request is submitted.
+// Older versions of libcurl fall back to curl_multi_wait() with a short timeout so that submissions are still picked up promptly.
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define CURL_HAS_MULTI_WAKEUP 1
+static const int EVENT_LOOP_POLL_TIMEOUT_MS = 1000;
+#else
+static const int EVENT_LOOP_POLL_TIMEOUT_MS = 5;
+#endif
+
+// HTTP/2 stream multiplexing on the multi handle needs CURLPIPE_MULTIPLEX and CURLOPT_PIPEWAIT, both added in libcurl 7.43.0.
+#if defined(CURL_HAS_H2) && LIBCURL_VERSION_NUM >= 0x072B00
+#define CURL_HAS_MULTIPLEX 1
+#endif
+
+static bool IsHttp2Version(Version version)
+{
+    return version == Version::HTTP_VERSION_2_0 || version == Version::HTTP_VERSION_2TLS || version == Version::HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+}
+
+struct CurlMultiHttpClient::CurlMultiTransfer
+{
+    CurlMultiTransfer(const CurlMultiHttpClient* client,
+                      const std::shared_ptr<HttpRequest>& transferRequest,
+                      const HttpResponseReceivedHandler& responseHandler,
+                      Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+                      Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) :
+        request(transferRequest),
+        authority(GetConnectionAuthority(*transferRequest)),
+        response(Aws::MakeShared<StandardHttpResponse>(CURL_MULTI_HTTP_CLIENT_TAG, transferRequest)),
+        handler(responseHandler),
+        headers(nullptr),
+        connectionHandle(nullptr),
+        writeContext(client, transferRequest.get(), response.get(), readLimiter),
+        readContext(client, transferRequest.get(), writeLimiter),
+        startTransmissionTime(DateTime::Now())
+    {}
+
+    std::shared_ptr<HttpRequest> request;
+    Aws::String authority;
+    std::shared_ptr<HttpResponse> response;
+    HttpResponseReceivedHandler handler;
+    struct curl_slist* headers;
+    CURL* connectionHandle;
+    CurlWriteCallbackContext writeContext;
+    CurlReadCallbackContext readContext;
+    DateTime startTransmissionTime;
+};
+
+CurlMultiHttpClient::CurlMultiHttpClient(const ClientConfiguration& clientConfig, unsigned maxRequestsInFlight) :
+    Base(clientConfig),
+    m_multiHandle(curl_multi_init()),
+    m_transferHandles(maxRequestsInFlight, clientConfig.httpRequestTimeoutMs, clientConfig.connectTimeoutMs, clientConfig.enableTcpKeepAlive,
+                      clientConfig.tcpKeepAliveIntervalMs, clientConfig.requestTimeoutMs, clientConfig.lowSpeedLimit),
+    m_multiplexing(false),
+    m_continue(true)
+{
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Initializing curl multi handle with at most " << maxRequestsInFlight
+            << " requests in flight over " << clientConfig.maxConnections << " connections.");
+#if LIBCURL_VERSION_NUM >= 0x071E00
+    curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(clientConfig.maxConnections));
+#endif
+#ifdef CURL_HAS_MULTIPLEX
+    if (IsHttp2Version(clientConfig.version))
+    {
+        m_multiplexing = curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX) == CURLM_OK;
+#if LIBCURL_VERSION_NUM >= 0x074300
+        if (m_multiplexing && clientConfig.http2MaxConcurrentStreams > 0)
+        {
+            curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(clientConfig.http2MaxConcurrentStreams));
+        }
+#endif
+        AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "HTTP/2 stream multiplexing " << (m_multiplexing ? "enabled." : "is not supported by libcurl."));
+    }
+#endif
+    m_eventLoopThread = std::thread(&CurlMultiHttpClient::EventLoop, this);
+}
+
+CurlMultiHttpClient::~CurlMultiHttpClient()
+{
+    AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, "Shutting down curl multi event loop.");
+    {
+        std::lock_guard<std::mutex> locker(m_pendingTransfersLock);
+        m_continue = false;
+    }
+    WakeEventLoop();
+    if (m_eventLoopThread.joinable())
+    {
+        m_eventLoopThread.join();
+    }
+    curl_multi_cleanup(m_multiHandle);
+}
+
+std::shared_ptr<HttpResponse> CurlMultiHttpClient::MakeRequest(const std::shared_ptr<HttpRequest>& request,
+    Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+    Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    if (request->IsEventStreamRequest())
+    {
+        return Base::MakeRequest(request, readLimiter, writeLimiter);
+    }
+
+    if (IsEventLoopThread())
+    {
+        AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "MakeRequest called from a response handler would wait on the event loop running it forever, "
+                "use MakeRequestAsync instead.");
+        auto response = Aws::MakeShared<StandardHttpResponse>(CURL_MULTI_HTTP_CLIENT_TAG, request);
+        response->SetClientErrorType(CoreErrors::INVALID_ACTION);
+        response->SetClientErrorMessage("Synchronous requests can't be made from the event loop thread of the http client");
+        return response;
+    }
+
+    std::promise<std::shared_ptr<HttpResponse>> responsePromise;
+    MakeRequestAsync(request, [&responsePromise](const std::shared_ptr<HttpRequest>&, const std::shared_ptr<HttpResponse>& response)
+        {
+            responsePromise.set_value(response);
+        }, readLimiter, writeLimiter);
+
+    return responsePromise.get_future().get();
+}
+
+void CurlMultiHttpClient::MakeRequestAsync(const std::shared_ptr<HttpRequest>& request,
+    const HttpResponseReceivedHandler& handler,
+    Aws::Utils::RateLimits::RateLimiterInterface* readLimiter,
+    Aws::Utils::RateLimits::RateLimiterInterface* writeLimiter) const
+{
+    if (request->IsEventStreamRequest())
+    {
+        // The event stream body reader blocks waiting for the next event, which would stall every other transfer on the loop.
+        AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Making event stream request synchronously on the calling thread.");
+        HttpClient::MakeRequestAsync(request, handler, readLimiter, writeLimiter);
+        return;
+    }
+
+    AWS_LOGSTREAM_TRACE(CURL_MULTI_HTTP_CLIENT_TAG, "Submitting request to " << request->GetURIString());
+
+    if (writeLimiter != nullptr)
+    {
+        if (IsEventLoopThread())
+        {
+            // Submitted from a response handler, the upload pays for it by being paused instead of sleeping on the loop.
+            writeLimiter->ApplyCost(request->GetSize());
+        }
+        else
+        {
+            writeLimiter->ApplyAndPayForCost(request->GetSize());
+        }
+    }
+
+    CurlMultiTransfer* transfer = Aws::New<CurlMultiTransfer>(CURL_MULTI_HTTP_CLIENT_TAG, this, request, handler, readLimiter, writeLimiter);
+    transfer->headers = CreateCurlHeaderList(request);
+
+    {
+        std::lock_guard<std::mutex> locker(m_pendingTransfersLock);
+        if (m_continue)
+        {
+            m_pendingTransfers.push_back(transfer);
+            transfer = nullptr;
+        }
+    }
+
+    if (transfer)
+    {
+        AWS_LOGSTREAM_WARN(CURL_MULTI_HTTP_CLIENT_TAG, "Request submitted after the event loop was shut down.");
+        CancelTransfer(transfer);
+        return;
+    }
+
+    WakeEventLoop();
+}
+
+void CurlMultiHttpClient::PayForTransferCost(Aws::Utils::RateLimits::RateLimiterInterface* rateLimiter, int64_t cost,
+    CURL* connectionHandle, int direction) const
+{
+    if (!connectionHandle || !IsEventLoopThread())
+    {
+        // Event stream requests are made synchronously on the calling thread, which is free to sleep.
+        Base::PayForTransferCost(rateLimiter, cost, connectionHandle, direction);
+        return;
+    }
+
+    auto delay = rateLimiter->ApplyCost(cost);
+    if (delay.count() <= 0)
+    {
+        return;
+    }
+
+    PausedTransfer& pausedTransfer = m_pausedTransfers[connectionHandle];
+    const auto resumeTime = std::chrono::steady_clock::now() + delay;
+    (direction == CURLPAUSE_RECV ? pausedTransfer.recvResumeTime : pausedTransfer.sendResumeTime) = resumeTime;
+    pausedTransfer.directions |= direction;
+    AWS_LOGSTREAM_TRACE(CURL_MULTI_HTTP_CLIENT_TAG, "Pausing connection handle " << connectionHandle << " for " << delay.count() << " ms.");
+    curl_easy_pause(connectionHandle, pausedTransfer.directions);
+}
+
+bool CurlMultiHttpClient::IsEventLoopThread() const
+{
+    return std::this_thread::get_id() == m_eventLoopThread.get_id();
+}
+
+int CurlMultiHttpClient::ResumePausedTransfers()
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto pausedTransfer = m_pausedTransfers.begin(); pausedTransfer != m_pausedTransfers.end();)
+    {
+        int directions = pausedTransfer->second.directions;
+        if ((directions & CURLPAUSE_RECV) && pausedTransfer->second.recvResumeTime <= now)
+        {
+            directions &= ~CURLPAUSE_RECV;
+        }
+        if ((directions & CURLPAUSE_SEND) && pausedTransfer->second.sendResumeTime <= now)
+        {
+            directions &= ~CURLPAUSE_SEND;
+        }
+        if (directions == pausedTransfer->second.directions)
+        {
+            ++pausedTransfer;
+            continue;
+        }
+
+        CURL* connectionHandle = pausedTransfer->first;
+        pausedTransfer->second.directions = directions;
+        pausedTransfer = directions ? std::next(pausedTransfer) : m_pausedTransfers.erase(pausedTransfer);
+        // Unpausing may deliver buffered data right away, whose callback can pause the transfer again.
+        curl_easy_pause(connectionHandle, directions);
+    }
+
+    // Wake up in time to resume the next transfer.
+    int pollTimeoutMs = EVENT_LOOP_POLL_TIMEOUT_MS;
+    now = std::chrono::steady_clock::now();
+    for (const auto& pausedTransfer : m_pausedTransfers)
+    {
+        for (int direction : {CURLPAUSE_RECV, CURLPAUSE_SEND})
+        {
+            if (pausedTransfer.second.directions & direction)
+            {
+                const auto resumeTime = direction == CURLPAUSE_RECV ? pausedTransfer.second.recvResumeTime : pausedTransfer.second.sendResumeTime;
+                const int64_t remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(resumeTime - now).count() + 1;
+                pollTimeoutMs = static_cast<int>((std::min)(static_cast<int64_t>(pollTimeoutMs), (std::max)(remainingMs, static_cast<int64_t>(1))));
+            }
+        }
+    }
+    return pollTimeoutMs;
+}
+
+void CurlMultiHttpClient::WakeEventLoop() const
+{
+    m_pendingTransfersSignal.notify_one();
+#ifdef CURL_HAS_MULTI_WAKEUP
+    curl_multi_wakeup(m_multiHandle);
+#endif
+}
+
+void CurlMultiHttpClient::EventLoop()
+{
+    AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Curl multi event loop started.");
+    while (m_continue)
+    {
+        if (m_activeTransfers.empty() && m_queuedTransfers.empty())
+        {
+            std::unique_lock<std::mutex> locker(m_pendingTransfersLock);
+            m_pendingTransfersSignal.wait(locker, [this]() { return !m_continue || !m_pendingTransfers.empty(); });
+        }
+
+        AddPendingTransfers();
+
+        int runningHandles = 0;
+        CURLMcode multiCode = curl_multi_perform(m_multiHandle, &runningHandles);
+        if (multiCode != CURLM_OK)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "curl_multi_perform returned error code " << multiCode
+                    << " - " << curl_multi_strerror(multiCode));
+        }
+
+        ProcessCompletedTransfers();
+
+        if (!m_activeTransfers.empty())
+        {
+            const int pollTimeoutMs = m_pausedTransfers.empty() ? EVENT_LOOP_POLL_TIMEOUT_MS : ResumePausedTransfers();
+            int numFds = 0;
+#ifdef CURL_HAS_MULTI_WAKEUP
+            curl_multi_poll(m_multiHandle, nullptr, 0, pollTimeoutMs, &numFds);
+#else
+            curl_multi_wait(m_multiHandle, nullptr, 0, pollTimeoutMs, &numFds);
+#endif
+        }
+    }
+
+    Aws::Deque<CurlMultiTransfer*> pendingTransfers;
+    {
+        std::lock_guard<std::mutex> locker(m_pendingTransfersLock);
+        pendingTransfers.swap(m_pendingTransfers);
+    }
+    for (auto transfer : pendingTransfers)
+    {
+        CancelTransfer(transfer);
+    }
+    for (auto transfer : m_queuedTransfers)
+    {
+        CancelTransfer(transfer);
+    }
+    m_queuedTransfers.clear();
+    for (auto& activeTransfer : m_activeTransfers)
+    {
+        curl_multi_remove_handle(m_multiHandle, activeTransfer.first);
+        m_transferHandles.DestroyCurlHandle(activeTransfer.first);
+        CancelTransfer(activeTransfer.second);
+    }
+    m_activeTransfers.clear();
+    m_pausedTransfers.clear();
+    AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Curl multi event loop stopped.");
+}
+
+void CurlMultiHttpClient::AddPendingTransfers()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_pendingTransfersLock);
+        m_queuedTransfers.insert(m_queuedTransfers.end(), m_pendingTransfers.begin(), m_pendingTransfers.end());
+        m_pendingTransfers.clear();
+    }
+
+    while (!m_queuedTransfers.empty())
+    {
+        CURL* connectionHandle = m_transferHandles.TryAcquireCurlHandle(m_queuedTransfers.front()->authority);
+        if (!connectionHandle)
+        {
+            AWS_LOGSTREAM_TRACE(CURL_MULTI_HTTP_CLIENT_TAG, m_queuedTransfers.size() << " requests waiting for a transfer slot.");
+            break;
+        }
+
+        CurlMultiTransfer* transfer = m_queuedTransfers.front();
+        m_queuedTransfers.pop_front();
+        transfer->connectionHandle = connectionHandle;
+
+        ConfigureConnectionHandle(connectionHandle, transfer->request, transfer->headers, transfer->writeContext, transfer->readContext);
+#ifdef CURL_HAS_MULTIPLEX
+        if (m_multiplexing)
+        {
+            if (m_http1Authorities.find(transfer->authority) != m_http1Authorities.end())
+            {
+                curl_easy_setopt(connectionHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+            }
+            else
+            {
+                // Wait for a connection that may multiplex this transfer rather than opening a new one right away.
+                curl_easy_setopt(connectionHandle, CURLOPT_PIPEWAIT, 1L);
+            }
+        }
+#endif
+        transfer->startTransmissionTime = DateTime::Now();
+
+        CURLMcode multiCode = curl_multi_add_handle(m_multiHandle, connectionHandle);
+        if (multiCode != CURLM_OK)
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "curl_multi_add_handle returned error code " << multiCode
+                    << " - " << curl_multi_strerror(multiCode));
+            FinishTransfer(transfer, CURLE_FAILED_INIT);
+            continue;
+        }
+
+        AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Added connection handle " << connectionHandle << " to the event loop.");
+        m_activeTransfers[connectionHandle] = transfer;
+    }
+}
+
+void CurlMultiHttpClient::ProcessCompletedTransfers()
+{
+    int messagesInQueue = 0;
+    while (CURLMsg* message = curl_multi_info_read(m_multiHandle, &messagesInQueue))
+    {
+        if (message->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+
+        // message is invalidated by curl_multi_remove_handle(), so copy out what is needed first.
+        CURL* connectionHandle = message->easy_handle;
+        CURLcode curlResponseCode = message->data.result;
+
+        auto activeTransfer = m_activeTransfers.find(connectionHandle);
+        if (activeTransfer == m_activeTransfers.end())
+        {
+            AWS_LOGSTREAM_ERROR(CURL_MULTI_HTTP_CLIENT_TAG, "Completed connection handle " << connectionHandle << " does not belong to any request.");
+            continue;
+        }
+
+        CurlMultiTransfer* transfer = activeTransfer->second;
+        m_activeTransfers.erase(activeTransfer);
+        m_pausedTransfers.erase(connectionHandle);
+        curl_multi_remove_handle(m_multiHandle, connectionHandle);
+        FinishTransfer(transfer, curlResponseCode);
+    }
+}
+
+void CurlMultiHttpClient::FinishTransfer(CurlMultiTransfer* transfer, CURLcode curlResponseCode)
+{
+    CompleteResponse(transfer->connectionHandle, curlResponseCode, transfer->request, transfer->response,
+        transfer->writeContext, transfer->startTransmissionTime);
+
+    if (curlResponseCode != CURLE_OK)
+    {
+        m_transferHandles.DestroyCurlHandle(transfer->connectionHandle);
+    }
+    else
+    {
+#if defined(CURL_HAS_MULTIPLEX) && LIBCURL_VERSION_NUM >= 0x073200
+        long httpVersion = CURL_HTTP_VERSION_NONE;
+        if (m_multiplexing && curl_easy_getinfo(transfer->connectionHandle, CURLINFO_HTTP_VERSION, &httpVersion) == CURLE_OK
+            && (httpVersion == CURL_HTTP_VERSION_1_0 || httpVersion == CURL_HTTP_VERSION_1_1)
+            && m_http1Authorities.insert(transfer->authority).second)
+        {
+            AWS_LOGSTREAM_INFO(CURL_MULTI_HTTP_CLIENT_TAG, transfer->authority << " did not negotiate HTTP/2, using HTTP/1.1 for it from now on.");
+        }
+#endif
+        AWS_LOGSTREAM_DEBUG(CURL_MULTI_HTTP_CLIENT_TAG, "Releasing curl handle " << transfer->connectionHandle);
+        m_transferHandles.ReleaseCurlHandle(transfer->connectionHandle, transfer->authority);
+    }
+
+    if (transfer->headers)
+    {
+        curl_slist_free_all(transfer->headers);
+    }
+
+    if (transfer->handler)
+    {
+        transfer->handler(transfer->request, transfer->response);
+    }
+    Aws::Delete(transfer);
+}
+
+void CurlMultiHttpClient::CancelTransfer(CurlMultiTransfer* transfer) const
+{
+    if (transfer->headers)
+    {
+        curl_slist_free_all(transfer->headers);
+    }
+
+    transfer->response->SetClientErrorType(CoreErrors::USER_CANCELLED);
+    transfer->response->SetClientErrorMessage("Request cancelled because the http client is shutting down");
+    if (transfer->handler)
+    {
+        transfer->handler(transfer->request, transfer->response);
+    }
+    Aws::Delete(transfer);
+}
@@ -10,11 +10,20 @@
 #include <iostream>
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
 
 using namespace Aws::Http;
 using namespace Aws::Http::Standard;
 using namespace Aws::Utils;
 
+// same classification as StringUtils::Trim
+static bool IsSpace(char ch)
+{
+    int value = static_cast<int>(ch);
+    return value >= -1 && value <= 255 && ::isspace(value) != 0;
+}
+
 static bool IsDefaultPort(const URI& uri)
 {
     switch(uri.GetPort())
@@ -47,48 +56,52 @@ StandardHttpRequest::StandardHttpRequest(const URI& uri, HttpMethod method) :
 
 HeaderValueCollection StandardHttpRequest::GetHeaders() const
 {
-    HeaderValueCollection headers;
-
-    for (HeaderValueCollection::const_iterator iter = headerMap.begin(); iter != headerMap.end(); ++iter)
-    {
-        headers.emplace(HeaderValuePair(iter->first, iter->second));
-    }
-
-    return headers;
+    return headerMap.ToHeaderValueCollection();
 }
 
 const Aws::String& StandardHttpRequest::GetHeaderValue(const char* headerName) const
 {
-    auto iter = headerMap.find(headerName);
-    assert (iter != headerMap.end());
-    return iter->second;
+    const Aws::String* value = headerMap.Find(headerName);
+    assert (value);
+    return value ? *value : m_emptyHeader;
 }
 
 void StandardHttpRequest::SetHeaderValue(const char* headerName, const Aws::String& headerValue)
 {
-    headerMap[StringUtils::ToLower(headerName)] = StringUtils::Trim(headerValue.c_str());
+    //trimmed in place, the value is copied once into the header's storage.
+    const char* valueBegin = headerValue.c_str();
+    const char* valueEnd = valueBegin + headerValue.size();
+    while (valueBegin < valueEnd && IsSpace(*valueBegin))
+    {
+        ++valueBegin;
+    }
+    while (valueEnd > valueBegin && IsSpace(*(valueEnd - 1)))
+    {
+        --valueEnd;
+    }
+    headerMap.Set(headerName, strlen(headerName), valueBegin, static_cast<size_t>(valueEnd - valueBegin));
 }
 
 void StandardHttpRequest::SetHeaderValue(const Aws::String& headerName, const Aws::String& headerValue)
 {
-    headerMap[StringUtils::ToLower(headerName.c_str())] = StringUtils::Trim(headerValue.c_str());
+    SetHeaderValue(headerName.c_str(), headerValue);
 }
 
 void StandardHttpRequest::DeleteHeader(const char* headerName)
 {
-    headerMap.erase(StringUtils::ToLower(headerName));
+    headerMap.Erase(headerName);
 }
 
 bool StandardHttpRequest::HasHeader(const char* headerName) const
 {
-    return headerMap.find(StringUtils::ToLower(headerName)) != headerMap.end();
+    return headerMap.Has(headerName);
 }
 
 int64_t StandardHttpRequest::GetSize() const
 {
     int64_t size = 0;
 
-    std::for_each(headerMap.cbegin(), headerMap.cend(), [&](const HeaderValueCollection::value_type& kvPair){ size += kvPair.first.length(); size += kvPair.second.length(); });
+    std::for_each(headerMap.begin(), headerMap.end(), [&](const FlatHeaderCollection::Entry& header){ size += header.GetNameLength(); size += header.GetValue().length(); });
 
     return size;
 }
@@ -207,10 +207,20 @@ bool WinSyncHttpClient::BuildSuccessResponse(const std::shared_ptr<HttpRequest>&
         read = 0;
 
         bool success = ContinueRequest(*request);
+        int responseCode = static_cast<int>(response->GetResponseCode());
+        const ResponseBodySink& sink = request->GetResponseBodySink();
+        bool useSink = sink && responseCode >= 200 && responseCode < 300;
 
         while (DoReadData(hHttpRequest, body, bodySize, read) && read > 0 && success)
         {
-            response->GetResponseBody().write(body, read);
+            if (useSink)
+            {
+                success = sink(body, static_cast<size_t>(read), static_cast<uint64_t>(numBytesResponseReceived));
+            }
+            else
+            {
+                response->GetResponseBody().write(body, read);
+            }
             if (read > 0)
             {
                 numBytesResponseReceived += read;
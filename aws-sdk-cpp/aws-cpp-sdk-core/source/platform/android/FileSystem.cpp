@@ -10,9 +10,13 @@
 
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <cerrno>
 #include <dirent.h>
 #include <cassert>
+#include <algorithm>
+#include <limits>
 
 #include <mutex>
 
@@ -23,6 +27,41 @@ namespace FileSystem
 
 static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
 
+    /**
+     * Fills in the type, size and last modified time of the entry at entry.path. Returns false if the path can not be stat'ed.
+     */
+    static bool StatFileInfo(DirectoryEntry& entry)
+    {
+        AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Calling stat on path " << entry.path);
+
+        struct stat dirInfo;
+        if(!lstat(entry.path.c_str(), &dirInfo))
+        {
+           if(S_ISDIR(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
+               entry.fileType = FileType::Directory;
+           }
+           else if(S_ISLNK(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
+               entry.fileType = FileType::Symlink;
+           }
+           else if(S_ISREG(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
+               entry.fileType = FileType::File;
+           }
+
+           entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
+           AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
+           entry.lastModified = Aws::Utils::DateTime(static_cast<int64_t>(dirInfo.st_mtime) * 1000);
+           return true;
+        }
+
+        return false;
+    }
+
     class AndroidDirectory : public Directory
     {
     public:
@@ -108,31 +147,7 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
                 entry.relativePath = m_directoryEntry.relativePath;
             }
 
-            AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Calling stat on path " << entry.path);
-
-            struct stat dirInfo;
-            if(!lstat(entry.path.c_str(), &dirInfo))
-            {
-               if(S_ISDIR(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
-                   entry.fileType = FileType::Directory;
-               }
-               else if(S_ISLNK(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
-                   entry.fileType = FileType::Symlink;
-               }
-               else if(S_ISREG(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
-                   entry.fileType = FileType::File;
-               }
-
-               entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
-               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
-            }
-            else
+            if(!StatFileInfo(entry))
             {
                 AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to stat file path " << entry.path << " with error code " << errno);
             }
@@ -143,6 +158,47 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystem";
         DIR* m_dir;
     };
 
+    class AndroidMappedFile : public MappedFile
+    {
+    public:
+        AndroidMappedFile(unsigned char* data, uint64_t size) : MappedFile(data, size)
+        {
+        }
+
+        ~AndroidMappedFile()
+        {
+            munmap(m_data, static_cast<size_t>(m_size));
+        }
+
+        void WillNeed(uint64_t offset, uint64_t length) override
+        {
+            Advise(offset, length, MADV_WILLNEED);
+        }
+
+        void DontNeed(uint64_t offset, uint64_t length) override
+        {
+            Advise(offset, length, MADV_DONTNEED);
+        }
+
+    private:
+        void Advise(uint64_t offset, uint64_t length, int advice)
+        {
+            if (offset >= m_size)
+            {
+                return;
+            }
+
+            //madvise wants a page aligned address.
+            static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            uint64_t begin = offset - offset % pageSize;
+            uint64_t end = offset + (std::min)(length, m_size - offset);
+            if (madvise(m_data + begin, static_cast<size_t>(end - begin), advice) != 0)
+            {
+                AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "madvise " << advice << " failed with error code " << errno);
+            }
+        }
+    };
+
 Aws::String GetHomeDirectory()
 {
     return Aws::Platform::GetCacheDirectory();
@@ -242,6 +298,78 @@ Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::Stri
     return Aws::MakeUnique<AndroidDirectory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+DirectoryEntry GetFileInfo(const Aws::String& path)
+{
+    DirectoryEntry entry;
+    entry.path = path;
+    StatFileInfo(entry);
+    return entry;
+}
+
+Aws::UniquePtr<MappedFile> MapFile(const Aws::String& path, MappedFileAccess access, uint64_t size)
+{
+    bool readWrite = access == MappedFileAccess::ReadWrite;
+    int fd = open(path.c_str(), readWrite ? O_RDWR | O_CREAT : O_RDONLY, 0666);
+    if (fd < 0)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not open file " << path << " for mapping with error code " << errno);
+        return nullptr;
+    }
+
+    if (readWrite)
+    {
+        if (size > static_cast<uint64_t>((std::numeric_limits<off_t>::max)()) || ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not resize file " << path << " to " << size << " bytes with error code " << errno);
+            close(fd);
+            return nullptr;
+        }
+#if __ANDROID_API__ >= 21
+        //allocate the blocks up front, writing to a page of a sparse file on a full disk would raise SIGBUS instead of failing here.
+        int allocateResult = size > 0 ? posix_fallocate(fd, 0, static_cast<off_t>(size)) : 0;
+        if (allocateResult != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not allocate " << size << " bytes for file " << path << " with error code " << allocateResult);
+            close(fd);
+            return nullptr;
+        }
+#endif
+    }
+    else
+    {
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to stat file " << path << " with error code " << errno);
+            close(fd);
+            return nullptr;
+        }
+        size = static_cast<uint64_t>(fileInfo.st_size);
+    }
+
+    if (size == 0 || size > static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+    {
+        AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "Not mapping file " << path << " of " << size << " bytes.");
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(size), readWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    //the mapping keeps its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not map file " << path << " with error code " << errno);
+        return nullptr;
+    }
+
+    if (!readWrite)
+    {
+        madvise(data, static_cast<size_t>(size), MADV_SEQUENTIAL);
+    }
+    return Aws::MakeUnique<AndroidMappedFile>(FILE_SYSTEM_UTILS_LOG_TAG, static_cast<unsigned char*>(data), size);
+}
+
 } // namespace FileSystem
 } // namespace Aws
 
@@ -14,9 +14,13 @@
 #include <unistd.h>
 #include <pwd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <dirent.h>
 #include <errno.h>
 #include <climits>
+#include <algorithm>
+#include <limits>
 
 #include <cassert>
 #ifdef __APPLE__
@@ -29,6 +33,41 @@ namespace FileSystem
 
 static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystemUtils";
 
+    /**
+     * Fills in the type, size and last modified time of the entry at entry.path. Returns false if the path can not be stat'ed.
+     */
+    static bool StatFileInfo(DirectoryEntry& entry)
+    {
+        AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Calling stat on path " << entry.path);
+
+        struct stat dirInfo;
+        if(!lstat(entry.path.c_str(), &dirInfo))
+        {
+           if(S_ISDIR(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
+               entry.fileType = FileType::Directory;
+           }
+           else if(S_ISLNK(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
+               entry.fileType = FileType::Symlink;
+           }
+           else if(S_ISREG(dirInfo.st_mode))
+           {
+               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
+               entry.fileType = FileType::File;
+           }
+
+           entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
+           AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
+           entry.lastModified = Aws::Utils::DateTime(static_cast<int64_t>(dirInfo.st_mtime) * 1000);
+           return true;
+        }
+
+        return false;
+    }
+
     class PosixDirectory : public Directory
     {
     public:
@@ -118,31 +157,7 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystemUtils";
                 entry.relativePath = m_directoryEntry.relativePath;
             }
 
-            AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Calling stat on path " << entry.path);
-
-            struct stat dirInfo;
-            if(!lstat(entry.path.c_str(), &dirInfo))
-            {
-               if(S_ISDIR(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type directory detected");
-                   entry.fileType = FileType::Directory;
-               }
-               else if(S_ISLNK(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type symlink detected");
-                   entry.fileType = FileType::Symlink;
-               }
-               else if(S_ISREG(dirInfo.st_mode))
-               {
-                   AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "type file detected");
-                   entry.fileType = FileType::File;
-               }
-
-               entry.fileSize = static_cast<int64_t>(dirInfo.st_size);
-               AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "file size detected as " << entry.fileSize);
-            }
-            else
+            if(!StatFileInfo(entry))
             {
                 AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to stat file path " << entry.path << " with error code " << errno);
             }
@@ -153,6 +168,47 @@ static const char* FILE_SYSTEM_UTILS_LOG_TAG = "FileSystemUtils";
         DIR* m_dir;
     };
 
+    class PosixMappedFile : public MappedFile
+    {
+    public:
+        PosixMappedFile(unsigned char* data, uint64_t size) : MappedFile(data, size)
+        {
+        }
+
+        ~PosixMappedFile()
+        {
+            munmap(m_data, static_cast<size_t>(m_size));
+        }
+
+        void WillNeed(uint64_t offset, uint64_t length) override
+        {
+            Advise(offset, length, MADV_WILLNEED);
+        }
+
+        void DontNeed(uint64_t offset, uint64_t length) override
+        {
+            Advise(offset, length, MADV_DONTNEED);
+        }
+
+    private:
+        void Advise(uint64_t offset, uint64_t length, int advice)
+        {
+            if (offset >= m_size)
+            {
+                return;
+            }
+
+            //madvise wants a page aligned address.
+            static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            uint64_t begin = offset - offset % pageSize;
+            uint64_t end = offset + (std::min)(length, m_size - offset);
+            if (madvise(m_data + begin, static_cast<size_t>(end - begin), advice) != 0)
+            {
+                AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "madvise " << advice << " failed with error code " << errno);
+            }
+        }
+    };
+
 Aws::String GetHomeDirectory()
 {
     static const char* HOME_DIR_ENV_VAR = "HOME";
@@ -288,5 +344,86 @@ Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::Stri
     return Aws::MakeUnique<PosixDirectory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+DirectoryEntry GetFileInfo(const Aws::String& path)
+{
+    DirectoryEntry entry;
+    entry.path = path;
+    StatFileInfo(entry);
+    return entry;
+}
+
+//returns 0 once the first size bytes of the file are backed by disk blocks, or the error code.
+static int AllocateFile(int fd, off_t size)
+{
+#ifdef __APPLE__
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, size, 0 };
+    return fcntl(fd, F_PREALLOCATE, &store) == -1 ? errno : 0;
+#else
+    return posix_fallocate(fd, 0, size);
+#endif
+}
+
+Aws::UniquePtr<MappedFile> MapFile(const Aws::String& path, MappedFileAccess access, uint64_t size)
+{
+    bool readWrite = access == MappedFileAccess::ReadWrite;
+    int fd = open(path.c_str(), readWrite ? O_RDWR | O_CREAT : O_RDONLY, 0666);
+    if (fd < 0)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not open file " << path << " for mapping with error code " << errno);
+        return nullptr;
+    }
+
+    if (readWrite)
+    {
+        if (size > static_cast<uint64_t>((std::numeric_limits<off_t>::max)()) || ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not resize file " << path << " to " << size << " bytes with error code " << errno);
+            close(fd);
+            return nullptr;
+        }
+        //allocate the blocks up front, writing to a page of a sparse file on a full disk would raise SIGBUS instead of failing here.
+        int allocateResult = size > 0 ? AllocateFile(fd, static_cast<off_t>(size)) : 0;
+        if (allocateResult != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not allocate " << size << " bytes for file " << path << " with error code " << allocateResult);
+            close(fd);
+            return nullptr;
+        }
+    }
+    else
+    {
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0)
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to stat file " << path << " with error code " << errno);
+            close(fd);
+            return nullptr;
+        }
+        size = static_cast<uint64_t>(fileInfo.st_size);
+    }
+
+    if (size == 0 || size > static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+    {
+        AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "Not mapping file " << path << " of " << size << " bytes.");
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(size), readWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    //the mapping keeps its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not map file " << path << " with error code " << errno);
+        return nullptr;
+    }
+
+    if (!readWrite)
+    {
+        madvise(data, static_cast<size_t>(size), MADV_SEQUENTIAL);
+    }
+    return Aws::MakeUnique<PosixMappedFile>(FILE_SYSTEM_UTILS_LOG_TAG, static_cast<unsigned char*>(data), size);
+}
+
 } // namespace FileSystem
 } // namespace Aws
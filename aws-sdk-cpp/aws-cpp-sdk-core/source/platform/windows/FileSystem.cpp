@@ -7,8 +7,11 @@
 #include <aws/core/platform/Environment.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/UnreferencedParam.h>
 #include <cassert>
 #include <iostream>
+#include <algorithm>
+#include <limits>
 #include <Userenv.h>
 
 #pragma warning( disable : 4996)
@@ -35,6 +38,18 @@ static inline Aws::WString ToLongPath(const Aws::WString& path)
     return path;
 }
 
+/**
+ * FILETIME counts 100 nanosecond intervals since January 1, 1601.
+ */
+static inline DateTime FileTimeToDateTime(const FILETIME& fileTime)
+{
+    ULARGE_INTEGER ticks;
+    ticks.HighPart = fileTime.dwHighDateTime;
+    ticks.LowPart = fileTime.dwLowDateTime;
+    static const uint64_t EPOCH_DIFFERENCE_IN_TICKS = 116444736000000000ULL;
+    return DateTime(static_cast<int64_t>((ticks.QuadPart - EPOCH_DIFFERENCE_IN_TICKS) / 10000));
+}
+
 class User32Directory : public Directory
 {
 public:
@@ -110,6 +125,7 @@ private:
         fileSize.HighPart = ffd.nFileSizeHigh;
         fileSize.LowPart = ffd.nFileSizeLow;
         entry.fileSize = static_cast<int64_t>(fileSize.QuadPart);
+        entry.lastModified = FileTimeToDateTime(ffd.ftLastWriteTime);
 
         if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
         {
@@ -139,6 +155,43 @@ private:
     DWORD m_lastError;
 };
 
+class User32MappedFile : public MappedFile
+{
+public:
+    User32MappedFile(unsigned char* data, uint64_t size) : MappedFile(data, size)
+    {
+    }
+
+    ~User32MappedFile()
+    {
+        UnmapViewOfFile(m_data);
+    }
+
+    void WillNeed(uint64_t offset, uint64_t length) override
+    {
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+        if (offset < m_size)
+        {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = m_data + offset;
+            range.NumberOfBytes = static_cast<SIZE_T>((std::min)(length, m_size - offset));
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#else
+        //PrefetchVirtualMemory needs Windows 8.
+        AWS_UNREFERENCED_PARAM(offset);
+        AWS_UNREFERENCED_PARAM(length);
+#endif
+    }
+
+    void DontNeed(uint64_t offset, uint64_t length) override
+    {
+        //the working set of the process is trimmed by the memory manager.
+        AWS_UNREFERENCED_PARAM(offset);
+        AWS_UNREFERENCED_PARAM(length);
+    }
+};
+
 Aws::String GetHomeDirectory()
 {
     static const char* HOME_DIR_ENV_VAR = "USERPROFILE";
@@ -332,5 +385,84 @@ Aws::UniquePtr<Directory> OpenDirectory(const Aws::String& path, const Aws::Stri
     return Aws::MakeUnique<User32Directory>(FILE_SYSTEM_UTILS_LOG_TAG, path, relativePath);
 }
 
+DirectoryEntry GetFileInfo(const Aws::String& path)
+{
+    DirectoryEntry entry;
+    WIN32_FILE_ATTRIBUTE_DATA fileData;
+    if (!GetFileAttributesExW(ToLongPath(Aws::Utils::StringUtils::ToWString(path.c_str())).c_str(), GetFileExInfoStandard, &fileData))
+    {
+        AWS_LOGSTREAM_TRACE(FILE_SYSTEM_UTILS_LOG_TAG, "Could not get attributes of " << path << " with error code " << GetLastError());
+        return entry;
+    }
+
+    entry.path = path;
+    LARGE_INTEGER fileSize;
+    fileSize.HighPart = fileData.nFileSizeHigh;
+    fileSize.LowPart = fileData.nFileSizeLow;
+    entry.fileSize = static_cast<int64_t>(fileSize.QuadPart);
+    entry.lastModified = FileTimeToDateTime(fileData.ftLastWriteTime);
+    entry.fileType = (fileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? FileType::Directory : FileType::File;
+    return entry;
+}
+
+Aws::UniquePtr<MappedFile> MapFile(const Aws::String& path, MappedFileAccess access, uint64_t size)
+{
+    bool readWrite = access == MappedFileAccess::ReadWrite;
+    HANDLE file = CreateFileW(ToLongPath(Aws::Utils::StringUtils::ToWString(path.c_str())).c_str(),
+        readWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+        readWrite ? OPEN_ALWAYS : OPEN_EXISTING, readWrite ? FILE_ATTRIBUTE_NORMAL : FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not open file " << path << " for mapping with error code " << GetLastError());
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (readWrite)
+    {
+        fileSize.QuadPart = static_cast<LONGLONG>(size);
+        if (size > static_cast<uint64_t>((std::numeric_limits<LONGLONG>::max)()) || !SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not resize file " << path << " to " << size << " bytes with error code " << GetLastError());
+            CloseHandle(file);
+            return nullptr;
+        }
+    }
+    else
+    {
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Failed to get the size of file " << path << " with error code " << GetLastError());
+            CloseHandle(file);
+            return nullptr;
+        }
+        size = static_cast<uint64_t>(fileSize.QuadPart);
+    }
+
+    if (size == 0 || size > static_cast<uint64_t>((std::numeric_limits<size_t>::max)()))
+    {
+        AWS_LOGSTREAM_DEBUG(FILE_SYSTEM_UTILS_LOG_TAG, "Not mapping file " << path << " of " << size << " bytes.");
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, readWrite ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, readWrite ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size)) : nullptr;
+    DWORD errorCode = GetLastError();
+    //the view keeps its own references to the mapping and the file.
+    if (mapping)
+    {
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (!data)
+    {
+        AWS_LOGSTREAM_ERROR(FILE_SYSTEM_UTILS_LOG_TAG, "Could not map file " << path << " with error code " << errorCode);
+        return nullptr;
+    }
+
+    return Aws::MakeUnique<User32MappedFile>(FILE_SYSTEM_UTILS_LOG_TAG, static_cast<unsigned char*>(data), size);
+}
+
 } // namespace FileSystem
 } // namespace Aws
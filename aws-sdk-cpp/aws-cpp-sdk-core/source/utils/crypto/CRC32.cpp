@@ -0,0 +1,210 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/crypto/CRC32.h>
+#include <aws/core/utils/Array.h>
+#include <aws/checksums/crc.h>
+#include <climits>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Crypto;
+
+//reversed polynomials, aws-checksums computes the reflected variants of both checksums.
+static const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+static const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+typedef uint32_t (*ChecksumFunction)(const uint8_t* input, int length, uint32_t previousCrc);
+
+static uint32_t RunChecksum(ChecksumFunction checksumFunction, const unsigned char* data, size_t length, uint32_t crc)
+{
+    //aws-checksums takes an int length.
+    while (length > static_cast<size_t>(INT_MAX))
+    {
+        crc = checksumFunction(data, INT_MAX, crc);
+        data += INT_MAX;
+        length -= INT_MAX;
+    }
+    return checksumFunction(data, static_cast<int>(length), crc);
+}
+
+static HashResult ToHashResult(uint32_t crc)
+{
+    ByteBuffer result(4);
+    result[0] = static_cast<unsigned char>(crc >> 24);
+    result[1] = static_cast<unsigned char>(crc >> 16);
+    result[2] = static_cast<unsigned char>(crc >> 8);
+    result[3] = static_cast<unsigned char>(crc);
+    return HashResult(std::move(result));
+}
+
+static HashResult ChecksumStream(ChecksumFunction checksumFunction, Aws::IStream& stream)
+{
+    auto currentPos = stream.tellg();
+    if (currentPos == -1)
+    {
+        currentPos = 0;
+        stream.clear();
+    }
+    stream.seekg(0, stream.beg);
+
+    uint32_t crc = 0;
+    char streamBuffer[Hash::INTERNAL_HASH_STREAM_BUFFER_SIZE];
+    while (stream.good())
+    {
+        stream.read(streamBuffer, Hash::INTERNAL_HASH_STREAM_BUFFER_SIZE);
+        auto bytesRead = stream.gcount();
+
+        if (bytesRead > 0)
+        {
+            crc = RunChecksum(checksumFunction, reinterpret_cast<unsigned char*>(streamBuffer), static_cast<size_t>(bytesRead), crc);
+        }
+    }
+
+    stream.clear();
+    stream.seekg(currentPos, stream.beg);
+
+    return ToHashResult(crc);
+}
+
+/*
+ * Combining two checksums amounts to running crcA through lengthB zero bytes and xoring in crcB. The zeros are applied
+ * with the matrix of the crc's linear map over GF(2), squared once per bit of lengthB (the zlib crc32_combine technique),
+ * so it costs O(log(lengthB)) rather than O(lengthB).
+ */
+static uint32_t Gf2MatrixTimes(const uint32_t* matrix, uint32_t vector)
+{
+    uint32_t sum = 0;
+    while (vector)
+    {
+        if (vector & 1)
+        {
+            sum ^= *matrix;
+        }
+        vector >>= 1;
+        matrix++;
+    }
+    return sum;
+}
+
+static void Gf2MatrixSquare(uint32_t* square, const uint32_t* matrix)
+{
+    for (int n = 0; n < 32; n++)
+    {
+        square[n] = Gf2MatrixTimes(matrix, matrix[n]);
+    }
+}
+
+static uint32_t CombineChecksums(uint32_t polynomial, uint32_t crcA, uint32_t crcB, uint64_t lengthB)
+{
+    if (lengthB == 0)
+    {
+        return crcA;
+    }
+
+    uint32_t even[32];
+    uint32_t odd[32];
+
+    //operator for a single zero bit
+    odd[0] = polynomial;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; n++)
+    {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    //operators for two and then four zero bits
+    Gf2MatrixSquare(even, odd);
+    Gf2MatrixSquare(odd, even);
+
+    //the first square below gives the operator for one zero byte
+    do
+    {
+        Gf2MatrixSquare(even, odd);
+        if (lengthB & 1)
+        {
+            crcA = Gf2MatrixTimes(even, crcA);
+        }
+        lengthB >>= 1;
+
+        if (lengthB == 0)
+        {
+            break;
+        }
+
+        Gf2MatrixSquare(odd, even);
+        if (lengthB & 1)
+        {
+            crcA = Gf2MatrixTimes(odd, crcA);
+        }
+        lengthB >>= 1;
+    } while (lengthB != 0);
+
+    return crcA ^ crcB;
+}
+
+HashResult CRC32::Calculate(const Aws::String& str)
+{
+    return ToHashResult(Checksum(reinterpret_cast<const unsigned char*>(str.c_str()), str.size()));
+}
+
+HashResult CRC32::Calculate(Aws::IStream& stream)
+{
+    return ChecksumStream(aws_checksums_crc32, stream);
+}
+
+void CRC32::Update(const unsigned char* buffer, size_t bufferSize)
+{
+    m_crc = Checksum(buffer, bufferSize, m_crc);
+}
+
+HashResult CRC32::GetHash()
+{
+    auto result = ToHashResult(m_crc);
+    m_crc = 0;
+    return result;
+}
+
+uint32_t CRC32::Checksum(const unsigned char* data, size_t length, uint32_t previousCrc)
+{
+    return RunChecksum(aws_checksums_crc32, data, length, previousCrc);
+}
+
+uint32_t CRC32::Combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB)
+{
+    return CombineChecksums(CRC32_POLYNOMIAL, crcA, crcB, lengthB);
+}
+
+HashResult CRC32C::Calculate(const Aws::String& str)
+{
+    return ToHashResult(Checksum(reinterpret_cast<const unsigned char*>(str.c_str()), str.size()));
+}
+
+HashResult CRC32C::Calculate(Aws::IStream& stream)
+{
+    return ChecksumStream(aws_checksums_crc32c, stream);
+}
+
+void CRC32C::Update(const unsigned char* buffer, size_t bufferSize)
+{
+    m_crc = Checksum(buffer, bufferSize, m_crc);
+}
+
+HashResult CRC32C::GetHash()
+{
+    auto result = ToHashResult(m_crc);
+    m_crc = 0;
+    return result;
+}
+
+uint32_t CRC32C::Checksum(const unsigned char* data, size_t length, uint32_t previousCrc)
+{
+    return RunChecksum(aws_checksums_crc32c, data, length, previousCrc);
+}
+
+uint32_t CRC32C::Combine(uint32_t crcA, uint32_t crcB, uint64_t lengthB)
+{
+    return CombineChecksums(CRC32C_POLYNOMIAL, crcA, crcB, lengthB);
+}
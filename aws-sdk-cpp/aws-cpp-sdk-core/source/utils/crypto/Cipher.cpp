@@ -9,6 +9,7 @@
 #include <aws/core/utils/logging/LogMacros.h>
 #include <cstdlib>
 #include <climits>
+#include <cstring>
 
 //if you are reading this, you are witnessing pure brilliance.
 #define IS_BIG_ENDIAN (*(uint16_t*)"\0\xff" < 0x100)
@@ -118,6 +119,26 @@ namespace Aws
 
                 return key;
             }
+
+            size_t SymmetricCipher::EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output)
+            {
+                CryptoBuffer encryptedData = EncryptBuffer(CryptoBuffer(data, length));
+                if (encryptedData.GetLength() > 0)
+                {
+                    memcpy(output, encryptedData.GetUnderlyingData(), encryptedData.GetLength());
+                }
+                return encryptedData.GetLength();
+            }
+
+            size_t SymmetricCipher::DecryptBufferTo(const unsigned char* data, size_t length, unsigned char* output)
+            {
+                CryptoBuffer decryptedData = DecryptBuffer(CryptoBuffer(data, length));
+                if (decryptedData.GetLength() > 0)
+                {
+                    memcpy(output, decryptedData.GetUnderlyingData(), decryptedData.GetLength());
+                }
+                return decryptedData.GetLength();
+            }
         }
     }
 }
@@ -4,6 +4,7 @@
  */
 
 #include <aws/core/utils/crypto/CryptoBuf.h>
+#include <cstring>
 
 namespace Aws
 {
@@ -13,10 +14,10 @@ namespace Aws
         {
             SymmetricCryptoBufSrc::SymmetricCryptoBufSrc(Aws::IStream& stream, SymmetricCipher& cipher, CipherMode cipherMode, size_t bufferSize)
                     :
-                    m_isBuf(PUT_BACK_SIZE), m_cipher(cipher), m_stream(stream), m_cipherMode(cipherMode), m_isFinalized(false),
-                    m_bufferSize(bufferSize), m_putBack(PUT_BACK_SIZE)
+                    m_isBuf(PUT_BACK_SIZE + bufferSize + MAX_CIPHER_BLOCK_SIZE), m_readBuf(bufferSize), m_cipher(cipher), m_stream(stream),
+                    m_cipherMode(cipherMode), m_isFinalized(false), m_bufferSize(bufferSize), m_putBack(PUT_BACK_SIZE)
             {
-                char* end = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData() + m_isBuf.GetLength());
+                char* end = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData() + m_putBack);
                 setg(end, end, end);
             }
 
@@ -50,65 +51,26 @@ namespace Aws
                         index = 0;
                     }
 
-                    CryptoBuffer cryptoBuffer;
+                    size_t filled = 0;
                     while (m_cipher && index < seekTo && !m_isFinalized)
                     {
-                        size_t max_read = std::min<size_t>(static_cast<size_t>(seekTo - index), m_bufferSize);
-
-                        Aws::Utils::Array<char> buf(max_read);
-                        size_t readSize(0);
-                        if(m_stream)
-                        {
-                            m_stream.read(buf.GetUnderlyingData(), max_read);
-                            readSize = static_cast<size_t>(m_stream.gcount());
-                        }
-
-                        if (readSize > 0)
-                        {
-                            if (m_cipherMode == CipherMode::Encrypt)
-                            {
-                                cryptoBuffer = m_cipher.EncryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(buf.GetUnderlyingData()), readSize));
-                            }
-                            else
-                            {
-                                cryptoBuffer = m_cipher.DecryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(buf.GetUnderlyingData()), readSize));
-                            }
-                        }
-                        else
-                        {
-                            if (m_cipherMode == CipherMode::Encrypt)
-                            {
-                                cryptoBuffer = m_cipher.FinalizeEncryption();
-                            }
-                            else
-                            {
-                                cryptoBuffer = m_cipher.FinalizeDecryption();
-                            }
-
-                            m_isFinalized = true;
-                        }
-
-                        index += cryptoBuffer.GetLength();
+                        filled = FillBuffer(std::min<size_t>(static_cast<size_t>(seekTo - index), m_bufferSize));
+                        index += filled;
                     }
 
-                    if (cryptoBuffer.GetLength() && m_cipher)
+                    char* baseBufPtr = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData());
+                    if (filled && m_cipher)
                     {
-                        CryptoBuffer putBackArea(m_putBack);
-
-                        m_isBuf = CryptoBuffer({&putBackArea, &cryptoBuffer});
                         //in the very unlikely case that the cipher had less output than the source stream.
                         assert(seekTo <= index);
-                        size_t newBufferPos = index > seekTo ? cryptoBuffer.GetLength() - (index - seekTo) : cryptoBuffer.GetLength();
-                        char* baseBufPtr = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData());
-                        setg(baseBufPtr, baseBufPtr + m_putBack + newBufferPos, baseBufPtr + m_isBuf.GetLength());
+                        size_t newBufferPos = index > seekTo ? filled - (index - seekTo) : filled;
+                        setg(baseBufPtr, baseBufPtr + m_putBack + newBufferPos, baseBufPtr + m_putBack + filled);
 
                         return pos_type(seekTo);
                     }
                     else if (seekTo == 0)
                     {
-                        m_isBuf = CryptoBuffer(m_putBack);
-                        char* end = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData() + m_isBuf.GetLength());
-                        setg(end, end, end);
+                        setg(baseBufPtr + m_putBack, baseBufPtr + m_putBack, baseBufPtr + m_putBack);
                         return pos_type(seekTo);
                     }
                 }
@@ -134,61 +96,78 @@ namespace Aws
                 }
 
                 char* baseBufPtr = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData());
-                CryptoBuffer putBackArea(m_putBack);
 
                 //eback is properly set after the first fill. So this guarantees we are on the second or later fill.
                 if (eback() == baseBufPtr)
                 {
                     //just fill in the last bit of the previous buffer into the put back area so that it has some data in it
-                    memcpy(putBackArea.GetUnderlyingData(), egptr() - m_putBack, m_putBack);
+                    memmove(baseBufPtr, egptr() - m_putBack, m_putBack);
                 }
 
-                CryptoBuffer newDataBuf;
+                size_t filled = FillBuffer(m_bufferSize);
+                if (filled > 0)
+                {
+                    baseBufPtr = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData());
+                    setg(baseBufPtr, baseBufPtr + m_putBack, baseBufPtr + m_putBack + filled);
 
-                while(!newDataBuf.GetLength() && !m_isFinalized)
+                    return traits_type::to_int_type(*gptr());
+                }
+
+                return traits_type::eof();
+            }
+
+            size_t SymmetricCryptoBufSrc::FillBuffer(size_t readSize)
+            {
+                size_t filled = 0;
+                while (!filled && !m_isFinalized && m_cipher)
                 {
-                    Aws::Utils::Array<char> buf(m_bufferSize);
-                    m_stream.read(buf.GetUnderlyingData(), m_bufferSize);
-                    size_t readSize = static_cast<size_t>(m_stream.gcount());
+                    size_t sourceSize = 0;
+                    if (m_stream)
+                    {
+                        m_stream.read(reinterpret_cast<char*>(m_readBuf.GetUnderlyingData()), readSize);
+                        sourceSize = static_cast<size_t>(m_stream.gcount());
+                    }
 
-                    if (readSize > 0)
+                    if (sourceSize > 0)
                     {
+                        unsigned char* output = m_isBuf.GetUnderlyingData() + m_putBack;
                         if (m_cipherMode == CipherMode::Encrypt)
                         {
-                            newDataBuf = m_cipher.EncryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(buf.GetUnderlyingData()), readSize));
+                            filled = m_cipher.EncryptBufferTo(m_readBuf.GetUnderlyingData(), sourceSize, output);
                         }
                         else
                         {
-                            newDataBuf = m_cipher.DecryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(buf.GetUnderlyingData()), readSize));
+                            filled = m_cipher.DecryptBufferTo(m_readBuf.GetUnderlyingData(), sourceSize, output);
                         }
                     }
                     else
                     {
+                        CryptoBuffer finalBuffer;
                         if (m_cipherMode == CipherMode::Encrypt)
                         {
-                            newDataBuf = m_cipher.FinalizeEncryption();
+                            finalBuffer = m_cipher.FinalizeEncryption();
                         }
                         else
                         {
-                            newDataBuf = m_cipher.FinalizeDecryption();
+                            finalBuffer = m_cipher.FinalizeDecryption();
                         }
-
                         m_isFinalized = true;
-                    }
-                }
-
 
-                if(newDataBuf.GetLength() > 0)
-                {
-                    m_isBuf = CryptoBuffer({&putBackArea, &newDataBuf});
-
-                    baseBufPtr = reinterpret_cast<char*>(m_isBuf.GetUnderlyingData());
-                    setg(baseBufPtr, baseBufPtr + m_putBack, baseBufPtr + m_isBuf.GetLength());
-
-                    return traits_type::to_int_type(*gptr());
+                        filled = finalBuffer.GetLength();
+                        if (m_putBack + filled > m_isBuf.GetLength())
+                        {
+                            // a cipher may append more than a block when finalizing, e.g. a tag.
+                            CryptoBuffer putBackArea(m_isBuf.GetUnderlyingData(), m_putBack);
+                            m_isBuf = CryptoBuffer({&putBackArea, &finalBuffer});
+                        }
+                        else if (filled > 0)
+                        {
+                            memcpy(m_isBuf.GetUnderlyingData() + m_putBack, finalBuffer.GetUnderlyingData(), filled);
+                        }
+                    }
                 }
 
-                return traits_type::eof();
+                return m_cipher ? filled : 0;
             }
 
             SymmetricCryptoBufSrc::off_type SymmetricCryptoBufSrc::ComputeAbsSeekPosition(off_type pos, std::ios_base::seekdir dir,  std::fpos<FPOS_TYPE> curPos)
@@ -228,7 +207,8 @@ namespace Aws
 
             SymmetricCryptoBufSink::SymmetricCryptoBufSink(Aws::OStream& stream, SymmetricCipher& cipher, CipherMode cipherMode, size_t bufferSize, int16_t blockOffset)
                     :
-                    m_osBuf(bufferSize), m_cipher(cipher), m_stream(stream), m_cipherMode(cipherMode), m_isFinalized(false), m_blockOffset(blockOffset)
+                    m_osBuf(bufferSize), m_cipherBuf(bufferSize + MAX_CIPHER_BLOCK_SIZE), m_cipher(cipher), m_stream(stream), m_cipherMode(cipherMode),
+                    m_isFinalized(false), m_blockOffset(blockOffset)
             {
                 assert(m_blockOffset < 16 && m_blockOffset >= 0);
                 char* outputBase = reinterpret_cast<char*>(m_osBuf.GetUnderlyingData());
@@ -252,23 +232,25 @@ namespace Aws
             {
                 if(!m_isFinalized)
                 {
-                    CryptoBuffer cryptoBuf;
+                    size_t cipherLength = 0;
                     if (pptr() > pbase())
                     {
+                        const unsigned char* data = reinterpret_cast<unsigned char*>(pbase());
+                        size_t length = static_cast<size_t>(pptr() - pbase());
                         if (m_cipherMode == CipherMode::Encrypt)
                         {
-                            cryptoBuf = m_cipher.EncryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(pbase()), pptr() - pbase()));
+                            cipherLength = m_cipher.EncryptBufferTo(data, length, m_cipherBuf.GetUnderlyingData());
                         }
                         else
                         {
-                            cryptoBuf = m_cipher.DecryptBuffer(CryptoBuffer(reinterpret_cast<unsigned char*>(pbase()), pptr() - pbase()));
+                            cipherLength = m_cipher.DecryptBufferTo(data, length, m_cipherBuf.GetUnderlyingData());
                         }
 
                         pbump(-(static_cast<int>(pptr() - pbase())));
                     }
+                    CryptoBuffer finalBuffer;
                     if(finalize)
                     {
-                        CryptoBuffer finalBuffer;
                         if (m_cipherMode == CipherMode::Encrypt)
                         {
                             finalBuffer = m_cipher.FinalizeEncryption();
@@ -277,37 +259,14 @@ namespace Aws
                         {
                             finalBuffer = m_cipher.FinalizeDecryption();
                         }
-                        if(cryptoBuf.GetLength())
-                        {
-                            cryptoBuf = CryptoBuffer({&cryptoBuf, &finalBuffer});
-                        }
-                        else
-                        {
-                            cryptoBuf = std::move(finalBuffer);
-                        }
 
                         m_isFinalized = true;
                     }
 
                     if (m_cipher)
                     {
-                        if(cryptoBuf.GetLength())
-                        {
-                            //allow mid block decryption. We have to decrypt it, but we don't have to write it to the stream.
-                            //the assumption here is that tellp() will always be 0 or >= 16 bytes. The block offset should only
-                            //be the offset of the first block read.
-                            size_t len = cryptoBuf.GetLength();
-                            size_t blockOffset = m_stream.tellp() > m_blockOffset ? 0 : m_blockOffset;
-                            if (len > blockOffset)
-                            {
-                                m_stream.write(reinterpret_cast<char*>(cryptoBuf.GetUnderlyingData() + blockOffset), len - blockOffset);
-                                m_blockOffset = 0;
-                            }
-                            else
-                            {
-                                m_blockOffset -= static_cast<int16_t>(len);
-                            }
-                        }
+                        WriteToSink(m_cipherBuf.GetUnderlyingData(), cipherLength);
+                        WriteToSink(finalBuffer.GetUnderlyingData(), finalBuffer.GetLength());
                         return true;
                     }
                 }
@@ -315,6 +274,26 @@ namespace Aws
                 return false;
             }
 
+            void SymmetricCryptoBufSink::WriteToSink(const unsigned char* data, size_t length)
+            {
+                if(length)
+                {
+                    //allow mid block decryption. We have to decrypt it, but we don't have to write it to the stream.
+                    //the assumption here is that tellp() will always be 0 or >= 16 bytes. The block offset should only
+                    //be the offset of the first block read.
+                    size_t blockOffset = m_stream.tellp() > m_blockOffset ? 0 : m_blockOffset;
+                    if (length > blockOffset)
+                    {
+                        m_stream.write(reinterpret_cast<const char*>(data + blockOffset), length - blockOffset);
+                        m_blockOffset = 0;
+                    }
+                    else
+                    {
+                        m_blockOffset -= static_cast<int16_t>(length);
+                    }
+                }
+            }
+
             SymmetricCryptoBufSink::int_type SymmetricCryptoBufSink::overflow(int_type ch)
             {
                 if(m_cipher && m_stream)
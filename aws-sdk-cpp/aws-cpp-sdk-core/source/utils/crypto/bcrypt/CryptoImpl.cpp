@@ -121,6 +121,9 @@ namespace Aws
                 m_hashBuffer(nullptr),
                 m_hashObjectLength(0),
                 m_hashObject(nullptr),
+                m_incrementalContext(nullptr),
+                m_incrementalHashObject(nullptr),
+                m_incrementalHashFailed(false),
                 m_algorithmMutex()
             {
                 NTSTATUS status = BCryptOpenAlgorithmProvider(&m_algorithmHandle, algorithmName, MS_PRIMITIVE_PROVIDER, isHMAC ? BCRYPT_ALG_HANDLE_HMAC_FLAG : 0);
@@ -163,6 +166,8 @@ namespace Aws
 
             BCryptHashImpl::~BCryptHashImpl()
             {
+                Aws::Delete(m_incrementalContext);
+                Aws::DeleteArray(m_incrementalHashObject);
                 Aws::DeleteArray(m_hashObject);
                 Aws::DeleteArray(m_hashBuffer);
 
@@ -303,6 +308,77 @@ namespace Aws
                 return HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
             }
 
+            bool BCryptHashImpl::StartIncrementalHash()
+            {
+                if (!m_incrementalHashObject)
+                {
+                    m_incrementalHashObject = Aws::NewArray<BYTE>(m_hashObjectLength, logTag);
+                }
+
+                m_incrementalContext = Aws::New<BCryptHashContext>(logTag, m_algorithmHandle, m_incrementalHashObject, m_hashObjectLength);
+                if (!m_incrementalContext->IsValid())
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error creating hash handle.");
+                    return false;
+                }
+                return true;
+            }
+
+            void BCryptHashImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                if (!IsValid() || m_incrementalHashFailed)
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                if (!m_incrementalContext && !StartIncrementalHash())
+                {
+                    m_incrementalHashFailed = true;
+                    return;
+                }
+
+                NTSTATUS status = BCryptHashData(m_incrementalContext->m_hashHandle, const_cast<PBYTE>(buffer), static_cast<ULONG>(bufferSize), 0);
+                if (!NT_SUCCESS(status))
+                {
+                    AWS_LOGSTREAM_ERROR(logTag, "Error computing hash.");
+                    m_incrementalHashFailed = true;
+                }
+            }
+
+            HashResult BCryptHashImpl::GetHash()
+            {
+                if (!IsValid())
+                {
+                    return HashResult();
+                }
+
+                std::lock_guard<std::mutex> locker(m_algorithmMutex);
+
+                bool success = !m_incrementalHashFailed && (m_incrementalContext || StartIncrementalHash());
+                if (success)
+                {
+                    NTSTATUS status = BCryptFinishHash(m_incrementalContext->m_hashHandle, m_hashBuffer, m_hashBufferLength, 0);
+                    if (!NT_SUCCESS(status))
+                    {
+                        AWS_LOGSTREAM_ERROR(logTag, "Error obtaining computed hash");
+                        success = false;
+                    }
+                }
+
+                Aws::Delete(m_incrementalContext);
+                m_incrementalContext = nullptr;
+                m_incrementalHashFailed = false;
+
+                if (!success)
+                {
+                    return HashResult();
+                }
+
+                return HashResult(ByteBuffer(m_hashBuffer, m_hashBufferLength));
+            }
+
             MD5BcryptImpl::MD5BcryptImpl() :
                 m_impl(BCRYPT_MD5_ALGORITHM, false)
             {
@@ -318,6 +394,16 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            void MD5BcryptImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                m_impl.Update(buffer, bufferSize);
+            }
+
+            HashResult MD5BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256BcryptImpl::Sha256BcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, false)
             {
@@ -333,6 +419,16 @@ namespace Aws
                 return m_impl.Calculate(stream);
             }
 
+            void Sha256BcryptImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                m_impl.Update(buffer, bufferSize);
+            }
+
+            HashResult Sha256BcryptImpl::GetHash()
+            {
+                return m_impl.GetHash();
+            }
+
             Sha256HMACBcryptImpl::Sha256HMACBcryptImpl() :
                 m_impl(BCRYPT_SHA256_ALGORITHM, true)
             {
@@ -168,6 +168,44 @@ namespace Aws
                 EVP_MD_CTX *m_ctx;
             };
 
+            static EVP_MD_CTX* CreateDigestContext(const EVP_MD* digest, bool allowNonFips)
+            {
+                EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+                assert(ctx != nullptr);
+                if (allowNonFips)
+                {
+#if !defined(OPENSSL_IS_BORINGSSL)
+                    EVP_MD_CTX_set_flags(ctx, EVP_MD_CTX_FLAG_NON_FIPS_ALLOW);
+#endif
+                }
+                EVP_DigestInit_ex(ctx, digest, nullptr);
+                return ctx;
+            }
+
+            static HashResult FinishDigestContext(EVP_MD_CTX*& ctx, const EVP_MD* digest, bool allowNonFips)
+            {
+                if (ctx == nullptr)
+                {
+                    //nothing was added, this is the digest of the empty string
+                    ctx = CreateDigestContext(digest, allowNonFips);
+                }
+
+                ByteBuffer hash(EVP_MD_size(digest));
+                EVP_DigestFinal(ctx, hash.GetUnderlyingData(), nullptr);
+                EVP_MD_CTX_destroy(ctx);
+                ctx = nullptr;
+
+                return HashResult(std::move(hash));
+            }
+
+            MD5OpenSSLImpl::~MD5OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
             HashResult MD5OpenSSLImpl::Calculate(const Aws::String& str)
             {
                 OpensslCtxRAIIGuard guard;
@@ -222,6 +260,28 @@ namespace Aws
                 return HashResult(std::move(hash));
             }
 
+            void MD5OpenSSLImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                if (m_ctx == nullptr)
+                {
+                    m_ctx = CreateDigestContext(EVP_md5(), true);
+                }
+                EVP_DigestUpdate(m_ctx, buffer, bufferSize);
+            }
+
+            HashResult MD5OpenSSLImpl::GetHash()
+            {
+                return FinishDigestContext(m_ctx, EVP_md5(), true);
+            }
+
+            Sha256OpenSSLImpl::~Sha256OpenSSLImpl()
+            {
+                if (m_ctx)
+                {
+                    EVP_MD_CTX_destroy(m_ctx);
+                }
+            }
+
             HashResult Sha256OpenSSLImpl::Calculate(const Aws::String& str)
             {
                 OpensslCtxRAIIGuard guard;
@@ -272,6 +332,20 @@ namespace Aws
                 return HashResult(std::move(hash));
             }
 
+            void Sha256OpenSSLImpl::Update(const unsigned char* buffer, size_t bufferSize)
+            {
+                if (m_ctx == nullptr)
+                {
+                    m_ctx = CreateDigestContext(EVP_sha256(), false);
+                }
+                EVP_DigestUpdate(m_ctx, buffer, bufferSize);
+            }
+
+            HashResult Sha256OpenSSLImpl::GetHash()
+            {
+                return FinishDigestContext(m_ctx, EVP_sha256(), false);
+            }
+
             class HMACRAIIGuard {
             public:
                 HMACRAIIGuard() {
@@ -411,29 +485,36 @@ namespace Aws
 
             CryptoBuffer OpenSSLCipher::EncryptBuffer(const CryptoBuffer& unEncryptedData)
             {
+                CryptoBuffer encryptedText(unEncryptedData.GetLength() + GetBlockSizeBytes());
+                size_t lengthWritten = EncryptBufferTo(unEncryptedData.GetUnderlyingData(), unEncryptedData.GetLength(), encryptedText.GetUnderlyingData());
                 if (m_failure)
                 {
-                    AWS_LOGSTREAM_FATAL(OPENSSL_LOG_TAG, "Cipher not properly initialized for encryption. Aborting");
                     return CryptoBuffer();
                 }
 
-                int lengthWritten = static_cast<int>(unEncryptedData.GetLength() + (GetBlockSizeBytes() - 1));
-                CryptoBuffer encryptedText(static_cast<size_t>( lengthWritten + (GetBlockSizeBytes() - 1)));
+                if (lengthWritten < encryptedText.GetLength())
+                {
+                    return CryptoBuffer(encryptedText.GetUnderlyingData(), lengthWritten);
+                }
+                return encryptedText;
+            }
 
-                if (!EVP_EncryptUpdate(m_encryptor_ctx, encryptedText.GetUnderlyingData(), &lengthWritten,
-                                       unEncryptedData.GetUnderlyingData(),
-                                       static_cast<int>(unEncryptedData.GetLength())))
+            size_t OpenSSLCipher::EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output)
+            {
+                if (m_failure)
                 {
-                    m_failure = true;
-                    LogErrors();
-                    return CryptoBuffer();
+                    AWS_LOGSTREAM_FATAL(OPENSSL_LOG_TAG, "Cipher not properly initialized for encryption. Aborting");
+                    return 0;
                 }
 
-                if (static_cast<size_t>(lengthWritten) < encryptedText.GetLength())
+                int lengthWritten = 0;
+                if (!EVP_EncryptUpdate(m_encryptor_ctx, output, &lengthWritten, data, static_cast<int>(length)))
                 {
-                    return CryptoBuffer(encryptedText.GetUnderlyingData(), static_cast<size_t>(lengthWritten));
+                    m_failure = true;
+                    LogErrors();
+                    return 0;
                 }
-                return encryptedText;
+                return static_cast<size_t>(lengthWritten);
             }
 
             CryptoBuffer OpenSSLCipher::FinalizeEncryption()
@@ -457,33 +538,41 @@ namespace Aws
 
             CryptoBuffer OpenSSLCipher::DecryptBuffer(const CryptoBuffer& encryptedData)
             {
+                CryptoBuffer decryptedText(encryptedData.GetLength() + GetBlockSizeBytes());
+                size_t lengthWritten = DecryptBufferTo(encryptedData.GetUnderlyingData(), encryptedData.GetLength(), decryptedText.GetUnderlyingData());
                 if (m_failure)
                 {
-                    AWS_LOGSTREAM_FATAL(OPENSSL_LOG_TAG, "Cipher not properly initialized for decryption. Aborting");
                     return CryptoBuffer();
                 }
 
-                int lengthWritten = static_cast<int>(encryptedData.GetLength() + (GetBlockSizeBytes() - 1));
-                CryptoBuffer decryptedText(static_cast<size_t>(lengthWritten));
+                if (lengthWritten < decryptedText.GetLength())
+                {
+                    return CryptoBuffer(decryptedText.GetUnderlyingData(), lengthWritten);
+                }
+                return decryptedText;
+            }
+
+            size_t OpenSSLCipher::DecryptBufferTo(const unsigned char* data, size_t length, unsigned char* output)
+            {
+                if (m_failure)
+                {
+                    AWS_LOGSTREAM_FATAL(OPENSSL_LOG_TAG, "Cipher not properly initialized for decryption. Aborting");
+                    return 0;
+                }
 
-                if (!EVP_DecryptUpdate(m_decryptor_ctx, decryptedText.GetUnderlyingData(), &lengthWritten,
-                                       encryptedData.GetUnderlyingData(),
-                                       static_cast<int>(encryptedData.GetLength())))
+                int lengthWritten = 0;
+                if (!EVP_DecryptUpdate(m_decryptor_ctx, output, &lengthWritten, data, static_cast<int>(length)))
                 {
                     m_failure = true;
                     LogErrors();
-                    return CryptoBuffer();
+                    return 0;
                 }
 
                 if (lengthWritten == 0)
                 {
                     m_emptyPlaintext = true;
                 }
-                if (static_cast<size_t>(lengthWritten) < decryptedText.GetLength())
-                {
-                    return CryptoBuffer(decryptedText.GetUnderlyingData(), static_cast<size_t>(lengthWritten));
-                }
-                return decryptedText;
+                return static_cast<size_t>(lengthWritten);
             }
 
             CryptoBuffer OpenSSLCipher::FinalizeDecryption()
@@ -19,8 +19,17 @@ namespace Aws
 
             EventEncoderStream& EventEncoderStream::WriteEvent(const Aws::Utils::Event::Message& msg)
             {
-                auto bits = m_encoder.EncodeAndSign(msg);
-                write(reinterpret_cast<char*>(bits.data()), bits.size());
+                m_encodedEvents.clear();
+                m_encoder.EncodeAndSign(msg, m_encodedEvents);
+                write(reinterpret_cast<char*>(m_encodedEvents.data()), m_encodedEvents.size());
+                return *this;
+            }
+
+            EventEncoderStream& EventEncoderStream::WriteEvents(const Aws::Vector<Aws::Utils::Event::Message>& msgs)
+            {
+                m_encodedEvents.clear();
+                m_encoder.EncodeAndSign(msgs, m_encodedEvents);
+                write(reinterpret_cast<char*>(m_encodedEvents.data()), m_encodedEvents.size());
                 return *this;
             }
         }
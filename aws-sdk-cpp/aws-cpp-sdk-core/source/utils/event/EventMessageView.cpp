@@ -0,0 +1,265 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/event/EventMessageView.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Event
+        {
+            static const char EVENT_MESSAGE_VIEW_CLASS_TAG[] = "EventMessageView";
+
+            static bool IsStaticHeaderType(EventHeaderValue::EventHeaderType type, EventHeaderValue::EventHeaderType expected)
+            {
+                if (type == expected ||
+                    (expected == EventHeaderValue::EventHeaderType::BOOL_TRUE && type == EventHeaderValue::EventHeaderType::BOOL_FALSE))
+                {
+                    return true;
+                }
+                AWS_LOGSTREAM_ERROR(EVENT_MESSAGE_VIEW_CLASS_TAG, "Expected event header type is " << EventHeaderValue::GetNameForEventHeaderType(expected)
+                    << ", but encountered " << EventHeaderValue::GetNameForEventHeaderType(type));
+                return false;
+            }
+
+            bool EventHeaderView::IsNamed(const char* name) const
+            {
+                return m_name && strlen(name) == m_nameLength && memcmp(m_name, name, m_nameLength) == 0;
+            }
+
+            bool EventHeaderView::ValueEquals(const char* value) const
+            {
+                return m_type == EventHeaderValue::EventHeaderType::STRING &&
+                    strlen(value) == m_valueLength && memcmp(m_value, value, m_valueLength) == 0;
+            }
+
+            Aws::String EventHeaderView::GetValueAsString() const
+            {
+                if (m_type != EventHeaderValue::EventHeaderType::STRING)
+                {
+                    AWS_LOGSTREAM_ERROR(EVENT_MESSAGE_VIEW_CLASS_TAG, "Expected event header type is STRING, but encountered "
+                        << EventHeaderValue::GetNameForEventHeaderType(m_type));
+                    return {};
+                }
+                return Aws::String(reinterpret_cast<const char*>(m_value), m_valueLength);
+            }
+
+            bool EventHeaderView::GetValueAsBoolean() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::BOOL_TRUE) && m_staticValue != 0;
+            }
+
+            uint8_t EventHeaderView::GetValueAsByte() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::BYTE) ? static_cast<uint8_t>(m_staticValue) : 0;
+            }
+
+            int16_t EventHeaderView::GetValueAsInt16() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::INT16) ? static_cast<int16_t>(m_staticValue) : 0;
+            }
+
+            int32_t EventHeaderView::GetValueAsInt32() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::INT32) ? static_cast<int32_t>(m_staticValue) : 0;
+            }
+
+            int64_t EventHeaderView::GetValueAsInt64() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::INT64) ? m_staticValue : 0;
+            }
+
+            int64_t EventHeaderView::GetValueAsTimestamp() const
+            {
+                return IsStaticHeaderType(m_type, EventHeaderValue::EventHeaderType::TIMESTAMP) ? m_staticValue : 0;
+            }
+
+            EventHeaderValue EventHeaderView::ToEventHeaderValue() const
+            {
+                switch (m_type)
+                {
+                case EventHeaderValue::EventHeaderType::BOOL_TRUE:
+                case EventHeaderValue::EventHeaderType::BOOL_FALSE:
+                    return EventHeaderValue(m_staticValue != 0);
+                case EventHeaderValue::EventHeaderType::BYTE:
+                    return EventHeaderValue(static_cast<unsigned char>(m_staticValue));
+                case EventHeaderValue::EventHeaderType::INT16:
+                    return EventHeaderValue(static_cast<int16_t>(m_staticValue));
+                case EventHeaderValue::EventHeaderType::INT32:
+                    return EventHeaderValue(static_cast<int32_t>(m_staticValue));
+                case EventHeaderValue::EventHeaderType::INT64:
+                case EventHeaderValue::EventHeaderType::TIMESTAMP:
+                    return EventHeaderValue(m_staticValue, m_type);
+                case EventHeaderValue::EventHeaderType::BYTE_BUF:
+                    return EventHeaderValue(ByteBuffer(m_value, m_valueLength));
+                case EventHeaderValue::EventHeaderType::STRING:
+                    return EventHeaderValue(GetValueAsString());
+                default:
+                    AWS_LOGSTREAM_ERROR(EVENT_MESSAGE_VIEW_CLASS_TAG, "Unable to copy header of type "
+                        << EventHeaderValue::GetNameForEventHeaderType(m_type));
+                    return EventHeaderValue();
+                }
+            }
+
+            EventMessageView::EventMessageView() :
+                m_payload(nullptr), m_payloadLength(0), m_expectedPayloadLength(0)
+            {
+            }
+
+            const EventHeaderView* EventMessageView::FindHeader(const char* name) const
+            {
+                for (const auto& header : m_headers)
+                {
+                    if (header.IsNamed(name))
+                    {
+                        return &header;
+                    }
+                }
+                return nullptr;
+            }
+
+            Aws::String EventMessageView::GetPayloadAsString() const
+            {
+                return m_payloadLength ? Aws::String(reinterpret_cast<const char*>(m_payload), m_payloadLength) : Aws::String();
+            }
+
+            Aws::Vector<unsigned char> EventMessageView::CopyPayload() const
+            {
+                return m_payloadLength ? Aws::Vector<unsigned char>(m_payload, m_payload + m_payloadLength) : Aws::Vector<unsigned char>();
+            }
+
+            void EventMessageView::Reset()
+            {
+                m_headers.clear();
+                m_headerBytes.clear();
+                m_payload = nullptr;
+                m_payloadLength = 0;
+                m_expectedPayloadLength = 0;
+                m_payloadBuffer.clear();
+            }
+
+            void EventMessageView::Reserve(size_t headersLength, size_t payloadLength)
+            {
+                // Each header is encoded with at least 4 bytes of framing around its name and value,
+                // enough room for the null terminators we append, so this never needs to grow while decoding.
+                m_headerBytes.reserve(headersLength);
+                m_expectedPayloadLength = payloadLength;
+            }
+
+            char* EventMessageView::AppendHeaderBytes(const void* data, size_t length)
+            {
+                size_t offset = m_headerBytes.size();
+                if (m_headerBytes.capacity() < offset + length + 1)
+                {
+                    // Growing moves the bytes the existing views point at, rebase them onto the new buffer.
+                    const char* oldBase = m_headerBytes.data();
+                    Aws::Vector<std::pair<size_t, size_t>> offsets;
+                    offsets.reserve(m_headers.size());
+                    for (const auto& header : m_headers)
+                    {
+                        offsets.emplace_back(header.m_name - oldBase, header.m_value ? reinterpret_cast<const char*>(header.m_value) - oldBase : 0);
+                    }
+                    m_headerBytes.reserve((std::max)(m_headerBytes.capacity() * 2, offset + length + 1));
+                    const char* newBase = m_headerBytes.data();
+                    for (size_t i = 0; i < m_headers.size(); ++i)
+                    {
+                        m_headers[i].m_name = newBase + offsets[i].first;
+                        if (m_headers[i].m_value)
+                        {
+                            m_headers[i].m_value = reinterpret_cast<const unsigned char*>(newBase + offsets[i].second);
+                        }
+                    }
+                }
+
+                m_headerBytes.resize(offset + length + 1);
+                char* dest = m_headerBytes.data() + offset;
+                if (length)
+                {
+                    memcpy(dest, data, length);
+                }
+                dest[length] = '\0';
+                return dest;
+            }
+
+            void EventMessageView::AddHeader(aws_event_stream_header_value_pair* header)
+            {
+                EventHeaderView view;
+                view.m_type = static_cast<EventHeaderValue::EventHeaderType>(header->header_value_type);
+                switch (view.m_type)
+                {
+                case EventHeaderValue::EventHeaderType::BOOL_TRUE:
+                case EventHeaderValue::EventHeaderType::BOOL_FALSE:
+                    view.m_staticValue = aws_event_stream_header_value_as_bool(header) != 0;
+                    break;
+                case EventHeaderValue::EventHeaderType::BYTE:
+                    view.m_staticValue = static_cast<uint8_t>(aws_event_stream_header_value_as_byte(header));
+                    break;
+                case EventHeaderValue::EventHeaderType::INT16:
+                    view.m_staticValue = aws_event_stream_header_value_as_int16(header);
+                    break;
+                case EventHeaderValue::EventHeaderType::INT32:
+                    view.m_staticValue = aws_event_stream_header_value_as_int32(header);
+                    break;
+                case EventHeaderValue::EventHeaderType::INT64:
+                    view.m_staticValue = aws_event_stream_header_value_as_int64(header);
+                    break;
+                case EventHeaderValue::EventHeaderType::TIMESTAMP:
+                    view.m_staticValue = aws_event_stream_header_value_as_timestamp(header);
+                    break;
+                case EventHeaderValue::EventHeaderType::BYTE_BUF:
+                case EventHeaderValue::EventHeaderType::STRING:
+                case EventHeaderValue::EventHeaderType::UUID:
+                    break;
+                default:
+                    AWS_LOGSTREAM_ERROR(EVENT_MESSAGE_VIEW_CLASS_TAG, "Encountered unknown type of header.");
+                    view.m_type = EventHeaderValue::EventHeaderType::UNKNOWN;
+                    break;
+                }
+
+                view.m_nameLength = header->header_name_len;
+                size_t nameOffset = AppendHeaderBytes(header->header_name, header->header_name_len) - m_headerBytes.data();
+                if (view.m_type == EventHeaderValue::EventHeaderType::BYTE_BUF || view.m_type == EventHeaderValue::EventHeaderType::STRING)
+                {
+                    view.m_valueLength = header->header_value_len;
+                    view.m_value = reinterpret_cast<const unsigned char*>(AppendHeaderBytes(header->header_value.variable_len_val, view.m_valueLength));
+                }
+                else if (view.m_type == EventHeaderValue::EventHeaderType::UUID)
+                {
+                    view.m_valueLength = 16u;
+                    view.m_value = reinterpret_cast<const unsigned char*>(AppendHeaderBytes(header->header_value.static_val, view.m_valueLength));
+                }
+                // Appending the value may have moved the name.
+                view.m_name = m_headerBytes.data() + nameOffset;
+                m_headers.push_back(view);
+            }
+
+            void EventMessageView::WritePayload(const unsigned char* data, size_t length)
+            {
+                if (m_payloadLength == 0 && length == m_expectedPayloadLength)
+                {
+                    m_payload = data;
+                    m_payloadLength = length;
+                    return;
+                }
+
+                if (m_payloadBuffer.empty())
+                {
+                    m_payloadBuffer.reserve((std::max)(m_expectedPayloadLength, m_payloadLength + length));
+                    if (m_payloadLength)
+                    {
+                        m_payloadBuffer.assign(m_payload, m_payload + m_payloadLength);
+                    }
+                }
+                m_payloadBuffer.insert(m_payloadBuffer.end(), data, data + length);
+                m_payload = m_payloadBuffer.data();
+                m_payloadLength = m_payloadBuffer.size();
+            }
+        }
+    }
+}
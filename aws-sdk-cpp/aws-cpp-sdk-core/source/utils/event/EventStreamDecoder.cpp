@@ -42,7 +42,12 @@ namespace Aws
 
             void EventStreamDecoder::Pump(const ByteBuffer& data, size_t length)
             {
-                aws_byte_buf dataBuf = aws_byte_buf_from_array(static_cast<uint8_t*>(data.GetUnderlyingData()), length);
+                Pump(data.GetUnderlyingData(), length);
+            }
+
+            void EventStreamDecoder::Pump(const unsigned char* data, size_t length)
+            {
+                aws_byte_buf dataBuf = aws_byte_buf_from_array(data, length);
                 aws_event_stream_streaming_decoder_pump(&m_decoder, &dataBuf);
             }
 
@@ -137,8 +142,15 @@ namespace Aws
 
                 // The length of a header = 1 byte (to represent the length of header name) + length of header name + 1 byte (to represent header type)
                 //                          + 2 bytes (to represent length of header value) + length of header value
-                handler->InsertMessageEventHeader(Aws::String(header->header_name, header->header_name_len),
-                    1 + header->header_name_len + 1 + 2 + header->header_value_len, EventHeaderValue(header));
+                size_t headerLength = 1 + header->header_name_len + 1 + 2 + header->header_value_len;
+                if (handler->IsBorrowingMessages())
+                {
+                    handler->InsertMessageEventHeaderView(header, headerLength);
+                }
+                else
+                {
+                    handler->InsertMessageEventHeader(Aws::String(header->header_name, header->header_name_len), headerLength, EventHeaderValue(header));
+                }
 
                 // Handle messages only have headers, but without payload.
                 //if (handler->m_message.GetHeadersLength() == handler->m_headersBytesReceived() && handler->m_message.GetPayloadLength() == 0)
@@ -8,10 +8,10 @@
 #include <aws/core/utils/event/EventStreamEncoder.h>
 #include <aws/core/utils/logging/LogMacros.h>
 #include <aws/core/auth/AWSAuthSigner.h>
-#include <aws/common/byte_order.h>
-#include <aws/core/utils/memory/AWSMemory.h>
+#include <aws/checksums/crc.h>
 
 #include <cassert>
+#include <cstring>
 
 namespace Aws
 {
@@ -21,58 +21,124 @@ namespace Aws
         {
             static const char TAG[] = "EventStreamEncoder";
 
-            static void EncodeHeaders(const Aws::Utils::Event::Message& msg, aws_array_list* headers)
+            // total byte-length + headers byte-length + prelude crc
+            static const size_t PRELUDE_LENGTH = 12;
+            static const size_t MESSAGE_CRC_LENGTH = 4;
+            // Length of the HMAC-SHA256 digest carried by the signature header.
+            static const size_t SIGNATURE_LENGTH = 32;
+
+            static unsigned char* WriteBigEndian(unsigned char* out, uint64_t value, size_t length)
             {
-                aws_array_list_init_dynamic(headers, get_aws_allocator(), msg.GetEventHeaders().size(), sizeof(aws_event_stream_header_value_pair));
-                for (auto&& header : msg.GetEventHeaders())
+                for (size_t i = 0; i < length; ++i)
                 {
-                    const uint8_t headerKeyLen = static_cast<uint8_t>(header.first.length());
-                    switch(header.second.GetType())
+                    out[i] = static_cast<unsigned char>(value >> (8 * (length - 1 - i)));
+                }
+                return out + length;
+            }
+
+            /**
+             * Length of a header once encoded: name byte-length(1 byte) + name + value type(1 byte) + value,
+             * where variable length values are prefixed with their 2 bytes length. 0 for headers that can't be encoded.
+             */
+            static size_t GetEncodedHeaderLength(size_t nameLength, const EventHeaderValue& value)
+            {
+                size_t valueLength = 0;
+                switch (value.GetType())
+                {
+                case EventHeaderValue::EventHeaderType::BOOL_TRUE:
+                case EventHeaderValue::EventHeaderType::BOOL_FALSE:
+                    break;
+                case EventHeaderValue::EventHeaderType::BYTE:
+                    valueLength = 1;
+                    break;
+                case EventHeaderValue::EventHeaderType::INT16:
+                    valueLength = 2;
+                    break;
+                case EventHeaderValue::EventHeaderType::INT32:
+                    valueLength = 4;
+                    break;
+                case EventHeaderValue::EventHeaderType::INT64:
+                case EventHeaderValue::EventHeaderType::TIMESTAMP:
+                    valueLength = 8;
+                    break;
+                case EventHeaderValue::EventHeaderType::BYTE_BUF:
+                case EventHeaderValue::EventHeaderType::STRING:
+                    valueLength = 2 + value.GetUnderlyingBuffer().GetLength();
+                    break;
+                case EventHeaderValue::EventHeaderType::UUID:
+                    valueLength = 16;
+                    break;
+                default:
+                    return 0;
+                }
+                return 1 + nameLength + 1 + valueLength;
+            }
+
+            static size_t GetEncodedHeadersLength(const EventHeaderValueCollection& headers)
+            {
+                size_t headersLength = 0;
+                for (const auto& header : headers)
+                {
+                    headersLength += GetEncodedHeaderLength(header.first.length(), header.second);
+                }
+                return headersLength;
+            }
+
+            static unsigned char* WriteHeader(unsigned char* out, const char* name, size_t nameLength, const EventHeaderValue& value)
+            {
+                if (GetEncodedHeaderLength(nameLength, value) == 0)
+                {
+                    AWS_LOG_ERROR(TAG, "Encountered unknown type of header.");
+                    return out;
+                }
+
+                *out++ = static_cast<unsigned char>(nameLength);
+                memcpy(out, name, nameLength);
+                out += nameLength;
+                *out++ = static_cast<unsigned char>(value.GetType());
+                switch (value.GetType())
+                {
+                case EventHeaderValue::EventHeaderType::BYTE:
+                    return WriteBigEndian(out, value.GetEventHeaderValueAsByte(), 1);
+                case EventHeaderValue::EventHeaderType::INT16:
+                    return WriteBigEndian(out, static_cast<uint16_t>(value.GetEventHeaderValueAsInt16()), 2);
+                case EventHeaderValue::EventHeaderType::INT32:
+                    return WriteBigEndian(out, static_cast<uint32_t>(value.GetEventHeaderValueAsInt32()), 4);
+                case EventHeaderValue::EventHeaderType::INT64:
+                    return WriteBigEndian(out, static_cast<uint64_t>(value.GetEventHeaderValueAsInt64()), 8);
+                case EventHeaderValue::EventHeaderType::TIMESTAMP:
+                    return WriteBigEndian(out, static_cast<uint64_t>(value.GetEventHeaderValueAsTimestamp()), 8);
+                case EventHeaderValue::EventHeaderType::BYTE_BUF:
+                case EventHeaderValue::EventHeaderType::STRING:
+                {
+                    const auto& bytes = value.GetUnderlyingBuffer();
+                    out = WriteBigEndian(out, bytes.GetLength(), 2);
+                    if (bytes.GetLength())
                     {
-                        case EventHeaderValue::EventHeaderType::BOOL_TRUE:
-                        case EventHeaderValue::EventHeaderType::BOOL_FALSE:
-                            aws_event_stream_add_bool_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsBoolean());
-                            break;
-                        case EventHeaderValue::EventHeaderType::BYTE:
-                            aws_event_stream_add_bool_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsByte());
-                            break;
-                        case EventHeaderValue::EventHeaderType::INT16:
-                            aws_event_stream_add_int16_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsInt16());
-                            break;
-                        case EventHeaderValue::EventHeaderType::INT32:
-                            aws_event_stream_add_int32_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsInt32());
-                            break;
-                        case EventHeaderValue::EventHeaderType::INT64:
-                            aws_event_stream_add_int64_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsInt64());
-                            break;
-                        case EventHeaderValue::EventHeaderType::BYTE_BUF:
-                            {
-                                const auto& bytes = header.second.GetEventHeaderValueAsBytebuf();
-                                aws_event_stream_add_bytebuf_header(headers, header.first.c_str(), headerKeyLen, bytes.GetUnderlyingData(), static_cast<uint16_t>(bytes.GetLength()), 1 /*copy*/);
-                            }
-                            break;
-                        case EventHeaderValue::EventHeaderType::STRING:
-                            {
-                                const auto& bytes = header.second.GetUnderlyingBuffer();
-                                aws_event_stream_add_string_header(headers, header.first.c_str(), headerKeyLen, reinterpret_cast<char*>(bytes.GetUnderlyingData()), static_cast<uint16_t>(bytes.GetLength()), 0 /*copy*/);
-                            }
-                            break;
-                        case EventHeaderValue::EventHeaderType::TIMESTAMP:
-                            aws_event_stream_add_timestamp_header(headers, header.first.c_str(), headerKeyLen, header.second.GetEventHeaderValueAsTimestamp());
-                            break;
-                        case EventHeaderValue::EventHeaderType::UUID:
-                            {
-                                ByteBuffer uuidBytes = header.second.GetEventHeaderValueAsUuid();
-                                aws_event_stream_add_uuid_header(headers, header.first.c_str(), headerKeyLen, uuidBytes.GetUnderlyingData());
-                            }
-                            break;
-                        default:
-                            AWS_LOG_ERROR(TAG, "Encountered unknown type of header.");
-                            break;
+                        memcpy(out, bytes.GetUnderlyingData(), bytes.GetLength());
                     }
+                    return out + bytes.GetLength();
+                }
+                case EventHeaderValue::EventHeaderType::UUID:
+                    memcpy(out, value.GetUnderlyingBuffer().GetUnderlyingData(), 16);
+                    return out + 16;
+                default:
+                    return out;
                 }
             }
 
+            /**
+             * Fills in the prelude and both checksums of a frame whose headers and payload are already in place.
+             */
+            static void CompleteFrame(unsigned char* frame, size_t totalLength, size_t headersLength)
+            {
+                WriteBigEndian(frame, totalLength, 4);
+                WriteBigEndian(frame + 4, headersLength, 4);
+                WriteBigEndian(frame + 8, aws_checksums_crc32(frame, 8, 0), 4);
+                const size_t messageCrcOffset = totalLength - MESSAGE_CRC_LENGTH;
+                WriteBigEndian(frame + messageCrcOffset, aws_checksums_crc32(frame, static_cast<int>(messageCrcOffset), 0), 4);
+            }
+
             EventStreamEncoder::EventStreamEncoder(Client::AWSAuthSigner* signer) : m_signer(signer)
             {
             }
@@ -80,83 +146,98 @@ namespace Aws
 
             Aws::Vector<unsigned char> EventStreamEncoder::EncodeAndSign(const Aws::Utils::Event::Message& msg)
             {
-                aws_event_stream_message encoded = Encode(msg);
-                aws_event_stream_message signedMessage = Sign(&encoded);
-
-                const auto signedMessageLength = signedMessage.message_buffer ? aws_event_stream_message_total_length(&signedMessage) : 0;
-
-                Aws::Vector<unsigned char> outputBits(signedMessage.message_buffer, signedMessage.message_buffer + signedMessageLength);
-                aws_event_stream_message_clean_up(&encoded);
-                aws_event_stream_message_clean_up(&signedMessage);
+                Aws::Vector<unsigned char> outputBits;
+                EncodeAndSign(msg, outputBits);
                 return outputBits;
             }
 
-            aws_event_stream_message EventStreamEncoder::Encode(const Aws::Utils::Event::Message& msg)
+            bool EventStreamEncoder::EncodeAndSign(const Aws::Vector<Aws::Utils::Event::Message>& msgs, Aws::Vector<unsigned char>& output)
             {
-                aws_array_list headers;
-                EncodeHeaders(msg, &headers);
-
-                aws_byte_buf payload;
-                payload.len = msg.GetEventPayload().size();
-                // this const_cast is OK because aws_byte_buf will only be "read from" by the following functions.
-                payload.buffer = const_cast<uint8_t*>(msg.GetEventPayload().data());
-                payload.capacity = 0;
-                payload.allocator = nullptr;
-
-                aws_event_stream_message encoded;
-                if(aws_event_stream_message_init(&encoded, get_aws_allocator(), &headers, &payload) == AWS_OP_ERR)
+                for (const auto& msg : msgs)
                 {
-                    AWS_LOGSTREAM_ERROR(TAG, "Error creating event-stream message from payload.");
-                    aws_event_stream_headers_list_cleanup(&headers);
-                    // GCC 4.9.4 issues a warning with -Wextra if we simply do
-                    // return {};
-                    aws_event_stream_message empty{nullptr, nullptr, 0};
-                    return empty;
+                    if (!EncodeAndSign(msg, output))
+                    {
+                        return false;
+                    }
                 }
-                aws_event_stream_headers_list_cleanup(&headers);
-                return encoded;
+                return true;
             }
 
-            aws_event_stream_message EventStreamEncoder::Sign(aws_event_stream_message* msg)
+            bool EventStreamEncoder::EncodeAndSign(const Aws::Utils::Event::Message& msg, Aws::Vector<unsigned char>& output)
             {
-                const auto msglen = msg->message_buffer ? aws_event_stream_message_total_length(msg) : 0;
-                Event::Message signedMessage;
-                signedMessage.WriteEventPayload(msg->message_buffer, msglen);
-
                 assert(m_signer);
-                if (!m_signer->SignEventMessage(signedMessage, m_signatureSeed))
+                if (!m_signer)
                 {
                     AWS_LOGSTREAM_ERROR(TAG, "Failed to sign event message frame.");
-                    // GCC 4.9.4 issues a warning with -Wextra if we simply do
-                    // return {};
-                    aws_event_stream_message empty{nullptr, nullptr, 0};
-                    return empty;
+                    return false;
+                }
+
+                const size_t dateHeaderNameLength = strlen(Aws::Auth::EVENTSTREAM_DATE_HEADER);
+                const size_t signatureHeaderNameLength = strlen(Aws::Auth::EVENTSTREAM_SIGNATURE_HEADER);
+                const size_t signedHeadersLength = (1 + signatureHeaderNameLength + 1 + 2 + SIGNATURE_LENGTH) + (1 + dateHeaderNameLength + 1 + 8);
+
+                // Frame the message where it ends up once wrapped by the signed frame, so it is never copied.
+                const size_t start = output.size();
+                const size_t headersLength = GetEncodedHeadersLength(msg.GetEventHeaders());
+                const size_t payloadLength = msg.GetEventPayload().size();
+                const size_t frameLength = PRELUDE_LENGTH + headersLength + payloadLength + MESSAGE_CRC_LENGTH;
+                size_t frameOffset = start + PRELUDE_LENGTH + signedHeadersLength;
+                output.resize(frameOffset + frameLength + MESSAGE_CRC_LENGTH);
+
+                unsigned char* out = output.data() + frameOffset + PRELUDE_LENGTH;
+                for (const auto& header : msg.GetEventHeaders())
+                {
+                    out = WriteHeader(out, header.first.c_str(), header.first.length(), header.second);
+                }
+                if (payloadLength)
+                {
+                    memcpy(out, msg.GetEventPayload().data(), payloadLength);
                 }
+                CompleteFrame(output.data() + frameOffset, frameLength, headersLength);
+
+                int64_t signingTimeMillis = 0;
+                Aws::Utils::ByteBuffer signature;
+                if (m_signer->SignEncodedEventMessage(output.data() + frameOffset, frameLength, m_signatureSeed, signingTimeMillis, signature))
+                {
+                    // The signature seed has already moved on, signing the frame again would break the signature chain.
+                    if (signature.GetLength() != SIGNATURE_LENGTH)
+                    {
+                        AWS_LOGSTREAM_ERROR(TAG, "Failed to sign event message frame, unexpected signature length: " << signature.GetLength());
+                        output.resize(start);
+                        return false;
+                    }
 
-                aws_array_list headers;
-                EncodeHeaders(signedMessage, &headers);
+                    // Headers are written in the same (sorted) order the header map of a signed Message yields.
+                    out = output.data() + start + PRELUDE_LENGTH;
+                    out = WriteHeader(out, Aws::Auth::EVENTSTREAM_SIGNATURE_HEADER, signatureHeaderNameLength, EventHeaderValue(std::move(signature)));
+                    WriteHeader(out, Aws::Auth::EVENTSTREAM_DATE_HEADER, dateHeaderNameLength,
+                        EventHeaderValue(signingTimeMillis, EventHeaderValue::EventHeaderType::TIMESTAMP));
+                    CompleteFrame(output.data() + start, output.size() - start, signedHeadersLength);
+                    return true;
+                }
 
-                aws_byte_buf payload;
-                payload.len = signedMessage.GetEventPayload().size();
-                payload.buffer = signedMessage.GetEventPayload().data();
-                payload.capacity = 0;
-                payload.allocator = nullptr;
+                // The signer doesn't sign encoded messages in place, wrap the frame with whatever headers SignEventMessage() adds.
+                Event::Message signedMessage;
+                signedMessage.WriteEventPayload(output.data() + frameOffset, frameLength);
+                if (!m_signer->SignEventMessage(signedMessage, m_signatureSeed))
+                {
+                    AWS_LOGSTREAM_ERROR(TAG, "Failed to sign event message frame.");
+                    output.resize(start);
+                    return false;
+                }
 
-                aws_event_stream_message signedmsg;
-                if(aws_event_stream_message_init(&signedmsg, get_aws_allocator(), &headers, &payload))
+                const size_t envelopeHeadersLength = GetEncodedHeadersLength(signedMessage.GetEventHeaders());
+                output.resize(start + PRELUDE_LENGTH + envelopeHeadersLength + frameLength + MESSAGE_CRC_LENGTH);
+                out = output.data() + start + PRELUDE_LENGTH;
+                for (const auto& header : signedMessage.GetEventHeaders())
                 {
-                    AWS_LOGSTREAM_ERROR(TAG, "Error creating event-stream message from payload.");
-                    aws_event_stream_headers_list_cleanup(&headers);
-                    // GCC 4.9.4 issues a warning with -Wextra if we simply do
-                    // return {};
-                    aws_event_stream_message empty{nullptr, nullptr, 0};
-                    return empty;
+                    out = WriteHeader(out, header.first.c_str(), header.first.length(), header.second);
                 }
-                aws_event_stream_headers_list_cleanup(&headers);
-                return signedmsg;
+                memcpy(out, signedMessage.GetEventPayload().data(), frameLength);
+                CompleteFrame(output.data() + start, output.size() - start, envelopeHeadersLength);
+                return true;
             }
 
         } // namespace Event
     } // namespace Utils
 } // namespace Aws
-
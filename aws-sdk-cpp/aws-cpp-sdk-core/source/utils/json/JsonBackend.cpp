@@ -0,0 +1,1019 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/json/JsonBackend.h>
+
+#ifdef ENABLE_CJSON_BACKEND
+
+#include <aws/core/utils/UnreferencedParam.h>
+
+using namespace Aws::Utils::Json;
+
+const char* Backend::GetName()
+{
+    return "cjson";
+}
+
+cJSON* Backend::Parse(const char* json, size_t length, const char** errorPosition)
+{
+    AWS_UNREFERENCED_PARAM(length);
+    const char* parseEnd = nullptr;
+    cJSON* root = cJSON_ParseWithOpts(json, &parseEnd, 1/*require_null_terminated*/);
+    if (!root || cJSON_IsInvalid(root))
+    {
+        cJSON_Delete(root);
+        if (errorPosition)
+        {
+            *errorPosition = parseEnd;
+        }
+        return nullptr;
+    }
+    return root;
+}
+
+Aws::String Backend::Print(const cJSON* item, bool formatted)
+{
+    char* printed = formatted ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+    if (!printed)
+    {
+        return {};
+    }
+    Aws::String out(printed);
+    cJSON_free(printed);
+    return out;
+}
+
+#else
+
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_BACKEND_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace Aws::Utils::Json;
+
+namespace
+{
+    const size_t BLOCK_SIZE = 64;
+    //same limits as cJSON's parser
+    const size_t MAX_NUMBER_LENGTH = 63;
+    const int ITEM_FLAGS = cJSON_ArenaValue | cJSON_ArenaItem;
+
+    inline unsigned CountTrailingZeros(uint64_t bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
+
+    inline unsigned CountBits(uint64_t bits)
+    {
+#ifdef _MSC_VER
+        return static_cast<unsigned>(__popcnt64(bits));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+    }
+
+    /**
+     * Carry-less prefix xor: bit i of the result is the xor of bits 0 to i, turning the positions of quotes into the
+     * spans between them.
+     */
+    inline uint64_t PrefixXor(uint64_t bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    inline bool IsWhitespace(unsigned char c)
+    {
+        //cJSON skips anything up to and including the space character
+        return c <= ' ';
+    }
+
+    inline bool IsOperator(unsigned char c)
+    {
+        return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+    }
+
+    inline bool IsNumberCharacter(unsigned char c)
+    {
+        return (c >= '0' && c <= '9') || c == '+' || c == '-' || c == 'e' || c == 'E' || c == '.';
+    }
+
+    /**
+     * Character classes of a 64 byte block, bit i standing for byte i.
+     */
+    struct BlockMasks
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;
+        uint64_t whitespace;
+    };
+
+    void ClassifyBlock(const unsigned char* block, BlockMasks& masks)
+    {
+#ifdef JSON_BACKEND_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        //'[' and ']' are '{' and '}' without the 0x20 bit
+        const __m128i openBrace = _mm_set1_epi8('{');
+        const __m128i closeBrace = _mm_set1_epi8('}');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+
+        masks.quote = masks.backslash = masks.op = masks.whitespace = 0;
+        for (unsigned i = 0; i < BLOCK_SIZE / 16; ++i)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+            const __m128i folded = _mm_or_si128(chunk, caseBit);
+            const __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, openBrace), _mm_cmpeq_epi8(folded, closeBrace)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+            const __m128i whitespace = _mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk);
+
+            const unsigned shift = i * 16;
+            masks.quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)))) << shift;
+            masks.backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)))) << shift;
+            masks.op |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(op))) << shift;
+            masks.whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(whitespace))) << shift;
+        }
+#else
+        masks.quote = masks.backslash = masks.op = masks.whitespace = 0;
+        for (unsigned i = 0; i < BLOCK_SIZE; ++i)
+        {
+            const uint64_t bit = 1ULL << i;
+            const unsigned char c = block[i];
+            masks.quote |= c == '"' ? bit : 0;
+            masks.backslash |= c == '\\' ? bit : 0;
+            masks.op |= IsOperator(c) ? bit : 0;
+            masks.whitespace |= IsWhitespace(c) ? bit : 0;
+        }
+#endif
+    }
+
+    /**
+     * Builds the structural index of a document: the offsets of its operators, of the opening quote of every string and of
+     * the first character of every other scalar, in document order. Returns false if a string isn't terminated.
+     */
+    bool BuildIndex(const unsigned char* json, size_t length, Aws::Vector<size_t>& index)
+    {
+        uint64_t previousEscaped = 0;
+        uint64_t previousInString = 0;
+        uint64_t previousScalar = 0;
+        unsigned char tail[BLOCK_SIZE];
+
+        for (size_t offset = 0; offset < length; offset += BLOCK_SIZE)
+        {
+            const unsigned char* block = json + offset;
+            if (length - offset < BLOCK_SIZE)
+            {
+                memset(tail, ' ', sizeof(tail));
+                memcpy(tail, block, length - offset);
+                block = tail;
+            }
+
+            BlockMasks masks;
+            ClassifyBlock(block, masks);
+
+            //characters escaped by a backslash: the odd positions of every run of backslashes are escapes, a run starting
+            //on an odd bit is found by adding its start to it, which carries through the run.
+            const uint64_t evenBits = 0x5555555555555555ULL;
+            const uint64_t backslash = masks.backslash & ~previousEscaped;
+            const uint64_t followsEscape = (backslash << 1) | previousEscaped;
+            const uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+            const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+            previousEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+            const uint64_t escaped = (evenBits ^ (sequencesStartingOnEvenBits << 1)) & followsEscape;
+
+            const uint64_t quotes = masks.quote & ~escaped;
+            //set from an opening quote up to, not including, its closing quote
+            const uint64_t inString = PrefixXor(quotes) ^ previousInString;
+            previousInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+            const uint64_t scalar = ~(masks.op | masks.whitespace | quotes | inString);
+            const uint64_t scalarStarts = scalar & ~((scalar << 1) | previousScalar);
+            previousScalar = scalar >> 63;
+
+            uint64_t structurals = (masks.op & ~inString) | (quotes & inString) | scalarStarts;
+            size_t position = index.size();
+            index.resize(position + CountBits(structurals));
+            while (structurals)
+            {
+                index[position++] = offset + CountTrailingZeros(structurals);
+                structurals &= structurals - 1;
+            }
+        }
+
+        return previousInString == 0;
+    }
+
+    unsigned ParseHex4(const char* input, bool& valid)
+    {
+        unsigned value = 0;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            const char c = input[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+            {
+                value |= static_cast<unsigned>(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                value |= static_cast<unsigned>(c - 'a' + 10);
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                value |= static_cast<unsigned>(c - 'A' + 10);
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+        return value;
+    }
+
+    /**
+     * Builds a cJSON document from the structural index of its text. The items and all their strings are carved out of a
+     * single allocation, sized from the index, the root item at its start so that cJSON_Delete of the root releases it.
+     */
+    class IndexedParser
+    {
+    public:
+        IndexedParser(const char* json, size_t length) :
+            m_json(json), m_end(json + length), m_next(0), m_block(nullptr), m_items(nullptr), m_itemCount(0), m_itemsUsed(0),
+            m_strings(nullptr), m_error(json)
+        {
+        }
+
+        cJSON* Parse(const char** errorPosition)
+        {
+            //skip a utf-8 byte order mark, like cJSON
+            if (m_end - m_json > 3 && memcmp(m_json, "\xEF\xBB\xBF", 3) == 0)
+            {
+                m_json += 3;
+            }
+
+            const size_t length = static_cast<size_t>(m_end - m_json);
+            if (!BuildIndex(reinterpret_cast<const unsigned char*>(m_json), length, m_index))
+            {
+                return Fail(m_end, errorPosition);
+            }
+            if (m_index.empty())
+            {
+                return Fail(m_end, errorPosition);
+            }
+
+            //one item per object, array and scalar, less the keys, each of which is followed by a colon.
+            size_t values = 0;
+            size_t colons = 0;
+            for (auto position : m_index)
+            {
+                const char c = m_json[position];
+                if (c == ':')
+                {
+                    ++colons;
+                }
+                else if (c != ',' && c != '}' && c != ']')
+                {
+                    ++values;
+                }
+            }
+            m_itemCount = values > colons ? values - colons : 1;
+            //strings shrink when unescaped and number literals are copied as is, so the text bounds them, plus a terminator each
+            const size_t stringBytes = length + m_index.size() + 1;
+
+            m_block = static_cast<char*>(cJSON_malloc(m_itemCount * sizeof(cJSON) + stringBytes));
+            if (!m_block)
+            {
+                return Fail(m_json, errorPosition);
+            }
+            m_items = reinterpret_cast<cJSON*>(m_block);
+            m_strings = m_block + m_itemCount * sizeof(cJSON);
+
+            cJSON* root = NewItem();
+            if (!ParseValue(root, cJSON_ArenaValue, 0))
+            {
+                return Fail(m_error, errorPosition);
+            }
+            if (m_next != m_index.size())
+            {
+                //trailing content after the document
+                return Fail(m_json + m_index[m_next], errorPosition);
+            }
+            return root;
+        }
+
+    private:
+        cJSON* Fail(const char* position, const char** errorPosition)
+        {
+            if (m_block)
+            {
+                cJSON_free(m_block);
+                m_block = nullptr;
+            }
+            if (errorPosition)
+            {
+                *errorPosition = position;
+            }
+            return nullptr;
+        }
+
+        bool SetError(const char* position)
+        {
+            m_error = position;
+            return false;
+        }
+
+        cJSON* NewItem()
+        {
+            if (m_itemsUsed == m_itemCount)
+            {
+                return nullptr;
+            }
+            cJSON* item = m_items + m_itemsUsed++;
+            memset(item, 0, sizeof(cJSON));
+            return item;
+        }
+
+        char PeekStructural() const
+        {
+            return m_next < m_index.size() ? m_json[m_index[m_next]] : '\0';
+        }
+
+        const char* NextStructural()
+        {
+            return m_next < m_index.size() ? m_json + m_index[m_next++] : nullptr;
+        }
+
+        bool IsTokenEnd(const char* position) const
+        {
+            if (position == m_end)
+            {
+                return true;
+            }
+            const unsigned char c = static_cast<unsigned char>(*position);
+            return IsWhitespace(c) || IsOperator(c) || c == '"';
+        }
+
+        bool ParseValue(cJSON* item, int flags, size_t depth)
+        {
+            const char* at = NextStructural();
+            if (!at)
+            {
+                return SetError(m_end);
+            }
+
+            switch (*at)
+            {
+                case '{':
+                    return ParseObject(item, flags, depth, at);
+                case '[':
+                    return ParseArray(item, flags, depth, at);
+                case '"':
+                    item->type = cJSON_String | flags;
+                    return ParseString(at, item->valuestring);
+                case 'n':
+                    return ParseLiteral(item, flags, at, "null", cJSON_NULL);
+                case 't':
+                    item->valueint = 1;
+                    return ParseLiteral(item, flags, at, "true", cJSON_True);
+                case 'f':
+                    return ParseLiteral(item, flags, at, "false", cJSON_False);
+                default:
+                    if (*at == '-' || (*at >= '0' && *at <= '9'))
+                    {
+                        return ParseNumber(item, flags, at);
+                    }
+                    return SetError(at);
+            }
+        }
+
+        bool ParseObject(cJSON* item, int flags, size_t depth, const char* at)
+        {
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return SetError(at);
+            }
+            item->type = cJSON_Object | flags;
+            if (PeekStructural() == '}')
+            {
+                ++m_next;
+                return true;
+            }
+
+            cJSON* last = nullptr;
+            for (;;)
+            {
+                const char* keyAt = NextStructural();
+                if (!keyAt || *keyAt != '"')
+                {
+                    return SetError(keyAt ? keyAt : m_end);
+                }
+                cJSON* child = NewItem();
+                if (!child)
+                {
+                    return SetError(keyAt);
+                }
+                if (!ParseString(keyAt, child->string))
+                {
+                    return false;
+                }
+                const char* colon = NextStructural();
+                if (!colon || *colon != ':')
+                {
+                    return SetError(colon ? colon : m_end);
+                }
+                if (!ParseValue(child, ITEM_FLAGS | cJSON_StringIsConst, depth + 1))
+                {
+                    return false;
+                }
+
+                if (last)
+                {
+                    last->next = child;
+                    child->prev = last;
+                }
+                else
+                {
+                    item->child = child;
+                }
+                last = child;
+
+                const char* separator = NextStructural();
+                if (!separator)
+                {
+                    return SetError(m_end);
+                }
+                if (*separator == '}')
+                {
+                    return true;
+                }
+                if (*separator != ',')
+                {
+                    return SetError(separator);
+                }
+            }
+        }
+
+        bool ParseArray(cJSON* item, int flags, size_t depth, const char* at)
+        {
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return SetError(at);
+            }
+            item->type = cJSON_Array | flags;
+            if (PeekStructural() == ']')
+            {
+                ++m_next;
+                return true;
+            }
+
+            cJSON* last = nullptr;
+            for (;;)
+            {
+                cJSON* child = NewItem();
+                if (!child)
+                {
+                    return SetError(at);
+                }
+                if (!ParseValue(child, ITEM_FLAGS, depth + 1))
+                {
+                    return false;
+                }
+
+                if (last)
+                {
+                    last->next = child;
+                    child->prev = last;
+                }
+                else
+                {
+                    item->child = child;
+                }
+                last = child;
+
+                const char* separator = NextStructural();
+                if (!separator)
+                {
+                    return SetError(m_end);
+                }
+                if (*separator == ']')
+                {
+                    return true;
+                }
+                if (*separator != ',')
+                {
+                    return SetError(separator);
+                }
+            }
+        }
+
+        bool ParseLiteral(cJSON* item, int flags, const char* at, const char* literal, int type)
+        {
+            const size_t length = strlen(literal);
+            if (static_cast<size_t>(m_end - at) < length || memcmp(at, literal, length) != 0 || !IsTokenEnd(at + length))
+            {
+                return SetError(at);
+            }
+            item->type = type | flags;
+            return true;
+        }
+
+        bool ParseNumber(cJSON* item, int flags, const char* at)
+        {
+            const char* end = at;
+            bool isInteger = true;
+            bool isSimpleInteger = true;
+            while (end < m_end && IsNumberCharacter(static_cast<unsigned char>(*end)))
+            {
+                const char c = *end;
+                if (c == '.' || c == 'e' || c == 'E')
+                {
+                    isInteger = false;
+                }
+                if ((c < '0' || c > '9') && !(c == '-' && end == at))
+                {
+                    isSimpleInteger = false;
+                }
+                ++end;
+            }
+            const size_t length = static_cast<size_t>(end - at);
+            if (length > MAX_NUMBER_LENGTH || !IsTokenEnd(end))
+            {
+                return SetError(at);
+            }
+
+            double number = 0;
+            const bool negative = *at == '-';
+            const size_t digits = negative ? length - 1 : length;
+            if (isSimpleInteger && digits > 0 && digits <= 18)
+            {
+                //exact in 64 bits, and converting it rounds like strtod does
+                int64_t value = 0;
+                for (const char* digit = negative ? at + 1 : at; digit < end; ++digit)
+                {
+                    value = value * 10 + (*digit - '0');
+                }
+                number = negative ? (value == 0 ? -0.0 : -static_cast<double>(value)) : static_cast<double>(value);
+            }
+            else
+            {
+                char buffer[MAX_NUMBER_LENGTH + 1];
+                memcpy(buffer, at, length);
+                buffer[length] = '\0';
+                char* parsedEnd = nullptr;
+                number = strtod(buffer, &parsedEnd);
+                if (parsedEnd != buffer + length)
+                {
+                    return SetError(at);
+                }
+            }
+
+            item->type = cJSON_Number | flags;
+            item->valuedouble = number;
+            //integers out of int range keep their literal, they may not survive the trip through double
+            if (isInteger && (number > INT_MAX || number < INT_MIN))
+            {
+                item->valuestring = CopyString(at, length);
+            }
+
+            if (number >= INT_MAX)
+            {
+                item->valueint = INT_MAX;
+            }
+            else if (number <= INT_MIN)
+            {
+                item->valueint = INT_MIN;
+            }
+            else
+            {
+                item->valueint = static_cast<int>(number);
+            }
+            return true;
+        }
+
+        char* CopyString(const char* text, size_t length)
+        {
+            char* out = m_strings;
+            memcpy(out, text, length);
+            out[length] = '\0';
+            m_strings += length + 1;
+            return out;
+        }
+
+        /**
+         * Unescapes the string whose opening quote is at into the block.
+         */
+        bool ParseString(const char* at, char*& result)
+        {
+            char* out = m_strings;
+            const char* position = at + 1;
+
+            for (;;)
+            {
+                const char* run = position;
+#ifdef JSON_BACKEND_SSE2
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+                while (m_end - position >= 16)
+                {
+                    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+                    const unsigned found = static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+                    if (found)
+                    {
+                        position += CountTrailingZeros(found);
+                        break;
+                    }
+                    position += 16;
+                }
+#endif
+                while (position < m_end && *position != '"' && *position != '\\')
+                {
+                    ++position;
+                }
+                if (position == m_end)
+                {
+                    return SetError(at);
+                }
+
+                memcpy(out, run, static_cast<size_t>(position - run));
+                out += position - run;
+
+                if (*position == '"')
+                {
+                    break;
+                }
+
+                //escape sequence
+                if (m_end - position < 2)
+                {
+                    return SetError(position);
+                }
+                switch (position[1])
+                {
+                    case 'b': *out++ = '\b'; break;
+                    case 'f': *out++ = '\f'; break;
+                    case 'n': *out++ = '\n'; break;
+                    case 'r': *out++ = '\r'; break;
+                    case 't': *out++ = '\t'; break;
+                    case '"':
+                    case '\\':
+                    case '/':
+                        *out++ = position[1];
+                        break;
+                    case 'u':
+                    {
+                        const size_t consumed = ParseUtf16Literal(position, out);
+                        if (consumed == 0)
+                        {
+                            return SetError(position);
+                        }
+                        position += consumed;
+                        continue;
+                    }
+                    default:
+                        return SetError(position);
+                }
+                position += 2;
+            }
+
+            *out++ = '\0';
+            result = m_strings;
+            m_strings = out;
+            return true;
+        }
+
+        /**
+         * Converts a \uXXXX escape, or a surrogate pair of them, at position to utf-8. Returns the number of characters
+         * consumed, 0 if the escape is invalid.
+         */
+        size_t ParseUtf16Literal(const char* position, char*& out)
+        {
+            if (m_end - position < 6)
+            {
+                return 0;
+            }
+            bool valid = true;
+            unsigned long codepoint = ParseHex4(position + 2, valid);
+            size_t consumed = 6;
+            if (!valid || (codepoint >= 0xDC00 && codepoint <= 0xDFFF))
+            {
+                return 0;
+            }
+            if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+            {
+                const char* second = position + 6;
+                if (m_end - second < 6 || second[0] != '\\' || second[1] != 'u')
+                {
+                    return 0;
+                }
+                const unsigned low = ParseHex4(second + 2, valid);
+                if (!valid || low < 0xDC00 || low > 0xDFFF)
+                {
+                    return 0;
+                }
+                codepoint = 0x10000 + (((codepoint & 0x3FF) << 10) | (low & 0x3FF));
+                consumed = 12;
+            }
+
+            if (codepoint < 0x80)
+            {
+                *out++ = static_cast<char>(codepoint);
+            }
+            else if (codepoint < 0x800)
+            {
+                *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+                *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+            else if (codepoint < 0x10000)
+            {
+                *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+                *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+                *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+            return consumed;
+        }
+
+        const char* m_json;
+        const char* m_end;
+        Aws::Vector<size_t> m_index;
+        size_t m_next;
+        char* m_block;
+        cJSON* m_items;
+        size_t m_itemCount;
+        size_t m_itemsUsed;
+        char* m_strings;
+        const char* m_error;
+    };
+
+    /**
+     * Prints a document the way cJSON_Print and cJSON_PrintUnformatted do, straight into a string.
+     */
+    class Writer
+    {
+    public:
+        Writer(Aws::String& out, bool formatted) : m_out(out), m_formatted(formatted), m_depth(0)
+        {
+        }
+
+        bool WriteValue(const cJSON* item)
+        {
+            switch (item->type & 0xFF)
+            {
+                case cJSON_NULL:
+                    m_out.append("null", 4);
+                    return true;
+                case cJSON_False:
+                    m_out.append("false", 5);
+                    return true;
+                case cJSON_True:
+                    m_out.append("true", 4);
+                    return true;
+                case cJSON_Number:
+                    WriteNumber(item);
+                    return true;
+                case cJSON_Raw:
+                    if (!item->valuestring)
+                    {
+                        return false;
+                    }
+                    m_out.append(item->valuestring);
+                    return true;
+                case cJSON_String:
+                    WriteString(item->valuestring);
+                    return true;
+                case cJSON_Array:
+                    return WriteArray(item);
+                case cJSON_Object:
+                    return WriteObject(item);
+                default:
+                    return false;
+            }
+        }
+
+    private:
+        bool WriteArray(const cJSON* item)
+        {
+            m_out.push_back('[');
+            ++m_depth;
+            for (const cJSON* element = item->child; element; element = element->next)
+            {
+                if (!WriteValue(element))
+                {
+                    return false;
+                }
+                if (element->next)
+                {
+                    m_out.push_back(',');
+                    if (m_formatted)
+                    {
+                        m_out.push_back(' ');
+                    }
+                }
+            }
+            m_out.push_back(']');
+            --m_depth;
+            return true;
+        }
+
+        bool WriteObject(const cJSON* item)
+        {
+            m_out.push_back('{');
+            ++m_depth;
+            if (m_formatted)
+            {
+                m_out.push_back('\n');
+            }
+            for (const cJSON* member = item->child; member; member = member->next)
+            {
+                if (m_formatted)
+                {
+                    m_out.append(m_depth, '\t');
+                }
+                WriteString(member->string);
+                m_out.push_back(':');
+                if (m_formatted)
+                {
+                    m_out.push_back('\t');
+                }
+                if (!WriteValue(member))
+                {
+                    return false;
+                }
+                if (member->next)
+                {
+                    m_out.push_back(',');
+                }
+                if (m_formatted)
+                {
+                    m_out.push_back('\n');
+                }
+            }
+            if (m_formatted)
+            {
+                m_out.append(m_depth - 1, '\t');
+            }
+            m_out.push_back('}');
+            --m_depth;
+            return true;
+        }
+
+        void WriteNumber(const cJSON* item)
+        {
+            const double d = item->valuedouble;
+            if (item->valuestring)
+            {
+                m_out.append(item->valuestring);
+                return;
+            }
+            //NaN and infinity
+            if ((d * 0) != 0)
+            {
+                m_out.append("null", 4);
+                return;
+            }
+
+            char buffer[26];
+            //integers cJSON's "%1.15g" prints without an exponent
+            if (d == std::floor(d) && std::fabs(d) < 1e15 && !(d == 0 && std::signbit(d)))
+            {
+                long long value = static_cast<long long>(d);
+                unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+                char* end = buffer + sizeof(buffer);
+                char* begin = end;
+                do
+                {
+                    *--begin = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude);
+                if (value < 0)
+                {
+                    *--begin = '-';
+                }
+                m_out.append(begin, static_cast<size_t>(end - begin));
+                return;
+            }
+
+            //15 significant digits unless they don't round trip
+            int length = snprintf(buffer, sizeof(buffer), "%1.15g", d);
+            if (strtod(buffer, nullptr) != d)
+            {
+                length = snprintf(buffer, sizeof(buffer), "%1.17g", d);
+            }
+            m_out.append(buffer, static_cast<size_t>(length));
+        }
+
+        void WriteString(const char* value)
+        {
+            static const char HEX_DIGITS[] = "0123456789abcdef";
+
+            m_out.push_back('"');
+            if (value)
+            {
+                const char* run = value;
+                const char* position = value;
+                for (;; ++position)
+                {
+                    const unsigned char c = static_cast<unsigned char>(*position);
+                    if (c >= 32 && c != '"' && c != '\\')
+                    {
+                        continue;
+                    }
+                    m_out.append(run, static_cast<size_t>(position - run));
+                    if (c == '\0')
+                    {
+                        break;
+                    }
+                    run = position + 1;
+
+                    m_out.push_back('\\');
+                    switch (c)
+                    {
+                        case '"': m_out.push_back('"'); break;
+                        case '\\': m_out.push_back('\\'); break;
+                        case '\b': m_out.push_back('b'); break;
+                        case '\f': m_out.push_back('f'); break;
+                        case '\n': m_out.push_back('n'); break;
+                        case '\r': m_out.push_back('r'); break;
+                        case '\t': m_out.push_back('t'); break;
+                        default:
+                        {
+                            const char escape[] = { 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xF] };
+                            m_out.append(escape, sizeof(escape));
+                            break;
+                        }
+                    }
+                }
+            }
+            m_out.push_back('"');
+        }
+
+        Aws::String& m_out;
+        bool m_formatted;
+        size_t m_depth;
+    };
+} // namespace
+
+const char* Backend::GetName()
+{
+    return "aws";
+}
+
+cJSON* Backend::Parse(const char* json, size_t length, const char** errorPosition)
+{
+    IndexedParser parser(json, length);
+    return parser.Parse(errorPosition);
+}
+
+Aws::String Backend::Print(const cJSON* item, bool formatted)
+{
+    Aws::String out;
+    if (!item)
+    {
+        return out;
+    }
+    Writer writer(out, formatted);
+    if (!writer.WriteValue(item))
+    {
+        return {};
+    }
+    return out;
+}
+
+#endif // ENABLE_CJSON_BACKEND
@@ -0,0 +1,727 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/json/JsonReader.h>
+#include <aws/core/utils/logging/LogMacros.h>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace Aws::Utils::Json;
+
+static const char JSON_READER_TAG[] = "JsonReader";
+static const size_t READ_BUFFER_SIZE = 16 * 1024;
+
+static bool IsJsonWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static bool IsNumberStart(char c)
+{
+    return c == '-' || (c >= '0' && c <= '9');
+}
+
+static bool IsNumberChar(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static void AppendUtf8(Aws::String& out, unsigned codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+JsonReader::JsonReader(Aws::IStream& stream) :
+    m_stream(&stream),
+    m_buffer(READ_BUFFER_SIZE),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_valuePending(false),
+    m_started(false)
+{
+}
+
+JsonReader::JsonReader(const char* data, size_t length) :
+    m_stream(nullptr),
+    m_cursor(data),
+    m_end(data + length),
+    m_valuePending(false),
+    m_started(false)
+{
+}
+
+bool JsonReader::Fill()
+{
+    if (!m_stream || !m_stream->good())
+    {
+        return false;
+    }
+
+    m_stream->read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    auto bytesRead = m_stream->gcount();
+    if (bytesRead <= 0)
+    {
+        return false;
+    }
+
+    m_cursor = m_buffer.data();
+    m_end = m_cursor + bytesRead;
+    return true;
+}
+
+bool JsonReader::SkipWhitespace()
+{
+    for (;;)
+    {
+        while (m_cursor < m_end && IsJsonWhitespace(*m_cursor))
+        {
+            ++m_cursor;
+        }
+
+        if (m_cursor < m_end)
+        {
+            return true;
+        }
+
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+}
+
+bool JsonReader::Expect(char c)
+{
+    if (!SkipWhitespace())
+    {
+        SetError("Unexpected end of document");
+        return false;
+    }
+
+    if (*m_cursor != c)
+    {
+        SetError("Unexpected character");
+        return false;
+    }
+
+    ++m_cursor;
+    return true;
+}
+
+void JsonReader::SetError(const char* message)
+{
+    if (m_errorMessage.empty())
+    {
+        m_errorMessage = message;
+        AWS_LOGSTREAM_ERROR(JSON_READER_TAG, "Failed to parse json: " << message);
+    }
+    m_valuePending = false;
+    m_cursor = m_end;
+    m_stream = nullptr;
+}
+
+bool JsonReader::AtValue()
+{
+    if (!WasParseSuccessful())
+    {
+        return false;
+    }
+
+    if (m_scopes.empty())
+    {
+        //a document holds a single value, an empty document none.
+        if (m_started)
+        {
+            return false;
+        }
+        m_started = true;
+        return SkipWhitespace();
+    }
+
+    //values inside objects and arrays are read after NextMember or NextElement.
+    if (!m_valuePending)
+    {
+        return false;
+    }
+
+    m_valuePending = false;
+    if (!SkipWhitespace())
+    {
+        SetError("Unexpected end of document");
+        return false;
+    }
+    return true;
+}
+
+JsonTokenType JsonReader::PeekType()
+{
+    if (!WasParseSuccessful())
+    {
+        return JsonTokenType::Error;
+    }
+
+    if (m_scopes.empty() ? m_started : !m_valuePending)
+    {
+        return JsonTokenType::End;
+    }
+
+    if (!SkipWhitespace())
+    {
+        if (m_scopes.empty())
+        {
+            return JsonTokenType::End;
+        }
+        SetError("Unexpected end of document");
+        return JsonTokenType::Error;
+    }
+
+    switch (*m_cursor)
+    {
+        case '{':
+            return JsonTokenType::Object;
+        case '[':
+            return JsonTokenType::Array;
+        case '"':
+            return JsonTokenType::String;
+        case 't':
+        case 'f':
+            return JsonTokenType::Bool;
+        case 'n':
+            return JsonTokenType::Null;
+        default:
+            return IsNumberStart(*m_cursor) ? JsonTokenType::Number : JsonTokenType::Error;
+    }
+}
+
+bool JsonReader::BeginObject()
+{
+    if (!AtValue())
+    {
+        return false;
+    }
+
+    if (*m_cursor != '{')
+    {
+        ConsumeValue(nullptr);
+        return false;
+    }
+
+    ++m_cursor;
+    m_scopes.push_back(Scope::Object);
+    m_scopeHasItems.push_back(false);
+    return true;
+}
+
+bool JsonReader::BeginArray()
+{
+    if (!AtValue())
+    {
+        return false;
+    }
+
+    if (*m_cursor != '[')
+    {
+        ConsumeValue(nullptr);
+        return false;
+    }
+
+    ++m_cursor;
+    m_scopes.push_back(Scope::Array);
+    m_scopeHasItems.push_back(false);
+    return true;
+}
+
+bool JsonReader::NextMember()
+{
+    return NextInScope(Scope::Object, '}');
+}
+
+bool JsonReader::NextElement()
+{
+    return NextInScope(Scope::Array, ']');
+}
+
+bool JsonReader::NextInScope(Scope scope, char close)
+{
+    if (!WasParseSuccessful() || m_scopes.empty() || m_scopes.back() != scope)
+    {
+        return false;
+    }
+
+    if (m_valuePending)
+    {
+        SkipValue();
+        if (!WasParseSuccessful())
+        {
+            return false;
+        }
+    }
+
+    if (!SkipWhitespace())
+    {
+        SetError("Unexpected end of document");
+        return false;
+    }
+
+    if (*m_cursor == close)
+    {
+        ++m_cursor;
+        m_scopes.pop_back();
+        m_scopeHasItems.pop_back();
+        return false;
+    }
+
+    if (m_scopeHasItems.back())
+    {
+        if (!Expect(','))
+        {
+            return false;
+        }
+        if (!SkipWhitespace())
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+    }
+    m_scopeHasItems.back() = true;
+
+    if (scope == Scope::Object)
+    {
+        if (*m_cursor != '"')
+        {
+            SetError("Expected a member name");
+            return false;
+        }
+
+        m_memberName.clear();
+        if (!ParseString(m_memberName, nullptr) || !Expect(':'))
+        {
+            return false;
+        }
+    }
+
+    m_valuePending = true;
+    return true;
+}
+
+Aws::String JsonReader::ReadString()
+{
+    Aws::String value;
+    if (!AtValue())
+    {
+        return value;
+    }
+
+    if (*m_cursor == '"')
+    {
+        if (!ParseString(value, nullptr))
+        {
+            value.clear();
+        }
+    }
+    else
+    {
+        ConsumeValue(nullptr);
+    }
+    return value;
+}
+
+int JsonReader::ReadInteger()
+{
+    return static_cast<int>(ReadInt64());
+}
+
+long long JsonReader::ReadInt64()
+{
+    if (!AtValue())
+    {
+        return 0;
+    }
+
+    if (!IsNumberStart(*m_cursor))
+    {
+        ConsumeValue(nullptr);
+        return 0;
+    }
+
+    if (!ParseNumber(m_scratch))
+    {
+        return 0;
+    }
+
+    if (m_scratch.find_first_of(".eE") != Aws::String::npos)
+    {
+        return static_cast<long long>(strtod(m_scratch.c_str(), nullptr));
+    }
+    return strtoll(m_scratch.c_str(), nullptr, 10);
+}
+
+double JsonReader::ReadDouble()
+{
+    if (!AtValue())
+    {
+        return 0;
+    }
+
+    if (!IsNumberStart(*m_cursor))
+    {
+        ConsumeValue(nullptr);
+        return 0;
+    }
+
+    if (!ParseNumber(m_scratch))
+    {
+        return 0;
+    }
+    return strtod(m_scratch.c_str(), nullptr);
+}
+
+bool JsonReader::ReadBool()
+{
+    if (!AtValue())
+    {
+        return false;
+    }
+
+    if (*m_cursor == 't')
+    {
+        return ParseLiteral("true", nullptr);
+    }
+
+    ConsumeValue(nullptr);
+    return false;
+}
+
+Aws::String JsonReader::ReadRawValue()
+{
+    Aws::String raw;
+    if (AtValue())
+    {
+        ConsumeValue(&raw);
+    }
+    return raw;
+}
+
+void JsonReader::SkipValue()
+{
+    if (AtValue())
+    {
+        ConsumeValue(nullptr);
+    }
+}
+
+void JsonReader::ConsumeValue(Aws::String* raw)
+{
+    //closing characters of the objects and arrays entered so far
+    Aws::String closers;
+
+    do
+    {
+        if (!SkipWhitespace())
+        {
+            SetError("Unexpected end of document");
+            return;
+        }
+
+        char c = *m_cursor;
+        if (c == '{' || c == '[')
+        {
+            closers.push_back(c == '{' ? '}' : ']');
+            ++m_cursor;
+            if (raw)
+            {
+                raw->push_back(c);
+            }
+            continue;
+        }
+
+        if (!closers.empty())
+        {
+            if (c == closers.back())
+            {
+                closers.pop_back();
+                ++m_cursor;
+                if (raw)
+                {
+                    raw->push_back(c);
+                }
+                continue;
+            }
+
+            if (c == ',' || c == ':')
+            {
+                ++m_cursor;
+                if (raw)
+                {
+                    raw->push_back(c);
+                }
+                continue;
+            }
+        }
+
+        bool parsed = false;
+        if (c == '"')
+        {
+            m_scratch.clear();
+            parsed = ParseString(m_scratch, raw);
+        }
+        else if (IsNumberStart(c))
+        {
+            parsed = ParseNumber(m_scratch);
+            if (parsed && raw)
+            {
+                raw->append(m_scratch);
+            }
+        }
+        else if (c == 't')
+        {
+            parsed = ParseLiteral("true", raw);
+        }
+        else if (c == 'f')
+        {
+            parsed = ParseLiteral("false", raw);
+        }
+        else if (c == 'n')
+        {
+            parsed = ParseLiteral("null", raw);
+        }
+        else
+        {
+            SetError("Unexpected character");
+        }
+
+        if (!parsed)
+        {
+            return;
+        }
+    } while (!closers.empty());
+}
+
+bool JsonReader::ParseString(Aws::String& out, Aws::String* raw)
+{
+    //opening quote
+    ++m_cursor;
+    if (raw)
+    {
+        raw->push_back('"');
+    }
+
+    for (;;)
+    {
+        if (m_cursor == m_end && !Fill())
+        {
+            SetError("Unterminated string");
+            return false;
+        }
+
+        const char* runEnd = m_cursor;
+        while (runEnd < m_end && *runEnd != '"' && *runEnd != '\\')
+        {
+            ++runEnd;
+        }
+
+        out.append(m_cursor, runEnd);
+        if (raw)
+        {
+            raw->append(m_cursor, runEnd);
+        }
+        m_cursor = runEnd;
+
+        if (m_cursor == m_end)
+        {
+            continue;
+        }
+
+        if (*m_cursor == '"')
+        {
+            ++m_cursor;
+            if (raw)
+            {
+                raw->push_back('"');
+            }
+            return true;
+        }
+
+        //escape sequence
+        ++m_cursor;
+        if (m_cursor == m_end && !Fill())
+        {
+            SetError("Unterminated string");
+            return false;
+        }
+
+        char escaped = *m_cursor++;
+        if (raw)
+        {
+            raw->push_back('\\');
+            raw->push_back(escaped);
+        }
+
+        switch (escaped)
+        {
+            case '"':
+            case '\\':
+            case '/':
+                out.push_back(escaped);
+                break;
+            case 'b':
+                out.push_back('\b');
+                break;
+            case 'f':
+                out.push_back('\f');
+                break;
+            case 'n':
+                out.push_back('\n');
+                break;
+            case 'r':
+                out.push_back('\r');
+                break;
+            case 't':
+                out.push_back('\t');
+                break;
+            case 'u':
+            {
+                unsigned codePoint = 0;
+                if (!ParseHex4(codePoint, raw))
+                {
+                    return false;
+                }
+
+                //a high surrogate is followed by an escaped low surrogate
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                {
+                    unsigned lowSurrogate = 0;
+                    if (!ParseLiteral("\\u", raw) || !ParseHex4(lowSurrogate, raw) || lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF)
+                    {
+                        SetError("Invalid surrogate pair");
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                }
+                AppendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                SetError("Invalid escape sequence");
+                return false;
+        }
+    }
+}
+
+bool JsonReader::ParseHex4(unsigned& value, Aws::String* raw)
+{
+    value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (m_cursor == m_end && !Fill())
+        {
+            SetError("Unterminated string");
+            return false;
+        }
+
+        char c = *m_cursor++;
+        if (raw)
+        {
+            raw->push_back(c);
+        }
+
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+        {
+            value |= static_cast<unsigned>(c - '0');
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            value |= static_cast<unsigned>(c - 'a' + 10);
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            value |= static_cast<unsigned>(c - 'A' + 10);
+        }
+        else
+        {
+            SetError("Invalid unicode escape");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonReader::ParseNumber(Aws::String& out)
+{
+    out.clear();
+    for (;;)
+    {
+        const char* runEnd = m_cursor;
+        while (runEnd < m_end && IsNumberChar(*runEnd))
+        {
+            ++runEnd;
+        }
+
+        out.append(m_cursor, runEnd);
+        m_cursor = runEnd;
+
+        if (m_cursor < m_end || !Fill())
+        {
+            break;
+        }
+    }
+
+    char* numberEnd = nullptr;
+    strtod(out.c_str(), &numberEnd);
+    if (out.empty() || numberEnd != out.c_str() + out.size())
+    {
+        SetError("Invalid number");
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::ParseLiteral(const char* literal, Aws::String* raw)
+{
+    for (const char* expected = literal; *expected; ++expected)
+    {
+        if (m_cursor == m_end && !Fill())
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+
+        if (*m_cursor != *expected)
+        {
+            SetError("Invalid literal");
+            return false;
+        }
+        ++m_cursor;
+    }
+
+    if (raw)
+    {
+        raw->append(literal);
+    }
+    return true;
+}
@@ -4,6 +4,7 @@
  */
 
 #include <aws/core/utils/json/JsonSerializer.h>
+#include <aws/core/utils/json/JsonBackend.h>
 
 #include <iterator>
 #include <algorithm>
@@ -26,10 +27,10 @@ JsonValue::JsonValue(cJSON* value) :
 
 JsonValue::JsonValue(const Aws::String& value) : m_wasParseSuccessful(true)
 {
-    const char* return_parse_end;
-    m_value = cJSON_ParseWithOpts(value.c_str(), &return_parse_end, 1/*require_null_terminated*/);
+    const char* return_parse_end = value.c_str();
+    m_value = Backend::Parse(value.c_str(), value.size(), &return_parse_end);
 
-    if (!m_value || cJSON_IsInvalid(m_value))
+    if (!m_value)
     {
         m_wasParseSuccessful = false;
         m_errorMessage = "Failed to parse JSON at: ";
@@ -39,13 +40,11 @@ JsonValue::JsonValue(const Aws::String& value) : m_wasParseSuccessful(true)
 
 JsonValue::JsonValue(Aws::IStream& istream) : m_wasParseSuccessful(true)
 {
-    Aws::StringStream memoryStream;
-    std::copy(std::istreambuf_iterator<char>(istream), std::istreambuf_iterator<char>(), std::ostreambuf_iterator<char>(memoryStream));
-    const char* return_parse_end;
-    const auto input = memoryStream.str();
-    m_value = cJSON_ParseWithOpts(input.c_str(), &return_parse_end, 1/*require_null_terminated*/);
+    const Aws::String input((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+    const char* return_parse_end = input.c_str();
+    m_value = Backend::Parse(input.c_str(), input.size(), &return_parse_end);
 
-    if (!m_value || cJSON_IsInvalid(m_value))
+    if (!m_value)
     {
         m_wasParseSuccessful = false;
         m_errorMessage = "Failed to parse JSON. Invalid input at: ";
@@ -636,10 +635,7 @@ Aws::String JsonView::WriteCompact(bool treatAsObject) const
         return {};
     }
 
-    auto temp = cJSON_PrintUnformatted(m_value);
-    Aws::String out(temp);
-    cJSON_free(temp);
-    return out;
+    return Backend::Print(m_value, false/*formatted*/);
 }
 
 Aws::String JsonView::WriteReadable(bool treatAsObject) const
@@ -653,10 +649,7 @@ Aws::String JsonView::WriteReadable(bool treatAsObject) const
         return {};
     }
 
-    auto temp = cJSON_Print(m_value);
-    Aws::String out(temp);
-    cJSON_free(temp);
-    return out;
+    return Backend::Print(m_value, true/*formatted*/);
 }
 
 JsonValue JsonView::Materialize() const
@@ -0,0 +1,1106 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/logging/AsyncLogSystem.h>
+#include <aws/core/utils/logging/LogField.h>
+
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace Aws::Utils;
+using namespace Aws::Utils::Logging;
+
+static const char* AllocationTag = "AsyncLogSystem";
+static const size_t MIN_BUFFER_SIZE = 4096;
+static const size_t RECORD_ALIGNMENT = 8;
+//a record size that tells the reader the rest of the buffer is unused and the next record is at its start
+static const uint32_t WRAP_MARKER = 0xFFFFFFFF;
+static const std::chrono::milliseconds POLL_INTERVAL(50);
+
+static std::atomic<uint64_t> s_nextLogSystemId(1);
+
+namespace
+{
+    enum class RecordType : uint8_t
+    {
+        Text,
+        Format,
+        Fields
+    };
+
+    enum class ArgumentType : uint8_t
+    {
+        Signed,
+        Unsigned,
+        Double,
+        LongDouble,
+        Pointer,
+        String,
+        Bool,
+        None
+    };
+
+    /**
+     * Every record starts with this, followed by the tag, then by the text, by the format string and its arguments, or by
+     * the message, the number of fields and the key and value of every field.
+     */
+    struct RecordHeader
+    {
+        uint32_t size;
+        uint8_t level;
+        uint8_t type;
+        uint16_t tagLength;
+        int64_t timestamp;
+    };
+
+    /**
+     * A conversion specification of a printf format string.
+     */
+    struct Conversion
+    {
+        const char* flags;
+        size_t flagsLength;
+        bool widthArgument;
+        int width;
+        bool precisionArgument;
+        int precision;
+        char length[3];
+        char specifier;
+    };
+
+    size_t AlignRecordSize(size_t size)
+    {
+        return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+
+    size_t RoundUpToPowerOfTwo(size_t size)
+    {
+        size_t capacity = MIN_BUFFER_SIZE;
+        while (capacity < size)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    int ParseNumber(const char*& cursor)
+    {
+        int value = 0;
+        while (*cursor >= '0' && *cursor <= '9')
+        {
+            value = value * 10 + (*cursor++ - '0');
+        }
+        return value;
+    }
+
+    /**
+     * Parses the conversion specification starting after a '%'. Returns the character following it, or nullptr if the
+     * specification isn't valid, in which case the rest of the format string is treated as text.
+     */
+    const char* ParseConversion(const char* cursor, Conversion& conversion)
+    {
+        conversion.flags = cursor;
+        while (*cursor == '-' || *cursor == '+' || *cursor == ' ' || *cursor == '#' || *cursor == '0')
+        {
+            ++cursor;
+        }
+        conversion.flagsLength = static_cast<size_t>(cursor - conversion.flags);
+
+        conversion.widthArgument = *cursor == '*';
+        conversion.width = 0;
+        if (conversion.widthArgument)
+        {
+            ++cursor;
+        }
+        else
+        {
+            conversion.width = ParseNumber(cursor);
+        }
+
+        conversion.precisionArgument = false;
+        conversion.precision = -1;
+        if (*cursor == '.')
+        {
+            ++cursor;
+            conversion.precisionArgument = *cursor == '*';
+            if (conversion.precisionArgument)
+            {
+                ++cursor;
+            }
+            else
+            {
+                conversion.precision = ParseNumber(cursor);
+            }
+        }
+
+        size_t lengthSize = 0;
+        while (lengthSize < 2 && (*cursor == 'h' || *cursor == 'l' || *cursor == 'j' || *cursor == 'z' || *cursor == 't' || *cursor == 'L'))
+        {
+            conversion.length[lengthSize++] = *cursor++;
+        }
+        conversion.length[lengthSize] = '\0';
+
+        conversion.specifier = *cursor;
+        if (!conversion.specifier || !strchr("diuoxXcsfFeEgGaApn", conversion.specifier))
+        {
+            return nullptr;
+        }
+        return cursor + 1;
+    }
+
+    ArgumentType GetArgumentType(const Conversion& conversion)
+    {
+        switch (conversion.specifier)
+        {
+            case 'd':
+            case 'i':
+            case 'c':
+                return ArgumentType::Signed;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                return ArgumentType::Unsigned;
+            case 's':
+                return conversion.length[0] == 'l' ? ArgumentType::Pointer : ArgumentType::String;
+            case 'p':
+                return ArgumentType::Pointer;
+            case 'n':
+                return ArgumentType::None;
+            default:
+                return conversion.length[0] == 'L' ? ArgumentType::LongDouble : ArgumentType::Double;
+        }
+    }
+
+    class ArgumentWriter
+    {
+    public:
+        ArgumentWriter(char* out) : m_out(out), m_size(0) {}
+
+        template<typename T>
+        void Write(ArgumentType type, T value)
+        {
+            if (m_out)
+            {
+                m_out[m_size] = static_cast<char>(type);
+                memcpy(m_out + m_size + 1, &value, sizeof(T));
+            }
+            m_size += 1 + sizeof(T);
+        }
+
+        void WriteString(const char* value, size_t length)
+        {
+            uint32_t stringLength = static_cast<uint32_t>(length);
+            if (m_out)
+            {
+                m_out[m_size] = static_cast<char>(ArgumentType::String);
+                memcpy(m_out + m_size + 1, &stringLength, sizeof(stringLength));
+                memcpy(m_out + m_size + 1 + sizeof(stringLength), value, length);
+                m_out[m_size + 1 + sizeof(stringLength) + length] = '\0';
+            }
+            m_size += 1 + sizeof(stringLength) + length + 1;
+        }
+
+        size_t GetSize() const { return m_size; }
+
+    private:
+        char* m_out;
+        size_t m_size;
+    };
+
+    /**
+     * Copies the arguments of the format string into out, or only computes their size if out is null.
+     */
+    size_t CaptureArguments(const char* formatStr, va_list args, char* out)
+    {
+        ArgumentWriter writer(out);
+        for (const char* cursor = strchr(formatStr, '%'); cursor; cursor = strchr(cursor, '%'))
+        {
+            if (cursor[1] == '%')
+            {
+                cursor += 2;
+                continue;
+            }
+
+            Conversion conversion;
+            cursor = ParseConversion(cursor + 1, conversion);
+            if (!cursor)
+            {
+                break;
+            }
+
+            if (conversion.widthArgument)
+            {
+                writer.Write(ArgumentType::Signed, static_cast<int64_t>(va_arg(args, int)));
+            }
+            int precision = conversion.precision;
+            if (conversion.precisionArgument)
+            {
+                precision = va_arg(args, int);
+                writer.Write(ArgumentType::Signed, static_cast<int64_t>(precision));
+            }
+
+            const char* length = conversion.length;
+            switch (GetArgumentType(conversion))
+            {
+                case ArgumentType::Signed:
+                {
+                    int64_t value;
+                    if (!strcmp(length, "l")) value = va_arg(args, long);
+                    else if (!strcmp(length, "ll")) value = va_arg(args, long long);
+                    else if (!strcmp(length, "j")) value = va_arg(args, intmax_t);
+                    else if (!strcmp(length, "z")) value = static_cast<int64_t>(va_arg(args, size_t));
+                    else if (!strcmp(length, "t")) value = va_arg(args, ptrdiff_t);
+                    else value = va_arg(args, int);
+                    if (!strcmp(length, "h")) value = static_cast<short>(value);
+                    else if (!strcmp(length, "hh")) value = static_cast<signed char>(value);
+                    writer.Write(ArgumentType::Signed, value);
+                    break;
+                }
+                case ArgumentType::Unsigned:
+                {
+                    uint64_t value;
+                    if (!strcmp(length, "l")) value = va_arg(args, unsigned long);
+                    else if (!strcmp(length, "ll")) value = va_arg(args, unsigned long long);
+                    else if (!strcmp(length, "j")) value = va_arg(args, uintmax_t);
+                    else if (!strcmp(length, "z")) value = va_arg(args, size_t);
+                    else if (!strcmp(length, "t")) value = static_cast<uint64_t>(va_arg(args, ptrdiff_t));
+                    else value = va_arg(args, unsigned int);
+                    if (!strcmp(length, "h")) value = static_cast<unsigned short>(value);
+                    else if (!strcmp(length, "hh")) value = static_cast<unsigned char>(value);
+                    writer.Write(ArgumentType::Unsigned, value);
+                    break;
+                }
+                case ArgumentType::Double:
+                    writer.Write(ArgumentType::Double, va_arg(args, double));
+                    break;
+                case ArgumentType::LongDouble:
+                    writer.Write(ArgumentType::LongDouble, va_arg(args, long double));
+                    break;
+                case ArgumentType::Pointer:
+                    writer.Write(ArgumentType::Pointer, va_arg(args, void*));
+                    break;
+                case ArgumentType::String:
+                {
+                    const char* value = va_arg(args, const char*);
+                    if (!value)
+                    {
+                        value = "(null)";
+                    }
+                    size_t valueLength = 0;
+                    while ((precision < 0 || valueLength < static_cast<size_t>(precision)) && value[valueLength])
+                    {
+                        ++valueLength;
+                    }
+                    writer.WriteString(value, valueLength);
+                    break;
+                }
+                case ArgumentType::Bool: //only captured for the fields of LogFields()
+                    break;
+                case ArgumentType::None:
+                    va_arg(args, void*);
+                    break;
+            }
+        }
+        return writer.GetSize();
+    }
+
+    /**
+     * Copies the keys and values of the fields into out, or only computes their size if out is null.
+     */
+    size_t CaptureFields(const LogField* fields, size_t fieldCount, char* out)
+    {
+        ArgumentWriter writer(out);
+        for (size_t i = 0; i < fieldCount; ++i)
+        {
+            const LogField& field = fields[i];
+            writer.WriteString(field.GetKey(), strlen(field.GetKey()));
+            switch (field.GetType())
+            {
+                case LogField::Type::Signed:
+                    writer.Write(ArgumentType::Signed, field.GetSigned());
+                    break;
+                case LogField::Type::Unsigned:
+                    writer.Write(ArgumentType::Unsigned, field.GetUnsigned());
+                    break;
+                case LogField::Type::Double:
+                    writer.Write(ArgumentType::Double, field.GetDouble());
+                    break;
+                case LogField::Type::Bool:
+                    writer.Write(ArgumentType::Bool, field.GetBool());
+                    break;
+                case LogField::Type::String:
+                    writer.WriteString(field.GetString(), field.GetStringLength());
+                    break;
+            }
+        }
+        return writer.GetSize();
+    }
+
+    /**
+     * Formats a single captured argument with snprintf and appends it to line. conversionFormat takes the width and, unless
+     * precision is negative, the precision as arguments.
+     */
+    template<typename T>
+    void AppendConversion(Aws::String& line, const char* conversionFormat, int width, int precision, T value)
+    {
+        size_t offset = line.size();
+        size_t available = 64;
+        for (;;)
+        {
+            line.resize(offset + available);
+            int written = precision < 0 ? snprintf(&line[offset], available, conversionFormat, width, value) :
+                snprintf(&line[offset], available, conversionFormat, width, precision, value);
+            if (written < 0)
+            {
+                line.resize(offset);
+                return;
+            }
+            if (static_cast<size_t>(written) < available)
+            {
+                line.resize(offset + written);
+                return;
+            }
+            available = static_cast<size_t>(written) + 1;
+        }
+    }
+
+    class ArgumentReader
+    {
+    public:
+        ArgumentReader(const char* in, const char* end) : m_in(in), m_end(end) {}
+
+        bool Next(ArgumentType& type, const char*& value)
+        {
+            if (m_in >= m_end)
+            {
+                return false;
+            }
+            type = static_cast<ArgumentType>(*m_in++);
+            value = m_in;
+            switch (type)
+            {
+                case ArgumentType::Signed: m_in += sizeof(int64_t); break;
+                case ArgumentType::Unsigned: m_in += sizeof(uint64_t); break;
+                case ArgumentType::Double: m_in += sizeof(double); break;
+                case ArgumentType::LongDouble: m_in += sizeof(long double); break;
+                case ArgumentType::Pointer: m_in += sizeof(void*); break;
+                case ArgumentType::Bool: m_in += sizeof(bool); break;
+                case ArgumentType::String:
+                {
+                    uint32_t length;
+                    memcpy(&length, m_in, sizeof(length));
+                    value = m_in + sizeof(length);
+                    m_in += sizeof(length) + length + 1;
+                    break;
+                }
+                default:
+                    return false;
+            }
+            return true;
+        }
+
+        template<typename T>
+        static T As(const char* value)
+        {
+            T result;
+            memcpy(&result, value, sizeof(T));
+            return result;
+        }
+
+    private:
+        const char* m_in;
+        const char* m_end;
+    };
+
+    /**
+     * Formats a captured structured statement the way AppendLogFields would have at the time it was logged. fields is
+     * only reused to save allocations.
+     */
+    void AppendFields(Aws::String& line, const char* message, size_t messageLength, const char* captured, const char* capturedEnd, Aws::Vector<LogField>& fields)
+    {
+        uint32_t fieldCount;
+        memcpy(&fieldCount, captured, sizeof(fieldCount));
+        ArgumentReader reader(captured + sizeof(fieldCount), capturedEnd);
+        fields.clear();
+        ArgumentType type;
+        const char* key;
+        const char* value;
+        while (fields.size() < fieldCount && reader.Next(type, key) && type == ArgumentType::String && reader.Next(type, value))
+        {
+            switch (type)
+            {
+                case ArgumentType::Signed:
+                    fields.emplace_back(key, ArgumentReader::As<int64_t>(value));
+                    break;
+                case ArgumentType::Unsigned:
+                    fields.emplace_back(key, ArgumentReader::As<uint64_t>(value));
+                    break;
+                case ArgumentType::Double:
+                    fields.emplace_back(key, ArgumentReader::As<double>(value));
+                    break;
+                case ArgumentType::Bool:
+                    fields.emplace_back(key, ArgumentReader::As<bool>(value));
+                    break;
+                case ArgumentType::String:
+                {
+                    uint32_t length;
+                    memcpy(&length, value - sizeof(length), sizeof(length));
+                    fields.emplace_back(key, value, static_cast<size_t>(length));
+                    break;
+                }
+                default:
+                    return;
+            }
+        }
+        AppendLogFields(line, message, messageLength, fields.data(), fields.size());
+    }
+
+    /**
+     * Formats a captured printf style statement the way vsnprintf would have at the time it was logged.
+     */
+    void AppendFormatted(Aws::String& line, const char* formatStr, size_t formatLength, const char* arguments, const char* argumentsEnd)
+    {
+        ArgumentReader reader(arguments, argumentsEnd);
+        const char* end = formatStr + formatLength;
+        const char* cursor = formatStr;
+        while (cursor < end)
+        {
+            const char* percent = static_cast<const char*>(memchr(cursor, '%', static_cast<size_t>(end - cursor)));
+            if (!percent)
+            {
+                line.append(cursor, end);
+                return;
+            }
+            line.append(cursor, percent);
+            if (percent[1] == '%')
+            {
+                line += '%';
+                cursor = percent + 2;
+                continue;
+            }
+
+            Conversion conversion;
+            const char* next = ParseConversion(percent + 1, conversion);
+            if (!next)
+            {
+                line.append(percent, end);
+                return;
+            }
+            cursor = next;
+
+            ArgumentType type;
+            const char* value;
+            int width = conversion.width;
+            int precision = conversion.precision;
+            if (conversion.widthArgument)
+            {
+                if (!reader.Next(type, value)) return;
+                width = static_cast<int>(ArgumentReader::As<int64_t>(value));
+            }
+            if (conversion.precisionArgument)
+            {
+                if (!reader.Next(type, value)) return;
+                precision = static_cast<int>(ArgumentReader::As<int64_t>(value));
+            }
+            if (conversion.specifier == 'n')
+            {
+                continue;
+            }
+            if (!reader.Next(type, value))
+            {
+                return;
+            }
+
+            //width and precision are passed as arguments, the length modifier is replaced with the one of the captured type
+            if (conversion.specifier == 'c' || type == ArgumentType::Pointer)
+            {
+                precision = -1;
+            }
+            char conversionFormat[16] = "%";
+            size_t formatSize = 1;
+            memcpy(conversionFormat + formatSize, conversion.flags, conversion.flagsLength);
+            formatSize += conversion.flagsLength;
+            conversionFormat[formatSize++] = '*';
+            if (precision >= 0)
+            {
+                conversionFormat[formatSize++] = '.';
+                conversionFormat[formatSize++] = '*';
+            }
+            switch (type)
+            {
+                case ArgumentType::Signed:
+                    if (conversion.specifier != 'c')
+                    {
+                        conversionFormat[formatSize++] = 'j';
+                    }
+                    conversionFormat[formatSize++] = conversion.specifier;
+                    conversionFormat[formatSize] = '\0';
+                    if (conversion.specifier == 'c')
+                    {
+                        AppendConversion(line, conversionFormat, width, precision, static_cast<int>(ArgumentReader::As<int64_t>(value)));
+                    }
+                    else
+                    {
+                        AppendConversion(line, conversionFormat, width, precision, static_cast<intmax_t>(ArgumentReader::As<int64_t>(value)));
+                    }
+                    break;
+                case ArgumentType::Unsigned:
+                    conversionFormat[formatSize++] = 'j';
+                    conversionFormat[formatSize++] = conversion.specifier;
+                    conversionFormat[formatSize] = '\0';
+                    AppendConversion(line, conversionFormat, width, precision, static_cast<uintmax_t>(ArgumentReader::As<uint64_t>(value)));
+                    break;
+                case ArgumentType::Double:
+                    conversionFormat[formatSize++] = conversion.specifier;
+                    conversionFormat[formatSize] = '\0';
+                    AppendConversion(line, conversionFormat, width, precision, ArgumentReader::As<double>(value));
+                    break;
+                case ArgumentType::LongDouble:
+                    conversionFormat[formatSize++] = 'L';
+                    conversionFormat[formatSize++] = conversion.specifier;
+                    conversionFormat[formatSize] = '\0';
+                    AppendConversion(line, conversionFormat, width, precision, ArgumentReader::As<long double>(value));
+                    break;
+                case ArgumentType::Pointer:
+                    // %p ignores the precision, a wide string (%ls) is printed as its address
+                    conversionFormat[formatSize++] = 'p';
+                    conversionFormat[formatSize] = '\0';
+                    AppendConversion(line, conversionFormat, width, precision, ArgumentReader::As<void*>(value));
+                    break;
+                case ArgumentType::String:
+                    conversionFormat[formatSize++] = 's';
+                    conversionFormat[formatSize] = '\0';
+                    AppendConversion(line, conversionFormat, width, precision, value);
+                    break;
+                default:
+                    return;
+            }
+        }
+    }
+}
+
+/**
+ * Ring buffer written by a single logging thread and read by the logging system's thread. Records are written and read
+ * in place: the writer reserves a contiguous range, fills it, and publishes it by moving the tail, the reader publishes
+ * the space it is done with by moving the head.
+ */
+class AsyncLogSystem::ThreadBuffer
+{
+public:
+    ThreadBuffer(size_t capacity, const Aws::String& threadId) :
+        m_head(0),
+        m_readCursor(0),
+        m_readEnd(0),
+        m_data(capacity),
+        m_capacity(capacity),
+        m_threadId(threadId),
+        m_tail(0),
+        m_abandoned(false)
+    {
+    }
+
+    size_t GetMaxRecordSize() const { return m_capacity / 2; }
+
+    const Aws::String& GetThreadId() const { return m_threadId; }
+
+    /**
+     * Returns a contiguous range of size bytes to write a record to, or nullptr if the buffer is too full.
+     */
+    char* Reserve(size_t size)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        size_t offset = static_cast<size_t>(tail & (m_capacity - 1));
+        size_t contiguous = m_capacity - offset;
+        size_t available = m_capacity - static_cast<size_t>(tail - head);
+
+        if (size <= contiguous)
+        {
+            return size <= available ? m_data.data() + offset : nullptr;
+        }
+        if (contiguous + size > available)
+        {
+            return nullptr;
+        }
+
+        memcpy(m_data.data() + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+        m_tail.store(tail + contiguous, std::memory_order_release);
+        return m_data.data();
+    }
+
+    void Commit(size_t size)
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
+
+    /**
+     * Starts reading the records written so far.
+     */
+    void BeginRead()
+    {
+        m_readCursor = m_head.load(std::memory_order_relaxed);
+        m_readEnd = m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns the next record written before BeginRead(), or nullptr when there are no more.
+     */
+    const char* NextRecord()
+    {
+        while (m_readCursor != m_readEnd)
+        {
+            size_t offset = static_cast<size_t>(m_readCursor & (m_capacity - 1));
+            const char* record = m_data.data() + offset;
+            uint32_t size;
+            memcpy(&size, record, sizeof(size));
+            if (size == WRAP_MARKER)
+            {
+                m_readCursor += m_capacity - offset;
+                continue;
+            }
+            m_readCursor += size;
+            return record;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Hands the space of the records read back to the writer.
+     */
+    void EndRead()
+    {
+        m_head.store(m_readCursor, std::memory_order_release);
+    }
+
+    bool IsEmpty() const
+    {
+        return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire);
+    }
+
+    void Abandon() { m_abandoned.store(true, std::memory_order_release); }
+
+    bool IsAbandoned() const { return m_abandoned.load(std::memory_order_acquire); }
+
+private:
+    //reader side
+    std::atomic<uint64_t> m_head;
+    uint64_t m_readCursor;
+    uint64_t m_readEnd;
+
+    //fixed after construction, keeps the reader and the writer side off the same cache line
+    Aws::Vector<char> m_data;
+    const size_t m_capacity;
+    const Aws::String m_threadId;
+
+    //writer side
+    std::atomic<uint64_t> m_tail;
+    std::atomic<bool> m_abandoned;
+};
+
+static std::shared_ptr<Aws::OFStream> MakeDefaultLogFile(const Aws::String& filenamePrefix)
+{
+    Aws::String newFileName = filenamePrefix + DateTime::CalculateGmtTimestampAsString("%Y-%m-%d-%H") + ".log";
+    return Aws::MakeShared<Aws::OFStream>(AllocationTag, newFileName.c_str(), Aws::OFStream::out | Aws::OFStream::app);
+}
+
+static char* WriteRecordHeader(char* record, size_t size, LogLevel logLevel, RecordType type, const char* tag, size_t tagLength)
+{
+    RecordHeader header;
+    header.size = static_cast<uint32_t>(size);
+    header.level = static_cast<uint8_t>(logLevel);
+    header.type = static_cast<uint8_t>(type);
+    header.tagLength = static_cast<uint16_t>(tagLength);
+    header.timestamp = DateTime::CurrentTimeMillis();
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), tag, tagLength);
+    return record + sizeof(header) + tagLength;
+}
+
+static char* WriteLengthPrefixed(char* out, const char* data, size_t length)
+{
+    uint32_t prefix = static_cast<uint32_t>(length);
+    memcpy(out, &prefix, sizeof(prefix));
+    memcpy(out + sizeof(prefix), data, length);
+    return out + sizeof(prefix) + length;
+}
+
+//the buffer stays alive after the thread exits until the logging thread has written out what is left in it
+struct AsyncLogSystem::ThreadBufferCache
+{
+    ThreadBufferCache() : logSystemId(0) {}
+    ~ThreadBufferCache()
+    {
+        if (buffer)
+        {
+            buffer->Abandon();
+        }
+    }
+
+    uint64_t logSystemId;
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+AsyncLogSystem::ThreadBufferCache& AsyncLogSystem::GetThreadBufferCache()
+{
+    static thread_local ThreadBufferCache cache;
+    return cache;
+}
+
+AsyncLogSystem::AsyncLogSystem(LogLevel logLevel, const std::shared_ptr<Aws::OStream>& logFile, size_t bufferSize) :
+    m_logLevel(logLevel),
+    m_id(s_nextLogSystemId++),
+    m_bufferSize(RoundUpToPowerOfTwo(bufferSize)),
+    m_droppedStatements(0),
+    m_flushRequested(0),
+    m_flushCompleted(0),
+    m_stopLogging(false),
+    m_loggingStopped(false),
+    m_cachedSecond(-1),
+    m_loggingThread()
+{
+    m_loggingThread = std::thread(&AsyncLogSystem::WriteLogs, this, logFile, "", false);
+}
+
+AsyncLogSystem::AsyncLogSystem(LogLevel logLevel, const Aws::String& filenamePrefix, size_t bufferSize) :
+    m_logLevel(logLevel),
+    m_id(s_nextLogSystemId++),
+    m_bufferSize(RoundUpToPowerOfTwo(bufferSize)),
+    m_droppedStatements(0),
+    m_flushRequested(0),
+    m_flushCompleted(0),
+    m_stopLogging(false),
+    m_loggingStopped(false),
+    m_cachedSecond(-1),
+    m_loggingThread()
+{
+    m_loggingThread = std::thread(&AsyncLogSystem::WriteLogs, this, MakeDefaultLogFile(filenamePrefix), filenamePrefix, true);
+}
+
+AsyncLogSystem::~AsyncLogSystem()
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_stopLogging = true;
+    }
+
+    m_wakeSignal.notify_one();
+
+    m_loggingThread.join();
+
+    //the thread destroying the logger usually logged too, its buffer is freed now rather than at thread exit, which is after
+    //ShutdownAPI() for the main thread, when the memory system the buffer comes from may be gone
+    ThreadBufferCache& cache = GetThreadBufferCache();
+    if (cache.logSystemId == m_id)
+    {
+        cache.buffer = nullptr;
+        cache.logSystemId = 0;
+    }
+}
+
+AsyncLogSystem::ThreadBuffer* AsyncLogSystem::GetThreadBuffer()
+{
+    ThreadBufferCache& cache = GetThreadBufferCache();
+    if (cache.logSystemId != m_id)
+    {
+        if (cache.buffer)
+        {
+            cache.buffer->Abandon();
+        }
+
+        Aws::StringStream threadId;
+        threadId << std::this_thread::get_id();
+        cache.buffer = Aws::MakeShared<ThreadBuffer>(AllocationTag, m_bufferSize, threadId.str());
+        cache.logSystemId = m_id;
+
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_newBuffers.push_back(cache.buffer);
+    }
+    return cache.buffer.get();
+}
+
+void AsyncLogSystem::DropStatement()
+{
+    m_droppedStatements.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLogSystem::Log(LogLevel logLevel, const char* tag, const char* formatStr, ...)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    std::va_list args;
+    va_start(args, formatStr);
+
+    va_list sizingArgs; //unfortunately you cannot consume a va_list twice
+    va_copy(sizingArgs, args); //so we have to copy it
+    size_t argumentsSize = CaptureArguments(formatStr, sizingArgs, nullptr);
+    va_end(sizingArgs);
+
+    size_t tagLength = (std::min)(strlen(tag), static_cast<size_t>(UINT16_MAX));
+    size_t formatLength = strlen(formatStr);
+    size_t size = AlignRecordSize(sizeof(RecordHeader) + tagLength + sizeof(uint32_t) + formatLength + argumentsSize);
+
+    char* record = size <= buffer->GetMaxRecordSize() ? buffer->Reserve(size) : nullptr;
+    if (!record)
+    {
+        va_end(args);
+        DropStatement();
+        return;
+    }
+
+    char* out = WriteRecordHeader(record, size, logLevel, RecordType::Format, tag, tagLength);
+    out = WriteLengthPrefixed(out, formatStr, formatLength);
+    CaptureArguments(formatStr, args, out);
+    va_end(args);
+
+    buffer->Commit(size);
+}
+
+void AsyncLogSystem::LogStream(LogLevel logLevel, const char* tag, const Aws::OStringStream& messageStream)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    Aws::String message = messageStream.str();
+    size_t tagLength = (std::min)(strlen(tag), static_cast<size_t>(UINT16_MAX));
+    size_t fixedSize = sizeof(RecordHeader) + tagLength + sizeof(uint32_t);
+    if (fixedSize >= buffer->GetMaxRecordSize())
+    {
+        DropStatement();
+        return;
+    }
+    //a statement too big for the buffer is truncated rather than dropped
+    size_t messageLength = (std::min)(message.size(), buffer->GetMaxRecordSize() - fixedSize);
+    size_t size = AlignRecordSize(fixedSize + messageLength);
+
+    char* record = buffer->Reserve(size);
+    if (!record)
+    {
+        DropStatement();
+        return;
+    }
+
+    char* out = WriteRecordHeader(record, size, logLevel, RecordType::Text, tag, tagLength);
+    WriteLengthPrefixed(out, message.c_str(), messageLength);
+
+    buffer->Commit(size);
+}
+
+void AsyncLogSystem::LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    size_t tagLength = (std::min)(strlen(tag), static_cast<size_t>(UINT16_MAX));
+    size_t messageLength = strlen(message);
+    size_t size = AlignRecordSize(sizeof(RecordHeader) + tagLength + sizeof(uint32_t) + messageLength + sizeof(uint32_t) +
+        CaptureFields(fields, fieldCount, nullptr));
+
+    char* record = size <= buffer->GetMaxRecordSize() ? buffer->Reserve(size) : nullptr;
+    if (!record)
+    {
+        DropStatement();
+        return;
+    }
+
+    char* out = WriteRecordHeader(record, size, logLevel, RecordType::Fields, tag, tagLength);
+    out = WriteLengthPrefixed(out, message, messageLength);
+    uint32_t capturedCount = static_cast<uint32_t>(fieldCount);
+    memcpy(out, &capturedCount, sizeof(capturedCount));
+    CaptureFields(fields, fieldCount, out + sizeof(capturedCount));
+
+    buffer->Commit(size);
+}
+
+void AsyncLogSystem::Flush()
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    uint64_t flushRequest = ++m_flushRequested;
+    m_wakeSignal.notify_one();
+    m_flushSignal.wait(locker, [&](){ return m_flushCompleted >= flushRequest || m_loggingStopped; });
+}
+
+void AsyncLogSystem::AppendPrefix(Aws::String& line, LogLevel logLevel, int64_t timestamp, const char* tag, size_t tagLength, const Aws::String& threadId)
+{
+    switch (logLevel)
+    {
+        case LogLevel::Error:
+            line += "[ERROR] ";
+            break;
+        case LogLevel::Fatal:
+            line += "[FATAL] ";
+            break;
+        case LogLevel::Warn:
+            line += "[WARN] ";
+            break;
+        case LogLevel::Info:
+            line += "[INFO] ";
+            break;
+        case LogLevel::Debug:
+            line += "[DEBUG] ";
+            break;
+        case LogLevel::Trace:
+            line += "[TRACE] ";
+            break;
+        default:
+            line += "[UNKOWN] ";
+            break;
+    }
+
+    //the date and time only change once a second, only the milliseconds are formatted for every statement
+    int64_t second = timestamp / 1000;
+    if (second != m_cachedSecond)
+    {
+        Aws::String secondText = DateTime(second * 1000).ToGmtString("%Y-%m-%d %H:%M:%S");
+        size_t length = (std::min)(secondText.size(), sizeof(m_cachedSecondText) - 1);
+        memcpy(m_cachedSecondText, secondText.c_str(), length);
+        m_cachedSecondText[length] = '\0';
+        m_cachedSecond = second;
+    }
+    int milliseconds = static_cast<int>(timestamp - second * 1000);
+    char millisecondsText[5] = { '.', static_cast<char>('0' + milliseconds / 100), static_cast<char>('0' + milliseconds / 10 % 10),
+        static_cast<char>('0' + milliseconds % 10), '\0' };
+
+    line += m_cachedSecondText;
+    line += millisecondsText;
+    line += ' ';
+    line.append(tag, tagLength);
+    line += " [";
+    line += threadId;
+    line += "] ";
+}
+
+void AsyncLogSystem::WriteLogs(std::shared_ptr<Aws::OStream> logFile, const Aws::String& filenamePrefix, bool rollLog)
+{
+    struct PendingRecord
+    {
+        int64_t timestamp;
+        size_t bufferIndex;
+        const char* record;
+    };
+
+    int32_t lastRolledHour = DateTime::Now().GetHour(false /*localtime*/);
+    std::shared_ptr<Aws::OStream> log = logFile;
+    Aws::Vector<PendingRecord> pending;
+    Aws::String line;
+    Aws::Vector<LogField> fields;
+    uint64_t reportedDrops = 0;
+    Aws::StringStream loggingThreadId;
+    loggingThreadId << std::this_thread::get_id();
+
+    for(;;)
+    {
+        bool stop = false;
+        uint64_t flushRequest = 0;
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            m_wakeSignal.wait_for(locker, POLL_INTERVAL, [&](){ return m_stopLogging || m_flushRequested != m_flushCompleted; });
+            stop = m_stopLogging;
+            flushRequest = m_flushRequested;
+            m_buffers.insert(m_buffers.end(), m_newBuffers.begin(), m_newBuffers.end());
+            m_newBuffers.clear();
+        }
+
+        //statements of different threads are written in the order they were logged in
+        pending.clear();
+        for (size_t i = 0; i < m_buffers.size(); ++i)
+        {
+            m_buffers[i]->BeginRead();
+            while (const char* record = m_buffers[i]->NextRecord())
+            {
+                RecordHeader header;
+                memcpy(&header, record, sizeof(header));
+                pending.push_back({header.timestamp, i, record});
+            }
+        }
+        std::stable_sort(pending.begin(), pending.end(), [](const PendingRecord& a, const PendingRecord& b) { return a.timestamp < b.timestamp; });
+
+        uint64_t drops = GetDroppedStatementCount();
+        if (!pending.empty() || drops != reportedDrops)
+        {
+            if (rollLog)
+            {
+                int32_t currentHour = DateTime::Now().GetHour(false /*localtime*/);
+                if (currentHour != lastRolledHour)
+                {
+                    log = MakeDefaultLogFile(filenamePrefix);
+                    lastRolledHour = currentHour;
+                }
+            }
+
+            for (const auto& item : pending)
+            {
+                RecordHeader header;
+                memcpy(&header, item.record, sizeof(header));
+                const char* tag = item.record + sizeof(header);
+                const char* body = tag + header.tagLength;
+                uint32_t length;
+                memcpy(&length, body, sizeof(length));
+                body += sizeof(length);
+
+                line.clear();
+                AppendPrefix(line, static_cast<LogLevel>(header.level), header.timestamp, tag, header.tagLength, m_buffers[item.bufferIndex]->GetThreadId());
+                switch (static_cast<RecordType>(header.type))
+                {
+                    case RecordType::Text:
+                        line.append(body, length);
+                        break;
+                    case RecordType::Format:
+                        AppendFormatted(line, body, length, body + length, item.record + header.size);
+                        break;
+                    case RecordType::Fields:
+                        AppendFields(line, body, length, body + length, item.record + header.size, fields);
+                        break;
+                }
+                line += '\n';
+                log->write(line.data(), static_cast<std::streamsize>(line.size()));
+            }
+
+            if (drops != reportedDrops)
+            {
+                line.clear();
+                AppendPrefix(line, LogLevel::Warn, DateTime::CurrentTimeMillis(), AllocationTag, strlen(AllocationTag), loggingThreadId.str());
+                line += "Dropped ";
+                line += StringUtils::to_string(drops - reportedDrops);
+                line += " log statements because the buffer of the thread logging them was full\n";
+                log->write(line.data(), static_cast<std::streamsize>(line.size()));
+                reportedDrops = drops;
+            }
+
+            log->flush();
+        }
+
+        for (auto& buffer : m_buffers)
+        {
+            buffer->EndRead();
+        }
+        //a buffer is abandoned when its thread exits, it can go once everything written to it has been read
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+            [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer->IsAbandoned() && buffer->IsEmpty(); }), m_buffers.end());
+
+        {
+            std::lock_guard<std::mutex> locker(m_mutex);
+            m_flushCompleted = flushRequest;
+            if (stop)
+            {
+                m_loggingStopped = true;
+            }
+        }
+        m_flushSignal.notify_all();
+
+        if (stop)
+        {
+            break;
+        }
+    }
+}
@@ -5,6 +5,7 @@
 
 
 #include <aws/core/utils/logging/FormattedLogSystem.h>
+#include <aws/core/utils/logging/LogField.h>
 
 #include <aws/core/utils/DateTime.h>
 #include <aws/core/utils/Array.h>
@@ -97,3 +98,11 @@ void FormattedLogSystem::LogStream(LogLevel logLevel, const char* tag, const Aws
 {
     ProcessFormattedStatement(CreateLogPrefixLine(logLevel, tag) + message_stream.str() + "\n");
 }
+
+void FormattedLogSystem::LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount)
+{
+    Aws::String statement = CreateLogPrefixLine(logLevel, tag);
+    AppendLogFields(statement, message, strlen(message), fields, fieldCount);
+    statement += '\n';
+    ProcessFormattedStatement(std::move(statement));
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/logging/LogField.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+
+#include <cinttypes>
+#include <cstdio>
+
+using namespace Aws::Utils::Logging;
+
+static bool NeedsQuotes(const char* value, size_t length)
+{
+    if (length == 0)
+    {
+        return true;
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c <= ' ' || c == '"' || c == '=' || c == 0x7F)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void AppendQuoted(Aws::String& line, const char* value, size_t length)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    line += '"';
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        switch (c)
+        {
+            case '"': line += "\\\""; break;
+            case '\\': line += "\\\\"; break;
+            case '\n': line += "\\n"; break;
+            case '\r': line += "\\r"; break;
+            case '\t': line += "\\t"; break;
+            default:
+                if (c < ' ' || c == 0x7F)
+                {
+                    line += "\\x";
+                    line += HEX_DIGITS[c >> 4];
+                    line += HEX_DIGITS[c & 0xF];
+                }
+                else
+                {
+                    line += static_cast<char>(c);
+                }
+                break;
+        }
+    }
+    line += '"';
+}
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Logging
+        {
+            void AppendLogFields(Aws::String& line, const char* message, size_t messageLength, const LogField* fields, size_t fieldCount)
+            {
+                line.append(message, messageLength);
+                char number[32];
+                for (size_t i = 0; i < fieldCount; ++i)
+                {
+                    const LogField& field = fields[i];
+                    line += ' ';
+                    line += field.GetKey();
+                    line += '=';
+                    switch (field.GetType())
+                    {
+                        case LogField::Type::Signed:
+                            snprintf(number, sizeof(number), "%" PRId64, field.GetSigned());
+                            line += number;
+                            break;
+                        case LogField::Type::Unsigned:
+                            snprintf(number, sizeof(number), "%" PRIu64, field.GetUnsigned());
+                            line += number;
+                            break;
+                        case LogField::Type::Double:
+                            snprintf(number, sizeof(number), "%.15g", field.GetDouble());
+                            line += number;
+                            break;
+                        case LogField::Type::Bool:
+                            line += field.GetBool() ? "true" : "false";
+                            break;
+                        case LogField::Type::String:
+                            if (NeedsQuotes(field.GetString(), field.GetStringLength()))
+                            {
+                                AppendQuoted(line, field.GetString(), field.GetStringLength());
+                            }
+                            else
+                            {
+                                line.append(field.GetString(), field.GetStringLength());
+                            }
+                            break;
+                    }
+                }
+            }
+
+            void LogSystemInterface::LogFields(LogLevel logLevel, const char* tag, const char* message, const LogField* fields, size_t fieldCount)
+            {
+                Aws::String line;
+                AppendLogFields(line, message, strlen(message), fields, fieldCount);
+                Aws::OStringStream messageStream;
+                messageStream << line;
+                LogStream(logLevel, tag, messageStream);
+            }
+
+        } // namespace Logging
+    } // namespace Utils
+} // namespace Aws
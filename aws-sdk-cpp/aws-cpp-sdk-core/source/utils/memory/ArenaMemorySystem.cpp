@@ -0,0 +1,193 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/memory/ArenaMemorySystem.h>
+#include <aws/core/utils/UnreferencedParam.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Aws::Utils::Memory;
+
+static const char* AllocationTag = "ArenaMemorySystem";
+static const size_t ALIGNMENT = 16;
+
+namespace
+{
+    size_t AlignSize(size_t size)
+    {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    /**
+     * Start of every block. The block is referenced by the scope allocating from it and by every allocation that isn't freed yet.
+     */
+    struct ArenaBlock
+    {
+        ArenaBlock(ArenaMemorySystem* blockOwner) : references(1), owner(blockOwner) {}
+
+        std::atomic<size_t> references;
+        ArenaMemorySystem* owner;
+    };
+
+    /**
+     * Precedes every allocation, block is null for the ones that come from the upstream memory system.
+     */
+    struct AllocationHeader
+    {
+        ArenaBlock* block;
+    };
+
+    const size_t BLOCK_HEADER_SIZE = AlignSize(sizeof(ArenaBlock));
+    const size_t ALLOCATION_HEADER_SIZE = AlignSize(sizeof(AllocationHeader));
+}
+
+static thread_local RequestArenaScope* s_currentScope = nullptr;
+
+ArenaMemorySystem::ArenaMemorySystem(MemorySystemInterface* upstream, size_t blockSize) :
+    m_upstream(upstream),
+    m_blockSize(AlignSize(blockSize < 1024 ? 1024 : blockSize))
+{
+}
+
+void ArenaMemorySystem::Begin()
+{
+    if (m_upstream)
+    {
+        m_upstream->Begin();
+    }
+}
+
+void ArenaMemorySystem::End()
+{
+    if (m_upstream)
+    {
+        m_upstream->End();
+    }
+}
+
+void* ArenaMemorySystem::AllocateUpstream(size_t size, const char* allocationTag)
+{
+    return m_upstream ? m_upstream->AllocateMemory(size, ALIGNMENT, allocationTag) : malloc(size);
+}
+
+void ArenaMemorySystem::FreeUpstream(void* memoryPtr)
+{
+    if (m_upstream)
+    {
+        m_upstream->FreeMemory(memoryPtr);
+    }
+    else
+    {
+        free(memoryPtr);
+    }
+}
+
+void ArenaMemorySystem::ReleaseBlock(void* block)
+{
+    ArenaBlock* arenaBlock = static_cast<ArenaBlock*>(block);
+    if (arenaBlock->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        ArenaMemorySystem* owner = arenaBlock->owner;
+        arenaBlock->~ArenaBlock();
+        owner->FreeUpstream(arenaBlock);
+    }
+}
+
+bool ArenaMemorySystem::NewBlock(RequestArenaScope& scope)
+{
+    char* block = static_cast<char*>(AllocateUpstream(m_blockSize, AllocationTag));
+    if (!block)
+    {
+        return false;
+    }
+
+    if (scope.m_block)
+    {
+        ReleaseBlock(scope.m_block);
+    }
+    scope.m_block = new (block) ArenaBlock(this);
+    scope.m_cursor = block + BLOCK_HEADER_SIZE;
+    scope.m_end = block + m_blockSize;
+    return true;
+}
+
+void* ArenaMemorySystem::AllocateMemory(std::size_t blockSize, std::size_t alignment, const char* allocationTag)
+{
+    AWS_UNREFERENCED_PARAM(alignment);
+
+    size_t size = ALLOCATION_HEADER_SIZE + AlignSize(blockSize);
+    RequestArenaScope* scope = s_currentScope;
+    if (scope && size <= m_blockSize / 4)
+    {
+        ArenaBlock* block = static_cast<ArenaBlock*>(scope->m_block);
+        bool fits = block && block->owner == this && static_cast<size_t>(scope->m_end - scope->m_cursor) >= size;
+        if (fits || NewBlock(*scope))
+        {
+            block = static_cast<ArenaBlock*>(scope->m_block);
+            block->references.fetch_add(1, std::memory_order_relaxed);
+            char* memory = scope->m_cursor;
+            scope->m_cursor += size;
+            new (memory) AllocationHeader{block};
+            return memory + ALLOCATION_HEADER_SIZE;
+        }
+    }
+
+    char* memory = static_cast<char*>(AllocateUpstream(size, allocationTag));
+    if (!memory)
+    {
+        return nullptr;
+    }
+    new (memory) AllocationHeader{nullptr};
+    return memory + ALLOCATION_HEADER_SIZE;
+}
+
+void ArenaMemorySystem::FreeMemory(void* memoryPtr)
+{
+    if (!memoryPtr)
+    {
+        return;
+    }
+
+    AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(memoryPtr) - ALLOCATION_HEADER_SIZE);
+    if (header->block)
+    {
+        ReleaseBlock(header->block);
+    }
+    else
+    {
+        FreeUpstream(header);
+    }
+}
+
+RequestArenaScope::RequestArenaScope() :
+    m_previous(s_currentScope),
+    m_block(nullptr),
+    m_cursor(nullptr),
+    m_end(nullptr)
+{
+    s_currentScope = this;
+}
+
+RequestArenaScope::~RequestArenaScope()
+{
+    s_currentScope = m_previous;
+    if (m_block)
+    {
+        ArenaMemorySystem::ReleaseBlock(m_block);
+    }
+}
+
+RequestArenaSuspension::RequestArenaSuspension() :
+    m_suspended(s_currentScope)
+{
+    s_currentScope = nullptr;
+}
+
+RequestArenaSuspension::~RequestArenaSuspension()
+{
+    s_currentScope = m_suspended;
+}
@@ -0,0 +1,241 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/stream/AwsChunkedStream.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Stream
+        {
+            static const char* CLASS_TAG = "AwsChunkedStream";
+            static const char CHUNK_SIGNATURE_EXTENSION[] = ";chunk-signature=";
+            static const char CRLF[] = "\r\n";
+            static const size_t CHUNK_SIGNATURE_EXTENSION_LENGTH = sizeof(CHUNK_SIGNATURE_EXTENSION) - 1;
+            static const size_t CRLF_LENGTH = sizeof(CRLF) - 1;
+            //hex encoded sha256 hmac
+            static const size_t SIGNATURE_LENGTH = 64;
+            //room in front of the chunk data for its header, large enough for a 64 bit hex length and a signature
+            static const size_t CHUNK_HEADER_RESERVE = 128;
+
+            static size_t HexLength(uint64_t value)
+            {
+                size_t length = 1;
+                while (value >>= 4)
+                {
+                    ++length;
+                }
+                return length;
+            }
+
+            static size_t ChunkOverhead(uint64_t chunkLength)
+            {
+                return HexLength(chunkLength) + CHUNK_SIGNATURE_EXTENSION_LENGTH + SIGNATURE_LENGTH + CRLF_LENGTH * 2;
+            }
+
+            AwsChunkedStreamBuf::AwsChunkedStreamBuf(const std::shared_ptr<Aws::IOStream>& body, const ChunkSigner& chunkSigner,
+                const Aws::String& seedSignature, size_t chunkSize) :
+                m_body(body),
+                m_chunkSigner(chunkSigner),
+                m_seedSignature(seedSignature),
+                m_priorSignature(seedSignature),
+                m_chunkSize(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE),
+                m_buffer(CHUNK_HEADER_RESERVE + m_chunkSize + CRLF_LENGTH),
+                m_position(0),
+                m_decodedPosition(0),
+                m_decodedReported(0),
+                m_chunkData(nullptr),
+                m_chunkDataLength(0),
+                m_finished(false)
+            {
+                m_body->clear();
+                m_body->seekg(0, std::ios_base::beg);
+                setg(nullptr, nullptr, nullptr);
+            }
+
+            uint64_t AwsChunkedStreamBuf::GetEncodedLength(uint64_t decodedLength, size_t chunkSize)
+            {
+                if (chunkSize == 0)
+                {
+                    chunkSize = DEFAULT_CHUNK_SIZE;
+                }
+
+                uint64_t fullChunks = decodedLength / chunkSize;
+                uint64_t remainder = decodedLength % chunkSize;
+
+                uint64_t encodedLength = fullChunks * (chunkSize + ChunkOverhead(chunkSize));
+                if (remainder > 0)
+                {
+                    encodedLength += remainder + ChunkOverhead(remainder);
+                }
+                //the terminating empty chunk
+                return encodedLength + ChunkOverhead(0);
+            }
+
+            uint64_t AwsChunkedStreamBuf::TakeDecodedBytesRead()
+            {
+                uint64_t decodedRead = m_decodedPosition;
+                if (m_chunkData && gptr() > m_chunkData)
+                {
+                    decodedRead += (std::min)(static_cast<size_t>(gptr() - m_chunkData), m_chunkDataLength);
+                }
+
+                uint64_t taken = decodedRead > m_decodedReported ? decodedRead - m_decodedReported : 0;
+                m_decodedReported = (std::max)(m_decodedReported, decodedRead);
+                return taken;
+            }
+
+            bool AwsChunkedStreamBuf::EncodeNextChunk()
+            {
+                if (m_finished)
+                {
+                    return false;
+                }
+
+                char* data = m_buffer.data() + CHUNK_HEADER_RESERVE;
+                size_t length = 0;
+                while (length < m_chunkSize && m_body->good())
+                {
+                    m_body->read(data + length, static_cast<std::streamsize>(m_chunkSize - length));
+                    length += static_cast<size_t>(m_body->gcount());
+                }
+
+                if (m_body->bad())
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to read the body for the next aws-chunked chunk.");
+                    return false;
+                }
+
+                Aws::String signature = m_chunkSigner(m_priorSignature, reinterpret_cast<const unsigned char*>(data), length);
+                if (signature.empty())
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Failed to sign aws-chunked chunk of " << length << " bytes.");
+                    return false;
+                }
+
+                char hexLength[17];
+                size_t hexDigits = HexLength(length);
+                uint64_t value = length;
+                for (size_t i = hexDigits; i > 0; --i)
+                {
+                    hexLength[i - 1] = "0123456789abcdef"[value & 0xF];
+                    value >>= 4;
+                }
+
+                size_t headerLength = hexDigits + CHUNK_SIGNATURE_EXTENSION_LENGTH + signature.size() + CRLF_LENGTH;
+                if (headerLength > CHUNK_HEADER_RESERVE)
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Unexpected chunk signature of " << signature.size() << " characters.");
+                    return false;
+                }
+
+                char* header = data - headerLength;
+                char* out = header;
+                memcpy(out, hexLength, hexDigits);
+                out += hexDigits;
+                memcpy(out, CHUNK_SIGNATURE_EXTENSION, CHUNK_SIGNATURE_EXTENSION_LENGTH);
+                out += CHUNK_SIGNATURE_EXTENSION_LENGTH;
+                memcpy(out, signature.c_str(), signature.size());
+                out += signature.size();
+                memcpy(out, CRLF, CRLF_LENGTH);
+                memcpy(data + length, CRLF, CRLF_LENGTH);
+
+                m_priorSignature = std::move(signature);
+                m_finished = length == 0;
+                m_chunkData = data;
+                m_chunkDataLength = length;
+                setg(header, header, data + length + CRLF_LENGTH);
+                return true;
+            }
+
+            AwsChunkedStreamBuf::int_type AwsChunkedStreamBuf::underflow()
+            {
+                if (gptr() < egptr())
+                {
+                    return traits_type::to_int_type(*gptr());
+                }
+
+                m_position += static_cast<uint64_t>(egptr() - eback());
+                m_decodedPosition += m_chunkDataLength;
+                m_chunkData = nullptr;
+                m_chunkDataLength = 0;
+                if (!EncodeNextChunk())
+                {
+                    setg(nullptr, nullptr, nullptr);
+                    return traits_type::eof();
+                }
+
+                return traits_type::to_int_type(*gptr());
+            }
+
+            AwsChunkedStreamBuf::pos_type AwsChunkedStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+            {
+                if (dir == std::ios_base::beg)
+                {
+                    return seekpos(off, which);
+                }
+
+                if (dir == std::ios_base::cur && off == 0 && (which & std::ios_base::in))
+                {
+                    return pos_type(static_cast<off_type>(m_position + static_cast<uint64_t>(gptr() - eback())));
+                }
+
+                return pos_type(off_type(-1));
+            }
+
+            AwsChunkedStreamBuf::pos_type AwsChunkedStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+            {
+                if (!(which & std::ios_base::in))
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                if (pos == seekoff(0, std::ios_base::cur, which))
+                {
+                    return pos;
+                }
+
+                //the signature chain can only be restarted from the first chunk
+                if (pos != pos_type(0))
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                m_body->clear();
+                m_body->seekg(0, std::ios_base::beg);
+                if (m_body->fail())
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                m_priorSignature = m_seedSignature;
+                m_finished = false;
+                m_position = 0;
+                m_decodedPosition = 0;
+                m_decodedReported = 0;
+                m_chunkData = nullptr;
+                m_chunkDataLength = 0;
+                setg(nullptr, nullptr, nullptr);
+                return pos;
+            }
+
+            AwsChunkedStream::AwsChunkedStream(const std::shared_ptr<Aws::IOStream>& body, const ChunkSigner& chunkSigner,
+                const Aws::String& seedSignature, size_t chunkSize) :
+                Aws::IOStream(m_chunkedBuf = Aws::New<AwsChunkedStreamBuf>(CLASS_TAG, body, chunkSigner, seedSignature, chunkSize))
+            {
+            }
+
+            AwsChunkedStream::~AwsChunkedStream()
+            {
+                Aws::Delete(m_chunkedBuf);
+            }
+        }
+    }
+}
@@ -4,6 +4,7 @@
  */
 #include <aws/core/utils/stream/ConcurrentStreamBuf.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <algorithm>
 #include <cstdint>
 #include <cassert>
 
@@ -15,43 +16,94 @@ namespace Aws
         {
             const char TAG[] = "ConcurrentStreamBuf";
             ConcurrentStreamBuf::ConcurrentStreamBuf(size_t bufferLength) :
-                m_putArea(bufferLength), // we access [0] of the put area below so we must initialize it.
-                m_eof(false)
+                m_buffer((std::max)(bufferLength, static_cast<size_t>(1))),
+                m_writePos(0),
+                m_readPos(0),
+                m_putPos(0),
+                m_getPos(0),
+                m_eof(false),
+                m_waiters(0)
             {
-                m_getArea.reserve(bufferLength);
-                m_backbuf.reserve(bufferLength);
-
-                char* pbegin = reinterpret_cast<char*>(&m_putArea[0]);
-                setp(pbegin, pbegin + bufferLength);
+                ResetPutArea();
             }
 
             void ConcurrentStreamBuf::SetEof()
             {
+                m_eof = true;
                 {
-                    std::unique_lock<std::mutex> lock(m_lock);
-                    m_eof = true;
+                    std::lock_guard<std::mutex> lock(m_lock);
                 }
                 m_signal.notify_all();
             }
 
-            void ConcurrentStreamBuf::FlushPutArea()
+            void ConcurrentStreamBuf::ResetPutArea()
             {
-                const size_t bitslen = pptr() - pbase();
-                if (bitslen)
+                // The put area spans the free bytes of the ring up to its end, it wraps around on a later overflow.
+                const size_t capacity = m_buffer.size();
+                const size_t offset = m_putPos % capacity;
+                const size_t available = (std::min)(capacity - (m_putPos - m_readPos), capacity - offset);
+                char* pbegin = reinterpret_cast<char*>(m_buffer.data() + offset);
+                setp(pbegin, pbegin + available);
+            }
+
+            void ConcurrentStreamBuf::ReleaseGetArea()
+            {
+                // Hand the bytes read so far back to the writer.
+                if (eback())
+                {
+                    m_getPos += egptr() - eback();
+                    m_readPos = m_getPos;
+                    setg(nullptr, nullptr, nullptr);
+                    Notify();
+                }
+            }
+
+            void ConcurrentStreamBuf::Notify()
+            {
+                // Publishing a position and reading the waiters count are both sequentially consistent, so either the
+                // other side sees the new position before parking or it is counted here and gets woken up.
+                if (m_waiters > 0)
                 {
-                    // scope the lock
                     {
-                        std::unique_lock<std::mutex> lock(m_lock);
-                        m_signal.wait(lock, [this, bitslen]{ return m_eof || bitslen <= (m_backbuf.capacity() - m_backbuf.size()); });
-                        if (m_eof)
-                        {
-                            return;
-                        }
-                        std::copy(pbase(), pptr(), std::back_inserter(m_backbuf));
+                        std::lock_guard<std::mutex> lock(m_lock);
                     }
-                    m_signal.notify_one();
-                    char* pbegin = reinterpret_cast<char*>(&m_putArea[0]);
-                    setp(pbegin, pbegin + m_putArea.size());
+                    m_signal.notify_all();
+                }
+            }
+
+            bool ConcurrentStreamBuf::WaitForSpace()
+            {
+                const size_t capacity = m_buffer.size();
+                if (!m_eof && m_putPos - m_readPos == capacity)
+                {
+                    ++m_waiters;
+                    std::unique_lock<std::mutex> lock(m_lock);
+                    m_signal.wait(lock, [this, capacity]{ return m_eof || m_putPos - m_readPos < capacity; });
+                    --m_waiters;
+                }
+                return !m_eof;
+            }
+
+            void ConcurrentStreamBuf::WaitForData()
+            {
+                if (!m_eof && m_writePos == m_getPos)
+                {
+                    ++m_waiters;
+                    std::unique_lock<std::mutex> lock(m_lock);
+                    m_signal.wait(lock, [this]{ return m_eof || m_writePos != m_getPos; });
+                    --m_waiters;
+                }
+            }
+
+            void ConcurrentStreamBuf::FlushPutArea()
+            {
+                const size_t bitslen = pptr() - pbase();
+                if (bitslen && !m_eof)
+                {
+                    m_putPos += bitslen;
+                    m_writePos = m_putPos;
+                    Notify();
+                    ResetPutArea();
                 }
             }
 
@@ -67,53 +119,63 @@ namespace Aws
 
             int ConcurrentStreamBuf::underflow()
             {
+                if (gptr() < egptr())
                 {
-                    std::unique_lock<std::mutex> lock(m_lock);
-                    m_signal.wait(lock, [this]{ return m_backbuf.empty() == false || m_eof; });
-
-                    if (m_eof && m_backbuf.empty())
-                    {
-                        return std::char_traits<char>::eof();
-                    }
+                    return std::char_traits<char>::to_int_type(*gptr());
+                }
 
-                    m_getArea.clear(); // keep the get-area from growing unbounded.
-                    std::copy(m_backbuf.begin(), m_backbuf.end(), std::back_inserter(m_getArea));
-                    m_backbuf.clear();
+                ReleaseGetArea();
+                WaitForData();
+                const size_t writePos = m_writePos;
+                if (writePos == m_getPos)
+                {
+                    return std::char_traits<char>::eof();
                 }
-                m_signal.notify_one();
-                char* gbegin = reinterpret_cast<char*>(&m_getArea[0]);
-                setg(gbegin, gbegin, gbegin + m_getArea.size());
+
+                const size_t capacity = m_buffer.size();
+                const size_t offset = m_getPos % capacity;
+                const size_t available = (std::min)(writePos - m_getPos, capacity - offset);
+                char* gbegin = reinterpret_cast<char*>(m_buffer.data() + offset);
+                setg(gbegin, gbegin, gbegin + available);
                 return std::char_traits<char>::to_int_type(*gptr());
             }
 
+            std::streamsize ConcurrentStreamBuf::xsgetn(char* s, std::streamsize n)
+            {
+                const auto read = std::streambuf::xsgetn(s, n);
+                if (gptr() == egptr())
+                {
+                    // Don't hold on to the bytes just read until the next read, the writer may be waiting for them.
+                    ReleaseGetArea();
+                }
+                return read;
+            }
+
             std::streamsize ConcurrentStreamBuf::showmanyc()
             {
-                std::unique_lock<std::mutex> lock(m_lock);
-                AWS_LOGSTREAM_TRACE(TAG, "stream how many character? " << m_backbuf.size());
-                return m_backbuf.size();
+                const size_t available = m_writePos - (m_getPos + (egptr() - eback()));
+                AWS_LOGSTREAM_TRACE(TAG, "stream how many character? " << available);
+                return available;
             }
 
             int ConcurrentStreamBuf::overflow(int ch)
             {
                 const auto eof = std::char_traits<char>::eof();
 
+                FlushPutArea();
                 if (ch == eof)
                 {
-                    FlushPutArea();
                     return eof;
                 }
 
-                FlushPutArea();
+                if (!WaitForSpace())
                 {
-                    std::unique_lock<std::mutex> lock(m_lock);
-                    if (m_eof)
-                    {
-                        return eof;
-                    }
-                    *pptr() = static_cast<char>(ch);
-                    pbump(1);
-                    return ch;
+                    return eof;
                 }
+                ResetPutArea();
+                *pptr() = static_cast<char>(ch);
+                pbump(1);
+                return ch;
             }
 
             int ConcurrentStreamBuf::sync()
@@ -0,0 +1,175 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/threading/BoundedThreadExecutor.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <algorithm>
+
+static const char* BOUNDED_CLASS_TAG = "BoundedThreadExecutor";
+
+using namespace Aws::Utils::Threading;
+
+namespace
+{
+    //executor state the current thread works for, submissions from these threads must not wait for queue space
+    thread_local const void* s_currentExecutor = nullptr;
+}
+
+BoundedThreadExecutor::State::State(size_t maxThreadCount, size_t maxQueuedTaskCount, QueueFullPolicy policy) :
+    maxThreads(maxThreadCount > 0 ? maxThreadCount : 1),
+    maxQueuedTasks(maxQueuedTaskCount),
+    queueFullPolicy(policy),
+    idleThreads(0),
+    shouldContinue(true)
+{
+}
+
+BoundedThreadExecutor::BoundedThreadExecutor(size_t maxThreads, size_t maxQueuedTasks, QueueFullPolicy queueFullPolicy) :
+    m_state(Aws::MakeShared<State>(BOUNDED_CLASS_TAG, maxThreads, maxQueuedTasks, queueFullPolicy))
+{
+}
+
+BoundedThreadExecutor::~BoundedThreadExecutor()
+{
+    Aws::Vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> locker(m_state->lock);
+        m_state->shouldContinue = false;
+        threads.swap(m_state->threads);
+    }
+    m_state->taskAvailable.notify_all();
+    m_state->spaceAvailable.notify_all();
+
+    for (auto& thread : threads)
+    {
+        if (thread.get_id() == std::this_thread::get_id())
+        {
+            //one of our tasks released the last reference, joining would never return
+            AWS_LOGSTREAM_DEBUG(BOUNDED_CLASS_TAG, "Executor destroyed by one of its tasks, detaching the thread running it.");
+            thread.detach();
+        }
+        else
+        {
+            thread.join();
+        }
+    }
+}
+
+size_t BoundedThreadExecutor::GetDefaultMaxThreads()
+{
+    return (std::max)(static_cast<size_t>(16), static_cast<size_t>(std::thread::hardware_concurrency()) * 4);
+}
+
+BoundedThreadExecutorMetrics BoundedThreadExecutor::GetMetrics() const
+{
+    std::lock_guard<std::mutex> locker(m_state->lock);
+    BoundedThreadExecutorMetrics metrics = m_state->metrics;
+    metrics.threadCount = m_state->threads.size();
+    metrics.idleThreadCount = m_state->idleThreads;
+    metrics.queueDepth = m_state->tasks.size();
+    return metrics;
+}
+
+bool BoundedThreadExecutor::SubmitToThread(std::function<void()>&& fn)
+{
+    State& state = *m_state;
+    const bool nested = s_currentExecutor == &state;
+    std::unique_lock<std::mutex> locker(state.lock);
+
+    if (state.maxQueuedTasks > 0 && state.tasks.size() >= state.maxQueuedTasks && !nested)
+    {
+        if (state.queueFullPolicy == QueueFullPolicy::REJECT)
+        {
+            state.metrics.rejectedTasks++;
+            AWS_LOGSTREAM_WARN(BOUNDED_CLASS_TAG, "Rejecting task, " << state.tasks.size() << " tasks are already queued.");
+            return false;
+        }
+
+        state.metrics.blockedSubmissions++;
+        AWS_LOGSTREAM_DEBUG(BOUNDED_CLASS_TAG, "Queue is full with " << state.tasks.size() << " tasks, waiting for space.");
+        state.spaceAvailable.wait(locker, [&state] { return !state.shouldContinue || state.tasks.size() < state.maxQueuedTasks; });
+    }
+
+    if (!state.shouldContinue)
+    {
+        return false;
+    }
+
+    QueuedTask task;
+    task.fn = std::move(fn);
+    task.enqueueTime = std::chrono::steady_clock::now();
+    state.tasks.push_back(std::move(task));
+    state.metrics.submittedTasks++;
+    state.metrics.peakQueueDepth = (std::max)(state.metrics.peakQueueDepth, state.tasks.size());
+
+    //grow lazily: only start a thread when the idle ones can't pick up everything that is queued.
+    //a task of ours may wait on what it submits, so it always gets a thread, past the limit if need be.
+    if (state.idleThreads < state.tasks.size() && (state.threads.size() < state.maxThreads || nested))
+    {
+        AWS_LOGSTREAM_DEBUG(BOUNDED_CLASS_TAG, "Starting thread " << state.threads.size() + 1 << " of " << state.maxThreads);
+        state.threads.emplace_back(&BoundedThreadExecutor::WorkerLoop, m_state);
+    }
+
+    locker.unlock();
+    state.taskAvailable.notify_one();
+    return true;
+}
+
+void BoundedThreadExecutor::WorkerLoop(std::shared_ptr<State> state)
+{
+    s_currentExecutor = state.get();
+
+    std::unique_lock<std::mutex> locker(state->lock);
+    for (;;)
+    {
+        if (state->tasks.empty())
+        {
+            if (!state->shouldContinue)
+            {
+                break;
+            }
+
+            if (state->threads.size() > state->maxThreads)
+            {
+                //extra thread started for a nested submission, nothing is left for it to do
+                auto self = std::find_if(state->threads.begin(), state->threads.end(),
+                        [](const std::thread& thread) { return thread.get_id() == std::this_thread::get_id(); });
+                if (self != state->threads.end())
+                {
+                    self->detach();
+                    state->threads.erase(self);
+                    break;
+                }
+            }
+
+            state->idleThreads++;
+            state->taskAvailable.wait(locker, [&state] { return !state->shouldContinue || !state->tasks.empty(); });
+            state->idleThreads--;
+            continue;
+        }
+
+        QueuedTask task = std::move(state->tasks.front());
+        state->tasks.pop_front();
+        locker.unlock();
+        state->spaceAvailable.notify_one();
+
+        auto startTime = std::chrono::steady_clock::now();
+        task.fn();
+        auto endTime = std::chrono::steady_clock::now();
+
+        auto queueLatency = std::chrono::duration_cast<std::chrono::microseconds>(startTime - task.enqueueTime);
+        auto executionTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
+        //release whatever the task captured before taking the lock again, this may destroy the executor
+        task.fn = nullptr;
+
+        locker.lock();
+        state->metrics.completedTasks++;
+        state->metrics.totalQueueLatency += queueLatency;
+        state->metrics.maxQueueLatency = (std::max)(state->metrics.maxQueueLatency, queueLatency);
+        state->metrics.totalExecutionTime += executionTime;
+    }
+
+    s_currentExecutor = nullptr;
+}
@@ -5,10 +5,15 @@
 
 #include <aws/core/utils/threading/Executor.h>
 #include <aws/core/utils/threading/ThreadTask.h>
+#include <aws/core/utils/logging/LogMacros.h>
 #include <thread>
 #include <cassert>
 
 static const char* POOLED_CLASS_TAG = "PooledThreadExecutor";
+static const char* DEFAULT_EXECUTOR_TAG = "DefaultExecutor";
+
+static std::mutex s_defaultExecutorLock;
+static std::function<std::shared_ptr<Aws::Utils::Threading::Executor>()> s_defaultExecutorCreateFn;
 
 using namespace Aws::Utils::Threading;
 
@@ -153,3 +158,42 @@ bool PooledThreadExecutor::HasTasks()
     std::lock_guard<std::mutex> locker(m_queueLock);
     return m_tasks.size() > 0;
 }
+
+namespace Aws
+{
+    namespace Utils
+    {
+        namespace Threading
+        {
+            std::shared_ptr<Executor> GetDefaultExecutor()
+            {
+                std::lock_guard<std::mutex> locker(s_defaultExecutorLock);
+                if (!s_defaultExecutorCreateFn)
+                {
+                    //don't bring a shared pool back to life after ShutdownAPI(), give the caller a thread per task like before
+                    AWS_LOGSTREAM_ERROR(DEFAULT_EXECUTOR_TAG, "No default executor, was Aws::InitAPI() called? "
+                            "Falling back to a DefaultExecutor that isn't shared with other clients.");
+                    return Aws::MakeShared<DefaultExecutor>(DEFAULT_EXECUTOR_TAG);
+                }
+
+                return s_defaultExecutorCreateFn();
+            }
+
+            void InitDefaultExecutor(const std::function<std::shared_ptr<Executor>()>& createFn)
+            {
+                std::lock_guard<std::mutex> locker(s_defaultExecutorLock);
+                s_defaultExecutorCreateFn = createFn;
+            }
+
+            void CleanupDefaultExecutor()
+            {
+                std::function<std::shared_ptr<Executor>()> createFn;
+                {
+                    std::lock_guard<std::mutex> locker(s_defaultExecutorLock);
+                    createFn.swap(s_defaultExecutorCreateFn);
+                }
+                //the shared executor, if nobody else holds it, finishes its queued tasks here, outside the lock
+            }
+        } // namespace Threading
+    } // namespace Utils
+} // namespace Aws
@@ -0,0 +1,533 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/threading/WorkStealingThreadExecutor.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+
+static const char* WORK_STEALING_CLASS_TAG = "WorkStealingThreadExecutor";
+
+using namespace Aws::Utils::Threading;
+
+namespace
+{
+    //idle workers retry this many times before parking, adapted per worker between the two bounds
+    const size_t MIN_SPIN_COUNT = 16;
+    const size_t MAX_SPIN_COUNT = 1024;
+    //recycled task nodes kept per worker
+    const size_t MAX_CACHED_TASK_NODES = 256;
+    const size_t CACHE_LINE_SIZE = 64;
+
+    //worker the current thread belongs to, used to route nested submissions onto the worker's own deque
+    thread_local const void* s_currentExecutor = nullptr;
+    thread_local size_t s_currentWorkerIndex = 0;
+    //per submitting thread inbox cursor, seeded from the thread id so that producers spread over different inboxes
+    thread_local size_t s_submitCursor = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    size_t RoundUpToPowerOf2(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    /**
+     * Bounded multi-producer/multi-consumer queue. Each slot carries a sequence number that tells producers and consumers
+     * whose turn it is, so tasks are moved into and out of their slots without a lock or an extra allocation.
+     */
+    class TaskQueue
+    {
+    public:
+        explicit TaskQueue(size_t capacity) :
+            m_slots(capacity), m_mask(capacity - 1), m_enqueuePos(0), m_dequeuePos(0)
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Moves from task only if it returns true.
+         */
+        bool TryPush(std::function<void()>& task)
+        {
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;)
+            {
+                slot = &m_slots[pos & m_mask];
+                size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->task = std::move(task);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(std::function<void()>& task)
+        {
+            size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;)
+            {
+                slot = &m_slots[pos & m_mask];
+                size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            task = std::move(slot->task);
+            slot->task = nullptr;
+            slot->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Only a hint. A slot that has been claimed but not yet filled by a producer counts as non empty.
+         */
+        bool Empty() const
+        {
+            return m_dequeuePos.load() == m_enqueuePos.load();
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            std::function<void()> task;
+        };
+
+        Aws::Vector<Slot> m_slots;
+        const size_t m_mask;
+        char m_pad0[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_enqueuePos;
+        char m_pad1[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_dequeuePos;
+    };
+
+    struct TaskNode
+    {
+        std::function<void()> task;
+    };
+
+    /**
+     * Fixed capacity Chase-Lev deque. Only the owning worker pushes and pops at the bottom, any thread may steal from the top.
+     */
+    class WorkStealingDeque
+    {
+    public:
+        explicit WorkStealingDeque(size_t capacity) :
+            m_slots(capacity), m_mask(static_cast<int64_t>(capacity) - 1), m_top(0), m_bottom(0)
+        {
+        }
+
+        bool Push(TaskNode* node)
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            if (bottom - top > m_mask)
+            {
+                return false;
+            }
+
+            m_slots[bottom & m_mask].store(node, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        TaskNode* Pop()
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            TaskNode* node = m_slots[bottom & m_mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                //last element, race the thieves for it
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    node = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return node;
+        }
+
+        /**
+         * Returns nullptr if the deque is empty or another thread won the race for the top element.
+         */
+        TaskNode* Steal()
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            TaskNode* node = m_slots[top & m_mask].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return node;
+        }
+
+        bool Empty() const
+        {
+            return m_bottom.load() <= m_top.load();
+        }
+
+    private:
+        Aws::Vector<std::atomic<TaskNode*>> m_slots;
+        const int64_t m_mask;
+        char m_pad0[CACHE_LINE_SIZE];
+        std::atomic<int64_t> m_top;
+        char m_pad1[CACHE_LINE_SIZE];
+        std::atomic<int64_t> m_bottom;
+    };
+}
+
+struct WorkStealingThreadExecutor::Worker
+{
+    Worker(size_t capacity, size_t index) :
+        inbox(capacity), deque(capacity), spinCount(MIN_SPIN_COUNT), randomState(static_cast<uint32_t>(index) * 2654435761u + 1)
+    {
+    }
+
+    ~Worker()
+    {
+        std::function<void()> discarded;
+        while (inbox.TryPop(discarded))
+        {
+        }
+
+        while (TaskNode* node = deque.Pop())
+        {
+            Aws::Delete(node);
+        }
+
+        for (auto node : freeNodes)
+        {
+            Aws::Delete(node);
+        }
+    }
+
+    TaskNode* AcquireNode()
+    {
+        if (freeNodes.empty())
+        {
+            return Aws::New<TaskNode>(WORK_STEALING_CLASS_TAG);
+        }
+
+        TaskNode* node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+
+    void RecycleNode(TaskNode* node)
+    {
+        if (freeNodes.size() < MAX_CACHED_TASK_NODES)
+        {
+            freeNodes.push_back(node);
+        }
+        else
+        {
+            Aws::Delete(node);
+        }
+    }
+
+    size_t NextRandom()
+    {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    //filled by other threads, drained by anyone
+    TaskQueue inbox;
+    //filled by this worker only
+    WorkStealingDeque deque;
+    //the members below are only touched by this worker's thread
+    Aws::Vector<TaskNode*> freeNodes;
+    size_t spinCount;
+    uint32_t randomState;
+    std::thread thread;
+};
+
+WorkStealingThreadExecutor::WorkStealingThreadExecutor(size_t poolSize, OverflowPolicy overflowPolicy, size_t queueCapacityPerThread) :
+    m_sleepingWorkers(0), m_continue(true), m_overflowTaskCount(0), m_overflowPolicy(overflowPolicy)
+{
+    const size_t workerCount = poolSize > 0 ? poolSize : 1;
+    const size_t capacity = RoundUpToPowerOf2(queueCapacityPerThread);
+
+    //every worker has to exist before the first thread starts stealing
+    for (size_t index = 0; index < workerCount; ++index)
+    {
+        m_workers.push_back(Aws::New<Worker>(WORK_STEALING_CLASS_TAG, capacity, index));
+    }
+
+    for (size_t index = 0; index < workerCount; ++index)
+    {
+        m_workers[index]->thread = std::thread(&WorkStealingThreadExecutor::WorkerLoop, this, index);
+    }
+}
+
+WorkStealingThreadExecutor::~WorkStealingThreadExecutor()
+{
+    m_continue = false;
+    {
+        std::lock_guard<std::mutex> locker(m_parkLock);
+        m_parkSignal.notify_all();
+    }
+
+    for (auto worker : m_workers)
+    {
+        worker->thread.join();
+    }
+
+    for (auto worker : m_workers)
+    {
+        Aws::Delete(worker);
+    }
+}
+
+bool WorkStealingThreadExecutor::SubmitToThread(std::function<void()>&& fn)
+{
+    std::function<void()> task(std::move(fn));
+
+    if (s_currentExecutor == this)
+    {
+        Worker& worker = *m_workers[s_currentWorkerIndex];
+        TaskNode* node = worker.AcquireNode();
+        node->task = std::move(task);
+        if (worker.deque.Push(node))
+        {
+            WakeOne();
+            return true;
+        }
+
+        task = std::move(node->task);
+        node->task = nullptr;
+        worker.RecycleNode(node);
+    }
+
+    const size_t workerCount = m_workers.size();
+    const size_t start = s_submitCursor++;
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        if (m_workers[(start + i) % workerCount]->inbox.TryPush(task))
+        {
+            WakeOne();
+            return true;
+        }
+    }
+
+    if (m_overflowPolicy == OverflowPolicy::REJECT_IMMEDIATELY)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> locker(m_overflowLock);
+        m_overflowTasks.push(std::move(task));
+        m_overflowTaskCount.fetch_add(1);
+    }
+
+    WakeOne();
+    return true;
+}
+
+void WorkStealingThreadExecutor::WorkerLoop(size_t workerIndex)
+{
+    s_currentExecutor = this;
+    s_currentWorkerIndex = workerIndex;
+    Worker& worker = *m_workers[workerIndex];
+
+    size_t idleRounds = 0;
+    while (m_continue.load(std::memory_order_acquire))
+    {
+        if (TryRunTask(worker))
+        {
+            if (idleRounds > 0)
+            {
+                //spinning paid off, spin longer next time
+                worker.spinCount = (std::min)(worker.spinCount * 2, MAX_SPIN_COUNT);
+            }
+            idleRounds = 0;
+            continue;
+        }
+
+        if (++idleRounds < worker.spinCount)
+        {
+            if (idleRounds > worker.spinCount / 2)
+            {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+
+        //spinning did not find anything, give up sooner next time
+        worker.spinCount = (std::max)(worker.spinCount / 2, MIN_SPIN_COUNT);
+        Park();
+        idleRounds = 0;
+    }
+
+    s_currentExecutor = nullptr;
+}
+
+bool WorkStealingThreadExecutor::TryRunTask(Worker& worker)
+{
+    std::function<void()> task;
+
+    if (TaskNode* node = worker.deque.Pop())
+    {
+        task = std::move(node->task);
+        node->task = nullptr;
+        worker.RecycleNode(node);
+    }
+    else if (!worker.inbox.TryPop(task) && !TryPopOverflowTask(task) && !TryStealTask(worker, task))
+    {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+bool WorkStealingThreadExecutor::TryStealTask(Worker& worker, std::function<void()>& task)
+{
+    const size_t workerCount = m_workers.size();
+    const size_t start = worker.NextRandom();
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        Worker* victim = m_workers[(start + i) % workerCount];
+        if (victim == &worker)
+        {
+            continue;
+        }
+
+        if (TaskNode* node = victim->deque.Steal())
+        {
+            task = std::move(node->task);
+            node->task = nullptr;
+            worker.RecycleNode(node);
+            return true;
+        }
+
+        if (victim->inbox.TryPop(task))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WorkStealingThreadExecutor::TryPopOverflowTask(std::function<void()>& task)
+{
+    if (m_overflowTaskCount.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> locker(m_overflowLock);
+    if (m_overflowTasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(m_overflowTasks.front());
+    m_overflowTasks.pop();
+    m_overflowTaskCount.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingThreadExecutor::HasVisibleTasks() const
+{
+    if (m_overflowTaskCount.load() > 0)
+    {
+        return true;
+    }
+
+    for (auto worker : m_workers)
+    {
+        if (!worker->inbox.Empty() || !worker->deque.Empty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingThreadExecutor::Park()
+{
+    std::unique_lock<std::mutex> locker(m_parkLock);
+    //pairs with the fence in WakeOne(): either the submitter sees this worker sleeping or this worker sees the new task
+    m_sleepingWorkers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_continue.load() && !HasVisibleTasks())
+    {
+        m_parkSignal.wait(locker);
+    }
+    m_sleepingWorkers.fetch_sub(1);
+}
+
+void WorkStealingThreadExecutor::WakeOne()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepingWorkers.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> locker(m_parkLock);
+        m_parkSignal.notify_one();
+    }
+}
@@ -0,0 +1,737 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/core/utils/xml/XmlReader.h>
+#include <aws/core/utils/logging/LogMacros.h>
+
+#include <cstring>
+
+using namespace Aws::Utils::Xml;
+
+static const char XML_READER_TAG[] = "XmlReader";
+static const size_t READ_BUFFER_SIZE = 16 * 1024;
+//longest entity or character reference name, "#x10FFFF"
+static const size_t MAX_REFERENCE_LENGTH = 8;
+
+static bool IsXmlWhitespace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static bool IsNameEnd(char c)
+{
+    return IsXmlWhitespace(c) || c == '/' || c == '>' || c == '=' || c == '<';
+}
+
+static void AppendUtf8(Aws::String& out, unsigned long codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * Decodes the predefined entities and character references. Returns false for anything else, which is then kept as is.
+ */
+static bool DecodeReference(const char* name, size_t length, Aws::String* text)
+{
+    static const struct
+    {
+        const char* name;
+        char value;
+    } ENTITIES[] = { { "lt", '<' }, { "gt", '>' }, { "amp", '&' }, { "quot", '"' }, { "apos", '\'' } };
+
+    for (const auto& entity : ENTITIES)
+    {
+        if (strlen(entity.name) == length && memcmp(entity.name, name, length) == 0)
+        {
+            if (text)
+            {
+                text->push_back(entity.value);
+            }
+            return true;
+        }
+    }
+
+    if (length < 2 || name[0] != '#')
+    {
+        return false;
+    }
+
+    const bool hex = name[1] == 'x';
+    size_t i = hex ? 2 : 1;
+    if (i == length)
+    {
+        return false;
+    }
+    unsigned long codePoint = 0;
+    for (; i < length; ++i)
+    {
+        const char c = name[i];
+        unsigned digit = 0;
+        if (c >= '0' && c <= '9')
+        {
+            digit = static_cast<unsigned>(c - '0');
+        }
+        else if (hex && c >= 'a' && c <= 'f')
+        {
+            digit = static_cast<unsigned>(c - 'a' + 10);
+        }
+        else if (hex && c >= 'A' && c <= 'F')
+        {
+            digit = static_cast<unsigned>(c - 'A' + 10);
+        }
+        else
+        {
+            return false;
+        }
+        codePoint = codePoint * (hex ? 16 : 10) + digit;
+    }
+    if (codePoint == 0 || codePoint > 0x10FFFF)
+    {
+        return false;
+    }
+
+    if (text)
+    {
+        AppendUtf8(*text, codePoint);
+    }
+    return true;
+}
+
+XmlReader::XmlReader(Aws::IStream& stream) :
+    m_stream(&stream),
+    m_buffer(READ_BUFFER_SIZE),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_attributeCount(0),
+    m_elementPending(false),
+    m_emptyElement(false),
+    m_enteredEmpty(false),
+    m_rootRead(false)
+{
+}
+
+XmlReader::XmlReader(const char* data, size_t length) :
+    m_stream(nullptr),
+    m_cursor(data),
+    m_end(data + length),
+    m_attributeCount(0),
+    m_elementPending(false),
+    m_emptyElement(false),
+    m_enteredEmpty(false),
+    m_rootRead(false)
+{
+}
+
+bool XmlReader::Fill()
+{
+    if (!m_stream || !m_stream->good())
+    {
+        return false;
+    }
+
+    m_stream->read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    auto bytesRead = m_stream->gcount();
+    if (bytesRead <= 0)
+    {
+        return false;
+    }
+
+    m_cursor = m_buffer.data();
+    m_end = m_cursor + bytesRead;
+    return true;
+}
+
+bool XmlReader::Available()
+{
+    return m_cursor < m_end || Fill();
+}
+
+bool XmlReader::Expect(char c)
+{
+    if (!Available())
+    {
+        SetError("Unexpected end of document");
+        return false;
+    }
+
+    if (*m_cursor != c)
+    {
+        SetError("Unexpected character");
+        return false;
+    }
+
+    ++m_cursor;
+    return true;
+}
+
+void XmlReader::SetError(const char* message)
+{
+    if (m_errorMessage.empty())
+    {
+        m_errorMessage = message;
+        AWS_LOGSTREAM_ERROR(XML_READER_TAG, "Failed to parse xml: " << message);
+    }
+    m_elementPending = false;
+    m_enteredEmpty = false;
+    m_cursor = m_end;
+    m_stream = nullptr;
+}
+
+bool XmlReader::SkipWhitespace()
+{
+    for (;;)
+    {
+        while (m_cursor < m_end && IsXmlWhitespace(*m_cursor))
+        {
+            ++m_cursor;
+        }
+
+        if (m_cursor < m_end)
+        {
+            return true;
+        }
+
+        if (!Fill())
+        {
+            return false;
+        }
+    }
+}
+
+bool XmlReader::ReadText(Aws::String* text)
+{
+    for (;;)
+    {
+        const char* run = m_cursor;
+        while (m_cursor < m_end && *m_cursor != '<' && *m_cursor != '&' && *m_cursor != '\r')
+        {
+            ++m_cursor;
+        }
+        if (text)
+        {
+            text->append(run, static_cast<size_t>(m_cursor - run));
+        }
+
+        if (m_cursor == m_end)
+        {
+            if (!Fill())
+            {
+                return false;
+            }
+            continue;
+        }
+
+        switch (*m_cursor++)
+        {
+            case '<':
+                --m_cursor;
+                return true;
+            case '\r':
+                //line ends are normalized to a line feed
+                if (text)
+                {
+                    text->push_back('\n');
+                }
+                if (Available() && *m_cursor == '\n')
+                {
+                    ++m_cursor;
+                }
+                break;
+            default:
+                ReadReference(text);
+                break;
+        }
+    }
+}
+
+void XmlReader::ReadReference(Aws::String* text)
+{
+    char name[MAX_REFERENCE_LENGTH + 1];
+    size_t length = 0;
+    while (Available() && length <= MAX_REFERENCE_LENGTH)
+    {
+        const char c = *m_cursor;
+        if (c == ';' || c == '<' || c == '&' || c == '"' || c == '\'' || IsXmlWhitespace(c))
+        {
+            break;
+        }
+        name[length++] = c;
+        ++m_cursor;
+    }
+
+    if (m_cursor < m_end && *m_cursor == ';')
+    {
+        ++m_cursor;
+        if (DecodeReference(name, length, text))
+        {
+            return;
+        }
+        if (text)
+        {
+            text->push_back('&');
+            text->append(name, length);
+            text->push_back(';');
+        }
+        return;
+    }
+
+    //not a reference, a lone ampersand
+    if (text)
+    {
+        text->push_back('&');
+        text->append(name, length);
+    }
+}
+
+bool XmlReader::ReadName(Aws::String& name)
+{
+    name.clear();
+    for (;;)
+    {
+        const char* run = m_cursor;
+        while (m_cursor < m_end && !IsNameEnd(*m_cursor))
+        {
+            ++m_cursor;
+        }
+        name.append(run, static_cast<size_t>(m_cursor - run));
+        if (m_cursor < m_end || !Fill())
+        {
+            break;
+        }
+    }
+
+    if (name.empty())
+    {
+        SetError(m_cursor < m_end ? "Expected a name" : "Unexpected end of document");
+        return false;
+    }
+    return true;
+}
+
+bool XmlReader::ReadStartTag(Aws::String& name, bool keepAttributes)
+{
+    if (!ReadName(name))
+    {
+        return false;
+    }
+    if (keepAttributes)
+    {
+        m_attributeCount = 0;
+    }
+
+    for (;;)
+    {
+        if (!SkipWhitespace())
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+
+        if (*m_cursor == '>')
+        {
+            ++m_cursor;
+            m_emptyElement = false;
+            return true;
+        }
+        if (*m_cursor == '/')
+        {
+            ++m_cursor;
+            m_emptyElement = true;
+            return Expect('>');
+        }
+
+        Aws::String* value = nullptr;
+        if (keepAttributes)
+        {
+            if (m_attributeCount == m_attributes.size())
+            {
+                m_attributes.emplace_back();
+            }
+            auto& attribute = m_attributes[m_attributeCount++];
+            if (!ReadName(attribute.first))
+            {
+                return false;
+            }
+            attribute.second.clear();
+            value = &attribute.second;
+        }
+        else
+        {
+            //skipping over the element, its attribute names are of no use
+            while (Available() && !IsNameEnd(*m_cursor))
+            {
+                ++m_cursor;
+            }
+        }
+
+        if (!SkipWhitespace() || !Expect('=') || !SkipWhitespace())
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+        const char quote = *m_cursor++;
+        if (quote != '"' && quote != '\'')
+        {
+            SetError("Expected a quoted attribute value");
+            return false;
+        }
+
+        for (;;)
+        {
+            const char* run = m_cursor;
+            while (m_cursor < m_end && *m_cursor != quote && *m_cursor != '&')
+            {
+                ++m_cursor;
+            }
+            if (value)
+            {
+                value->append(run, static_cast<size_t>(m_cursor - run));
+            }
+
+            if (m_cursor == m_end)
+            {
+                if (!Fill())
+                {
+                    SetError("Unexpected end of document");
+                    return false;
+                }
+                continue;
+            }
+
+            if (*m_cursor++ == quote)
+            {
+                break;
+            }
+            ReadReference(value);
+        }
+    }
+}
+
+bool XmlReader::ReadEndTag()
+{
+    if (!ReadName(m_scratch) || !SkipWhitespace() || !Expect('>'))
+    {
+        SetError("Unexpected end of document");
+        return false;
+    }
+
+    if (m_elementOffsets.empty())
+    {
+        SetError("Unexpected end tag");
+        return false;
+    }
+
+    const size_t offset = m_elementOffsets.back();
+    if (m_elementPath.compare(offset, Aws::String::npos, m_scratch) != 0)
+    {
+        SetError("Mismatched end tag");
+        return false;
+    }
+
+    m_elementPath.resize(offset);
+    m_elementOffsets.pop_back();
+    return true;
+}
+
+bool XmlReader::SkipPast(const char* terminator, Aws::String* text)
+{
+    const size_t length = strlen(terminator);
+    size_t matched = 0;
+    for (;;)
+    {
+        if (!Available())
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+
+        const char c = *m_cursor++;
+        if (text)
+        {
+            text->push_back(c);
+        }
+
+        if (c == terminator[matched])
+        {
+            if (++matched == length)
+            {
+                if (text)
+                {
+                    text->resize(text->size() - length);
+                }
+                return true;
+            }
+        }
+        else if (matched > 0 && c == terminator[0])
+        {
+            //"--->" still ends a comment and "]]]>" a CDATA section
+            matched = terminator[1] == terminator[0] && matched >= 2 ? matched : 1;
+        }
+        else
+        {
+            matched = 0;
+        }
+    }
+}
+
+XmlReader::Markup XmlReader::ReadMarkup(Aws::String* text, bool keepElement)
+{
+    //the cursor is at '<'
+    ++m_cursor;
+    if (!Available())
+    {
+        SetError("Unexpected end of document");
+        return Markup::Error;
+    }
+
+    switch (*m_cursor)
+    {
+        case '/':
+            ++m_cursor;
+            return ReadEndTag() ? Markup::EndTag : Markup::Error;
+        case '?':
+            ++m_cursor;
+            return SkipPast("?>", nullptr) ? Markup::Other : Markup::Error;
+        case '!':
+            break;
+        default:
+            return ReadStartTag(keepElement ? m_elementName : m_scratch, keepElement) ? Markup::StartTag : Markup::Error;
+    }
+
+    ++m_cursor;
+    if (!Available())
+    {
+        SetError("Unexpected end of document");
+        return Markup::Error;
+    }
+
+    if (*m_cursor == '-')
+    {
+        ++m_cursor;
+        return Expect('-') && SkipPast("-->", nullptr) ? Markup::Other : Markup::Error;
+    }
+
+    if (*m_cursor == '[')
+    {
+        for (const char* c = "[CDATA["; *c; ++c)
+        {
+            if (!Expect(*c))
+            {
+                return Markup::Error;
+            }
+        }
+        return SkipPast("]]>", text) ? Markup::Other : Markup::Error;
+    }
+
+    //document type declaration, possibly with an internal subset
+    size_t subsetDepth = 0;
+    for (;;)
+    {
+        if (!Available())
+        {
+            SetError("Unexpected end of document");
+            return Markup::Error;
+        }
+
+        const char c = *m_cursor++;
+        if (c == '[')
+        {
+            ++subsetDepth;
+        }
+        else if (c == ']' && subsetDepth > 0)
+        {
+            --subsetDepth;
+        }
+        else if (c == '>' && subsetDepth == 0)
+        {
+            return Markup::Other;
+        }
+    }
+}
+
+void XmlReader::PushElement(const Aws::String& name)
+{
+    m_elementOffsets.push_back(m_elementPath.size());
+    m_elementPath.append(name);
+}
+
+bool XmlReader::NextChildElement()
+{
+    if (!WasParseSuccessful())
+    {
+        return false;
+    }
+
+    if (m_elementPending)
+    {
+        SkipElement();
+        if (!WasParseSuccessful())
+        {
+            return false;
+        }
+    }
+
+    if (m_enteredEmpty)
+    {
+        m_enteredEmpty = false;
+        m_elementPath.resize(m_elementOffsets.back());
+        m_elementOffsets.pop_back();
+        return false;
+    }
+
+    //a document has a single root element
+    const bool atDocument = m_elementOffsets.empty();
+    if (atDocument && m_rootRead)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        if (!ReadText(nullptr))
+        {
+            if (!atDocument)
+            {
+                SetError("Unexpected end of document");
+            }
+            return false;
+        }
+
+        switch (ReadMarkup(nullptr, true))
+        {
+            case Markup::StartTag:
+                m_elementPending = true;
+                m_rootRead = true;
+                return true;
+            case Markup::EndTag:
+            case Markup::Error:
+                return false;
+            case Markup::Other:
+                break;
+        }
+    }
+}
+
+Aws::String XmlReader::GetAttributeValue(const char* name) const
+{
+    for (size_t i = 0; i < m_attributeCount; ++i)
+    {
+        if (m_attributes[i].first == name)
+        {
+            return m_attributes[i].second;
+        }
+    }
+    return {};
+}
+
+bool XmlReader::EnterElement()
+{
+    if (!m_elementPending)
+    {
+        return false;
+    }
+
+    m_elementPending = false;
+    PushElement(m_elementName);
+    m_enteredEmpty = m_emptyElement;
+    return true;
+}
+
+bool XmlReader::ReadContent(Aws::String* text)
+{
+    m_elementPending = false;
+    if (m_emptyElement)
+    {
+        return true;
+    }
+
+    PushElement(m_elementName);
+    const size_t depth = m_elementOffsets.size();
+    for (;;)
+    {
+        //only the element's own text is kept, not that of the elements nested in it
+        Aws::String* ownText = m_elementOffsets.size() == depth ? text : nullptr;
+        if (!ReadText(ownText))
+        {
+            SetError("Unexpected end of document");
+            return false;
+        }
+
+        switch (ReadMarkup(ownText, false))
+        {
+            case Markup::StartTag:
+                if (!m_emptyElement)
+                {
+                    PushElement(m_scratch);
+                }
+                break;
+            case Markup::EndTag:
+                if (m_elementOffsets.size() < depth)
+                {
+                    return true;
+                }
+                break;
+            case Markup::Other:
+                break;
+            case Markup::Error:
+                return false;
+        }
+    }
+}
+
+Aws::String XmlReader::ReadElementText(bool trimWhitespace)
+{
+    Aws::String text;
+    if (!m_elementPending || !ReadContent(&text))
+    {
+        return {};
+    }
+
+    if (trimWhitespace)
+    {
+        size_t end = text.size();
+        while (end > 0 && IsXmlWhitespace(text[end - 1]))
+        {
+            --end;
+        }
+        size_t begin = 0;
+        while (begin < end && IsXmlWhitespace(text[begin]))
+        {
+            ++begin;
+        }
+        text.erase(end);
+        text.erase(0, begin);
+    }
+    return text;
+}
+
+void XmlReader::SkipElement()
+{
+    if (m_elementPending)
+    {
+        ReadContent(nullptr);
+    }
+}
@@ -30,6 +30,11 @@
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/core/utils/threading/Executor.h>
 
 #include <aws/kms/KMSClient.h>
 #include <aws/kms/model/GenerateDataKeyRequest.h>
@@ -170,7 +175,7 @@ namespace
     {
     public:
         MockS3Client(Aws::Client::ClientConfiguration clientConfiguration = Aws::Client::ClientConfiguration()) :
-            S3Client(Aws::Auth::AWSCredentials("", ""), clientConfiguration), m_putObjectCalled(0), m_getObjectCalled(0), m_body(nullptr)
+            S3Client(Aws::Auth::AWSCredentials("", ""), clientConfiguration), m_putObjectCalled(0), m_getObjectCalled(0), m_body(nullptr), m_uploadPartCalled(0), m_abortMultipartUploadCalled(0)
         {
         }
 
@@ -198,7 +203,10 @@ namespace
 
         Aws::S3::Model::GetObjectOutcome GetObject(const Aws::S3::Model::GetObjectRequest& request) const override
         {
-            m_getObjectCalled++;
+            {
+                std::lock_guard<std::mutex> locker(m_lock);
+                m_getObjectCalled++;
+            }
             auto factory = request.GetResponseStreamFactory();
             Aws::Utils::Stream::ResponseStream responseStream(factory);
 
@@ -234,6 +242,65 @@ namespace
             return result;
         }
 
+        /*
+        * The parts of a multipart upload are stored as they are uploaded, possibly concurrently, and become the body of the object once it completes.
+        */
+        Aws::S3::Model::CreateMultipartUploadOutcome CreateMultipartUpload(const Aws::S3::Model::CreateMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_uploadMetadata = request.GetMetadata();
+            m_parts.clear();
+            Aws::S3::Model::CreateMultipartUploadResult result;
+            result.SetUploadId("uploadId");
+            return result;
+        }
+
+        Aws::S3::Model::UploadPartOutcome UploadPart(const Aws::S3::Model::UploadPartRequest& request) const override
+        {
+            std::shared_ptr<Aws::IOStream> body = request.GetBody();
+            Aws::String partString((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
+
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_uploadPartCalled++;
+            m_parts[request.GetPartNumber()] = partString;
+            Aws::S3::Model::UploadPartResult result;
+            result.SetETag("etag" + Aws::Utils::StringUtils::to_string(request.GetPartNumber()));
+            return result;
+        }
+
+        Aws::S3::Model::CompleteMultipartUploadOutcome CompleteMultipartUpload(const Aws::S3::Model::CompleteMultipartUploadRequest& request) const override
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            bodyString.clear();
+            for (const auto& part : request.GetMultipartUpload().GetParts())
+            {
+                bodyString += m_parts[part.GetPartNumber()];
+            }
+            m_metadata = m_uploadMetadata;
+            m_requestContentLength = bodyString.size();
+            Aws::S3::Model::CompleteMultipartUploadResult result;
+            result.SetETag("etag");
+            return result;
+        }
+
+        Aws::S3::Model::AbortMultipartUploadOutcome AbortMultipartUpload(const Aws::S3::Model::AbortMultipartUploadRequest&) const override
+        {
+            std::lock_guard<std::mutex> locker(m_lock);
+            m_abortMultipartUploadCalled++;
+            return Aws::S3::Model::AbortMultipartUploadResult();
+        }
+
+        MultipartUploadFunctions GetMultipartUploadFunctions() const
+        {
+            MultipartUploadFunctions functions;
+            functions.putObject = [this](const PutObjectRequest& request) { return PutObject(request); };
+            functions.createMultipartUpload = [this](const CreateMultipartUploadRequest& request) { return CreateMultipartUpload(request); };
+            functions.uploadPart = [this](const UploadPartRequest& request) { return UploadPart(request); };
+            functions.completeMultipartUpload = [this](const CompleteMultipartUploadRequest& request) { return CompleteMultipartUpload(request); };
+            functions.abortMultipartUpload = [this](const AbortMultipartUploadRequest& request) { return AbortMultipartUpload(request); };
+            return functions;
+        }
+
         const Aws::Map<Aws::String, Aws::String>& GetMetadata() const
         {
             return m_metadata;
@@ -251,6 +318,11 @@ namespace
         mutable std::shared_ptr<Aws::IOStream> m_body;
         mutable std::shared_ptr<Aws::IOStream> m_instructionBody;
         mutable size_t m_requestContentLength;
+        mutable size_t m_uploadPartCalled;
+        mutable size_t m_abortMultipartUploadCalled;
+        mutable Aws::Map<Aws::String, Aws::String> m_uploadMetadata;
+        mutable Aws::Map<int, Aws::String> m_parts;
+        mutable std::mutex m_lock;
     };
 
     class CryptoModulesTest : public ::testing::Test
@@ -1319,6 +1391,127 @@ namespace
         ASSERT_FALSE(outcome.IsSuccess());
     }
 
+    TEST_F(CryptoModulesTest, AESGCMPartsMatchGCM)
+    {
+        auto key = Aws::Utils::Crypto::SymmetricCipher::GenerateKey();
+        Aws::Vector<Aws::Vector<size_t>> partLengthsList = { { 100 }, { 16, 84 }, { 48, 48, 4 }, { 96, 4 }, { 32, 64 }, { 0 } };
+        for (const auto& partLengths : partLengthsList)
+        {
+            size_t length = 0;
+            for (auto partLength : partLengths)
+            {
+                length += partLength;
+            }
+            Aws::Utils::CryptoBuffer plainText(length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                plainText[i] = static_cast<unsigned char>(i * 7);
+            }
+
+            auto gcmCipher = CreateAES_GCMImplementation(key);
+            Aws::Utils::CryptoBuffer cipherText = gcmCipher->EncryptBuffer(plainText);
+            Aws::Utils::CryptoBuffer finalBuffer = gcmCipher->FinalizeEncryption();
+            cipherText = Aws::Utils::CryptoBuffer({ (Aws::Utils::ByteBuffer*)&cipherText, (Aws::Utils::ByteBuffer*)&finalBuffer });
+            ASSERT_EQ(length, cipherText.GetLength());
+
+            AES_GCM_Parts parts(key, gcmCipher->GetIV());
+            ASSERT_TRUE(parts);
+            Aws::Vector<std::pair<uint64_t, Aws::Utils::CryptoBuffer>> partDigests;
+            size_t offset = 0;
+            for (auto partLength : partLengths)
+            {
+                Aws::Utils::CryptoBuffer part(plainText.GetUnderlyingData() + offset, partLength);
+                ASSERT_TRUE(parts.CreatePartCipher(offset)->EncryptInPlace(part.GetUnderlyingData(), part.GetLength()));
+                ASSERT_EQ(0, memcmp(cipherText.GetUnderlyingData() + offset, part.GetUnderlyingData(), partLength));
+
+                auto digest = parts.DigestPart(part.GetUnderlyingData(), part.GetLength());
+                ASSERT_EQ(16u, digest.GetLength());
+                partDigests.push_back(std::make_pair(static_cast<uint64_t>(partLength), digest));
+
+                ASSERT_TRUE(parts.CreatePartCipher(offset)->DecryptInPlace(part.GetUnderlyingData(), part.GetLength()));
+                ASSERT_EQ(0, memcmp(plainText.GetUnderlyingData() + offset, part.GetUnderlyingData(), partLength));
+                offset += partLength;
+            }
+            ASSERT_EQ(gcmCipher->GetTag(), parts.ComputeTag(partDigests));
+        }
+    }
+
+    TEST_F(CryptoModulesTest, AEPutAndGetObjectInParts)
+    {
+        SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
+        CryptoConfiguration cryptoConfig(StorageMethod::METADATA, CryptoMode::AUTHENTICATED_ENCRYPTION);
+        S3EncryptionPartsConfiguration partsConfig(Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 4));
+        partsConfig.partSize = 40;
+        partsConfig.maxPartsInFlight = 3;
+
+        MockS3Client s3Client;
+        CryptoModuleFactory factory;
+        auto module = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig);
+
+        Aws::String body;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            body += BODY_STREAM_TEST;
+        }
+        PutObjectRequest putRequest;
+        putRequest.SetBucket(BUCKET_TEST_NAME);
+        putRequest.SetKey(KEY_TEST_NAME);
+        std::shared_ptr<Aws::IOStream> objectStream = Aws::MakeShared<Aws::StringStream>(ALLOCATION_TAG);
+        *objectStream << body;
+        objectStream->flush();
+        putRequest.SetBody(objectStream);
+
+        auto putOutcome = module->PutObjectSecurelyInParts(putRequest, s3Client.GetMultipartUploadFunctions(), partsConfig);
+        ASSERT_TRUE(putOutcome.IsSuccess());
+        MetadataFilled(s3Client.GetMetadata());
+        // parts of 32 bytes, the part size rounded down to the block size, and the tag.
+        ASSERT_EQ((body.size() + 31) / 32, s3Client.m_uploadPartCalled);
+        ASSERT_EQ(body.size() + 16, s3Client.GetRequestContentLength());
+        ASSERT_EQ(0u, s3Client.m_abortMultipartUploadCalled);
+
+        HeadObjectRequest headObject;
+        headObject.WithBucket(BUCKET_TEST_NAME);
+        headObject.WithKey(KEY_TEST_NAME);
+        HeadObjectOutcome headOutcome = s3Client.HeadObject(headObject);
+        Aws::S3Encryption::Handlers::MetadataHandler handler;
+        ContentCryptoMaterial contentCryptoMaterial = handler.ReadContentCryptoMaterial(headOutcome.GetResult());
+        auto getObjectFunction = [&s3Client](const GetObjectRequest& getRequest) -> GetObjectOutcome { return s3Client.GetObject(getRequest); };
+
+        // the object is a GCM message like one put whole, so it is got whole and in parts alike.
+        GetObjectRequest getRequest;
+        getRequest.SetBucket(BUCKET_TEST_NAME);
+        getRequest.SetKey(KEY_TEST_NAME);
+        auto getOutcome = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig)->
+            GetObjectSecurely(getRequest, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction);
+        ASSERT_TRUE(getOutcome.IsSuccess());
+        Aws::OStringStream wholeStream;
+        wholeStream << getOutcome.GetResult().GetBody().rdbuf();
+        ASSERT_EQ(body, wholeStream.str());
+
+        auto getInPartsOutcome = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig)->
+            GetObjectSecurelyInParts(getRequest, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction, partsConfig);
+        ASSERT_TRUE(getInPartsOutcome.IsSuccess());
+        Aws::OStringStream partsStream;
+        partsStream << getInPartsOutcome.GetResult().GetBody().rdbuf();
+        ASSERT_EQ(body, partsStream.str());
+        ASSERT_EQ(static_cast<long long>(body.size()), getInPartsOutcome.GetResult().GetContentLength());
+
+        getRequest.SetRange("bytes=50-300");
+        auto rangeOutcome = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig)->
+            GetObjectSecurelyInParts(getRequest, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction, partsConfig);
+        ASSERT_TRUE(rangeOutcome.IsSuccess());
+        Aws::OStringStream rangeStream;
+        rangeStream << rangeOutcome.GetResult().GetBody().rdbuf();
+        ASSERT_EQ(body.substr(50, 251), rangeStream.str());
+
+        // a corrupted object fails to be verified.
+        s3Client.bodyString[100] ^= 1;
+        getRequest.SetRange("");
+        auto corruptedOutcome = factory.FetchCryptoModule(Aws::MakeShared<SimpleEncryptionMaterials>(ALLOCATION_TAG, materials), cryptoConfig)->
+            GetObjectSecurelyInParts(getRequest, headOutcome.GetResult(), contentCryptoMaterial, getObjectFunction, partsConfig);
+        ASSERT_FALSE(corruptedOutcome.IsSuccess());
+    }
+
     TEST_F(CryptoModulesTest, RangeParserSuccess)
     {
         SimpleEncryptionMaterials materials(Aws::Utils::Crypto::SymmetricCipher::GenerateKey());
@@ -554,6 +554,86 @@ namespace
         ASSERT_EQ(myClient->m_decryptCalledCount, 0u);
         ASSERT_EQ(myClient->m_genDataKeyCalledCount, 0u);
     }
+
+    //This tests that cached data keys encrypt up to their maximum number of uses, and that keys just generated or decrypted are not decrypted by KMS again.
+    TEST_F(KMSWithContextEncryptionMaterialsTest, TestDataKeyCacheEncryptDecryptCEK)
+    {
+        auto myClient = Aws::MakeShared<MockKMSClient>(AllocationTag, ClientConfiguration());
+        InitMockKMSClient(myClient);
+
+        KMSWithContextEncryptionMaterials encryptionMaterials(TEST_CMK_ID, myClient);
+        encryptionMaterials.SetDataKeyCache(Aws::MakeShared<KMSDataKeyCache>(AllocationTag, 10, std::chrono::minutes(1), 3));
+
+        Aws::Vector<ContentCryptoMaterial> contentCryptoMaterials;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+            ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+            ASSERT_EQ(myClient->m_decryptedKey, contentCryptoMaterial.GetContentEncryptionKey());
+            ASSERT_EQ(myClient->m_encryptedKey, contentCryptoMaterial.GetEncryptedContentEncryptionKey());
+            ASSERT_EQ(KeyWrapAlgorithm::KMS_CONTEXT, contentCryptoMaterial.GetKeyWrapAlgorithm());
+            contentCryptoMaterials.push_back(contentCryptoMaterial);
+        }
+        //the data key is used three times, then generated again
+        ASSERT_EQ(myClient->m_genDataKeyCalledCount, 2u);
+
+        ContentCryptoMaterial encryptedContentCryptoMaterial(ContentCryptoScheme::GCM);
+        encryptedContentCryptoMaterial.SetMaterialsDescription(contentCryptoMaterials[0].GetMaterialsDescription());
+        encryptedContentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+        encryptedContentCryptoMaterial.SetEncryptedContentEncryptionKey(contentCryptoMaterials[0].GetEncryptedContentEncryptionKey());
+        ASSERT_TRUE(encryptionMaterials.DecryptCEK(encryptedContentCryptoMaterial).IsSuccess());
+        ASSERT_EQ(myClient->m_decryptedKey, encryptedContentCryptoMaterial.GetContentEncryptionKey());
+        ASSERT_EQ(myClient->m_decryptCalledCount, 0u);
+
+        //a key encrypted with another context is decrypted by KMS, then cached
+        ContentCryptoMaterial otherContentCryptoMaterial(ContentCryptoScheme::GCM);
+        otherContentCryptoMaterial.SetMaterialsDescription(contentCryptoMaterials[0].GetMaterialsDescription());
+        otherContentCryptoMaterial.AddMaterialsDescription("purpose", "test");
+        otherContentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+        otherContentCryptoMaterial.SetEncryptedContentEncryptionKey(contentCryptoMaterials[0].GetEncryptedContentEncryptionKey());
+        ASSERT_TRUE(encryptionMaterials.DecryptCEK(otherContentCryptoMaterial).IsSuccess());
+        ASSERT_TRUE(encryptionMaterials.DecryptCEK(otherContentCryptoMaterial).IsSuccess());
+        ASSERT_EQ(myClient->m_decryptCalledCount, 1u);
+    }
+
+    //This tests that cached keys expire, and that the least recently used key is evicted from a full cache.
+    TEST_F(KMSWithContextEncryptionMaterialsTest, TestDataKeyCacheExpiryAndEviction)
+    {
+        auto myClient = Aws::MakeShared<MockKMSClient>(AllocationTag, ClientConfiguration());
+        InitMockKMSClient(myClient);
+
+        KMSWithContextEncryptionMaterials encryptionMaterials(TEST_CMK_ID, myClient);
+        encryptionMaterials.SetDataKeyCache(Aws::MakeShared<KMSDataKeyCache>(AllocationTag, 10, std::chrono::milliseconds(0), 3));
+        for (size_t i = 0; i < 3; ++i)
+        {
+            ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+            ASSERT_TRUE(encryptionMaterials.EncryptCEK(contentCryptoMaterial).IsSuccess());
+        }
+        ASSERT_EQ(myClient->m_genDataKeyCalledCount, 3u);
+
+        auto dataKeyCache = Aws::MakeShared<KMSDataKeyCache>(AllocationTag, 1, std::chrono::minutes(1), 3);
+        encryptionMaterials.SetDataKeyCache(dataKeyCache);
+        Aws::Vector<CryptoBuffer> encryptedKeys = { SymmetricCipher::GenerateKey(), SymmetricCipher::GenerateKey() };
+        for (size_t i = 0; i < 4; ++i)
+        {
+            ContentCryptoMaterial contentCryptoMaterial(ContentCryptoScheme::GCM);
+            contentCryptoMaterial.AddMaterialsDescription(kmsEncryptionContextKey, GCM_AAD);
+            contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+            contentCryptoMaterial.SetEncryptedContentEncryptionKey(encryptedKeys[i % 2]);
+            ASSERT_TRUE(encryptionMaterials.DecryptCEK(contentCryptoMaterial).IsSuccess());
+        }
+        //each key evicts the other
+        ASSERT_EQ(myClient->m_decryptCalledCount, 4u);
+
+        CryptoBuffer plainTextKey;
+        ASSERT_EQ(dataKeyCache, encryptionMaterials.GetDataKeyCache());
+        ASSERT_FALSE(dataKeyCache->GetDecryptedKey("key", plainTextKey));
+        dataKeyCache->PutDecryptedKey("key", myClient->m_decryptedKey);
+        ASSERT_TRUE(dataKeyCache->GetDecryptedKey("key", plainTextKey));
+        ASSERT_EQ(myClient->m_decryptedKey, plainTextKey);
+        dataKeyCache->Clear();
+        ASSERT_FALSE(dataKeyCache->GetDecryptedKey("key", plainTextKey));
+    }
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include <aws/s3/S3Client.h>
 #include <aws/s3-encryption/modules/CryptoModuleFactory.h>
 #include <aws/core/client/AWSError.h>
+#include <aws/core/utils/threading/Executor.h>
 
 namespace Aws
 {
@@ -42,6 +43,26 @@ namespace Aws
         typedef Aws::Utils::Outcome<Aws::S3::Model::PutObjectResult, Aws::Client::AWSError<S3EncryptionErrors>> S3EncryptionPutObjectOutcome;
         typedef Aws::Utils::Outcome<Aws::S3::Model::GetObjectResult, Aws::Client::AWSError<S3EncryptionErrors>> S3EncryptionGetObjectOutcome;
 
+        static const uint64_t DEFAULT_ENCRYPTED_PART_SIZE = 8 * 1024 * 1024;
+        static const size_t DEFAULT_ENCRYPTED_PARTS_IN_FLIGHT = 8;
+
+        /*
+        * How PutObjectInParts() and GetObjectInParts() split an object: in parts of partSize bytes, rounded down to a multiple of the AES block size,
+        * which are encrypted or decrypted and transferred on executor. At most maxPartsInFlight parts are held in memory at a time.
+        * S3 requires every part of an upload but the last to be at least 5MB.
+        */
+        struct AWS_S3ENCRYPTION_API S3EncryptionPartsConfiguration
+        {
+            S3EncryptionPartsConfiguration(const std::shared_ptr<Aws::Utils::Threading::Executor>& executor_) :
+                executor(executor_), partSize(DEFAULT_ENCRYPTED_PART_SIZE), maxPartsInFlight(DEFAULT_ENCRYPTED_PARTS_IN_FLIGHT)
+            {
+            }
+
+            std::shared_ptr<Aws::Utils::Threading::Executor> executor;
+            uint64_t partSize;
+            size_t maxPartsInFlight;
+        };
+
         class AWS_S3ENCRYPTION_API S3EncryptionClientBase
         {
         public:
@@ -84,9 +105,33 @@ namespace Aws
             */
             S3EncryptionGetObjectOutcome GetObject(const Aws::S3::Model::GetObjectRequest& request) const;
 
+            /*
+            * Function to put an object encrypted to S3 with a multipart upload, encrypting and uploading its parts concurrently, see S3EncryptionPartsConfiguration.
+            * The object is encrypted with AES GCM like PutObject() encrypts it in Authenticated Encryption and Strict Authenticated Encryption modes,
+            * so that GetObject() decrypts it. In Encryption Only mode, the object is put with PutObject().
+            * The context map is that of PutObject().
+            */
+            S3EncryptionPutObjectOutcome PutObjectInParts(const Aws::S3::Model::PutObjectRequest& request, const Aws::Map<Aws::String, Aws::String>& contextMap,
+                const S3EncryptionPartsConfiguration& partsConfig) const;
+
+            /*
+            * Function to get an object decrypted from S3 with concurrent range gets of its parts, see S3EncryptionPartsConfiguration.
+            * The parts are decrypted as they arrive and written to the response stream in order, and the tag of an object got whole is verified
+            * once all of it has been written. Objects encrypted with AES CBC are got with GetObject().
+            */
+            S3EncryptionGetObjectOutcome GetObjectInParts(const Aws::S3::Model::GetObjectRequest& request, const S3EncryptionPartsConfiguration& partsConfig) const;
+
             inline bool MultipartUploadSupported() const { return false; }
 
         protected:
+            typedef std::function<S3EncryptionGetObjectOutcome(Aws::S3Encryption::Modules::CryptoModule&, const Aws::S3::Model::HeadObjectResult&,
+                const Aws::Utils::Crypto::ContentCryptoMaterial&)> DecryptObjectFunction;
+
+            /*
+            * Function to read the content crypto material of an object, check that this client may decrypt it, and decrypt it with decryptObjectFunction.
+            */
+            S3EncryptionGetObjectOutcome DecryptObject(const Aws::S3::Model::GetObjectRequest& request, const DecryptObjectFunction& decryptObjectFunction) const;
+
             /*
             * Function to get the instruction file object of a encrypted object from S3. This instruction file object will be used to assist decryption.
             */
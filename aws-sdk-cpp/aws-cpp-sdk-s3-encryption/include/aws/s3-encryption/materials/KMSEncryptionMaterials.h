@@ -8,6 +8,10 @@
 #include <aws/core/client/ClientConfiguration.h>
 #include <aws/kms/KMSClient.h>
 #include <aws/s3-encryption/s3Encryption_EXPORTS.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSList.h>
+#include <chrono>
+#include <mutex>
 
 #if defined(_MSC_VER) && (_MSC_VER <= 1900 )
 #pragma warning (disable : 4996)
@@ -22,6 +26,80 @@ namespace Aws
             extern AWS_S3ENCRYPTION_API const char* cmkID_Identifier;
             extern AWS_S3ENCRYPTION_API const char* kmsEncryptionContextKey;
 
+            static const size_t DEFAULT_DATA_KEY_CACHE_MAX_ENTRIES = 1000;
+            static const size_t DEFAULT_DATA_KEY_CACHE_MAX_USES = 1000;
+            static const std::chrono::milliseconds::rep DEFAULT_DATA_KEY_CACHE_TIME_TO_LIVE_MS = 60 * 1000;
+
+            /*
+            * A cache of the keys KMS generates and decrypts, so that KMS Encryption Materials need not call KMS for every object.
+            * A data key generated by KMS encrypts up to maxUsesPerDataKey objects, each with its own IV, and a key KMS decrypted
+            * decrypts any object with the same encrypted key, encryption context and customer master key. Keys are cached for
+            * timeToLive at most, at most maxEntries of each kind, the least recently used being evicted first.
+            * Evicted keys are zeroed. The cache may be shared by several materials and used from several threads.
+            */
+            class AWS_S3ENCRYPTION_API KMSDataKeyCache
+            {
+            public:
+                KMSDataKeyCache(size_t maxEntries = DEFAULT_DATA_KEY_CACHE_MAX_ENTRIES,
+                    std::chrono::milliseconds timeToLive = std::chrono::milliseconds(DEFAULT_DATA_KEY_CACHE_TIME_TO_LIVE_MS),
+                    size_t maxUsesPerDataKey = DEFAULT_DATA_KEY_CACHE_MAX_USES);
+                ~KMSDataKeyCache();
+
+                /*
+                * Gets the data key generated for cacheKey, and counts it as used once. Returns false if there is none, or it has expired.
+                */
+                bool GetDataKey(const Aws::String& cacheKey, Aws::Utils::CryptoBuffer& plainTextKey, Aws::Utils::CryptoBuffer& encryptedKey);
+
+                /*
+                * Caches a data key generated for cacheKey, counting it as used once.
+                */
+                void PutDataKey(const Aws::String& cacheKey, const Aws::Utils::CryptoBuffer& plainTextKey, const Aws::Utils::CryptoBuffer& encryptedKey);
+
+                /*
+                * Gets the key decrypted for cacheKey. Returns false if there is none, or it has expired.
+                */
+                bool GetDecryptedKey(const Aws::String& cacheKey, Aws::Utils::CryptoBuffer& plainTextKey);
+
+                /*
+                * Caches a key decrypted for cacheKey.
+                */
+                void PutDecryptedKey(const Aws::String& cacheKey, const Aws::Utils::CryptoBuffer& plainTextKey);
+
+                /*
+                * Evicts every key.
+                */
+                void Clear();
+
+            private:
+                struct CachedKey
+                {
+                    Aws::Utils::CryptoBuffer plainTextKey;
+                    Aws::Utils::CryptoBuffer encryptedKey;
+                    std::chrono::steady_clock::time_point expiry;
+                    size_t uses;
+                    Aws::List<Aws::String>::iterator recentUse;
+                };
+
+                struct CachedKeys
+                {
+                    Aws::Map<Aws::String, CachedKey> keys;
+                    // the keys most recently used first.
+                    Aws::List<Aws::String> recentUses;
+                };
+
+                bool Get(CachedKeys& cachedKeys, const Aws::String& cacheKey, size_t maxUses, Aws::Utils::CryptoBuffer& plainTextKey, Aws::Utils::CryptoBuffer& encryptedKey);
+                void Put(CachedKeys& cachedKeys, const Aws::String& cacheKey, const Aws::Utils::CryptoBuffer& plainTextKey, const Aws::Utils::CryptoBuffer& encryptedKey);
+                void Evict(CachedKeys& cachedKeys, Aws::Map<Aws::String, CachedKey>::iterator cachedKey);
+                void EvictAll(CachedKeys& cachedKeys);
+
+                size_t m_maxEntries;
+                std::chrono::milliseconds m_timeToLive;
+                size_t m_maxUsesPerDataKey;
+                CachedKeys m_dataKeys;
+                CachedKeys m_decryptedKeys;
+                std::mutex m_cacheLock;
+            };
+
             /*
             * KMS Encryption Materials is responsible for handling the encryption/decryption of
             * content encryption keys using KMS. This class will use a user provided customer
@@ -62,12 +140,24 @@ namespace Aws
                 void SetKMSDecryptWithAnyCMK(bool allow) { m_allowDecryptWithAnyCMK = allow; }
                 bool IsKMSDecryptWithAnyCMKAllowed() const { return m_allowDecryptWithAnyCMK; }
 
+                /*
+                * Caches the keys KMS generates and decrypts in dataKeyCache, see KMSDataKeyCache. Keys are not cached by default, nor with a null cache.
+                */
+                void SetDataKeyCache(const std::shared_ptr<KMSDataKeyCache>& dataKeyCache) { m_dataKeyCache = dataKeyCache; }
+                const std::shared_ptr<KMSDataKeyCache>& GetDataKeyCache() const { return m_dataKeyCache; }
+
             protected:
                 virtual bool ValidateDecryptCEKMaterials(const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial) const;
 
+                /*
+                * The key under which a key is cached: the customer master key ID, the encryption context, and the encrypted key if any.
+                */
+                Aws::String BuildDataKeyCacheKey(const Aws::Map<Aws::String, Aws::String>& encryptionContext, const Aws::Utils::CryptoBuffer& encryptedKey) const;
+
                 Aws::String m_customerMasterKeyID;
                 std::shared_ptr<Aws::KMS::KMSClient> m_kmsClient;
                 bool m_allowDecryptWithAnyCMK;
+                std::shared_ptr<KMSDataKeyCache> m_dataKeyCache;
             };
             /**
              * @deprecated This class is in the maintenance mode, no new updates will be released, use KMSWithContextEncryptionMaterials.
@@ -20,6 +20,11 @@
 #include <aws/s3/model/GetObjectResult.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 
 namespace Aws
 {
@@ -29,6 +34,22 @@ namespace Aws
         {
             typedef std::function <Aws::S3::Model::PutObjectOutcome(const Aws::S3::Model::PutObjectRequest&)> PutObjectFunction;
             typedef std::function <Aws::S3::Model::GetObjectOutcome(const Aws::S3::Model::GetObjectRequest&)> GetObjectFunction;
+            typedef std::function <Aws::S3::Model::CreateMultipartUploadOutcome(const Aws::S3::Model::CreateMultipartUploadRequest&)> CreateMultipartUploadFunction;
+            typedef std::function <Aws::S3::Model::UploadPartOutcome(const Aws::S3::Model::UploadPartRequest&)> UploadPartFunction;
+            typedef std::function <Aws::S3::Model::CompleteMultipartUploadOutcome(const Aws::S3::Model::CompleteMultipartUploadRequest&)> CompleteMultipartUploadFunction;
+            typedef std::function <Aws::S3::Model::AbortMultipartUploadOutcome(const Aws::S3::Model::AbortMultipartUploadRequest&)> AbortMultipartUploadFunction;
+
+            /*
+             * The S3 operations of a multipart upload, putObject puts the instruction file if there is one.
+             */
+            struct AWS_S3ENCRYPTION_API MultipartUploadFunctions
+            {
+                PutObjectFunction putObject;
+                CreateMultipartUploadFunction createMultipartUpload;
+                UploadPartFunction uploadPart;
+                CompleteMultipartUploadFunction completeMultipartUpload;
+                AbortMultipartUploadFunction abortMultipartUpload;
+            };
 
             class AWS_S3ENCRYPTION_API CryptoModule
             {
@@ -55,12 +76,31 @@ namespace Aws
                 S3EncryptionGetObjectOutcome GetObjectSecurely(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
                     const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction);
 
+                /*
+                * Function to put an encrypted object to S3 with a multipart upload. The parts are encrypted and uploaded concurrently on the executor of partsConfig,
+                * and the tag is appended to the last part. Only modules encrypting with AES GCM support it.
+                */
+                S3EncryptionPutObjectOutcome PutObjectSecurelyInParts(const Aws::S3::Model::PutObjectRequest& request, const MultipartUploadFunctions& multipartUploadFunctions,
+                    const S3EncryptionPartsConfiguration& partsConfig, const Aws::Map<Aws::String, Aws::String>& contextMap = {});
+
+                /*
+                * Function to get an encrypted object from S3 with concurrent range gets on the executor of partsConfig, each part decrypted as it arrives and written
+                * to the response stream in order. Without a range the tag of the whole object is verified. Objects not encrypted with AES GCM are got with GetObjectSecurely().
+                */
+                S3EncryptionGetObjectOutcome GetObjectSecurelyInParts(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
+                    const Aws::Utils::Crypto::ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction, const S3EncryptionPartsConfiguration& partsConfig);
+
                 /*
                 * Function to parse range of a get object request and return a pair containing the lower and upper bounds.
                 */
                 static std::pair<int64_t, int64_t> ParseGetObjectRequestRange(const Aws::String& range, int64_t contentLength);
 
             private:
+                /*
+                * This function puts the content crypto material in the instruction file, or in the metadata of the given request.
+                */
+                S3EncryptionPutObjectOutcome PutContentCryptoMaterial(Aws::S3::Model::PutObjectRequest& request, const PutObjectFunction& putObjectFunction);
+
                 /*
                 * This function is used to encrypt the given S3 PutObjectRequest.
                 */
@@ -265,6 +305,11 @@ namespace Aws
                  */
                 Aws::Utils::CryptoBuffer EncryptBuffer(const Aws::Utils::CryptoBuffer& unEncryptedData) override;
 
+                /**
+                 * Calls straight through to internal cipher.
+                 */
+                size_t EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output) override;
+
                 /**
                  * Finalize Encryption, returns whatever is left in the cipher, computes the tag, and appends the tag to the output.
                  *  Calls FinalizeEncryption on the underlying cipher first.
@@ -290,6 +335,49 @@ namespace Aws
                 std::shared_ptr<Aws::Utils::Crypto::SymmetricCipher> m_cipher;
             };
 
+            /**
+             * Encrypts or decrypts the parts of an AES GCM message independently of each other, so that they can be processed concurrently, and computes
+             * the tag of the whole message from a digest of the cipher text of each part. A part is decrypted or encrypted with AES CTR from its position
+             * in the message, see http://csrc.nist.gov/publications/nistpubs/800-38D/SP-800-38D.pdf. Every part but the last must be a multiple of the
+             * block size long. The message has no additional authenticated data, as the crypto modules use none.
+             */
+            class AWS_S3ENCRYPTION_API AES_GCM_Parts
+            {
+            public:
+                /**
+                 * key and iv are those of the message, the iv must be 12 bytes long.
+                 */
+                AES_GCM_Parts(const Aws::Utils::CryptoBuffer& key, const Aws::Utils::CryptoBuffer& iv);
+
+                /**
+                 * Returns false if the key or iv were invalid.
+                 */
+                operator bool() const { return !m_failure; }
+
+                /**
+                 * Creates the cipher of the part beginning at offset in the message, a multiple of the block size.
+                 */
+                std::shared_ptr<Aws::Utils::Crypto::SymmetricCipher> CreatePartCipher(uint64_t offset) const;
+
+                /**
+                 * Computes the digest of the cipher text of a part, for ComputeTag(). Returns an empty buffer on failure.
+                 */
+                Aws::Utils::CryptoBuffer DigestPart(const unsigned char* cipherText, size_t length) const;
+
+                /**
+                 * Computes the tag of the message from the length and digest of each of its parts, in order.
+                 */
+                Aws::Utils::CryptoBuffer ComputeTag(const Aws::Vector<std::pair<uint64_t, Aws::Utils::CryptoBuffer>>& partDigests) const;
+
+            private:
+                Aws::Utils::CryptoBuffer m_key;
+                Aws::Utils::CryptoBuffer m_iv;
+                // the hash key of GHASH, and the encrypted first counter block which masks the tag.
+                Aws::Utils::CryptoBuffer m_hashKey;
+                Aws::Utils::CryptoBuffer m_tagMask;
+                bool m_failure;
+            };
+
         }
     }
 }
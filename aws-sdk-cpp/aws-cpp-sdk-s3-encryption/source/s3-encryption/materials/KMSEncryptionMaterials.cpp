@@ -9,6 +9,7 @@
 #include <aws/core/utils/Outcome.h>
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/logging/LogMacros.h>
+#include <aws/core/utils/StringUtils.h>
 
 using namespace Aws;
 using namespace Aws::Utils;
@@ -28,6 +29,119 @@ namespace Aws
             const char* cmkID_Identifier = "kms_cmk_id";
             const char* kmsEncryptionContextKey = "aws:x-amz-cek-alg";
 
+            KMSDataKeyCache::KMSDataKeyCache(size_t maxEntries, std::chrono::milliseconds timeToLive, size_t maxUsesPerDataKey) :
+                m_maxEntries(maxEntries), m_timeToLive(timeToLive), m_maxUsesPerDataKey(maxUsesPerDataKey)
+            {
+            }
+
+            KMSDataKeyCache::~KMSDataKeyCache()
+            {
+                Clear();
+            }
+
+            bool KMSDataKeyCache::GetDataKey(const Aws::String& cacheKey, CryptoBuffer& plainTextKey, CryptoBuffer& encryptedKey)
+            {
+                std::lock_guard<std::mutex> locker(m_cacheLock);
+                return Get(m_dataKeys, cacheKey, m_maxUsesPerDataKey, plainTextKey, encryptedKey);
+            }
+
+            void KMSDataKeyCache::PutDataKey(const Aws::String& cacheKey, const CryptoBuffer& plainTextKey, const CryptoBuffer& encryptedKey)
+            {
+                if (m_maxUsesPerDataKey <= 1)
+                {
+                    return;
+                }
+                std::lock_guard<std::mutex> locker(m_cacheLock);
+                Put(m_dataKeys, cacheKey, plainTextKey, encryptedKey);
+            }
+
+            bool KMSDataKeyCache::GetDecryptedKey(const Aws::String& cacheKey, CryptoBuffer& plainTextKey)
+            {
+                CryptoBuffer encryptedKey;
+                std::lock_guard<std::mutex> locker(m_cacheLock);
+                // a decrypted key may be used any number of times, it encrypts nothing new.
+                return Get(m_decryptedKeys, cacheKey, 0, plainTextKey, encryptedKey);
+            }
+
+            void KMSDataKeyCache::PutDecryptedKey(const Aws::String& cacheKey, const CryptoBuffer& plainTextKey)
+            {
+                std::lock_guard<std::mutex> locker(m_cacheLock);
+                Put(m_decryptedKeys, cacheKey, plainTextKey, CryptoBuffer());
+            }
+
+            void KMSDataKeyCache::Clear()
+            {
+                std::lock_guard<std::mutex> locker(m_cacheLock);
+                EvictAll(m_dataKeys);
+                EvictAll(m_decryptedKeys);
+            }
+
+            bool KMSDataKeyCache::Get(CachedKeys& cachedKeys, const Aws::String& cacheKey, size_t maxUses, CryptoBuffer& plainTextKey, CryptoBuffer& encryptedKey)
+            {
+                auto cachedKey = cachedKeys.keys.find(cacheKey);
+                if (cachedKey == cachedKeys.keys.end())
+                {
+                    return false;
+                }
+                if (std::chrono::steady_clock::now() >= cachedKey->second.expiry)
+                {
+                    Evict(cachedKeys, cachedKey);
+                    return false;
+                }
+
+                plainTextKey = cachedKey->second.plainTextKey;
+                encryptedKey = cachedKey->second.encryptedKey;
+                if (maxUses > 0 && ++cachedKey->second.uses >= maxUses)
+                {
+                    Evict(cachedKeys, cachedKey);
+                    return true;
+                }
+                cachedKeys.recentUses.splice(cachedKeys.recentUses.begin(), cachedKeys.recentUses, cachedKey->second.recentUse);
+                return true;
+            }
+
+            void KMSDataKeyCache::Put(CachedKeys& cachedKeys, const Aws::String& cacheKey, const CryptoBuffer& plainTextKey, const CryptoBuffer& encryptedKey)
+            {
+                if (m_maxEntries == 0)
+                {
+                    return;
+                }
+                auto cachedKey = cachedKeys.keys.find(cacheKey);
+                if (cachedKey != cachedKeys.keys.end())
+                {
+                    Evict(cachedKeys, cachedKey);
+                }
+                while (cachedKeys.keys.size() >= m_maxEntries)
+                {
+                    Evict(cachedKeys, cachedKeys.keys.find(cachedKeys.recentUses.back()));
+                }
+
+                cachedKeys.recentUses.push_front(cacheKey);
+                CachedKey& newKey = cachedKeys.keys[cacheKey];
+                newKey.plainTextKey = plainTextKey;
+                newKey.encryptedKey = encryptedKey;
+                newKey.expiry = std::chrono::steady_clock::now() + m_timeToLive;
+                newKey.uses = 1;
+                newKey.recentUse = cachedKeys.recentUses.begin();
+            }
+
+            void KMSDataKeyCache::Evict(CachedKeys& cachedKeys, Aws::Map<Aws::String, CachedKey>::iterator cachedKey)
+            {
+                cachedKey->second.plainTextKey.Zero();
+                cachedKeys.recentUses.erase(cachedKey->second.recentUse);
+                cachedKeys.keys.erase(cachedKey);
+            }
+
+            void KMSDataKeyCache::EvictAll(CachedKeys& cachedKeys)
+            {
+                for (auto& cachedKey : cachedKeys.keys)
+                {
+                    cachedKey.second.plainTextKey.Zero();
+                }
+                cachedKeys.keys.clear();
+                cachedKeys.recentUses.clear();
+            }
+
             KMSEncryptionMaterialsBase::KMSEncryptionMaterialsBase(const String& customerMasterKeyID, const ClientConfiguration& clientConfig) :
                 m_customerMasterKeyID(customerMasterKeyID), m_kmsClient(Aws::MakeShared<KMSClient>(ALLOCATION_TAG, clientConfig)), m_allowDecryptWithAnyCMK(true)
             {
@@ -68,6 +182,12 @@ namespace Aws
                 contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS);
                 contentCryptoMaterial.SetEncryptedContentEncryptionKey(result.GetCiphertextBlob());
                 contentCryptoMaterial.SetFinalCEK(result.GetCiphertextBlob());
+                if (m_dataKeyCache)
+                {
+                    // objects read back need not ask KMS for the key they were just encrypted with.
+                    m_dataKeyCache->PutDecryptedKey(BuildDataKeyCacheKey(contentCryptoMaterial.GetMaterialsDescription(), result.GetCiphertextBlob()),
+                        contentCryptoMaterial.GetContentEncryptionKey());
+                }
                 return CryptoOutcome(Aws::NoResult());
             }
 
@@ -94,6 +214,19 @@ namespace Aws
                     return errorOutcome;
                 }
 
+                Aws::String cacheKey;
+                if (m_dataKeyCache)
+                {
+                    cacheKey = BuildDataKeyCacheKey(contentCryptoMaterial.GetMaterialsDescription(), encryptedContentEncryptionKey);
+                    CryptoBuffer contentEncryptionKey;
+                    if (m_dataKeyCache->GetDecryptedKey(cacheKey, contentEncryptionKey))
+                    {
+                        AWS_LOGSTREAM_DEBUG(ALLOCATION_TAG, "Content encryption key found in the data key cache, not calling KMS.");
+                        contentCryptoMaterial.SetContentEncryptionKey(contentEncryptionKey);
+                        return CryptoOutcome(Aws::NoResult());
+                    }
+                }
+
                 DecryptRequest request;
 
                 if (!m_customerMasterKeyID.empty())
@@ -118,9 +251,34 @@ namespace Aws
                     AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Content Encryption Key could not be decrypted.");
                     return errorOutcome;
                 }
+                if (m_dataKeyCache)
+                {
+                    m_dataKeyCache->PutDecryptedKey(cacheKey, contentCryptoMaterial.GetContentEncryptionKey());
+                }
                 return CryptoOutcome(Aws::NoResult());
             }
 
+            // each field is prefixed with its length, so that no two different sets of fields make the same key.
+            static void AppendCacheKeyField(Aws::String& cacheKey, const char* field, size_t length)
+            {
+                cacheKey += StringUtils::to_string(length);
+                cacheKey += ':';
+                cacheKey.append(field, length);
+            }
+
+            Aws::String KMSEncryptionMaterialsBase::BuildDataKeyCacheKey(const Aws::Map<Aws::String, Aws::String>& encryptionContext, const CryptoBuffer& encryptedKey) const
+            {
+                Aws::String cacheKey;
+                AppendCacheKeyField(cacheKey, m_customerMasterKeyID.c_str(), m_customerMasterKeyID.size());
+                for (const auto& entry : encryptionContext)
+                {
+                    AppendCacheKeyField(cacheKey, entry.first.c_str(), entry.first.size());
+                    AppendCacheKeyField(cacheKey, entry.second.c_str(), entry.second.size());
+                }
+                AppendCacheKeyField(cacheKey, reinterpret_cast<const char*>(encryptedKey.GetUnderlyingData()), encryptedKey.GetLength());
+                return cacheKey;
+            }
+
             bool KMSEncryptionMaterialsBase::ValidateDecryptCEKMaterials(const ContentCryptoMaterial& contentCryptoMaterial) const
             {
                 switch(contentCryptoMaterial.GetKeyWrapAlgorithm())
@@ -159,6 +317,23 @@ namespace Aws
                 // Should be "AES/GCM/NoPadding" by default
                 Aws::String cekAlg = ContentCryptoSchemeMapper::GetNameForContentCryptoScheme(contentCryptoMaterial.GetContentCryptoScheme());
                 contentCryptoMaterial.AddMaterialsDescription(kmsEncryptionContextKey, cekAlg);
+                Aws::String cacheKey;
+                if (m_dataKeyCache)
+                {
+                    cacheKey = BuildDataKeyCacheKey(contentCryptoMaterial.GetMaterialsDescription(), CryptoBuffer());
+                    CryptoBuffer contentEncryptionKey;
+                    CryptoBuffer encryptedContentEncryptionKey;
+                    if (m_dataKeyCache->GetDataKey(cacheKey, contentEncryptionKey, encryptedContentEncryptionKey))
+                    {
+                        AWS_LOGSTREAM_DEBUG(ALLOCATION_TAG, "Data key found in the data key cache, not calling KMS.");
+                        contentCryptoMaterial.SetKeyWrapAlgorithm(KeyWrapAlgorithm::KMS_CONTEXT);
+                        contentCryptoMaterial.SetContentEncryptionKey(contentEncryptionKey);
+                        contentCryptoMaterial.SetEncryptedContentEncryptionKey(encryptedContentEncryptionKey);
+                        contentCryptoMaterial.SetFinalCEK(encryptedContentEncryptionKey);
+                        return CryptoOutcome(Aws::NoResult());
+                    }
+                }
+
                 request.SetEncryptionContext(contentCryptoMaterial.GetMaterialsDescription());
                 request.SetKeySpec(DataKeySpec::AES_256);
                 GenerateDataKeyOutcome outcome = m_kmsClient->GenerateDataKey(request);
@@ -175,6 +350,11 @@ namespace Aws
                 contentCryptoMaterial.SetContentEncryptionKey(result.GetPlaintext());
                 contentCryptoMaterial.SetEncryptedContentEncryptionKey(result.GetCiphertextBlob());
                 contentCryptoMaterial.SetFinalCEK(result.GetCiphertextBlob());
+                if (m_dataKeyCache)
+                {
+                    m_dataKeyCache->PutDataKey(cacheKey, result.GetPlaintext(), result.GetCiphertextBlob());
+                    m_dataKeyCache->PutDecryptedKey(BuildDataKeyCacheKey(contentCryptoMaterial.GetMaterialsDescription(), result.GetCiphertextBlob()), result.GetPlaintext());
+                }
                 return CryptoOutcome(Aws::NoResult());
             }
         }//namespace Materials
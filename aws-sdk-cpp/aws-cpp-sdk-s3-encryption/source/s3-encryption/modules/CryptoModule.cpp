@@ -10,6 +10,10 @@
 #include <aws/core/client/AWSError.h>
 #include <aws/s3/S3Errors.h>
 #include <aws/s3-encryption/S3EncryptionClient.h>
+#include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <condition_variable>
+#include <mutex>
 
 using namespace Aws::S3;
 using namespace Aws::S3::Model;
@@ -31,6 +35,10 @@ namespace Aws
             static const size_t TAG_SIZE_BYTES = 16u;
             static const size_t AES_BLOCK_SIZE = 16u;
             static const size_t BITS_IN_BYTE = 8u;
+            // large blocks let the cipher stream objects at the speed of the AES instructions, rather than of its per call overhead.
+            static const size_t CRYPTO_STREAM_BUFFER_SIZE = 64 * 1024;
+            // the counter of a GCM message is 32 bits long, and its first value is used for the tag.
+            static const uint64_t MAX_GCM_PLAIN_TEXT_LENGTH = ((1ull << 32) - 2) * AES_BLOCK_SIZE;
 
             CryptoModule::CryptoModule(const std::shared_ptr<EncryptionMaterials>& encryptionMaterials, const CryptoConfiguration & cryptoConfig) :
                 m_encryptionMaterials(encryptionMaterials), m_contentCryptoMaterial(ContentCryptoMaterial()), m_cryptoConfig(cryptoConfig), m_cipher(nullptr)
@@ -51,12 +59,22 @@ namespace Aws
 
                 InitEncryptionCipher();
 
+                auto contentCryptoMaterialOutcome = PutContentCryptoMaterial(copyRequest, putObjectFunction);
+                if (!contentCryptoMaterialOutcome.IsSuccess())
+                {
+                    return contentCryptoMaterialOutcome;
+                }
+                return WrapAndMakeRequestWithCipher(copyRequest, putObjectFunction);
+            }
+
+            S3EncryptionPutObjectOutcome CryptoModule::PutContentCryptoMaterial(Aws::S3::Model::PutObjectRequest& request, const PutObjectFunction& putObjectFunction)
+            {
                 if (m_cryptoConfig.GetStorageMethod() == StorageMethod::INSTRUCTION_FILE)
                 {
                     Handlers::InstructionFileHandler handler;
                     PutObjectRequest instructionFileRequest;
-                    instructionFileRequest.WithBucket(copyRequest.GetBucket());
-                    instructionFileRequest.WithKey(copyRequest.GetKey());
+                    instructionFileRequest.WithBucket(request.GetBucket());
+                    instructionFileRequest.WithKey(request.GetKey());
                     handler.PopulateRequest(instructionFileRequest, m_contentCryptoMaterial);
                     PutObjectOutcome instructionOutcome = putObjectFunction(instructionFileRequest);
                     if (!instructionOutcome.IsSuccess())
@@ -70,9 +88,349 @@ namespace Aws
                 else
                 {
                     Handlers::MetadataHandler handler;
-                    handler.PopulateRequest(copyRequest, m_contentCryptoMaterial);
+                    handler.PopulateRequest(request, m_contentCryptoMaterial);
+                }
+                return S3EncryptionPutObjectOutcome(PutObjectResult());
+            }
+
+            /*
+             * What the parts of an upload share with the thread that reads and dispatches them.
+             */
+            struct UploadPartsState
+            {
+                UploadPartsState(size_t partCount) : partsInFlight(0), digestsDone(0), digests(partCount), failed(false) {}
+
+                void Fail(const AWSError<S3EncryptionErrors>& partError)
+                {
+                    if (!failed)
+                    {
+                        failed = true;
+                        error = partError;
+                    }
+                }
+
+                std::mutex lock;
+                std::condition_variable signal;
+                size_t partsInFlight;
+                size_t digestsDone;
+                Aws::Vector<std::pair<uint64_t, CryptoBuffer>> digests;
+                Aws::Map<int, Aws::String> eTags;
+                bool failed;
+                AWSError<S3EncryptionErrors> error;
+            };
+
+            /*
+             * What the parts of a download share with the thread that dispatches them and writes them out.
+             */
+            struct DownloadPartsState
+            {
+                DownloadPartsState(size_t partCount) : partsInFlight(0), digests(partCount), failed(false) {}
+
+                void Fail(const AWSError<S3EncryptionErrors>& partError)
+                {
+                    if (!failed)
+                    {
+                        failed = true;
+                        error = partError;
+                    }
+                }
+
+                std::mutex lock;
+                std::condition_variable signal;
+                size_t partsInFlight;
+                Aws::Map<size_t, std::shared_ptr<CryptoBuffer>> decryptedParts;
+                Aws::Vector<std::pair<uint64_t, CryptoBuffer>> digests;
+                bool failed;
+                AWSError<S3EncryptionErrors> error;
+            };
+
+            static AWSError<S3EncryptionErrors> BuildPartsError(S3Errors errorType, const char* exceptionName, const char* message)
+            {
+                AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, message);
+                return BuildS3EncryptionError(AWSError<S3Errors>(errorType, exceptionName, message, false/*not retryable*/));
+            }
+
+            static void SubmitPart(Aws::Utils::Threading::Executor& executor, const std::function<void()>& part)
+            {
+                if (!executor.Submit(part))
+                {
+                    part();
+                }
+            }
+
+            static uint64_t GetPartSize(const S3EncryptionPartsConfiguration& partsConfig)
+            {
+                return (std::max)(static_cast<uint64_t>(AES_BLOCK_SIZE), partsConfig.partSize - partsConfig.partSize % AES_BLOCK_SIZE);
+            }
+
+            static CreateMultipartUploadRequest BuildCreateMultipartUploadRequest(const PutObjectRequest& request)
+            {
+                CreateMultipartUploadRequest createMultipartUploadRequest;
+                createMultipartUploadRequest.WithBucket(request.GetBucket()).WithKey(request.GetKey()).WithMetadata(request.GetMetadata());
+                createMultipartUploadRequest.SetContentType(request.GetContentType());
+                if (request.ACLHasBeenSet()) createMultipartUploadRequest.SetACL(request.GetACL());
+                if (request.CacheControlHasBeenSet()) createMultipartUploadRequest.SetCacheControl(request.GetCacheControl());
+                if (request.ContentDispositionHasBeenSet()) createMultipartUploadRequest.SetContentDisposition(request.GetContentDisposition());
+                if (request.ContentEncodingHasBeenSet()) createMultipartUploadRequest.SetContentEncoding(request.GetContentEncoding());
+                if (request.ContentLanguageHasBeenSet()) createMultipartUploadRequest.SetContentLanguage(request.GetContentLanguage());
+                if (request.ExpiresHasBeenSet()) createMultipartUploadRequest.SetExpires(request.GetExpires());
+                if (request.GrantFullControlHasBeenSet()) createMultipartUploadRequest.SetGrantFullControl(request.GetGrantFullControl());
+                if (request.GrantReadHasBeenSet()) createMultipartUploadRequest.SetGrantRead(request.GetGrantRead());
+                if (request.GrantReadACPHasBeenSet()) createMultipartUploadRequest.SetGrantReadACP(request.GetGrantReadACP());
+                if (request.GrantWriteACPHasBeenSet()) createMultipartUploadRequest.SetGrantWriteACP(request.GetGrantWriteACP());
+                if (request.ServerSideEncryptionHasBeenSet()) createMultipartUploadRequest.SetServerSideEncryption(request.GetServerSideEncryption());
+                if (request.StorageClassHasBeenSet()) createMultipartUploadRequest.SetStorageClass(request.GetStorageClass());
+                if (request.WebsiteRedirectLocationHasBeenSet()) createMultipartUploadRequest.SetWebsiteRedirectLocation(request.GetWebsiteRedirectLocation());
+                if (request.SSECustomerAlgorithmHasBeenSet()) createMultipartUploadRequest.SetSSECustomerAlgorithm(request.GetSSECustomerAlgorithm());
+                if (request.SSECustomerKeyHasBeenSet()) createMultipartUploadRequest.SetSSECustomerKey(request.GetSSECustomerKey());
+                if (request.SSECustomerKeyMD5HasBeenSet()) createMultipartUploadRequest.SetSSECustomerKeyMD5(request.GetSSECustomerKeyMD5());
+                if (request.SSEKMSKeyIdHasBeenSet()) createMultipartUploadRequest.SetSSEKMSKeyId(request.GetSSEKMSKeyId());
+                if (request.SSEKMSEncryptionContextHasBeenSet()) createMultipartUploadRequest.SetSSEKMSEncryptionContext(request.GetSSEKMSEncryptionContext());
+                if (request.RequestPayerHasBeenSet()) createMultipartUploadRequest.SetRequestPayer(request.GetRequestPayer());
+                if (request.TaggingHasBeenSet()) createMultipartUploadRequest.SetTagging(request.GetTagging());
+                if (request.ObjectLockModeHasBeenSet()) createMultipartUploadRequest.SetObjectLockMode(request.GetObjectLockMode());
+                if (request.ObjectLockRetainUntilDateHasBeenSet()) createMultipartUploadRequest.SetObjectLockRetainUntilDate(request.GetObjectLockRetainUntilDate());
+                if (request.ObjectLockLegalHoldStatusHasBeenSet()) createMultipartUploadRequest.SetObjectLockLegalHoldStatus(request.GetObjectLockLegalHoldStatus());
+                if (request.ExpectedBucketOwnerHasBeenSet()) createMultipartUploadRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                if (request.CustomizedAccessLogTagHasBeenSet()) createMultipartUploadRequest.SetCustomizedAccessLogTag(request.GetCustomizedAccessLogTag());
+                return createMultipartUploadRequest;
+            }
+
+            static UploadPartRequest BuildUploadPartRequest(const PutObjectRequest& request, const Aws::String& uploadId, int partNumber)
+            {
+                UploadPartRequest uploadPartRequest;
+                uploadPartRequest.WithBucket(request.GetBucket()).WithKey(request.GetKey()).WithUploadId(uploadId).WithPartNumber(partNumber);
+                if (request.SSECustomerAlgorithmHasBeenSet()) uploadPartRequest.SetSSECustomerAlgorithm(request.GetSSECustomerAlgorithm());
+                if (request.SSECustomerKeyHasBeenSet()) uploadPartRequest.SetSSECustomerKey(request.GetSSECustomerKey());
+                if (request.SSECustomerKeyMD5HasBeenSet()) uploadPartRequest.SetSSECustomerKeyMD5(request.GetSSECustomerKeyMD5());
+                if (request.RequestPayerHasBeenSet()) uploadPartRequest.SetRequestPayer(request.GetRequestPayer());
+                if (request.ExpectedBucketOwnerHasBeenSet()) uploadPartRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                if (request.CustomizedAccessLogTagHasBeenSet()) uploadPartRequest.SetCustomizedAccessLogTag(request.GetCustomizedAccessLogTag());
+                return uploadPartRequest;
+            }
+
+            static void AbortUpload(const MultipartUploadFunctions& multipartUploadFunctions, const PutObjectRequest& request, const Aws::String& uploadId)
+            {
+                AbortMultipartUploadRequest abortMultipartUploadRequest;
+                abortMultipartUploadRequest.WithBucket(request.GetBucket()).WithKey(request.GetKey()).WithUploadId(uploadId);
+                if (request.RequestPayerHasBeenSet()) abortMultipartUploadRequest.SetRequestPayer(request.GetRequestPayer());
+                if (request.ExpectedBucketOwnerHasBeenSet()) abortMultipartUploadRequest.SetExpectedBucketOwner(request.GetExpectedBucketOwner());
+                auto abortOutcome = multipartUploadFunctions.abortMultipartUpload(abortMultipartUploadRequest);
+                if (!abortOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Abort multipart upload operation not successful, upload ID [" << uploadId << "] is left behind: "
+                        << abortOutcome.GetError().GetExceptionName() << " : "
+                        << abortOutcome.GetError().GetMessage());
                 }
-                return WrapAndMakeRequestWithCipher(copyRequest, putObjectFunction);
+            }
+
+            S3EncryptionPutObjectOutcome CryptoModule::PutObjectSecurelyInParts(const Aws::S3::Model::PutObjectRequest& request, const MultipartUploadFunctions& multipartUploadFunctions,
+                const S3EncryptionPartsConfiguration& partsConfig, const Aws::Map<Aws::String, Aws::String>& contextMap)
+            {
+                PutObjectRequest copyRequest(request);
+                PopulateCryptoContentMaterial();
+                if (m_contentCryptoMaterial.GetContentCryptoScheme() != ContentCryptoScheme::GCM || !partsConfig.executor)
+                {
+                    return S3EncryptionPutObjectOutcome(BuildPartsError(S3Errors::INVALID_ACTION, "EncryptInPartsFailed",
+                        "S3 Encryption Client can only encrypt an object in parts with AES GCM, and with an executor to run the parts on."));
+                }
+                m_contentCryptoMaterial.SetMaterialsDescription(contextMap);
+
+                std::shared_ptr<Aws::IOStream> body = copyRequest.GetBody();
+                body->seekg(0, std::ios_base::end);
+                uint64_t plainTextLength = static_cast<uint64_t>(body->tellg());
+                body->seekg(0, std::ios_base::beg);
+                if (plainTextLength > MAX_GCM_PLAIN_TEXT_LENGTH)
+                {
+                    return S3EncryptionPutObjectOutcome(BuildPartsError(S3Errors::INVALID_PARAMETER_VALUE, "EncryptInPartsFailed",
+                        "S3 Encryption Client can not encrypt an object larger than AES GCM allows."));
+                }
+
+                auto encryptOutcome = m_encryptionMaterials->EncryptCEK(m_contentCryptoMaterial);
+                if (!encryptOutcome.IsSuccess())
+                {
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(encryptOutcome.GetError()));
+                }
+
+                InitEncryptionCipher();
+                AES_GCM_Parts parts(m_contentCryptoMaterial.GetContentEncryptionKey(), m_contentCryptoMaterial.GetIV());
+                if (!parts)
+                {
+                    return S3EncryptionPutObjectOutcome(BuildPartsError(S3Errors::VALIDATION, "FailedToEncryptContent",
+                        "S3 Encryption Client failed to initialize the cipher of the parts."));
+                }
+
+                auto contentCryptoMaterialOutcome = PutContentCryptoMaterial(copyRequest, multipartUploadFunctions.putObject);
+                if (!contentCryptoMaterialOutcome.IsSuccess())
+                {
+                    return contentCryptoMaterialOutcome;
+                }
+
+                auto createOutcome = multipartUploadFunctions.createMultipartUpload(BuildCreateMultipartUploadRequest(copyRequest));
+                if (!createOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Create multipart upload operation not successful: "
+                        << createOutcome.GetError().GetExceptionName() << " : "
+                        << createOutcome.GetError().GetMessage());
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(createOutcome.GetError()));
+                }
+                const Aws::String& uploadId = createOutcome.GetResult().GetUploadId();
+
+                uint64_t partSize = GetPartSize(partsConfig);
+                size_t maxPartsInFlight = (std::max)(static_cast<size_t>(1), partsConfig.maxPartsInFlight);
+                size_t partCount = static_cast<size_t>((std::max)(static_cast<uint64_t>(1), (plainTextLength + partSize - 1) / partSize));
+                auto state = Aws::MakeShared<UploadPartsState>(ALLOCATION_TAG, partCount);
+
+                for (size_t partIndex = 0; partIndex < partCount; ++partIndex)
+                {
+                    {
+                        std::unique_lock<std::mutex> locker(state->lock);
+                        state->signal.wait(locker, [&] { return state->failed || state->partsInFlight < maxPartsInFlight; });
+                        if (state->failed)
+                        {
+                            break;
+                        }
+                    }
+
+                    // parts are read in order on this thread, as the body is a single stream, then encrypted in place.
+                    uint64_t offset = partIndex * partSize;
+                    size_t length = static_cast<size_t>((std::min)(partSize, plainTextLength - offset));
+                    bool isLastPart = partIndex + 1 == partCount;
+                    auto partData = Aws::MakeShared<CryptoBuffer>(ALLOCATION_TAG, length + (isLastPart ? TAG_SIZE_BYTES : 0));
+                    body->read(reinterpret_cast<char*>(partData->GetUnderlyingData()), length);
+                    if (static_cast<size_t>(body->gcount()) != length)
+                    {
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        state->Fail(BuildPartsError(S3Errors::VALIDATION, "FailedToEncryptContent", "S3 Encryption Client failed to read the body of the object."));
+                        break;
+                    }
+
+                    auto encryptPart = [&parts, state, partData, length, offset, partIndex]()
+                    {
+                        CryptoBuffer digest;
+                        if (parts.CreatePartCipher(offset)->EncryptInPlace(partData->GetUnderlyingData(), length))
+                        {
+                            digest = parts.DigestPart(partData->GetUnderlyingData(), length);
+                        }
+
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        if (digest.GetLength() == 0)
+                        {
+                            state->Fail(BuildPartsError(S3Errors::VALIDATION, "FailedToEncryptContent", "S3 Encryption Client failed to encrypt a part of the object."));
+                            return false;
+                        }
+                        state->digests[partIndex] = std::make_pair(static_cast<uint64_t>(length), digest);
+                        state->digestsDone++;
+                        state->signal.notify_all();
+                        return true;
+                    };
+
+                    int partNumber = static_cast<int>(partIndex + 1);
+                    auto uploadPartRequest = BuildUploadPartRequest(copyRequest, uploadId, partNumber);
+                    auto uploadPart = [&multipartUploadFunctions, state, partData, partNumber, uploadPartRequest]() mutable
+                    {
+                        uploadPartRequest.SetContentLength(static_cast<long long>(partData->GetLength()));
+                        uploadPartRequest.SetBody(Aws::MakeShared<Aws::Utils::Stream::DefaultUnderlyingStream>(ALLOCATION_TAG,
+                            Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(ALLOCATION_TAG, partData->GetUnderlyingData(), partData->GetLength())));
+                        auto uploadPartOutcome = multipartUploadFunctions.uploadPart(uploadPartRequest);
+
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        if (uploadPartOutcome.IsSuccess())
+                        {
+                            state->eTags[partNumber] = uploadPartOutcome.GetResult().GetETag();
+                        }
+                        else
+                        {
+                            AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Upload part operation not successful for part " << partNumber << ": "
+                                << uploadPartOutcome.GetError().GetExceptionName() << " : "
+                                << uploadPartOutcome.GetError().GetMessage());
+                            state->Fail(BuildS3EncryptionError(uploadPartOutcome.GetError()));
+                        }
+                    };
+
+                    auto partDone = [state]()
+                    {
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        state->partsInFlight--;
+                        state->signal.notify_all();
+                    };
+
+                    {
+                        std::lock_guard<std::mutex> locker(state->lock);
+                        state->partsInFlight++;
+                    }
+
+                    if (!isLastPart)
+                    {
+                        SubmitPart(*partsConfig.executor, [encryptPart, uploadPart, partDone]() mutable
+                            {
+                                if (encryptPart())
+                                {
+                                    uploadPart();
+                                }
+                                partDone();
+                            });
+                        continue;
+                    }
+
+                    // the tag is appended to the last part, once every part has been encrypted.
+                    if (encryptPart())
+                    {
+                        {
+                            std::unique_lock<std::mutex> locker(state->lock);
+                            state->signal.wait(locker, [&] { return state->failed || state->digestsDone == partCount; });
+                        }
+                        if (!state->failed)
+                        {
+                            CryptoBuffer tag = parts.ComputeTag(state->digests);
+                            memcpy(partData->GetUnderlyingData() + length, tag.GetUnderlyingData(), TAG_SIZE_BYTES);
+                            uploadPart();
+                        }
+                    }
+                    partDone();
+                }
+
+                {
+                    std::unique_lock<std::mutex> locker(state->lock);
+                    state->signal.wait(locker, [&] { return state->partsInFlight == 0; });
+                }
+
+                if (state->failed)
+                {
+                    AbortUpload(multipartUploadFunctions, copyRequest, uploadId);
+                    return S3EncryptionPutObjectOutcome(state->error);
+                }
+
+                CompletedMultipartUpload completedUpload;
+                for (const auto& eTag : state->eTags)
+                {
+                    completedUpload.AddParts(CompletedPart().WithPartNumber(eTag.first).WithETag(eTag.second));
+                }
+                CompleteMultipartUploadRequest completeMultipartUploadRequest;
+                completeMultipartUploadRequest.WithBucket(copyRequest.GetBucket()).WithKey(copyRequest.GetKey()).WithUploadId(uploadId).WithMultipartUpload(completedUpload);
+                if (copyRequest.RequestPayerHasBeenSet()) completeMultipartUploadRequest.SetRequestPayer(copyRequest.GetRequestPayer());
+                if (copyRequest.ExpectedBucketOwnerHasBeenSet()) completeMultipartUploadRequest.SetExpectedBucketOwner(copyRequest.GetExpectedBucketOwner());
+                if (copyRequest.CustomizedAccessLogTagHasBeenSet()) completeMultipartUploadRequest.SetCustomizedAccessLogTag(copyRequest.GetCustomizedAccessLogTag());
+
+                auto completeOutcome = multipartUploadFunctions.completeMultipartUpload(completeMultipartUploadRequest);
+                if (!completeOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "Complete multipart upload operation not successful: "
+                        << completeOutcome.GetError().GetExceptionName() << " : "
+                        << completeOutcome.GetError().GetMessage());
+                    AbortUpload(multipartUploadFunctions, copyRequest, uploadId);
+                    return S3EncryptionPutObjectOutcome(BuildS3EncryptionError(completeOutcome.GetError()));
+                }
+
+                const auto& completeResult = completeOutcome.GetResult();
+                PutObjectResult result;
+                result.SetETag(completeResult.GetETag());
+                result.SetExpiration(completeResult.GetExpiration());
+                result.SetServerSideEncryption(completeResult.GetServerSideEncryption());
+                result.SetVersionId(completeResult.GetVersionId());
+                result.SetSSEKMSKeyId(completeResult.GetSSEKMSKeyId());
+                result.SetRequestCharged(completeResult.GetRequestCharged());
+                return S3EncryptionPutObjectOutcome(std::move(result));
             }
 
             S3EncryptionGetObjectOutcome CryptoModule::GetObjectSecurely(const Aws::S3::Model::GetObjectRequest& request,
@@ -122,10 +480,194 @@ namespace Aws
                 return UnwrapAndMakeRequestWithCipher(copyRequest, getObjectFunction, firstBlockAdjustment);
             }
 
+            static bool TagsMatch(const CryptoBuffer& computedTag, const CryptoBuffer& tag)
+            {
+                if (computedTag.GetLength() != TAG_SIZE_BYTES || tag.GetLength() != TAG_SIZE_BYTES)
+                {
+                    return false;
+                }
+                // compares every byte whatever the first difference, so that the time taken tells nothing about the tag.
+                unsigned char difference = 0;
+                for (size_t i = 0; i < TAG_SIZE_BYTES; ++i)
+                {
+                    difference |= computedTag[i] ^ tag[i];
+                }
+                return difference == 0;
+            }
+
+            S3EncryptionGetObjectOutcome CryptoModule::GetObjectSecurelyInParts(const Aws::S3::Model::GetObjectRequest& request, const Aws::S3::Model::HeadObjectResult& headObjectResult,
+                const ContentCryptoMaterial& contentCryptoMaterial, const GetObjectFunction& getObjectFunction, const S3EncryptionPartsConfiguration& partsConfig)
+            {
+                if (contentCryptoMaterial.GetContentCryptoScheme() != ContentCryptoScheme::GCM || !partsConfig.executor)
+                {
+                    return GetObjectSecurely(request, headObjectResult, contentCryptoMaterial, getObjectFunction);
+                }
+
+                GetObjectRequest copyRequest(request);
+                m_contentCryptoMaterial = contentCryptoMaterial;
+                if (!DecryptionConditionCheck(copyRequest.GetRange()))
+                {
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "DecryptionConditionCheckFailed",
+                            "S3 Encryption Client failed to validate the decryption condition", false/*not retryable*/)));
+                }
+                auto decryptOutcome = m_encryptionMaterials->DecryptCEK(m_contentCryptoMaterial);
+                if (!decryptOutcome.IsSuccess())
+                {
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(decryptOutcome.GetError()));
+                }
+
+                bool verifyTag = request.GetRange().empty();
+                CryptoBuffer tagFromBody = GetTag(copyRequest, getObjectFunction);
+                int64_t rangeStart = 0;
+                if (!verifyTag)
+                {
+                    rangeStart = ParseGetObjectRequestRange(request.GetRange(), headObjectResult.GetContentLength()).first;
+                }
+
+                auto newRange = AdjustRange(copyRequest, headObjectResult);
+                if (newRange.first > newRange.second)
+                {
+                    Aws::StringStream ss;
+                    ss << "S3 Encryption Client received invalid range get: rangeStart:" << newRange.first << " > rangeEnd:" << newRange.second << " after adjustment.";
+                    return S3EncryptionGetObjectOutcome(BuildS3EncryptionError(AWSError<S3Errors>(S3Errors::VALIDATION, "InvalidRangeGet",
+                            ss.str(), false/*not retryable*/)));
+                }
+
+                AES_GCM_Parts parts(m_contentCryptoMaterial.GetContentEncryptionKey(), m_contentCryptoMaterial.GetIV());
+                if (!parts || (verifyTag && tagFromBody.GetLength() != TAG_SIZE_BYTES))
+                {
+                    return S3EncryptionGetObjectOutcome(BuildPartsError(S3Errors::VALIDATION, "FailedToDecryptContent",
+                        "S3 Encryption Client failed to decrypt the encrypted object"));
+                }
+
+                // the first part begins at the block holding the first byte of the range, of which the bytes before the range are skipped.
+                uint64_t firstByte = static_cast<uint64_t>(newRange.first);
+                uint64_t cipherTextLength = static_cast<uint64_t>(newRange.second - newRange.first + 1);
+                size_t firstBlockOffset = rangeStart > 0 ? static_cast<size_t>(rangeStart - newRange.first) : 0;
+                uint64_t partSize = GetPartSize(partsConfig);
+                size_t maxPartsInFlight = (std::max)(static_cast<size_t>(1), partsConfig.maxPartsInFlight);
+                size_t partCount = static_cast<size_t>((cipherTextLength + partSize - 1) / partSize);
+                auto state = Aws::MakeShared<DownloadPartsState>(ALLOCATION_TAG, partCount);
+
+                Aws::Utils::Stream::ResponseStream responseStream(request.GetResponseStreamFactory());
+                Aws::IOStream& userStream = responseStream.GetUnderlyingStream();
+                uint64_t bytesWritten = 0;
+                size_t nextPart = 0;
+
+                for (size_t partIndex = 0; partIndex < partCount; ++partIndex)
+                {
+                    // parts are got ahead of the one written next, at most maxPartsInFlight of them held in memory.
+                    for (; nextPart < partCount && nextPart < partIndex + maxPartsInFlight; ++nextPart)
+                    {
+                        uint64_t offset = firstByte + nextPart * partSize;
+                        size_t length = static_cast<size_t>((std::min)(partSize, firstByte + cipherTextLength - offset));
+                        auto partData = Aws::MakeShared<CryptoBuffer>(ALLOCATION_TAG, length);
+
+                        GetObjectRequest partRequest(copyRequest);
+                        partRequest.SetRange("bytes=" + StringUtils::to_string(offset) + "-" + StringUtils::to_string(offset + length - 1));
+                        partRequest.SetResponseStreamFactory([partData]()
+                            {
+                                return Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(ALLOCATION_TAG,
+                                    Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(ALLOCATION_TAG, partData->GetUnderlyingData(), partData->GetLength()));
+                            });
+
+                        {
+                            std::lock_guard<std::mutex> locker(state->lock);
+                            state->partsInFlight++;
+                        }
+
+                        size_t partNumber = nextPart;
+                        SubmitPart(*partsConfig.executor, [&parts, &getObjectFunction, state, partRequest, partData, offset, length, partNumber, verifyTag]()
+                            {
+                                GetObjectOutcome outcome = getObjectFunction(partRequest);
+                                CryptoBuffer digest;
+                                bool decrypted = false;
+                                // the body is written straight to the part, which it must fill.
+                                if (outcome.IsSuccess() && outcome.GetResult().GetBody().tellp() == static_cast<std::streampos>(length))
+                                {
+                                    if (verifyTag)
+                                    {
+                                        digest = parts.DigestPart(partData->GetUnderlyingData(), length);
+                                    }
+                                    decrypted = (!verifyTag || digest.GetLength() > 0) &&
+                                        parts.CreatePartCipher(offset)->DecryptInPlace(partData->GetUnderlyingData(), length);
+                                }
+
+                                std::lock_guard<std::mutex> locker(state->lock);
+                                if (!outcome.IsSuccess())
+                                {
+                                    AWS_LOGSTREAM_ERROR(ALLOCATION_TAG, "S3 get operation not successful for a part: "
+                                        << outcome.GetError().GetExceptionName() << " : "
+                                        << outcome.GetError().GetMessage());
+                                    state->Fail(BuildS3EncryptionError(outcome.GetError()));
+                                }
+                                else if (!decrypted)
+                                {
+                                    state->Fail(BuildPartsError(S3Errors::VALIDATION, "FailedToDecryptContent",
+                                        "S3 Encryption Client failed to decrypt the encrypted object"));
+                                }
+                                else
+                                {
+                                    state->decryptedParts[partNumber] = partData;
+                                    state->digests[partNumber] = std::make_pair(static_cast<uint64_t>(length), digest);
+                                }
+                                state->partsInFlight--;
+                                state->signal.notify_all();
+                            });
+                    }
+
+                    std::shared_ptr<CryptoBuffer> partData;
+                    {
+                        std::unique_lock<std::mutex> locker(state->lock);
+                        state->signal.wait(locker, [&] { return state->failed || state->decryptedParts.find(partIndex) != state->decryptedParts.end(); });
+                        if (state->failed)
+                        {
+                            break;
+                        }
+                        auto decryptedPart = state->decryptedParts.find(partIndex);
+                        partData = decryptedPart->second;
+                        state->decryptedParts.erase(decryptedPart);
+                    }
+
+                    size_t skip = partIndex == 0 ? firstBlockOffset : 0;
+                    userStream.write(reinterpret_cast<const char*>(partData->GetUnderlyingData() + skip), partData->GetLength() - skip);
+                    bytesWritten += partData->GetLength() - skip;
+                }
+
+                {
+                    std::unique_lock<std::mutex> locker(state->lock);
+                    state->signal.wait(locker, [&] { return state->partsInFlight == 0; });
+                }
+
+                if (state->failed)
+                {
+                    return S3EncryptionGetObjectOutcome(state->error);
+                }
+                if (verifyTag && !TagsMatch(parts.ComputeTag(state->digests), tagFromBody))
+                {
+                    return S3EncryptionGetObjectOutcome(BuildPartsError(S3Errors::VALIDATION, "FailedToDecryptContent",
+                        "S3 Encryption Client failed to decrypt the encrypted object"));
+                }
+
+                userStream.flush();
+                userStream.clear();
+                userStream.seekg(0, std::ios_base::beg);
+
+                Aws::AmazonWebServiceResult<Aws::Utils::Stream::ResponseStream> streamResult(std::move(responseStream), Aws::Http::HeaderValueCollection());
+                GetObjectResult result(std::move(streamResult));
+                result.SetContentLength(static_cast<long long>(bytesWritten));
+                result.SetContentType(headObjectResult.GetContentType());
+                result.SetETag(headObjectResult.GetETag());
+                result.SetLastModified(headObjectResult.GetLastModified());
+                result.SetMetadata(headObjectResult.GetMetadata());
+                result.SetVersionId(headObjectResult.GetVersionId());
+                return S3EncryptionGetObjectOutcome(std::move(result));
+            }
+
             S3EncryptionPutObjectOutcome CryptoModule::WrapAndMakeRequestWithCipher(Aws::S3::Model::PutObjectRequest & request, const PutObjectFunction& putObjectFunction)
             {
                 std::shared_ptr<Aws::IOStream> iostream = request.GetBody();
-                request.SetBody(Aws::MakeShared<Aws::Utils::Crypto::SymmetricCryptoStream>(ALLOCATION_TAG, (Aws::IStream&)*iostream, CipherMode::Encrypt, (*m_cipher)));
+                request.SetBody(Aws::MakeShared<Aws::Utils::Crypto::SymmetricCryptoStream>(ALLOCATION_TAG, (Aws::IStream&)*iostream, CipherMode::Encrypt, (*m_cipher), CRYPTO_STREAM_BUFFER_SIZE));
                 iostream->clear();
                 iostream->seekg(0, std::ios_base::beg);
 
@@ -147,7 +689,7 @@ namespace Aws
                 auto userSuppliedStream = userSuppliedStreamFactory();
 
                 request.SetResponseStreamFactory(
-                    [&] { return Aws::New<SymmetricCryptoStream>(ALLOCATION_TAG, (Aws::OStream&)*userSuppliedStream, CipherMode::Decrypt, *m_cipher, DEFAULT_BUF_SIZE, firstBlockOffset); }
+                    [&] { return Aws::New<SymmetricCryptoStream>(ALLOCATION_TAG, (Aws::OStream&)*userSuppliedStream, CipherMode::Decrypt, *m_cipher, CRYPTO_STREAM_BUFFER_SIZE, firstBlockOffset); }
                 );
                 GetObjectOutcome outcome = getObjectFunction(request);
 
@@ -489,6 +1031,11 @@ namespace Aws
                 return m_cipher->EncryptBuffer(unEncryptedData);
             }
 
+            size_t AES_GCM_AppendedTag::EncryptBufferTo(const unsigned char* data, size_t length, unsigned char* output)
+            {
+                return m_cipher->EncryptBufferTo(data, length, output);
+            }
+
             CryptoBuffer AES_GCM_AppendedTag::FinalizeEncryption()
             {
                 CryptoBuffer&& finalizeBuffer = m_cipher->FinalizeEncryption();
@@ -519,6 +1066,164 @@ namespace Aws
                 m_failure = false;
             }
 
+            /*
+             * An element of GF(2^128) as GCM orders its bits, the first bit of the block being the most significant bit of hi.
+             */
+            struct GHashBlock
+            {
+                uint64_t hi;
+                uint64_t lo;
+            };
+
+            static GHashBlock ToGHashBlock(const CryptoBuffer& buffer)
+            {
+                GHashBlock block = { 0, 0 };
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    block.hi = (block.hi << 8) | buffer[i];
+                    block.lo = (block.lo << 8) | buffer[i + 8];
+                }
+                return block;
+            }
+
+            static CryptoBuffer FromGHashBlock(const GHashBlock& block)
+            {
+                CryptoBuffer buffer(AES_BLOCK_SIZE);
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    buffer[i] = static_cast<unsigned char>(block.hi >> (56 - 8 * i));
+                    buffer[i + 8] = static_cast<unsigned char>(block.lo >> (56 - 8 * i));
+                }
+                return buffer;
+            }
+
+            static GHashBlock Xor(const GHashBlock& x, const GHashBlock& y)
+            {
+                GHashBlock z = { x.hi ^ y.hi, x.lo ^ y.lo };
+                return z;
+            }
+
+            // the multiplication of SP 800-38D section 6.3, only run once or a few times per part so a bitwise one does.
+            static GHashBlock Multiply(const GHashBlock& x, const GHashBlock& y)
+            {
+                GHashBlock z = { 0, 0 };
+                GHashBlock v = y;
+                for (size_t i = 0; i < 128; ++i)
+                {
+                    uint64_t bit = i < 64 ? (x.hi >> (63 - i)) & 1 : (x.lo >> (127 - i)) & 1;
+                    if (bit)
+                    {
+                        z = Xor(z, v);
+                    }
+                    bool carry = (v.lo & 1) != 0;
+                    v.lo = (v.lo >> 1) | (v.hi << 63);
+                    v.hi >>= 1;
+                    if (carry)
+                    {
+                        v.hi ^= 0xe100000000000000ull;
+                    }
+                }
+                return z;
+            }
+
+            static GHashBlock Power(GHashBlock x, uint64_t exponent)
+            {
+                GHashBlock result = { 0x8000000000000000ull, 0 };
+                while (exponent > 0)
+                {
+                    if (exponent & 1)
+                    {
+                        result = Multiply(result, x);
+                    }
+                    x = Multiply(x, x);
+                    exponent >>= 1;
+                }
+                return result;
+            }
+
+            // encrypts a block of zeros with AES CTR from counter, that is encrypts counter with AES.
+            static CryptoBuffer EncryptCounter(const CryptoBuffer& key, const CryptoBuffer& counter)
+            {
+                auto cipher = CreateAES_CTRImplementation(key, counter);
+                if (!cipher || !*cipher)
+                {
+                    return CryptoBuffer();
+                }
+                CryptoBuffer block(AES_BLOCK_SIZE);
+                block.Zero();
+                if (!cipher->EncryptInPlace(block.GetUnderlyingData(), block.GetLength()))
+                {
+                    return CryptoBuffer();
+                }
+                return block;
+            }
+
+            AES_GCM_Parts::AES_GCM_Parts(const CryptoBuffer& key, const CryptoBuffer& iv) :
+                m_key(key), m_iv(iv), m_failure(iv.GetLength() != GCM_IV_SIZE)
+            {
+                if (m_failure)
+                {
+                    return;
+                }
+                CryptoBuffer zeros(AES_BLOCK_SIZE);
+                zeros.Zero();
+                m_hashKey = EncryptCounter(m_key, zeros);
+
+                CryptoBuffer counter(4);
+                counter.Zero();
+                counter[3] = 0x01;
+                m_tagMask = EncryptCounter(m_key, CryptoBuffer({ (ByteBuffer*)&m_iv, (ByteBuffer*)&counter }));
+                m_failure = m_hashKey.GetLength() != AES_BLOCK_SIZE || m_tagMask.GetLength() != AES_BLOCK_SIZE;
+            }
+
+            std::shared_ptr<SymmetricCipher> AES_GCM_Parts::CreatePartCipher(uint64_t offset) const
+            {
+                assert(offset % AES_BLOCK_SIZE == 0);
+                //start at 0x01, but that is for the Hash, this message should begin at 0x02
+                CryptoBuffer counter(4);
+                counter.Zero();
+                counter[3] = 0x02;
+                CryptoBuffer gcmToCtrIv({ (ByteBuffer*)&m_iv, (ByteBuffer*)&counter });
+                return CreateAES_CTRImplementation(m_key, IncrementCTRCounter(gcmToCtrIv, static_cast<int32_t>(offset / AES_BLOCK_SIZE)));
+            }
+
+            CryptoBuffer AES_GCM_Parts::DigestPart(const unsigned char* cipherText, size_t length) const
+            {
+                // a GCM message with the part as its additional authenticated data and nothing to encrypt has the tag
+                // E(K, J0) xor GHASH(part || len(part) || 0), from which the GHASH of the part alone is recovered.
+                auto cipher = CreateAES_GCMImplementation(CryptoBuffer(m_key), CryptoBuffer(m_iv), CryptoBuffer(), CryptoBuffer(cipherText, length));
+                if (!cipher || !*cipher)
+                {
+                    return CryptoBuffer();
+                }
+                cipher->FinalizeEncryption();
+                if (!*cipher || cipher->GetTag().GetLength() != TAG_SIZE_BYTES)
+                {
+                    return CryptoBuffer();
+                }
+                GHashBlock lengths = { static_cast<uint64_t>(length) * BITS_IN_BYTE, 0 };
+                GHashBlock hashKey = ToGHashBlock(m_hashKey);
+                GHashBlock digest = Xor(Xor(ToGHashBlock(cipher->GetTag()), ToGHashBlock(m_tagMask)), Multiply(lengths, hashKey));
+                return FromGHashBlock(digest);
+            }
+
+            CryptoBuffer AES_GCM_Parts::ComputeTag(const Aws::Vector<std::pair<uint64_t, CryptoBuffer>>& partDigests) const
+            {
+                // GHASH is a polynomial in the hash key, each part's digest being shifted by the blocks of the parts after it.
+                GHashBlock hashKey = ToGHashBlock(m_hashKey);
+                GHashBlock hash = { 0, 0 };
+                uint64_t totalLength = 0;
+                for (const auto& partDigest : partDigests)
+                {
+                    uint64_t blocks = (partDigest.first + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+                    hash = Xor(Multiply(hash, Power(hashKey, blocks)), ToGHashBlock(partDigest.second));
+                    totalLength += partDigest.first;
+                }
+                GHashBlock lengths = { 0, totalLength * BITS_IN_BYTE };
+                hash = Xor(hash, Multiply(lengths, hashKey));
+                return FromGHashBlock(Xor(hash, ToGHashBlock(m_tagMask)));
+            }
+
         }
     }
 }
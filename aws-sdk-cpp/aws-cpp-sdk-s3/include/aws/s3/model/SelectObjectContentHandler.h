@@ -33,6 +33,7 @@ namespace Model
     class AWS_S3_API SelectObjectContentHandler : public Aws::Utils::Event::EventStreamHandler
     {
         typedef std::function<void(const RecordsEvent&)> RecordsEventCallback;
+        typedef std::function<void(const unsigned char* payload, size_t payloadLength)> RecordsEventPayloadCallback;
         typedef std::function<void(const StatsEvent&)> StatsEventCallback;
         typedef std::function<void(const ProgressEvent&)> ProgressEventCallback;
         typedef std::function<void()> ContinuationEventCallback;
@@ -46,6 +47,11 @@ namespace Model
         virtual void OnEvent() override;
 
         inline void SetRecordsEventCallback(const RecordsEventCallback& callback) { m_onRecordsEvent = callback; }
+        /**
+         * Receive the RecordsEvent payload in place of the RecordsEvent callback, without copying it out of the decoder.
+         * The payload is only valid for the duration of the callback.
+         */
+        inline void SetRecordsEventPayloadCallback(const RecordsEventPayloadCallback& callback) { m_onRecordsEventPayload = callback; }
         inline void SetStatsEventCallback(const StatsEventCallback& callback) { m_onStatsEvent = callback; }
         inline void SetProgressEventCallback(const ProgressEventCallback& callback) { m_onProgressEvent = callback; }
         inline void SetContinuationEventCallback(const ContinuationEventCallback& callback) { m_onContinuationEvent = callback; }
@@ -58,6 +64,7 @@ namespace Model
         void MarshallError(const Aws::String& errorCode, const Aws::String& errorMessage);
 
         RecordsEventCallback m_onRecordsEvent;
+        RecordsEventPayloadCallback m_onRecordsEventPayload;
         StatsEventCallback m_onStatsEvent;
         ProgressEventCallback m_onProgressEvent;
         ContinuationEventCallback m_onContinuationEvent;
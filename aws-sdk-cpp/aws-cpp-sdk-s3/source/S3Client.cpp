@@ -3697,6 +3697,9 @@ SelectObjectContentOutcome S3Client::SelectObjectContent(SelectObjectContentRequ
   request.SetResponseStreamFactory(
       [&] { request.GetEventStreamDecoder().Reset(); return Aws::New<Aws::Utils::Event::EventDecoderStream>(ALLOCATION_TAG, request.GetEventStreamDecoder()); }
   );
+  request.SetResponseBodySink(
+      [&](const char* data, size_t length, uint64_t) { request.GetEventStreamDecoder().Pump(reinterpret_cast<const unsigned char*>(data), length); return true; }
+  );
   return SelectObjectContentOutcome(MakeRequestWithEventStream(uri, request, Aws::Http::HttpMethod::HTTP_POST, Aws::Auth::SIGV4_SIGNER, computeEndpointOutcome.GetResult().signerRegion.c_str() /*signerRegionOverride*/, computeEndpointOutcome.GetResult().signerServiceName.c_str() /*signerServiceNameOverride*/));
 }
 
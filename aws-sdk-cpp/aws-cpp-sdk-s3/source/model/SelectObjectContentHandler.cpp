@@ -26,6 +26,8 @@ namespace Model
 
     SelectObjectContentHandler::SelectObjectContentHandler() : EventStreamHandler()
     {
+        SetBorrowMessages(true);
+
         m_onRecordsEvent = [&](const RecordsEvent&)
         {
             AWS_LOGSTREAM_TRACE(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG, "RecordsEvent received.");
@@ -68,15 +70,14 @@ namespace Model
             return;
         }
 
-        const auto& headers = GetEventHeaders();
-        auto messageTypeHeaderIter = headers.find(MESSAGE_TYPE_HEADER);
-        if (messageTypeHeaderIter == headers.end())
+        const auto* messageTypeHeader = GetEventMessageView().FindHeader(MESSAGE_TYPE_HEADER);
+        if (!messageTypeHeader)
         {
             AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG, "Header: " << MESSAGE_TYPE_HEADER << " not found in the message.");
             return;
         }
 
-        switch (Aws::Utils::Event::Message::GetMessageTypeForName(messageTypeHeaderIter->second.GetEventHeaderValueAsString()))
+        switch (Aws::Utils::Event::Message::GetMessageTypeForName(messageTypeHeader->GetValueAsString()))
         {
         case Aws::Utils::Event::Message::MessageType::EVENT:
             HandleEventInMessage();
@@ -89,25 +90,30 @@ namespace Model
         }
         default:
             AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG,
-                "Unexpected message type: " << messageTypeHeaderIter->second.GetEventHeaderValueAsString());
+                "Unexpected message type: " << messageTypeHeader->GetValueAsString());
             break;
         }
     }
 
     void SelectObjectContentHandler::HandleEventInMessage()
     {
-        const auto& headers = GetEventHeaders();
-        auto eventTypeHeaderIter = headers.find(EVENT_TYPE_HEADER);
-        if (eventTypeHeaderIter == headers.end())
+        const auto& message = GetEventMessageView();
+        const auto* eventTypeHeader = message.FindHeader(EVENT_TYPE_HEADER);
+        if (!eventTypeHeader)
         {
             AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG, "Header: " << EVENT_TYPE_HEADER << " not found in the message.");
             return;
         }
-        switch (SelectObjectContentEventMapper::GetSelectObjectContentEventTypeForName(eventTypeHeaderIter->second.GetEventHeaderValueAsString()))
+        switch (SelectObjectContentEventMapper::GetSelectObjectContentEventTypeForName(eventTypeHeader->GetValueAsString()))
         {
         case SelectObjectContentEventType::RECORDS:
         {
-            RecordsEvent event(GetEventPayloadWithOwnership());
+            if (m_onRecordsEventPayload)
+            {
+                m_onRecordsEventPayload(message.GetPayload(), message.GetPayloadLength());
+                break;
+            }
+            RecordsEvent event(message.CopyPayload());
             m_onRecordsEvent(event);
             break;
         }
@@ -147,21 +153,21 @@ namespace Model
         }
         default:
             AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG,
-                "Unexpected event type: " << eventTypeHeaderIter->second.GetEventHeaderValueAsString());
+                "Unexpected event type: " << eventTypeHeader->GetValueAsString());
             break;
         }
     }
 
     void SelectObjectContentHandler::HandleErrorInMessage()
     {
-        const auto& headers = GetEventHeaders();
+        const auto& message = GetEventMessageView();
         Aws::String errorCode;
         Aws::String errorMessage;
-        auto errorHeaderIter = headers.find(ERROR_CODE_HEADER);
-        if (errorHeaderIter == headers.end())
+        const auto* errorHeader = message.FindHeader(ERROR_CODE_HEADER);
+        if (!errorHeader)
         {
-            errorHeaderIter = headers.find(EXCEPTION_TYPE_HEADER);
-            if (errorHeaderIter == headers.end())
+            errorHeader = message.FindHeader(EXCEPTION_TYPE_HEADER);
+            if (!errorHeader)
             {
                 AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG,
                         "Error type was not found in the event message.");
@@ -169,19 +175,19 @@ namespace Model
             }
         }
 
-        errorCode = errorHeaderIter->second.GetEventHeaderValueAsString();
-        errorHeaderIter = headers.find(ERROR_MESSAGE_HEADER);
-        if (errorHeaderIter == headers.end())
+        errorCode = errorHeader->GetValueAsString();
+        errorHeader = message.FindHeader(ERROR_MESSAGE_HEADER);
+        if (!errorHeader)
         {
-            errorHeaderIter = headers.find(EXCEPTION_TYPE_HEADER);
-            if (errorHeaderIter == headers.end())
+            errorHeader = message.FindHeader(EXCEPTION_TYPE_HEADER);
+            if (!errorHeader)
             {
                 AWS_LOGSTREAM_WARN(SELECTOBJECTCONTENT_HANDLER_CLASS_TAG,
                         "Error description was not found in the event message.");
                 return;
             }
         }
-        errorMessage = errorHeaderIter->second.GetEventHeaderValueAsString();
+        errorMessage = errorHeader->GetValueAsString();
         MarshallError(errorCode, errorMessage);
     }
 
@@ -26,14 +26,35 @@ namespace Model
   {
   public:
     AudioStream& WriteAudioEvent(const AudioEvent& value)
+    {
+       WriteEvent(MakeAudioEventMessage(value));
+       return *this;
+    }
+
+    /**
+     * Writes a batch of AudioEvents, signed and framed together and handed to the stream in one write.
+     */
+    AudioStream& WriteAudioEvents(const Aws::Vector<AudioEvent>& values)
+    {
+       Aws::Vector<Aws::Utils::Event::Message> msgs;
+       msgs.reserve(values.size());
+       for (const auto& value : values)
+       {
+           msgs.push_back(MakeAudioEventMessage(value));
+       }
+       WriteEvents(msgs);
+       return *this;
+    }
+
+  private:
+    static Aws::Utils::Event::Message MakeAudioEventMessage(const AudioEvent& value)
     {
        Aws::Utils::Event::Message msg;
        msg.InsertEventHeader(":message-type", Aws::String("event"));
        msg.InsertEventHeader(":event-type", Aws::String("AudioEvent"));
        msg.InsertEventHeader(":content-type", Aws::String("application/octet-stream"));
        msg.WriteEventPayload(value.GetAudioChunk());
-       WriteEvent(msg);
-       return *this;
+       return msg;
     }
 
   };
@@ -29,6 +29,8 @@ namespace Model
 
     StartMedicalStreamTranscriptionHandler::StartMedicalStreamTranscriptionHandler() : EventStreamHandler()
     {
+        SetBorrowMessages(true);
+
         m_onMedicalTranscriptEvent = [&](const MedicalTranscriptEvent&)
         {
             AWS_LOGSTREAM_TRACE(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "MedicalTranscriptEvent received.");
@@ -51,15 +53,14 @@ namespace Model
             return;
         }
 
-        const auto& headers = GetEventHeaders();
-        auto messageTypeHeaderIter = headers.find(MESSAGE_TYPE_HEADER);
-        if (messageTypeHeaderIter == headers.end())
+        const auto* messageTypeHeader = GetEventMessageView().FindHeader(MESSAGE_TYPE_HEADER);
+        if (!messageTypeHeader)
         {
             AWS_LOGSTREAM_WARN(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "Header: " << MESSAGE_TYPE_HEADER << " not found in the message.");
             return;
         }
 
-        switch (Aws::Utils::Event::Message::GetMessageTypeForName(messageTypeHeaderIter->second.GetEventHeaderValueAsString()))
+        switch (Aws::Utils::Event::Message::GetMessageTypeForName(messageTypeHeader->GetValueAsString()))
         {
         case Aws::Utils::Event::Message::MessageType::EVENT:
             HandleEventInMessage();
@@ -72,21 +73,21 @@ namespace Model
         }
         default:
             AWS_LOGSTREAM_WARN(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG,
-                "Unexpected message type: " << messageTypeHeaderIter->second.GetEventHeaderValueAsString());
+                "Unexpected message type: " << messageTypeHeader->GetValueAsString());
             break;
         }
     }
 
     void StartMedicalStreamTranscriptionHandler::HandleEventInMessage()
     {
-        const auto& headers = GetEventHeaders();
-        auto eventTypeHeaderIter = headers.find(EVENT_TYPE_HEADER);
-        if (eventTypeHeaderIter == headers.end())
+        const auto& message = GetEventMessageView();
+        const auto* eventTypeHeader = message.FindHeader(EVENT_TYPE_HEADER);
+        if (!eventTypeHeader)
         {
             AWS_LOGSTREAM_WARN(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "Header: " << EVENT_TYPE_HEADER << " not found in the message.");
             return;
         }
-        switch (StartMedicalStreamTranscriptionEventMapper::GetStartMedicalStreamTranscriptionEventTypeForName(eventTypeHeaderIter->second.GetEventHeaderValueAsString()))
+        switch (StartMedicalStreamTranscriptionEventMapper::GetStartMedicalStreamTranscriptionEventTypeForName(eventTypeHeader->GetValueAsString()))
         {
         case StartMedicalStreamTranscriptionEventType::TRANSCRIPTEVENT:
         {
@@ -102,21 +103,21 @@ namespace Model
         }
         default:
             AWS_LOGSTREAM_WARN(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG,
-                "Unexpected event type: " << eventTypeHeaderIter->second.GetEventHeaderValueAsString());
+                "Unexpected event type: " << eventTypeHeader->GetValueAsString());
             break;
         }
     }
 
     void StartMedicalStreamTranscriptionHandler::HandleErrorInMessage()
     {
-        const auto& headers = GetEventHeaders();
+        const auto& message = GetEventMessageView();
         Aws::String errorCode;
         Aws::String errorMessage;
-        auto errorHeaderIter = headers.find(ERROR_CODE_HEADER);
-        if (errorHeaderIter == headers.end())
+        const auto* errorHeader = message.FindHeader(ERROR_CODE_HEADER);
+        if (!errorHeader)
         {
-            errorHeaderIter = headers.find(EXCEPTION_TYPE_HEADER);
-            if (errorHeaderIter == headers.end())
+            errorHeader = message.FindHeader(EXCEPTION_TYPE_HEADER);
+            if (!errorHeader)
             {
                 AWS_LOGSTREAM_WARN(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG,
                         "Error type was not found in the event message.");
@@ -124,12 +125,12 @@ namespace Model
             }
         }
 
-        errorCode = errorHeaderIter->second.GetEventHeaderValueAsString();
-        errorHeaderIter = headers.find(ERROR_MESSAGE_HEADER);
-        if (errorHeaderIter == headers.end())
+        errorCode = errorHeader->GetValueAsString();
+        errorHeader = message.FindHeader(ERROR_MESSAGE_HEADER);
+        if (!errorHeader)
         {
-            errorHeaderIter = headers.find(EXCEPTION_TYPE_HEADER);
-            if (errorHeaderIter == headers.end())
+            errorHeader = message.FindHeader(EXCEPTION_TYPE_HEADER);
+            if (!errorHeader)
             {
                 AWS_LOGSTREAM_ERROR(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG,
                         "Error description was not found in the event message.");
@@ -140,10 +141,10 @@ namespace Model
             if (!exceptionPayload.WasParseSuccessful())
             {
                 AWS_LOGSTREAM_ERROR(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "Unable to generate a proper ServiceUnavailableException object from the response in JSON format.");
-                auto contentTypeIter = headers.find(Aws::Utils::Event::CONTENT_TYPE_HEADER);
-                if (contentTypeIter != headers.end())
+                const auto* contentTypeHeader = message.FindHeader(Aws::Utils::Event::CONTENT_TYPE_HEADER);
+                if (contentTypeHeader)
                 {
-                    AWS_LOGSTREAM_DEBUG(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "Error content-type: " << contentTypeIter->second.GetEventHeaderValueAsString());
+                    AWS_LOGSTREAM_DEBUG(STARTMEDICALSTREAMTRANSCRIPTION_HANDLER_CLASS_TAG, "Error content-type: " << contentTypeHeader->GetValueAsString());
                 }
                 return;
             }
@@ -157,7 +158,7 @@ namespace Model
         }
         else
         {
-            errorMessage = errorHeaderIter->second.GetEventHeaderValueAsString();
+            errorMessage = errorHeader->GetValueAsString();
         }
         MarshallError(errorCode, errorMessage);
     }
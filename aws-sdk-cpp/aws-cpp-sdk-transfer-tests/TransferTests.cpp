@@ -57,6 +57,7 @@ static const char* UNICODE_FILE_KEY = "UnicodeFileKey";
 #endif
 
 static const char* CANCEL_FILE_KEY = "CancelFileKey";
+static const char* RESUME_FILE_KEY = "ResumeFileKey";
 
 static const char* TEST_BUCKET_NAME_BASE = "transfertests";
 static const unsigned SMALL_TEST_SIZE = MB5 / 2;
@@ -1010,6 +1011,119 @@ TEST_F(TransferTests, TransferManager_DirectoryUploadAndDownloadTest)
     ASSERT_EQ(1u, m_s3Client->listObjectsV2RequestCount);
 }
 
+TEST_F(TransferTests, TransferManager_BatchedDirectoryUploadSkipsUnchangedFilesTest)
+{
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    auto uploadDir = Aws::FileSystem::Join(GetTestFilesDirectory(), RandomFileName + "batchedDirUpload");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(uploadDir.c_str()));
+
+    const size_t smallFileCount = 6;
+    Aws::Vector<std::shared_ptr<ScopedTestFile>> files;
+    for (size_t i = 0; i < smallFileCount; ++i)
+    {
+        auto fileName = Aws::FileSystem::Join(uploadDir, RandomFileName + "Small" + Aws::Utils::StringUtils::to_string(i));
+        files.push_back(Aws::MakeShared<ScopedTestFile>(ALLOCATION_TAG, fileName, static_cast<unsigned>(SMALL_TEST_SIZE + i), testString));
+    }
+    // larger than bufferSize, uploaded in parts and on its own.
+    files.push_back(Aws::MakeShared<ScopedTestFile>(ALLOCATION_TAG, Aws::FileSystem::Join(uploadDir, RandomFileName + "Medium"), MEDIUM_TEST_SIZE, testString));
+    const size_t fileCount = files.size();
+
+    Aws::Vector<std::shared_ptr<const TransferHandle>> directoryUploads;
+    std::condition_variable directoryUploadSignal;
+    std::mutex semaphoreLock;
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.maxDirectoryTransfersInFlight = 2;
+    transferManagerConfig.directoryBatchSize = 4;
+    transferManagerConfig.transferInitiatedCallback = [&](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+        {
+            std::lock_guard<std::mutex> m(semaphoreLock);
+            directoryUploads.push_back(handle);
+            if (directoryUploads.size() == fileCount)
+            {
+                directoryUploadSignal.notify_one();
+            }
+        };
+
+    auto waitForUploads = [&]()
+        {
+            std::unique_lock<std::mutex> locker(semaphoreLock);
+            directoryUploadSignal.wait_for(locker, TEST_WAIT_TIMEOUT, [&]() { return directoryUploads.size() == fileCount; });
+        };
+
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), "batchedTest", Aws::Map<Aws::String, Aws::String>());
+    waitForUploads();
+    ASSERT_EQ(fileCount, directoryUploads.size());
+    for (const auto& handle : directoryUploads)
+    {
+        handle->WaitUntilFinished();
+        ASSERT_EQ(TransferStatus::COMPLETED, handle->GetStatus());
+        ASSERT_TRUE(WaitForObjectToPropagate(GetTestBucketName(), handle->GetKey().c_str()));
+    }
+
+    // every file is already in the bucket, with the ETag an upload of it creates.
+    directoryUploads.clear();
+    transferManagerConfig.skipUnchangedFiles = SkipUnchangedFiles::IF_SAME_ETAG;
+    transferManager = TransferManager::Create(transferManagerConfig);
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), "batchedTest", Aws::Map<Aws::String, Aws::String>());
+    waitForUploads();
+    ASSERT_EQ(fileCount, directoryUploads.size());
+    for (const auto& handle : directoryUploads)
+    {
+        ASSERT_EQ(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS, handle->GetStatus());
+    }
+}
+
+// Bounded directory transfers must not wait for a slot on the thread the batches holding the slots run on.
+TEST_F(TransferTests, TransferManager_BoundedDirectoryUploadWithSingleThreadTest)
+{
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    auto uploadDir = Aws::FileSystem::Join(GetTestFilesDirectory(), RandomFileName + "singleThreadDirUpload");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(uploadDir.c_str()));
+
+    const size_t fileCount = 5;
+    Aws::Vector<std::shared_ptr<ScopedTestFile>> files;
+    for (size_t i = 0; i < fileCount; ++i)
+    {
+        auto fileName = Aws::FileSystem::Join(uploadDir, RandomFileName + "Small" + Aws::Utils::StringUtils::to_string(i));
+        files.push_back(Aws::MakeShared<ScopedTestFile>(ALLOCATION_TAG, fileName, static_cast<unsigned>(SMALL_TEST_SIZE), testString));
+    }
+
+    Aws::Vector<std::shared_ptr<const TransferHandle>> directoryUploads;
+    std::condition_variable directoryUploadSignal;
+    std::mutex semaphoreLock;
+
+    m_executor = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(ALLOCATION_TAG, 1);
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.maxDirectoryTransfersInFlight = 1;
+    transferManagerConfig.directoryBatchSize = 2;
+    transferManagerConfig.transferInitiatedCallback = [&](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+        {
+            std::lock_guard<std::mutex> m(semaphoreLock);
+            directoryUploads.push_back(handle);
+            if (directoryUploads.size() == fileCount)
+            {
+                directoryUploadSignal.notify_one();
+            }
+        };
+
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+    transferManager->UploadDirectory(uploadDir, GetTestBucketName(), "singleThreadTest", Aws::Map<Aws::String, Aws::String>());
+    {
+        std::unique_lock<std::mutex> locker(semaphoreLock);
+        directoryUploadSignal.wait_for(locker, TEST_WAIT_TIMEOUT, [&]() { return directoryUploads.size() == fileCount; });
+    }
+    ASSERT_EQ(fileCount, directoryUploads.size());
+    for (const auto& handle : directoryUploads)
+    {
+        handle->WaitUntilFinished();
+        ASSERT_EQ(TransferStatus::COMPLETED, handle->GetStatus());
+    }
+}
+
 // Test of a basic multi part upload - 7.5 megs
 TEST_F(TransferTests, TransferManager_MediumTest)
 {
@@ -1115,6 +1229,83 @@ TEST_F(TransferTests, TransferManager_BigTest)
                                       Aws::Map<Aws::String, Aws::String>());
 }
 
+// A download sink that can only be appended to, like a pipe.
+class AppendOnlyStreamBuf : public std::streambuf
+{
+public:
+    AppendOnlyStreamBuf(Aws::String& content) : m_content(content) {}
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (c != traits_type::eof())
+        {
+            m_content.push_back(static_cast<char>(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        m_content.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    Aws::String& m_content;
+};
+
+class AppendOnlyStream : public Aws::IOStream
+{
+public:
+    AppendOnlyStream(Aws::String& content) : Aws::IOStream(&m_buf), m_buf(content) {}
+
+private:
+    AppendOnlyStreamBuf m_buf;
+};
+
+TEST_F(TransferTests, TransferManager_AdaptiveDownloadToUnseekableStreamTest)
+{
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    Aws::String bigTestFileName = MakeFilePath(RandomFileName.c_str());
+    ScopedTestFile testFile(bigTestFileName, BIG_TEST_SIZE, testString);
+
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.useAdaptiveDownloadParts = true;
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+
+    std::shared_ptr<TransferHandle> uploadPtr = transferManager->UploadFile(bigTestFileName, GetTestBucketName(), RandomFileName, "text/plain", Aws::Map<Aws::String, Aws::String>());
+    uploadPtr->WaitUntilFinished();
+    size_t retries = 0;
+    while (uploadPtr->GetStatus() == TransferStatus::FAILED && retries++ < 5)
+    {
+        transferManager->RetryUpload(bigTestFileName, uploadPtr);
+        uploadPtr->WaitUntilFinished();
+    }
+    ASSERT_EQ(TransferStatus::COMPLETED, uploadPtr->GetStatus());
+    ASSERT_TRUE(WaitForObjectToPropagate(GetTestBucketName(), RandomFileName.c_str()));
+
+    // parts complete in any order but have to reach the stream in order.
+    Aws::String downloadedContent;
+    std::shared_ptr<TransferHandle> downloadPtr = transferManager->DownloadFile(GetTestBucketName(), RandomFileName,
+        [&downloadedContent]() { return Aws::New<AppendOnlyStream>(ALLOCATION_TAG, downloadedContent); });
+    downloadPtr->WaitUntilFinished();
+
+    ASSERT_EQ(TransferStatus::COMPLETED, downloadPtr->GetStatus());
+    ASSERT_TRUE(downloadPtr->IsMultipart());
+    ASSERT_EQ(0u, downloadPtr->GetFailedParts().size());
+    ASSERT_EQ(uploadPtr->GetBytesTotalSize(), downloadPtr->GetBytesTotalSize());
+    ASSERT_EQ(downloadPtr->GetBytesTotalSize(), downloadPtr->GetBytesTransferred());
+    ASSERT_STREQ("text/plain", downloadPtr->GetContentType().c_str());
+
+    Aws::IFStream sourceFile(bigTestFileName.c_str(), std::ios::binary);
+    Aws::StringStream sourceContent;
+    sourceContent << sourceFile.rdbuf();
+    ASSERT_EQ(sourceContent.str().size(), downloadedContent.size());
+    ASSERT_TRUE(sourceContent.str() == downloadedContent);
+}
+
 TEST_F(TransferTests, TransferManager_MultipartTestWithStreamOffset)
 {
     const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
@@ -1330,6 +1521,73 @@ TEST_F(TransferTests, TransferManager_CancelAndRetryUploadTest)
                        Aws::Map<Aws::String, Aws::String>());
 }
 
+TEST_F(TransferTests, TransferManager_CancelAndResumeUploadFromJournalTest)
+{
+    const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
+    Aws::String resumeTestFileName = MakeFilePath(RandomFileName.c_str());
+    ScopedTestFile testFile(resumeTestFileName, CANCEL_TEST_SIZE, testString);
+    auto journalDir = Aws::FileSystem::Join(GetTestFilesDirectory(), RandomFileName + "journals");
+    ASSERT_TRUE(Aws::FileSystem::CreateDirectoryIfNotExists(journalDir.c_str()));
+
+    std::atomic<bool> cancelHasBeenCalled(false);
+    TransferManagerConfiguration transferManagerConfig(m_executor.get());
+    transferManagerConfig.s3Client = m_s3Client;
+    transferManagerConfig.transferJournalDirectory = journalDir;
+    transferManagerConfig.transferStatusUpdatedCallback =
+        [&](const TransferManager*, const std::shared_ptr<const TransferHandle>& handle)
+        {
+            bool expected = false;
+            if (handle->GetCompletedParts().size() >= 15 && cancelHasBeenCalled.compare_exchange_strong(expected, true))
+            {
+                std::const_pointer_cast<TransferHandle>(handle)->Cancel();
+            }
+        };
+
+    size_t completedBeforeResume = 0;
+    {
+        auto transferManager = TransferManager::Create(transferManagerConfig);
+        std::shared_ptr<TransferHandle> requestPtr = transferManager->UploadFile(resumeTestFileName, GetTestBucketName(), RESUME_FILE_KEY, "text/plain", Aws::Map<Aws::String, Aws::String>());
+        requestPtr->WaitUntilFinished();
+        ASSERT_EQ(TransferStatus::CANCELED, requestPtr->GetStatus());
+        completedBeforeResume = requestPtr->GetCompletedParts().size();
+        ASSERT_TRUE(15u <= completedBeforeResume && completedBeforeResume < 30u);
+    }
+    ASSERT_EQ(1u, Aws::FileSystem::Directory::GetAllFilePathsInDirectory(journalDir).size());
+
+    // a new TransferManager, as after the process that started the upload has ended, sends only the parts the journal does not record.
+    transferManagerConfig.transferStatusUpdatedCallback = nullptr;
+    auto transferManager = TransferManager::Create(transferManagerConfig);
+    auto resumed = transferManager->ResumeTransfers();
+    ASSERT_EQ(1u, resumed.size());
+    auto requestPtr = resumed.front();
+    ASSERT_TRUE(requestPtr->IsMultipart());
+    ASSERT_LE(completedBeforeResume, requestPtr->GetCompletedParts().size());
+    requestPtr->WaitUntilFinished();
+
+    size_t retries = 0;
+    //just make sure we don't fail because an upload part failed. (e.g. network problems or interuptions)
+    while (requestPtr->GetStatus() == TransferStatus::FAILED && retries++ < 5)
+    {
+        transferManager->RetryUpload(resumeTestFileName, requestPtr);
+        requestPtr->WaitUntilFinished();
+    }
+
+    ASSERT_EQ(TransferStatus::COMPLETED, requestPtr->GetStatus());
+    ASSERT_EQ(30u, requestPtr->GetCompletedParts().size());
+    ASSERT_EQ(requestPtr->GetBytesTotalSize(), requestPtr->GetBytesTransferred());
+    ASSERT_EQ(0u, Aws::FileSystem::Directory::GetAllFilePathsInDirectory(journalDir).size());
+
+    ASSERT_TRUE(WaitForObjectToPropagate(GetTestBucketName(), RESUME_FILE_KEY));
+
+    VerifyUploadedFile(*transferManager,
+                       resumeTestFileName,
+                       GetTestBucketName(),
+                       RESUME_FILE_KEY,
+                       "text/plain",
+                       Aws::Map<Aws::String, Aws::String>());
+    Aws::FileSystem::RemoveDirectoryIfExists(journalDir.c_str());
+}
+
 TEST_F(TransferTests, TransferManager_AbortAndRetryUploadTest)
 {
     const Aws::String RandomFileName = Aws::Utils::UUID::RandomUUID();
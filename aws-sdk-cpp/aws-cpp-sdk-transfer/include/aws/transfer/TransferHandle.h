@@ -8,6 +8,7 @@
 #include <aws/transfer/Transfer_EXPORTS.h>
 #include <aws/core/utils/memory/stl/AWSString.h>
 #include <aws/core/utils/memory/stl/AWSSet.h>
+#include <aws/core/utils/memory/stl/AWSVector.h>
 #include <aws/core/utils/memory/stl/AWSMap.h>
 #include <aws/core/utils/UUID.h>
 #include <aws/core/client/AWSError.h>
@@ -28,6 +29,7 @@ namespace Aws
     namespace Transfer
     {
         class TransferHandle;
+        class TransferJournal;
 
         typedef std::function<Aws::IOStream*(void)> CreateDownloadStreamCallback;
 
@@ -347,10 +349,43 @@ namespace Aws
              */
             void WaitUntilFinished() const;
 
+            /**
+             * (Internal) Sets a function called once, when the transfer first reaches a finished status, or right away if it already has.
+             * TransferManager uses it to bound how many files of a directory are in flight.
+             */
+            void SetFinishedCallback(const std::function<void()>& callback);
+
+            /**
+             * (Internal) The journal of this transfer, see TransferManagerConfiguration::transferJournalDirectory. Completed parts are recorded to it,
+             * and it is removed once the transfer completes or is aborted.
+             */
+            inline std::shared_ptr<TransferJournal> GetJournal() const { std::lock_guard<std::mutex> locker(m_getterSetterLock); return m_journal; }
+            inline void SetJournal(const std::shared_ptr<TransferJournal>& journal) { std::lock_guard<std::mutex> locker(m_getterSetterLock); m_journal = journal; }
+
             const CreateDownloadStreamCallback& GetCreateDownloadStreamFunction() const { return m_createDownloadStreamFn; }
 
+            /**
+             * (Download only) Whether parts are written straight into a memory mapping of the target file rather than through the download stream.
+             */
+            inline bool IsDownloadToMappedFile() const { return m_downloadToMappedFile.load(); }
+            inline void SetDownloadToMappedFile(bool value) { m_downloadToMappedFile.store(value); }
+
             void WritePartToDownloadStream(Aws::IOStream* partStream, std::size_t writeOffset);
 
+            /**
+             * Writes a downloaded part, held in its download buffer, to the download stream at the part's range begin.
+             * When the download stream can not seek, parts are written in order: a part received ahead of a part before it is held,
+             * along with its buffer, until that part is written.
+             * Returns the parts written by this call, whose download buffers can be released. The stream is flushed after writing them;
+             * isWritten is set to false if it then is in a failed state, in which case those parts must not be recorded as completed.
+             */
+            Aws::Vector<PartPointer> WritePartToDownloadStream(const PartPointer& partState, bool& isWritten);
+
+            /**
+             * Stops holding the parts WritePartToDownloadStream() is holding and returns them, for a download that can not complete.
+             */
+            Aws::Vector<PartPointer> ReleaseHeldDownloadParts();
+
             void ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig);
 
             bool LockForCompletion()
@@ -386,6 +421,8 @@ namespace Aws
             Aws::String m_versionId;
             Aws::Map<Aws::String, Aws::String> m_metadata;
             TransferStatus m_status;
+            std::function<void()> m_finishedCallback;
+            std::shared_ptr<TransferJournal> m_journal;
             Aws::Client::AWSError<Aws::S3::S3Errors> m_lastError;
             std::atomic<bool> m_cancel;
             std::shared_ptr<const Aws::Client::AsyncCallerContext> m_context;
@@ -393,8 +430,13 @@ namespace Aws
 
             CreateDownloadStreamCallback m_createDownloadStreamFn;
             Aws::IOStream* m_downloadStream;
+            std::atomic<bool> m_downloadToMappedFile;
             /* in case cutomer stream is not based off 0 */
             uint64_t m_downloadStreamBaseOffset;
+            bool m_downloadStreamSeekable;
+            /* where the next part goes in a download stream that can not seek, and the parts received ahead of it */
+            uint64_t m_downloadStreamNextOffset;
+            PartStateMap m_heldDownloadParts;
 
             mutable std::mutex m_downloadStreamLock;
             mutable std::mutex m_partsLock;
@@ -0,0 +1,88 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <aws/transfer/Transfer_EXPORTS.h>
+#include <aws/transfer/TransferHandle.h>
+#include <aws/core/utils/memory/stl/AWSString.h>
+#include <aws/core/utils/memory/stl/AWSMap.h>
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <aws/core/utils/memory/AWSMemory.h>
+#include <mutex>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        /**
+         * What a journal tells of a transfer, see TransferJournal::Load().
+         */
+        struct AWS_TRANSFER_API TransferJournalRecord
+        {
+            TransferJournalRecord() : direction(TransferDirection::UPLOAD), totalSize(0) {}
+
+            TransferDirection direction;
+            Aws::String bucketName;
+            Aws::String keyName;
+            Aws::String versionId;
+            Aws::String fileName;
+            Aws::String contentType;
+            Aws::Map<Aws::String, Aws::String> metadata;
+            uint64_t totalSize;
+            // the last modified time of the file of an upload in milliseconds, or the ETag of the object of a download.
+            Aws::String sourceVersion;
+            // the upload ID of an upload.
+            Aws::String multipartId;
+            // the parts not completed yet, and the completed parts along with their ETags.
+            PartStateMap remainingParts;
+            PartStateMap completedParts;
+        };
+
+        /**
+         * The journal of a multi-part transfer between a file and S3: what it transfers, its upload ID and its parts, to which each completed part
+         * is appended as it completes, so that TransferManager::ResumeTransfer() can resume the transfer after the process that started it is gone.
+         * A part is recorded once its data is with S3, or with the operating system for a download, and the record is flushed to the operating
+         * system but not synced to disk: the journal survives the process, not the machine, crashing.
+         */
+        class AWS_TRANSFER_API TransferJournal
+        {
+        public:
+            TransferJournal(const Aws::String& fileName);
+            ~TransferJournal();
+
+            const Aws::String& GetFileName() const { return m_fileName; }
+
+            /**
+             * Writes the journal of handle, replacing any file at the file name, and keeps it open to record the parts completed from now on.
+             * sourceVersion identifies the content transferred, see TransferJournalRecord. Returns false if the file can not be written.
+             */
+            bool Begin(const TransferHandle& handle, const Aws::String& sourceVersion);
+
+            /**
+             * Reads the journal into record and keeps it open to record the parts completed from now on.
+             * Returns false if the file can not be read or is not a journal.
+             */
+            bool Load(TransferJournalRecord& record);
+
+            /**
+             * Records that part has completed, with its ETag.
+             */
+            void AddCompletedPart(const PartState& part);
+
+            /**
+             * Deletes the journal of a transfer that has completed or been aborted. Parts completed afterwards are not recorded.
+             */
+            void Remove();
+
+        private:
+            bool Open(std::ios_base::openmode mode);
+
+            Aws::String m_fileName;
+            Aws::UniquePtr<Aws::OFStream> m_file;
+            std::mutex m_fileLock;
+        };
+    }
+}
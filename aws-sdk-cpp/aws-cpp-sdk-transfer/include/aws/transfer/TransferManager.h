@@ -6,23 +6,35 @@
 #pragma once
 
 #include <aws/transfer/TransferHandle.h>
+#include <aws/transfer/TransferJournal.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/UploadPartRequest.h>
 #include <aws/core/utils/threading/Executor.h>
+#include <aws/core/utils/threading/Semaphore.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/ResourceManager.h>
 #include <aws/core/client/AsyncCallerContext.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 
 namespace Aws
 {    
+    namespace FileSystem
+    {
+        class MappedFile;
+    }
+
     namespace Transfer
     {
         class TransferManager;
+        struct DirectoryFile;
+        struct DirectoryTransferSlot;
 
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> UploadProgressCallback;
         typedef std::function<void(const TransferManager*, const std::shared_ptr<const TransferHandle>&)> DownloadProgressCallback;
@@ -32,12 +44,31 @@ namespace Aws
 
         const uint64_t MB5 = 5 * 1024 * 1024;
 
+        /**
+         * Which files UploadDirectory() and DownloadToDirectory() skip, as already at their destination.
+         */
+        enum class SkipUnchangedFiles
+        {
+            // every file is transferred.
+            NEVER,
+            // files whose destination has the same size are skipped.
+            IF_SAME_SIZE,
+            // files whose destination has the same size and was last modified after the source are skipped.
+            // S3 keeps the time an object was last modified to the second.
+            IF_SAME_SIZE_AND_NEWER,
+            // files whose destination has the same size and the ETag TransferManager computes for the file are skipped:
+            // the MD5 of the file, or for a file larger than bufferSize the ETag of a multipart upload in parts of bufferSize.
+            // An object uploaded in parts of another size, or encrypted with a KMS key, does not have that ETag.
+            IF_SAME_ETAG
+        };
+
         /**
          * Configuration for use with TransferManager. The data here will be copied directly to TransferManager.
          */
         struct TransferManagerConfiguration
         {
-            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), computeContentMD5(false), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5)
+            TransferManagerConfiguration(Aws::Utils::Threading::Executor* executor) : s3Client(nullptr), transferExecutor(executor), computeContentMD5(false), transferBufferMaxHeapSize(10 * MB5), bufferSize(MB5), useMemoryMappedFiles(false), useAdaptiveDownloadParts(false),
+                maxDirectoryTransfersInFlight(0), directoryBatchSize(1), skipUnchangedFiles(SkipUnchangedFiles::NEVER)
             {
             }
 
@@ -88,6 +119,52 @@ namespace Aws
              * to increase your max heap size if this is something you plan on increasing.
              */
             uint64_t bufferSize;
+            /**
+             * When true, files uploaded via UploadFile(fileName, ...) and downloaded via DownloadFile(bucketName, keyName, writeToFile, ...) are memory mapped:
+             * parts are sent straight from, and received straight into, the mapped file instead of being copied through the transfer buffers, and the OS
+             * is asked to read ahead each part about to be uploaded. The transfer buffers are then only allocated once a stream transfer needs them.
+             * transferBufferMaxHeapSize / bufferSize still bounds how many parts of mapped files are in flight.
+             * A file that can not be mapped, or whose download does not fit on the disk, is transferred through the buffers.
+             * A file must not be truncated while it is being uploaded: reading a part past its new end raises SIGBUS, which terminates the
+             * process, rather than failing the transfer. Don't enable this for files that other processes may shrink, such as logs being rotated.
+             * This option is disabled by default.
+             */
+            bool useMemoryMappedFiles;
+            /**
+             * When true, a download of a whole object gets its first part with a ranged GetObject, which also tells the size of the object,
+             * instead of sending a HeadObject first. The rest of the object is split into parts no larger than bufferSize, small enough that
+             * transferBufferMaxHeapSize / bufferSize parts can be in flight for it at once and sized to the throughput per connection
+             * measured on previous downloads. The concurrency of a download then follows from the size of the object.
+             * This option is disabled by default.
+             */
+            bool useAdaptiveDownloadParts;
+            /**
+             * Bounds how many batches of files (see directoryBatchSize) UploadDirectory() and DownloadToDirectory() have in flight, so that the walk
+             * of the directory or the listing of the bucket keeps only a window of files ahead of the transfers rather than a handle for each file.
+             * The walk or the listing waits for a batch to finish on a thread of its own, so this works with any number of threads in transferExecutor.
+             * Defaults to 0, which does not bound them.
+             */
+            size_t maxDirectoryTransfersInFlight;
+            /**
+             * Files of UploadDirectory() and DownloadToDirectory() no larger than bufferSize are transferred in batches of up to this many files,
+             * each batch by a single task of transferExecutor, to save scheduling a task for every small file. The uploads of a batch are sent
+             * concurrently, its downloads one after the other. Defaults to 1.
+             */
+            size_t directoryBatchSize;
+            /**
+             * Which files UploadDirectory() and DownloadToDirectory() skip. An upload compares the file with a HeadObject of its key,
+             * a download compares the object listed with the file. A skipped file is passed to transferInitiatedCallback
+             * with a handle in the EXACT_OBJECT_ALREADY_EXISTS status. Defaults to NEVER.
+             */
+            SkipUnchangedFiles skipUnchangedFiles;
+            /**
+             * If set, multi-part uploads of files (UploadFile() with a file name) and multi-part downloads to files (DownloadFile() with a file name)
+             * keep a journal of their parts in this directory, which must exist, named after the ID of their handle, see TransferJournal.
+             * A journal is removed once its transfer completes or is aborted; the journal of a transfer that failed, was canceled or
+             * was cut short by the process ending resumes it through ResumeTransfer(). Neither journals nor downloaded parts are synced to disk,
+             * so resuming is guaranteed after the process crashes, not after a power loss or an operating system crash. Defaults to empty, no journals.
+             */
+            Aws::String transferJournalDirectory;
 
             /**
              * Callback to receive progress updates for uploads.
@@ -210,7 +287,7 @@ namespace Aws
             /**
              * Uploads entire contents of directory to Amazon S3 bucket and stores them in a directory starting at prefix. This is an asynchronous method. You will receive notifications
              * that an upload has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
-             * the file transfers.
+             * the file transfers. Files are uploaded as the directory is walked, see maxDirectoryTransfersInFlight, directoryBatchSize and skipUnchangedFiles.
              *
              * directory: the absolute directory on disk to upload
              * bucketName: the name of the S3 bucket to upload to
@@ -222,6 +299,7 @@ namespace Aws
             * Downloads entire contents of an Amazon S3 bucket starting at prefix stores them in a directory (not including the prefix). This is an asynchronous method. You will receive notifications
             * that a download has started via the transferInitiatedCallback callback function in your configuration. If you do not set this callback, then you will not be able to handle
             * the file transfers. If an error occurs prior to the transfer being initiated (e.g. list objects fails, then an error will be passed through the errorCallback).
+            * Objects are downloaded as the bucket is listed, see maxDirectoryTransfersInFlight, directoryBatchSize and skipUnchangedFiles.
             *
             * directory: the absolute directory on disk to download to
             * bucketName: the name of the S3 bucket to upload to
@@ -229,6 +307,20 @@ namespace Aws
             */
             void DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix = Aws::String());
 
+            /**
+             * Resumes the transfer of the journal file, see transferJournalDirectory, typically written by a process that has since ended.
+             * Only the parts not completed yet are transferred, continuing the same multi-part upload for an upload.
+             * If the file of an upload, or the object of a download, changed since, or the parts of the journal do not fit in bufferSize,
+             * the journal is removed and the file is transferred from the start, aborting the multi-part upload of the journal.
+             * Returns nullptr if the journal can not be read.
+             */
+            std::shared_ptr<TransferHandle> ResumeTransfer(const Aws::String& journalFile);
+
+            /**
+             * Resumes the transfers of all of the journals in transferJournalDirectory, see ResumeTransfer().
+             */
+            Aws::Vector<std::shared_ptr<TransferHandle>> ResumeTransfers();
+
         private:
             /**
              * To ensure TransferManager is always created as a shared_ptr, since it inherits enable_shared_from_this.
@@ -277,10 +369,26 @@ namespace Aws
                                                          const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
 
             bool MultipartUploadSupported(uint64_t length) const;
-            bool InitializePartsForDownload(const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * firstPart is set to the part already downloaded to discover the size of the object, if any. It is pending, in its download buffer.
+             */
+            bool InitializePartsForDownload(const std::shared_ptr<TransferHandle>& handle, PartPointer& firstPart);
+            Aws::S3::Model::GetObjectOutcome DownloadFirstPart(const std::shared_ptr<TransferHandle>& handle, const PartPointer& firstPart);
+            uint64_t GetAdaptiveDownloadPartSize(uint64_t objectSize) const;
+            void UpdateDownloadThroughput(uint64_t bytes, std::chrono::steady_clock::duration elapsed);
+            /**
+             * Writes a part received into its download buffer to the download stream, then completes it and any part held for it.
+             * Returns false, with those parts failed, if the download stream could not take them.
+             */
+            bool StoreDownloadPart(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState);
 
-            void DoMultiPartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle);
-            void DoSinglePartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle);
+            /**
+             * Parts are read from mappedFile if it is set, from streamToPut otherwise.
+             */
+            void DoMultiPartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle,
+                                   const std::shared_ptr<Aws::FileSystem::MappedFile>& mappedFile = nullptr);
+            void DoSinglePartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle,
+                                    const std::shared_ptr<Aws::FileSystem::MappedFile>& mappedFile = nullptr);
 
             void DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle);
             void DoSinglePartUpload(const std::shared_ptr<TransferHandle>& handle);
@@ -297,7 +405,42 @@ namespace Aws
 
             void HandleUploadPartResponse(const Aws::S3::S3Client*, const Aws::S3::Model::UploadPartRequest&, const Aws::S3::Model::UploadPartOutcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
             void HandlePutObjectResponse(const Aws::S3::S3Client*, const Aws::S3::Model::PutObjectRequest&, const Aws::S3::Model::PutObjectOutcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
-            void HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request&, const Aws::S3::Model::ListObjectsV2Outcome&, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&);
+
+            void DoUploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix, const Aws::Map<Aws::String, Aws::String>& metadata);
+            void DoDownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix);
+            /**
+             * Adds file to batch, and submits the batch once it is full. A file larger than bufferSize is submitted on its own.
+             */
+            void AddToDirectoryBatch(Aws::Vector<DirectoryFile>& batch, const DirectoryFile& file);
+            /**
+             * Submits the files of batch, once a slot of maxDirectoryTransfersInFlight is free, and clears batch.
+             */
+            void SubmitDirectoryBatch(Aws::Vector<DirectoryFile>& batch);
+            /**
+             * Starts the transfers of the files of a batch one after the other. Each of them holds slot until it has finished.
+             */
+            void TransferDirectoryFiles(const Aws::Vector<DirectoryFile>& batch, const std::shared_ptr<DirectoryTransferSlot>& slot);
+            bool IsDirectoryFileUnchanged(const DirectoryFile& file) const;
+            /**
+             * The ETag of the object an upload of the file creates, see SkipUnchangedFiles::IF_SAME_ETAG. Empty if the file can not be read.
+             */
+            Aws::String ComputeETag(const Aws::String& fileName, uint64_t fileSize) const;
+            /**
+             * Gives handle a journal in transferJournalDirectory, if set. BeginTransferJournal() writes it once the parts of the transfer are known.
+             */
+            void AttachTransferJournal(const std::shared_ptr<TransferHandle>& handle) const;
+            void BeginTransferJournal(const std::shared_ptr<TransferHandle>& handle, const Aws::String& sourceVersion) const;
+            std::shared_ptr<TransferHandle> ResumeUpload(const std::shared_ptr<TransferJournal>& journal, const TransferJournalRecord& record);
+            std::shared_ptr<TransferHandle> ResumeDownload(const std::shared_ptr<TransferJournal>& journal, const TransferJournalRecord& record);
+            /**
+             * Whether the parts of a journal can be transferred with the transfer buffers, at the offsets this TransferManager gives to them.
+             */
+            bool CanResumeParts(const TransferJournalRecord& record) const;
+            std::shared_ptr<TransferHandle> CreateDownloadFileHandle(const Aws::String& bucketName,
+                                                                     const Aws::String& keyName,
+                                                                     const Aws::String& writeToFile,
+                                                                     const DownloadConfiguration& downloadConfig,
+                                                                     const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context);
 
             TransferStatus DetermineIfFailedOrCanceled(const TransferHandle&) const;
             void TriggerUploadProgressCallback(const std::shared_ptr<const TransferHandle>&) const;
@@ -307,8 +450,25 @@ namespace Aws
 
             static Aws::String DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName);
 
+            /**
+             * Maps the file of handle for an upload, or nullptr if memory mapped files are disabled or the file can not be mapped.
+             */
+            std::shared_ptr<Aws::FileSystem::MappedFile> MapFileToUpload(const std::shared_ptr<TransferHandle>& handle) const;
+            void InitializeBufferPool();
+            unsigned char* AcquireBuffer();
+
             Aws::Utils::ExclusiveOwnershipResourceManager<unsigned char*> m_bufferManager;
             TransferManagerConfiguration m_transferConfig;
+            std::once_flag m_bufferPoolInitialized;
+            size_t m_bufferCount;
+            // bounds the parts of memory mapped files in flight, as the buffers do for the other transfers.
+            Aws::Utils::Threading::Semaphore m_mappedPartSlots;
+            // bytes per second received on one connection, averaged over recent download parts. 0 until measured.
+            std::atomic<uint64_t> m_downloadThroughput;
+            // slots of maxDirectoryTransfersInFlight, or nullptr if directory transfers are not bounded.
+            std::shared_ptr<Aws::Utils::Threading::Semaphore> m_directoryTransferSlots;
+            // walks the directories and lists the buckets of UploadDirectory() and DownloadToDirectory(), one thread each.
+            Aws::Utils::Threading::DefaultExecutor m_directoryWalkers;
         };
 
         
@@ -4,6 +4,7 @@
  */
 
 #include <aws/transfer/TransferHandle.h>
+#include <aws/transfer/TransferJournal.h>
 #include <aws/core/utils/logging/LogMacros.h>
 
 #include <cassert>
@@ -76,7 +77,11 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(),
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadToMappedFile(false),
+            m_downloadStreamBaseOffset(0),
+            m_downloadStreamSeekable(true),
+            m_downloadStreamNextOffset(0)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, const Aws::String& targetFilePath) :
@@ -94,7 +99,11 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(),
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadToMappedFile(false),
+            m_downloadStreamBaseOffset(0),
+            m_downloadStreamSeekable(true),
+            m_downloadStreamNextOffset(0)
         {}
 
         TransferHandle::TransferHandle(const Aws::String& bucketName, const Aws::String& keyName, CreateDownloadStreamCallback createDownloadStreamFn, const Aws::String& targetFilePath) :
@@ -112,7 +121,11 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(createDownloadStreamFn),
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadToMappedFile(false),
+            m_downloadStreamBaseOffset(0),
+            m_downloadStreamSeekable(true),
+            m_downloadStreamNextOffset(0)
         {}
 
 
@@ -133,7 +146,11 @@ namespace Aws
             m_cancel(false),
             m_handleId(Utils::UUID::RandomUUID()),
             m_createDownloadStreamFn(createDownloadStreamFn),
-            m_downloadStream(nullptr)
+            m_downloadStream(nullptr),
+            m_downloadToMappedFile(false),
+            m_downloadStreamBaseOffset(0),
+            m_downloadStreamSeekable(true),
+            m_downloadStreamNextOffset(0)
         {}
 
         TransferHandle::~TransferHandle()
@@ -143,21 +160,29 @@ namespace Aws
 
         void TransferHandle::ChangePartToCompleted(const PartPointer& partState, const Aws::String &eTag)
         {
-            std::lock_guard<std::mutex> locker(m_partsLock);
-            const auto partId = partState->GetPartId();
-            if (!m_pendingParts.erase(partId))
             {
-                m_failedParts.erase(partId);
+                std::lock_guard<std::mutex> locker(m_partsLock);
+                const auto partId = partState->GetPartId();
+                if (!m_pendingParts.erase(partId))
+                {
+                    m_failedParts.erase(partId);
+                }
+
+                partState->SetETag(eTag);
+                if (partState->IsLastPart())
+                {
+                    AddMetadataEntry("ETag", eTag);
+                }
+                m_completedParts[partId] = partState;
+                AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle ID [" << GetId() << "] Setting part [" << partId
+                        << "] to [" << TransferStatus::COMPLETED << "].");
             }
 
-            partState->SetETag(eTag);
-            if (partState->IsLastPart())
+            auto journal = GetJournal();
+            if (journal)
             {
-                AddMetadataEntry("ETag", eTag);
+                journal->AddCompletedPart(*partState);
             }
-            m_completedParts[partId] = partState;
-            AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle ID [" << GetId() << "] Setting part [" << partId
-                    << "] to [" << TransferStatus::COMPLETED << "].");
         }
 
         PartStateMap TransferHandle::GetQueuedParts() const
@@ -320,8 +345,23 @@ namespace Aws
                         CleanupDownloadStream();
                     }
 
+                    if (value == TransferStatus::COMPLETED || value == TransferStatus::ABORTED)
+                    {
+                        auto journal = GetJournal();
+                        if (journal)
+                        {
+                            journal->Remove();
+                        }
+                    }
+
+                    std::function<void()> finishedCallback;
+                    finishedCallback.swap(m_finishedCallback);
                     semaphoreLock.unlock();
                     m_waitUntilFinishedSignal.notify_all();
+                    if (finishedCallback)
+                    {
+                        finishedCallback();
+                    }
                 }
             }
             else
@@ -341,6 +381,18 @@ namespace Aws
             }
         }
 
+        void TransferHandle::SetFinishedCallback(const std::function<void()>& callback)
+        {
+            std::unique_lock<std::mutex> semaphoreLock(m_statusLock);
+            if (IsFinishedStatus(m_status))
+            {
+                semaphoreLock.unlock();
+                callback();
+                return;
+            }
+            m_finishedCallback = callback;
+        }
+
         void TransferHandle::Cancel()
         {
             AWS_LOGSTREAM_TRACE(CLASS_TAG, "Transfer handle ID [" << GetId() << "] Cancelling transfer.");
@@ -376,6 +428,72 @@ namespace Aws
             m_downloadStream->flush();
         }
 
+        Aws::Vector<PartPointer> TransferHandle::WritePartToDownloadStream(const PartPointer& partState, bool& isWritten)
+        {
+            std::lock_guard<std::mutex> lock(m_downloadStreamLock);
+            Aws::Vector<PartPointer> writtenParts;
+            isWritten = true;
+
+            if(m_downloadStream == nullptr)
+            {
+                m_downloadStream = m_createDownloadStreamFn();
+                assert(m_downloadStream->good());
+                auto streamPosition = m_downloadStream->tellp();
+                m_downloadStreamSeekable = streamPosition != std::streampos(-1);
+                m_downloadStreamBaseOffset = m_downloadStreamSeekable ? static_cast<uint64_t>(streamPosition) : 0;
+            }
+
+            if (m_downloadStreamSeekable)
+            {
+                m_downloadStream->seekp(m_downloadStreamBaseOffset + partState->GetRangeBegin());
+                m_downloadStream->write(reinterpret_cast<const char*>(partState->GetDownloadBuffer()), static_cast<std::streamsize>(partState->GetSizeInBytes()));
+                writtenParts.push_back(partState);
+            }
+            else
+            {
+                m_heldDownloadParts[partState->GetPartId()] = partState;
+                // parts are numbered in the order of their ranges.
+                while (!m_heldDownloadParts.empty() && m_heldDownloadParts.begin()->second->GetRangeBegin() == m_downloadStreamNextOffset)
+                {
+                    auto nextPart = m_heldDownloadParts.begin()->second;
+                    m_heldDownloadParts.erase(m_heldDownloadParts.begin());
+                    m_downloadStream->write(reinterpret_cast<const char*>(nextPart->GetDownloadBuffer()), static_cast<std::streamsize>(nextPart->GetSizeInBytes()));
+                    m_downloadStreamNextOffset += nextPart->GetSizeInBytes();
+                    writtenParts.push_back(nextPart);
+                }
+                if (!m_heldDownloadParts.empty())
+                {
+                    AWS_LOGSTREAM_TRACE(CLASS_TAG, "Transfer handle ID [" << GetId() << "] Holding " << m_heldDownloadParts.size()
+                            << " parts until the download stream reaches offset " << m_downloadStreamNextOffset << ".");
+                }
+            }
+
+            if (!writtenParts.empty())
+            {
+                // the parts are about to be journaled as completed, they have to be with the operating system by then.
+                m_downloadStream->flush();
+                isWritten = m_downloadStream->good();
+                if (!isWritten)
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer handle ID [" << GetId() << "] Failed to write " << writtenParts.size()
+                            << " parts to the download stream.");
+                }
+            }
+            return writtenParts;
+        }
+
+        Aws::Vector<PartPointer> TransferHandle::ReleaseHeldDownloadParts()
+        {
+            std::lock_guard<std::mutex> lock(m_downloadStreamLock);
+            Aws::Vector<PartPointer> heldParts;
+            for (const auto& heldPart : m_heldDownloadParts)
+            {
+                heldParts.push_back(heldPart.second);
+            }
+            m_heldDownloadParts.clear();
+            return heldParts;
+        }
+
         void TransferHandle::ApplyDownloadConfiguration(const DownloadConfiguration& downloadConfig)
         {
             SetVersionId(downloadConfig.versionId);
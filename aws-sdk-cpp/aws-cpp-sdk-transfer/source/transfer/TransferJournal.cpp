@@ -0,0 +1,260 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/transfer/TransferJournal.h>
+#include <aws/core/utils/StringUtils.h>
+#include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/logging/LogMacros.h>
+#include <fstream>
+
+namespace Aws
+{
+    namespace Transfer
+    {
+        static const char JOURNAL_FORMAT[] = "aws-transfer-journal 1";
+
+        /*
+         * A journal is a text file of one record per line, a name then its values, separated by spaces.
+         * Strings are URL encoded, so that a value never holds a space or a line break.
+         */
+        static Aws::String Encode(const Aws::String& value)
+        {
+            return Aws::Utils::StringUtils::URLEncode(value.c_str());
+        }
+
+        static Aws::String Decode(const Aws::String& value)
+        {
+            return Aws::Utils::StringUtils::URLDecode(value.c_str());
+        }
+
+        static void WritePart(Aws::OStream& stream, const PartState& part)
+        {
+            stream << "part " << part.GetPartId() << " " << part.GetRangeBegin() << " " << part.GetSizeInBytes() << "\n";
+        }
+
+        static void WriteCompletedPart(Aws::OStream& stream, const PartState& part)
+        {
+            stream << "completed " << part.GetPartId() << " " << Encode(part.GetETag()) << "\n";
+        }
+
+        TransferJournal::TransferJournal(const Aws::String& fileName) :
+            m_fileName(fileName)
+        {
+        }
+
+        TransferJournal::~TransferJournal()
+        {
+        }
+
+        bool TransferJournal::Open(std::ios_base::openmode mode)
+        {
+#ifdef _MSC_VER
+            m_file = Aws::MakeUnique<Aws::OFStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(m_fileName.c_str()).c_str(), mode | std::ios_base::binary);
+#else
+            m_file = Aws::MakeUnique<Aws::OFStream>(CLASS_TAG, m_fileName.c_str(), mode | std::ios_base::binary);
+#endif
+            if (!m_file->good())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Could not open transfer journal: " << m_fileName);
+                m_file.reset();
+                return false;
+            }
+            return true;
+        }
+
+        bool TransferJournal::Begin(const TransferHandle& handle, const Aws::String& sourceVersion)
+        {
+            PartStateMap parts = handle.GetCompletedParts();
+            const auto completedParts = parts;
+            for (const auto& partList : { handle.GetQueuedParts(), handle.GetPendingParts(), handle.GetFailedParts() })
+            {
+                parts.insert(partList.begin(), partList.end());
+            }
+
+            // the parts of a large transfer are buffered and written at once.
+            Aws::StringStream journal;
+            journal << JOURNAL_FORMAT << "\n";
+            journal << "direction " << (handle.GetTransferDirection() == TransferDirection::UPLOAD ? "upload" : "download") << "\n";
+            journal << "bucket " << Encode(handle.GetBucketName()) << "\n";
+            journal << "key " << Encode(handle.GetKey()) << "\n";
+            journal << "version " << Encode(handle.GetVersionId()) << "\n";
+            journal << "file " << Encode(handle.GetTargetFilePath()) << "\n";
+            journal << "content-type " << Encode(handle.GetContentType()) << "\n";
+            for (const auto& entry : handle.GetMetadata())
+            {
+                journal << "metadata " << Encode(entry.first) << " " << Encode(entry.second) << "\n";
+            }
+            journal << "size " << handle.GetBytesTotalSize() << "\n";
+            journal << "source " << Encode(sourceVersion) << "\n";
+            journal << "upload-id " << Encode(handle.GetMultiPartId()) << "\n";
+            for (const auto& part : parts)
+            {
+                WritePart(journal, *part.second);
+            }
+            for (const auto& part : completedParts)
+            {
+                WriteCompletedPart(journal, *part.second);
+            }
+
+            std::lock_guard<std::mutex> locker(m_fileLock);
+            if (!Open(std::ios_base::out | std::ios_base::trunc))
+            {
+                return false;
+            }
+            *m_file << journal.str();
+            m_file->flush();
+            if (!m_file->good())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Could not write transfer journal: " << m_fileName);
+                m_file.reset();
+                return false;
+            }
+            AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle ID [" << handle.GetId() << "] Began transfer journal: " << m_fileName);
+            return true;
+        }
+
+        bool TransferJournal::Load(TransferJournalRecord& record)
+        {
+#ifdef _MSC_VER
+            Aws::IFStream file(Aws::Utils::StringUtils::ToWString(m_fileName.c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+            Aws::IFStream file(m_fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+            Aws::String line;
+            if (!std::getline(file, line) || line != JOURNAL_FORMAT)
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Could not read transfer journal: " << m_fileName);
+                return false;
+            }
+
+            PartStateMap parts;
+            Aws::Map<int, Aws::String> completedETags;
+            // the last line is only whole if it ends with a line break, a process ending while writing it may have left part of it.
+            while (std::getline(file, line) && !file.eof())
+            {
+                Aws::StringStream fields(line);
+                Aws::String name;
+                fields >> name;
+                if (name == "part")
+                {
+                    int partId = 0;
+                    uint64_t rangeBegin = 0;
+                    uint64_t sizeInBytes = 0;
+                    if (fields >> partId >> rangeBegin >> sizeInBytes)
+                    {
+                        auto part = Aws::MakeShared<PartState>(CLASS_TAG, partId, 0, sizeInBytes);
+                        part->SetRangeBegin(rangeBegin);
+                        parts[partId] = part;
+                    }
+                    continue;
+                }
+                if (name == "completed")
+                {
+                    int partId = 0;
+                    Aws::String eTag;
+                    if (fields >> partId >> eTag)
+                    {
+                        completedETags[partId] = Decode(eTag);
+                    }
+                    continue;
+                }
+
+                Aws::String value;
+                fields >> value;
+                if (name == "direction")
+                {
+                    record.direction = value == "download" ? TransferDirection::DOWNLOAD : TransferDirection::UPLOAD;
+                }
+                else if (name == "bucket")
+                {
+                    record.bucketName = Decode(value);
+                }
+                else if (name == "key")
+                {
+                    record.keyName = Decode(value);
+                }
+                else if (name == "version")
+                {
+                    record.versionId = Decode(value);
+                }
+                else if (name == "file")
+                {
+                    record.fileName = Decode(value);
+                }
+                else if (name == "content-type")
+                {
+                    record.contentType = Decode(value);
+                }
+                else if (name == "metadata")
+                {
+                    Aws::String metadataValue;
+                    fields >> metadataValue;
+                    record.metadata[Decode(value)] = Decode(metadataValue);
+                }
+                else if (name == "size")
+                {
+                    record.totalSize = static_cast<uint64_t>(Aws::Utils::StringUtils::ConvertToInt64(value.c_str()));
+                }
+                else if (name == "source")
+                {
+                    record.sourceVersion = Decode(value);
+                }
+                else if (name == "upload-id")
+                {
+                    record.multipartId = Decode(value);
+                }
+            }
+
+            if (parts.empty())
+            {
+                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer journal: " << m_fileName << " records no parts.");
+                return false;
+            }
+
+            for (const auto& part : parts)
+            {
+                if (part.second->GetRangeBegin() + part.second->GetSizeInBytes() == record.totalSize)
+                {
+                    part.second->SetLastPart();
+                }
+
+                auto completedETag = completedETags.find(part.first);
+                if (completedETag != completedETags.end())
+                {
+                    part.second->SetETag(completedETag->second);
+                    part.second->SetBestProgressInBytes(part.second->GetSizeInBytes());
+                    record.completedParts[part.first] = part.second;
+                }
+                else
+                {
+                    record.remainingParts[part.first] = part.second;
+                }
+            }
+
+            std::lock_guard<std::mutex> locker(m_fileLock);
+            return Open(std::ios_base::out | std::ios_base::app);
+        }
+
+        void TransferJournal::AddCompletedPart(const PartState& part)
+        {
+            std::lock_guard<std::mutex> locker(m_fileLock);
+            if (!m_file)
+            {
+                return;
+            }
+
+            WriteCompletedPart(*m_file, part);
+            m_file->flush();
+        }
+
+        void TransferJournal::Remove()
+        {
+            std::lock_guard<std::mutex> locker(m_fileLock);
+            m_file.reset();
+            Aws::FileSystem::RemoveFileIfExists(m_fileName.c_str());
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include <aws/core/utils/HashingUtils.h>
 #include <aws/core/utils/FileSystemUtils.h>
 #include <aws/core/platform/FileSystem.h>
+#include <aws/core/utils/StringUtils.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -19,6 +20,8 @@
 #include <aws/s3/model/AbortMultipartUploadRequest.h>
 #include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <future>
 
 #include <aws/core/utils/logging/LogMacros.h>
 
@@ -35,12 +38,63 @@ namespace Aws
         {
             std::shared_ptr<TransferHandle> handle;
             PartPointer partState;
+            // set if the part is sent from or received into this mapping rather than a transfer buffer.
+            std::shared_ptr<Aws::FileSystem::MappedFile> mappedFile;
+            // to measure the throughput of a download part, without the latency of its request.
+            std::chrono::steady_clock::time_point firstDataReceived;
         };
 
-        struct DownloadDirectoryContext : public Aws::Client::AsyncCallerContext
+        // a file of UploadDirectory() or DownloadToDirectory(), with what the walk of the directory or the listing of the bucket tells of it.
+        struct DirectoryFile
         {
-            Aws::String rootDirectory;
-            Aws::String prefix;
+            TransferDirection direction;
+            Aws::String bucketName;
+            Aws::String keyName;
+            Aws::String fileName;
+            // of the file for an upload, of the object for a download.
+            uint64_t size;
+            Aws::Utils::DateTime lastModified;
+            // of the object, for a download.
+            Aws::String eTag;
+            // for an upload.
+            std::shared_ptr<const Aws::Map<Aws::String, Aws::String>> metadata;
+        };
+
+        // a slot of maxDirectoryTransfersInFlight, taken by a batch of files and freed once the batch and each of its transfers have released it.
+        struct DirectoryTransferSlot
+        {
+            DirectoryTransferSlot(const std::shared_ptr<Aws::Utils::Threading::Semaphore>& directorySlots) : slots(directorySlots), holders(1)
+            {
+                if (slots)
+                {
+                    slots->WaitOne();
+                }
+            }
+
+            ~DirectoryTransferSlot()
+            {
+                // a transfer that never finished still gives the slot back with its handle.
+                if (holders > 0 && slots)
+                {
+                    slots->Release();
+                }
+            }
+
+            void Hold()
+            {
+                ++holders;
+            }
+
+            void Release()
+            {
+                if (--holders == 0 && slots)
+                {
+                    slots->Release();
+                }
+            }
+
+            std::shared_ptr<Aws::Utils::Threading::Semaphore> slots;
+            std::atomic<int> holders;
         };
 
         std::shared_ptr<TransferManager> TransferManager::Create(const TransferManagerConfiguration& config)
@@ -55,24 +109,79 @@ namespace Aws
             return Aws::MakeShared<MakeSharedEnabler>(CLASS_TAG, config);
         }
 
-        TransferManager::TransferManager(const TransferManagerConfiguration& configuration) : m_transferConfig(configuration)
+        static size_t GetMaxPartsInFlight(const TransferManagerConfiguration& configuration)
+        {
+            return static_cast<size_t>((std::max)(configuration.transferBufferMaxHeapSize / configuration.bufferSize, static_cast<uint64_t>(1)));
+        }
+
+        TransferManager::TransferManager(const TransferManagerConfiguration& configuration) :
+            m_transferConfig(configuration),
+            m_bufferCount(0),
+            m_mappedPartSlots(GetMaxPartsInFlight(configuration), GetMaxPartsInFlight(configuration)),
+            m_downloadThroughput(0)
         {
             assert(m_transferConfig.s3Client);
             assert(m_transferConfig.transferExecutor);
-            for (uint64_t i = 0; i < m_transferConfig.transferBufferMaxHeapSize; i += m_transferConfig.bufferSize)
+            if (m_transferConfig.maxDirectoryTransfersInFlight > 0)
             {
-                m_bufferManager.PutResource(Aws::NewArray<unsigned char>(static_cast<size_t>(m_transferConfig.bufferSize), CLASS_TAG));
+                m_directoryTransferSlots = Aws::MakeShared<Aws::Utils::Threading::Semaphore>(CLASS_TAG,
+                        m_transferConfig.maxDirectoryTransfersInFlight, m_transferConfig.maxDirectoryTransfersInFlight);
+            }
+            if (!m_transferConfig.useMemoryMappedFiles)
+            {
+                InitializeBufferPool();
             }
         }
 
         TransferManager::~TransferManager()
         {
+            if (m_bufferCount == 0)
+            {
+                return;
+            }
+
             for (auto buffer : m_bufferManager.ShutdownAndWait(static_cast<size_t>(m_transferConfig.transferBufferMaxHeapSize / m_transferConfig.bufferSize)))
             {
                 Aws::Delete(buffer);
             }
         }
 
+        void TransferManager::InitializeBufferPool()
+        {
+            std::call_once(m_bufferPoolInitialized, [this]()
+            {
+                for (uint64_t i = 0; i < m_transferConfig.transferBufferMaxHeapSize; i += m_transferConfig.bufferSize)
+                {
+                    m_bufferManager.PutResource(Aws::NewArray<unsigned char>(static_cast<size_t>(m_transferConfig.bufferSize), CLASS_TAG));
+                    ++m_bufferCount;
+                }
+            });
+        }
+
+        unsigned char* TransferManager::AcquireBuffer()
+        {
+            InitializeBufferPool();
+            return m_bufferManager.Acquire();
+        }
+
+        std::shared_ptr<Aws::FileSystem::MappedFile> TransferManager::MapFileToUpload(const std::shared_ptr<TransferHandle>& handle) const
+        {
+            // an empty file can not be mapped.
+            if (!m_transferConfig.useMemoryMappedFiles || handle->GetBytesTotalSize() == 0)
+            {
+                return nullptr;
+            }
+
+            std::shared_ptr<Aws::FileSystem::MappedFile> mappedFile = Aws::FileSystem::MapFile(handle->GetTargetFilePath(), Aws::FileSystem::MappedFileAccess::ReadOnly);
+            if (!mappedFile || mappedFile->GetSize() != handle->GetBytesTotalSize())
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Could not map file: "
+                        << handle->GetTargetFilePath() << " of " << handle->GetBytesTotalSize() << " bytes, uploading it through the transfer buffers.");
+                return nullptr;
+            }
+            return mappedFile;
+        }
+
         std::shared_ptr<TransferHandle> TransferManager::UploadFile(const Aws::String& fileName,
                                                                     const Aws::String& bucketName,
                                                                     const Aws::String& keyName,
@@ -132,6 +241,19 @@ namespace Aws
                                                                       const DownloadConfiguration& downloadConfig,
                                                                       const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
         {
+            auto handle = CreateDownloadFileHandle(bucketName, keyName, writeToFile, downloadConfig, context);
+
+            auto self = shared_from_this();
+            m_transferConfig.transferExecutor->Submit([self, handle] { self->DoDownload(handle); });
+            return handle;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::CreateDownloadFileHandle(const Aws::String& bucketName,
+                                                                                  const Aws::String& keyName,
+                                                                                  const Aws::String& writeToFile,
+                                                                                  const DownloadConfiguration& downloadConfig,
+                                                                                  const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
+        {
 #ifdef _MSC_VER
             auto createFileFn = [=]() { return Aws::New<Aws::FStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(writeToFile.c_str()).c_str(),
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
@@ -140,7 +262,13 @@ namespace Aws
                                                                      std::ios_base::out | std::ios_base::in | std::ios_base::binary | std::ios_base::trunc);};
 #endif
 
-            return DownloadFile(bucketName, keyName, createFileFn, downloadConfig, writeToFile, context);
+            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, keyName, createFileFn, writeToFile);
+            handle->ApplyDownloadConfiguration(downloadConfig);
+            handle->SetContext(context);
+            // the file is only created through createFileFn if it can not be mapped.
+            handle->SetDownloadToMappedFile(m_transferConfig.useMemoryMappedFiles);
+            AttachTransferJournal(handle);
+            return handle;
         }
 
         std::shared_ptr<TransferHandle> TransferManager::RetryUpload(const Aws::String& fileName, const std::shared_ptr<TransferHandle>& retryHandle)
@@ -196,6 +324,201 @@ namespace Aws
             return retryHandle;
         }
 
+        // identifies the content of the file of an upload in its journal.
+        static Aws::String GetFileVersion(const Aws::FileSystem::DirectoryEntry& fileInfo)
+        {
+            return Aws::Utils::StringUtils::to_string(fileInfo.lastModified.Millis());
+        }
+
+        void TransferManager::AttachTransferJournal(const std::shared_ptr<TransferHandle>& handle) const
+        {
+            if (!m_transferConfig.transferJournalDirectory.empty())
+            {
+                handle->SetJournal(Aws::MakeShared<TransferJournal>(CLASS_TAG,
+                        Aws::FileSystem::Join(m_transferConfig.transferJournalDirectory, handle->GetId() + ".journal")));
+            }
+        }
+
+        void TransferManager::BeginTransferJournal(const std::shared_ptr<TransferHandle>& handle, const Aws::String& objectETag) const
+        {
+            auto journal = handle->GetJournal();
+            if (!journal || !handle->IsMultipart())
+            {
+                return;
+            }
+
+            auto sourceVersion = handle->GetTransferDirection() == TransferDirection::UPLOAD ?
+                GetFileVersion(Aws::FileSystem::GetFileInfo(handle->GetTargetFilePath())) : objectETag;
+            if (!journal->Begin(*handle, sourceVersion))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Could not write transfer journal: "
+                        << journal->GetFileName() << ", the transfer can not be resumed.");
+                handle->SetJournal(nullptr);
+            }
+        }
+
+        // gives handle the parts of a journal, the remaining ones as failed parts to retry, as for a transfer that failed in this process.
+        static void RestoreJournaledParts(const std::shared_ptr<TransferHandle>& handle, const std::shared_ptr<TransferJournal>& journal,
+                                          const TransferJournalRecord& record)
+        {
+            handle->SetIsMultipart(true);
+            uint64_t completedBytes = 0;
+            for (const auto& part : record.completedParts)
+            {
+                handle->ChangePartToCompleted(part.second, part.second->GetETag());
+                completedBytes += part.second->GetSizeInBytes();
+            }
+            for (const auto& part : record.remainingParts)
+            {
+                handle->ChangePartToFailed(part.second);
+            }
+            handle->UpdateBytesTransferred(completedBytes);
+            handle->SetJournal(journal);
+            handle->UpdateStatus(TransferStatus::FAILED);
+        }
+
+        bool TransferManager::CanResumeParts(const TransferJournalRecord& record) const
+        {
+            PartStateMap parts = record.completedParts;
+            parts.insert(record.remainingParts.begin(), record.remainingParts.end());
+            uint64_t nextRangeBegin = 0;
+            int nextPartId = 1;
+            for (const auto& part : parts)
+            {
+                // an upload sends part n from (n - 1) * bufferSize, see DoMultiPartUpload().
+                if (part.first != nextPartId || part.second->GetRangeBegin() != nextRangeBegin || part.second->GetSizeInBytes() > m_transferConfig.bufferSize ||
+                    (record.direction == TransferDirection::UPLOAD && part.second->GetRangeBegin() != (nextPartId - 1) * m_transferConfig.bufferSize))
+                {
+                    return false;
+                }
+                nextRangeBegin += part.second->GetSizeInBytes();
+                ++nextPartId;
+            }
+            return nextRangeBegin == record.totalSize;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::ResumeTransfer(const Aws::String& journalFile)
+        {
+            auto journal = Aws::MakeShared<TransferJournal>(CLASS_TAG, journalFile);
+            TransferJournalRecord record;
+            if (!journal->Load(record))
+            {
+                return nullptr;
+            }
+
+            AWS_LOGSTREAM_INFO(CLASS_TAG, "Resuming transfer of file: " << record.fileName << " from journal: " << journalFile << " with "
+                    << record.completedParts.size() << " of " << record.completedParts.size() + record.remainingParts.size() << " parts completed.");
+            return record.direction == TransferDirection::UPLOAD ? ResumeUpload(journal, record) : ResumeDownload(journal, record);
+        }
+
+        Aws::Vector<std::shared_ptr<TransferHandle>> TransferManager::ResumeTransfers()
+        {
+            static const char JOURNAL_EXTENSION[] = ".journal";
+            const size_t extensionLength = sizeof(JOURNAL_EXTENSION) - 1;
+
+            // the journals are listed first, as resuming a transfer from the start writes a new journal.
+            Aws::Vector<Aws::String> journalFiles;
+            auto directory = Aws::FileSystem::OpenDirectory(m_transferConfig.transferJournalDirectory);
+            if (directory && *directory)
+            {
+                for (auto entry = directory->Next(); entry; entry = directory->Next())
+                {
+                    if (entry.fileType == Aws::FileSystem::FileType::File && entry.path.size() > extensionLength &&
+                        entry.path.compare(entry.path.size() - extensionLength, extensionLength, JOURNAL_EXTENSION) == 0)
+                    {
+                        journalFiles.push_back(entry.path);
+                    }
+                }
+            }
+
+            Aws::Vector<std::shared_ptr<TransferHandle>> handles;
+            for (const auto& journalFile : journalFiles)
+            {
+                auto handle = ResumeTransfer(journalFile);
+                if (handle)
+                {
+                    handles.push_back(handle);
+                }
+            }
+            return handles;
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::ResumeUpload(const std::shared_ptr<TransferJournal>& journal, const TransferJournalRecord& record)
+        {
+            auto fileInfo = Aws::FileSystem::GetFileInfo(record.fileName);
+            if (!fileInfo || static_cast<uint64_t>(fileInfo.fileSize) != record.totalSize || GetFileVersion(fileInfo) != record.sourceVersion || !CanResumeParts(record))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "File: " << record.fileName << " changed since its transfer journal: " << journal->GetFileName()
+                        << " was written, or its parts do not fit in the transfer buffers. Uploading it from the start.");
+
+                Aws::S3::Model::AbortMultipartUploadRequest abortMultipartUploadRequest;
+                abortMultipartUploadRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+                abortMultipartUploadRequest.WithBucket(record.bucketName)
+                                           .WithKey(record.keyName)
+                                           .WithUploadId(record.multipartId);
+                auto abortOutcome = m_transferConfig.s3Client->AbortMultipartUpload(abortMultipartUploadRequest);
+                if (!abortOutcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_WARN(CLASS_TAG, "Could not abort multi-part upload with Upload ID: [" << record.multipartId << "]. "
+                            << abortOutcome.GetError());
+                }
+                journal->Remove();
+                return UploadFile(record.fileName, record.bucketName, record.keyName, record.contentType, record.metadata);
+            }
+
+            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, record.bucketName, record.keyName, record.totalSize, record.fileName);
+            handle->SetContentType(record.contentType);
+            handle->SetMetadata(record.metadata);
+            handle->SetMultipartId(record.multipartId);
+            RestoreJournaledParts(handle, journal, record);
+            return RetryUpload(record.fileName, handle);
+        }
+
+        std::shared_ptr<TransferHandle> TransferManager::ResumeDownload(const std::shared_ptr<TransferJournal>& journal, const TransferJournalRecord& record)
+        {
+            Aws::S3::Model::HeadObjectRequest headObjectRequest;
+            headObjectRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+            headObjectRequest.WithBucket(record.bucketName)
+                             .WithKey(record.keyName);
+            if (!record.versionId.empty())
+            {
+                headObjectRequest.SetVersionId(record.versionId);
+            }
+            auto headObjectOutcome = m_transferConfig.s3Client->HeadObject(headObjectRequest);
+
+            DownloadConfiguration downloadConfig;
+            downloadConfig.versionId = record.versionId;
+            if (!headObjectOutcome.IsSuccess() || headObjectOutcome.GetResult().GetETag() != record.sourceVersion ||
+                static_cast<uint64_t>(headObjectOutcome.GetResult().GetContentLength()) != record.totalSize ||
+                !Aws::FileSystem::GetFileInfo(record.fileName) || !CanResumeParts(record))
+            {
+                AWS_LOGSTREAM_WARN(CLASS_TAG, "Object in Bucket: [" << record.bucketName << "] with Key: [" << record.keyName << "] or file: "
+                        << record.fileName << " changed since its transfer journal: " << journal->GetFileName()
+                        << " was written, or its parts do not fit in the transfer buffers. Downloading it from the start.");
+                journal->Remove();
+                return DownloadFile(record.bucketName, record.keyName, record.fileName, downloadConfig);
+            }
+
+            // the parts already downloaded are kept in the file.
+            const auto fileName = record.fileName;
+#ifdef _MSC_VER
+            auto createFileFn = [=]() { return Aws::New<Aws::FStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(fileName.c_str()).c_str(),
+                                                                     std::ios_base::out | std::ios_base::in | std::ios_base::binary);};
+#else
+            auto createFileFn = [=]() { return Aws::New<Aws::FStream>(CLASS_TAG, fileName.c_str(),
+                                                                     std::ios_base::out | std::ios_base::in | std::ios_base::binary);};
+#endif
+
+            auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, record.bucketName, record.keyName, createFileFn, record.fileName);
+            handle->ApplyDownloadConfiguration(downloadConfig);
+            handle->SetDownloadToMappedFile(m_transferConfig.useMemoryMappedFiles);
+            handle->SetBytesTotalSize(record.totalSize);
+            handle->SetContentType(headObjectOutcome.GetResult().GetContentType());
+            handle->SetMetadata(headObjectOutcome.GetResult().GetMetadata());
+            RestoreJournaledParts(handle, journal, record);
+            return RetryDownload(handle);
+        }
+
         void TransferManager::AbortMultipartUpload(const std::shared_ptr<TransferHandle>& inProgressHandle)
         {
             assert(inProgressHandle->IsMultipart());
@@ -213,7 +536,23 @@ namespace Aws
             assert(m_transferConfig.transferInitiatedCallback);
 
             auto self = shared_from_this();
-            auto visitor = [self, bucketName, prefix, metadata](const Aws::FileSystem::DirectoryTree*, const Aws::FileSystem::DirectoryEntry& entry)
+            m_directoryWalkers.Submit([self, directory, bucketName, prefix, metadata]() { self->DoUploadDirectory(directory, bucketName, prefix, metadata); });
+        }
+
+        void TransferManager::DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
+        {
+            assert(m_transferConfig.transferInitiatedCallback);
+            Aws::FileSystem::CreateDirectoryIfNotExists(directory.c_str());
+
+            auto self = shared_from_this(); // keep transfer manager alive until all files are submitted.
+            m_directoryWalkers.Submit([self, directory, bucketName, prefix]() { self->DoDownloadToDirectory(directory, bucketName, prefix); });
+        }
+
+        void TransferManager::DoUploadDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix, const Aws::Map<Aws::String, Aws::String>& metadata)
+        {
+            std::shared_ptr<const Aws::Map<Aws::String, Aws::String>> sharedMetadata = Aws::MakeShared<Aws::Map<Aws::String, Aws::String>>(CLASS_TAG, metadata);
+            Aws::Vector<DirectoryFile> batch;
+            auto visitor = [&](const Aws::FileSystem::DirectoryTree*, const Aws::FileSystem::DirectoryEntry& entry)
             {
                 if (entry && entry.fileType == Aws::FileSystem::FileType::File)
                 {
@@ -223,43 +562,309 @@ namespace Aws
                     Aws::Utils::StringUtils::Replace(relativePath, delimiter, "/");
 
                     ssKey << prefix << "/" << relativePath;
-                    Aws::String keyName = ssKey.str();
-                    AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Uploading file: " << entry.path
-                            << " as part of directory upload to S3 Bucket: [" << bucketName << "] and Key: ["
-                            << keyName << "].");
-                    self->m_transferConfig.transferInitiatedCallback(self.get(), self->UploadFile(entry.path, bucketName, keyName, DEFAULT_CONTENT_TYPE, metadata));
+
+                    DirectoryFile file;
+                    file.direction = TransferDirection::UPLOAD;
+                    file.bucketName = bucketName;
+                    file.keyName = ssKey.str();
+                    file.fileName = entry.path;
+                    file.size = static_cast<uint64_t>(entry.fileSize);
+                    file.lastModified = entry.lastModified;
+                    file.metadata = sharedMetadata;
+                    AddToDirectoryBatch(batch, file);
                 }
 
                 return true;
             };
 
-            m_transferConfig.transferExecutor->Submit([directory, visitor]() { Aws::FileSystem::DirectoryTree dir(directory); dir.TraverseDepthFirst(visitor); });
+            Aws::FileSystem::DirectoryTree dir(directory);
+            dir.TraverseDepthFirst(visitor);
+            SubmitDirectoryBatch(batch);
         }
 
-        void TransferManager::DownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
+        void TransferManager::DoDownloadToDirectory(const Aws::String& directory, const Aws::String& bucketName, const Aws::String& prefix)
         {
-            assert(m_transferConfig.transferInitiatedCallback);
-            Aws::FileSystem::CreateDirectoryIfNotExists(directory.c_str());
-
-            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
-            auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request,
-                const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) { self->HandleListObjectsResponse(client, request, outcome, context); };
-
             Aws::S3::Model::ListObjectsV2Request request;
             request.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
             request.WithBucket(bucketName)
                 .WithPrefix(prefix);
 
-            auto context = Aws::MakeShared<DownloadDirectoryContext>(CLASS_TAG);
-            context->rootDirectory = directory;
-            context->prefix = prefix;
+            auto self = shared_from_this();
+            auto listObjects = [self](const Aws::S3::Model::ListObjectsV2Request& listRequest)
+            {
+                auto page = Aws::MakeShared<std::promise<Aws::S3::Model::ListObjectsV2Outcome>>(CLASS_TAG);
+                self->m_transferConfig.s3Client->ListObjectsV2Async(listRequest, [page](const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request&,
+                        const Aws::S3::Model::ListObjectsV2Outcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>&) { page->set_value(outcome); });
+                return page->get_future();
+            };
+
+            Aws::Vector<DirectoryFile> batch;
+            auto listing = listObjects(request);
+            bool isListing = true;
+            while (isListing)
+            {
+                auto outcome = listing.get();
+                isListing = false;
+                if (!outcome.IsSuccess())
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Listing objects failed for bucket: " << bucketName << " with prefix: "
+                            << prefix << ". Error message: " << outcome.GetError());
+                    //notify user if list objects failed.
+                    if (m_transferConfig.errorCallback)
+                    {
+                        auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, bucketName, "");
+                        m_transferConfig.errorCallback(this, handle, outcome.GetError());
+                    }
+                    break;
+                }
+
+                const auto& result = outcome.GetResult();
+                AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects succeeded for bucket: " << bucketName <<
+                        " with prefix: " << prefix << ". Number of keys received: " << result.GetContents().size());
+
+                // the next page is listed while the objects of this one are submitted.
+                if (result.GetIsTruncated())
+                {
+                    AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects response has a continuation token for bucket: "
+                            << bucketName << " with prefix: " << prefix << ". Getting the next set of results.");
+                    request.SetContinuationToken(result.GetNextContinuationToken());
+                    listing = listObjects(request);
+                    isListing = true;
+                }
+
+                for (const auto& content : result.GetContents())
+                {
+                    if (!IsS3KeyPrefix(content.GetKey()))
+                    {
+                        DirectoryFile file;
+                        file.direction = TransferDirection::DOWNLOAD;
+                        file.bucketName = bucketName;
+                        file.keyName = content.GetKey();
+                        file.fileName = DetermineFilePath(directory, prefix, content.GetKey());
+                        file.size = static_cast<uint64_t>((std::max)(content.GetSize(), 0LL));
+                        file.lastModified = content.GetLastModified();
+                        file.eTag = content.GetETag();
+                        AddToDirectoryBatch(batch, file);
+                    }
+                }
+            }
+
+            SubmitDirectoryBatch(batch);
+        }
+
+        void TransferManager::AddToDirectoryBatch(Aws::Vector<DirectoryFile>& batch, const DirectoryFile& file)
+        {
+            // the parts of a larger file are in flight concurrently anyway.
+            if (file.size > m_transferConfig.bufferSize)
+            {
+                Aws::Vector<DirectoryFile> largeFile(1, file);
+                SubmitDirectoryBatch(largeFile);
+                return;
+            }
+
+            batch.push_back(file);
+            if (batch.size() >= m_transferConfig.directoryBatchSize)
+            {
+                SubmitDirectoryBatch(batch);
+            }
+        }
+
+        void TransferManager::SubmitDirectoryBatch(Aws::Vector<DirectoryFile>& batch)
+        {
+            if (batch.empty())
+            {
+                return;
+            }
+
+            // waits while maxDirectoryTransfersInFlight batches are in flight, on the walker thread so that transferExecutor can finish them.
+            auto slot = Aws::MakeShared<DirectoryTransferSlot>(CLASS_TAG, m_directoryTransferSlots);
+            auto files = Aws::MakeShared<Aws::Vector<DirectoryFile>>(CLASS_TAG);
+            files->swap(batch);
 
-            m_transferConfig.s3Client->ListObjectsV2Async(request, handler, context);
+            auto self = shared_from_this();
+            m_transferConfig.transferExecutor->Submit([self, files, slot]() { self->TransferDirectoryFiles(*files, slot); });
+        }
+
+        void TransferManager::TransferDirectoryFiles(const Aws::Vector<DirectoryFile>& batch, const std::shared_ptr<DirectoryTransferSlot>& slot)
+        {
+            for (const auto& file : batch)
+            {
+                bool isUnchanged = m_transferConfig.skipUnchangedFiles != SkipUnchangedFiles::NEVER && IsDirectoryFileUnchanged(file);
+                std::shared_ptr<TransferHandle> handle;
+                if (file.direction == TransferDirection::UPLOAD)
+                {
+                    if (isUnchanged)
+                    {
+                        handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, file.bucketName, file.keyName, file.size, file.fileName);
+                    }
+                    else
+                    {
+                        AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Uploading file: " << file.fileName
+                                << " as part of directory upload to S3 Bucket: [" << file.bucketName << "] and Key: ["
+                                << file.keyName << "].");
+#ifdef _MSC_VER
+                        auto fileStream = Aws::MakeShared<Aws::FStream>(CLASS_TAG, Aws::Utils::StringUtils::ToWString(file.fileName.c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+                        auto fileStream = Aws::MakeShared<Aws::FStream>(CLASS_TAG, file.fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+                        handle = CreateUploadFileHandle(fileStream.get(), file.bucketName, file.keyName, DEFAULT_CONTENT_TYPE, *file.metadata, nullptr, file.fileName);
+                    }
+                }
+                else
+                {
+                    if (isUnchanged)
+                    {
+                        handle = CreateDownloadFileHandle(file.bucketName, file.keyName, file.fileName, DownloadConfiguration(), nullptr);
+                        handle->SetBytesTotalSize(file.size);
+                    }
+                    else
+                    {
+                        auto lastDelimter = file.fileName.find_last_of(Aws::FileSystem::PATH_DELIM);
+                        if (lastDelimter != std::string::npos)
+                        {
+                            Aws::FileSystem::CreateDirectoryIfNotExists(file.fileName.substr(0, lastDelimter).c_str(), true/*create parent dirs*/);
+                        }
+                        AWS_LOGSTREAM_INFO(CLASS_TAG, "Initiating download of key: [" << file.keyName <<
+                                "] in bucket: [" << file.bucketName << "] to destination file: [" << file.fileName << "]");
+                        handle = CreateDownloadFileHandle(file.bucketName, file.keyName, file.fileName, DownloadConfiguration(), nullptr);
+                    }
+                }
+
+                if (isUnchanged)
+                {
+                    AWS_LOGSTREAM_DEBUG(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Skipping unchanged file: " << file.fileName
+                            << " of Bucket: [" << file.bucketName << "] and Key: [" << file.keyName << "].");
+                    handle->UpdateStatus(TransferStatus::EXACT_OBJECT_ALREADY_EXISTS);
+                    m_transferConfig.transferInitiatedCallback(this, handle);
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    continue;
+                }
+
+                // the slot is held until the transfer has finished.
+                slot->Hold();
+                handle->SetFinishedCallback([slot]() { slot->Release(); });
+                m_transferConfig.transferInitiatedCallback(this, handle);
+                if (file.direction == TransferDirection::DOWNLOAD)
+                {
+                    DoDownload(handle);
+                }
+                else if (handle->GetStatus() == TransferStatus::NOT_STARTED)
+                {
+                    if (MultipartUploadSupported(handle->GetBytesTotalSize()))
+                    {
+                        DoMultiPartUpload(handle);
+                    }
+                    else
+                    {
+                        DoSinglePartUpload(handle);
+                    }
+                }
+            }
+            slot->Release();
+        }
+
+        bool TransferManager::IsDirectoryFileUnchanged(const DirectoryFile& file) const
+        {
+            uint64_t fileSize = 0;
+            uint64_t objectSize = 0;
+            bool isDestinationNewer = false;
+            Aws::String objectETag;
+            if (file.direction == TransferDirection::UPLOAD)
+            {
+                Aws::S3::Model::HeadObjectRequest headObjectRequest;
+                headObjectRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+                headObjectRequest.WithBucket(file.bucketName)
+                                 .WithKey(file.keyName);
+                auto headObjectOutcome = m_transferConfig.s3Client->HeadObject(headObjectRequest);
+                if (!headObjectOutcome.IsSuccess())
+                {
+                    return false;
+                }
+
+                const auto& object = headObjectOutcome.GetResult();
+                fileSize = file.size;
+                objectSize = static_cast<uint64_t>(object.GetContentLength());
+                isDestinationNewer = object.GetLastModified() >= file.lastModified;
+                objectETag = object.GetETag();
+            }
+            else
+            {
+                auto fileInfo = Aws::FileSystem::GetFileInfo(file.fileName);
+                if (!fileInfo || fileInfo.fileType != Aws::FileSystem::FileType::File)
+                {
+                    return false;
+                }
+
+                fileSize = static_cast<uint64_t>(fileInfo.fileSize);
+                objectSize = file.size;
+                isDestinationNewer = fileInfo.lastModified >= file.lastModified;
+                objectETag = file.eTag;
+            }
+
+            if (fileSize != objectSize)
+            {
+                return false;
+            }
+
+            switch (m_transferConfig.skipUnchangedFiles)
+            {
+                case SkipUnchangedFiles::IF_SAME_SIZE:
+                    return true;
+                case SkipUnchangedFiles::IF_SAME_SIZE_AND_NEWER:
+                    return isDestinationNewer;
+                case SkipUnchangedFiles::IF_SAME_ETAG:
+                    return ComputeETag(file.fileName, fileSize) == objectETag;
+                default:
+                    return false;
+            }
+        }
+
+        Aws::String TransferManager::ComputeETag(const Aws::String& fileName, uint64_t fileSize) const
+        {
+#ifdef _MSC_VER
+            Aws::FStream fileStream(Aws::Utils::StringUtils::ToWString(fileName.c_str()).c_str(), std::ios_base::in | std::ios_base::binary);
+#else
+            Aws::FStream fileStream(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+#endif
+            if (!fileStream.good())
+            {
+                return "";
+            }
+
+            if (!MultipartUploadSupported(fileSize))
+            {
+                return "\"" + Aws::Utils::HashingUtils::HexEncode(Aws::Utils::HashingUtils::CalculateMD5(fileStream)) + "\"";
+            }
+
+            // the ETag of a multipart upload is the MD5 of the MD5s of its parts, followed by the number of parts.
+            Aws::String partData;
+            Aws::String partDigests;
+            uint64_t partCount = 0;
+            for (uint64_t partOffset = 0; partOffset < fileSize; partOffset += m_transferConfig.bufferSize, ++partCount)
+            {
+                partData.resize(static_cast<size_t>((std::min)(m_transferConfig.bufferSize, fileSize - partOffset)));
+                if (!fileStream.read(&partData[0], static_cast<std::streamsize>(partData.size())))
+                {
+                    return "";
+                }
+                auto partDigest = Aws::Utils::HashingUtils::CalculateMD5(partData);
+                partDigests.append(reinterpret_cast<const char*>(partDigest.GetUnderlyingData()), partDigest.GetLength());
+            }
+
+            Aws::StringStream ss;
+            ss << "\"" << Aws::Utils::HashingUtils::HexEncode(Aws::Utils::HashingUtils::CalculateMD5(partDigests)) << "-" << partCount << "\"";
+            return ss.str();
         }
 
         void TransferManager::DoMultiPartUpload(const std::shared_ptr<TransferHandle>& handle)
         {
+            auto mappedFile = MapFileToUpload(handle);
+            if (mappedFile)
+            {
+                DoMultiPartUpload(nullptr, handle, mappedFile);
+                return;
+            }
+
 #ifdef _MSC_VER
             auto wide = Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str());
             auto streamToPut = Aws::MakeShared<Aws::FStream>(CLASS_TAG, wide.c_str(), std::ios_base::in | std::ios_base::binary);
@@ -270,7 +875,8 @@ namespace Aws
 #endif
         }
 
-        void TransferManager::DoMultiPartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle)
+        void TransferManager::DoMultiPartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle,
+                                                const std::shared_ptr<Aws::FileSystem::MappedFile>& mappedFile)
         {
             handle->SetIsMultipart(true);
 
@@ -301,8 +907,11 @@ namespace Aws
                     {
                         uint64_t partSize = (std::min)(totalSize - i * m_transferConfig.bufferSize, m_transferConfig.bufferSize);
                         bool lastPart = (i == partCount - 1) ? true : false;
-                        handle->AddQueuedPart(Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, partSize, lastPart));
+                        auto partState = Aws::MakeShared<PartState>(CLASS_TAG, static_cast<int>(i + 1), 0, partSize, lastPart);
+                        partState->SetRangeBegin(i * m_transferConfig.bufferSize);
+                        handle->AddQueuedPart(partState);
                     }
+                    BeginTransferJournal(handle, "");
                 }
                 else
                 {
@@ -346,14 +955,33 @@ namespace Aws
 
             while (sentBytes < handle->GetBytesTotalSize() && handle->ShouldContinue() && partsIter != queuedParts.end())
             {
-                auto buffer = m_bufferManager.Acquire();
+                unsigned char* buffer = nullptr;
+                if (mappedFile)
+                {
+                    m_mappedPartSlots.WaitOne();
+                }
+                else
+                {
+                    buffer = AcquireBuffer();
+                }
+
                 if(handle->ShouldContinue())
                 {
                     auto lengthToWrite = partsIter->second->GetSizeInBytes();
-                    streamToPut->seekg((partsIter->first - 1) * m_transferConfig.bufferSize);
-                    streamToPut->read(reinterpret_cast<char*>(buffer), lengthToWrite);
+                    uint64_t partOffset = (partsIter->first - 1) * m_transferConfig.bufferSize;
+                    unsigned char* partData = buffer;
+                    if (mappedFile)
+                    {
+                        partData = mappedFile->GetData() + partOffset;
+                        mappedFile->WillNeed(partOffset, lengthToWrite);
+                    }
+                    else
+                    {
+                        streamToPut->seekg(partOffset);
+                        streamToPut->read(reinterpret_cast<char*>(buffer), lengthToWrite);
+                    }
 
-                    auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
+                    auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, partData, static_cast<size_t>(lengthToWrite));
                     auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
 
                     auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
@@ -379,6 +1007,7 @@ namespace Aws
                     auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
                     asyncContext->handle = handle;
                     asyncContext->partState = partsIter->second;
+                    asyncContext->mappedFile = mappedFile;
 
                     auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::UploadPartRequest& request,
                         const Aws::S3::Model::UploadPartOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
@@ -391,6 +1020,10 @@ namespace Aws
 
                     ++partsIter;
                 }
+                else if (mappedFile)
+                {
+                    m_mappedPartSlots.Release();
+                }
                 else
                 {
                     m_bufferManager.Release(buffer);
@@ -412,6 +1045,13 @@ namespace Aws
 
         void TransferManager::DoSinglePartUpload(const std::shared_ptr<TransferHandle>& handle)
         {
+            auto mappedFile = MapFileToUpload(handle);
+            if (mappedFile)
+            {
+                DoSinglePartUpload(nullptr, handle, mappedFile);
+                return;
+            }
+
 #ifdef _MSC_VER
             auto wide = Aws::Utils::StringUtils::ToWString(handle->GetTargetFilePath().c_str());
             auto streamToPut = Aws::MakeShared<Aws::FStream>(CLASS_TAG, wide.c_str(), std::ios_base::in | std::ios_base::binary);
@@ -422,7 +1062,8 @@ namespace Aws
 #endif
         }
 
-        void TransferManager::DoSinglePartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle)
+        void TransferManager::DoSinglePartUpload(const std::shared_ptr<Aws::IOStream>& streamToPut, const std::shared_ptr<TransferHandle>& handle,
+                                                 const std::shared_ptr<Aws::FileSystem::MappedFile>& mappedFile)
         {
             auto partState = Aws::MakeShared<PartState>(CLASS_TAG, 1, 0, handle->GetBytesTotalSize(), true);
 
@@ -441,11 +1082,20 @@ namespace Aws
 
             putObjectRequest.SetContentType(handle->GetContentType());
 
-            auto buffer = m_bufferManager.Acquire();
-
             auto lengthToWrite = (std::min)(m_transferConfig.bufferSize, handle->GetBytesTotalSize());
-            streamToPut->read((char*)buffer, lengthToWrite);
-            auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, static_cast<size_t>(lengthToWrite));
+            unsigned char* partData = nullptr;
+            if (mappedFile)
+            {
+                m_mappedPartSlots.WaitOne();
+                partData = mappedFile->GetData();
+                mappedFile->WillNeed(0, lengthToWrite);
+            }
+            else
+            {
+                partData = AcquireBuffer();
+                streamToPut->read((char*)partData, lengthToWrite);
+            }
+            auto streamBuf = Aws::New<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, partData, static_cast<size_t>(lengthToWrite));
             auto preallocatedStreamReader = Aws::MakeShared<Aws::IOStream>(CLASS_TAG, streamBuf);
 
             putObjectRequest.SetBody(preallocatedStreamReader);
@@ -472,6 +1122,7 @@ namespace Aws
             auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
             asyncContext->handle = handle;
             asyncContext->partState = partState;
+            asyncContext->mappedFile = mappedFile;
 
             auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::PutObjectRequest& request,
                 const Aws::S3::Model::PutObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
@@ -489,12 +1140,22 @@ namespace Aws
                 std::const_pointer_cast<TransferHandleAsyncContext>(std::static_pointer_cast<const TransferHandleAsyncContext>(context));
 
             auto originalStreamBuffer = (Aws::Utils::Stream::PreallocatedStreamBuf*)request.GetBody()->rdbuf();
-
-            m_bufferManager.Release(originalStreamBuffer->GetBuffer());
-            Aws::Delete(originalStreamBuffer);
             const auto& handle = transferContext->handle;
             const auto& partState = transferContext->partState;
 
+            if (transferContext->mappedFile)
+            {
+                // a failed part is read again from a new mapping on retry.
+                transferContext->mappedFile->DontNeed(static_cast<uint64_t>(partState->GetPartId() - 1) * m_transferConfig.bufferSize, partState->GetSizeInBytes());
+                transferContext->mappedFile = nullptr;
+                m_mappedPartSlots.Release();
+            }
+            else
+            {
+                m_bufferManager.Release(originalStreamBuffer->GetBuffer());
+            }
+            Aws::Delete(originalStreamBuffer);
+
             if (outcome.IsSuccess())
             {
                 if (handle->ShouldContinue())
@@ -597,7 +1258,15 @@ namespace Aws
 
             auto originalStreamBuffer = static_cast<Aws::Utils::Stream::PreallocatedStreamBuf*>(request.GetBody()->rdbuf());
 
-            m_bufferManager.Release(originalStreamBuffer->GetBuffer());
+            if (transferContext->mappedFile)
+            {
+                transferContext->mappedFile = nullptr;
+                m_mappedPartSlots.Release();
+            }
+            else
+            {
+                m_bufferManager.Release(originalStreamBuffer->GetBuffer());
+            }
             Aws::Delete(originalStreamBuffer);
 
             const auto& handle = transferContext->handle;
@@ -666,10 +1335,14 @@ namespace Aws
             auto request = m_transferConfig.getObjectTemplate;
             request.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
             request.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
-            request.SetRange(
-                FormatRangeSpecifier(
-                    handle->GetBytesOffset(),
-                    handle->GetBytesOffset() + handle->GetBytesTotalSize() - 1));
+            // there is no range of an empty object to get.
+            if (handle->GetBytesTotalSize() > 0)
+            {
+                request.SetRange(
+                    FormatRangeSpecifier(
+                        handle->GetBytesOffset(),
+                        handle->GetBytesOffset() + handle->GetBytesTotalSize() - 1));
+            }
             request.WithBucket(handle->GetBucketName())
                    .WithKey(handle->GetKey());
 
@@ -715,10 +1388,194 @@ namespace Aws
             TriggerTransferStatusUpdatedCallback(handle);
         }
 
-        bool TransferManager::InitializePartsForDownload(const std::shared_ptr<TransferHandle>& handle)
+        // the smallest download part worth a request of its own.
+        static const uint64_t MIN_ADAPTIVE_PART_SIZE = 1024 * 1024;
+        // how long a download part should keep its connection busy, for the latency of its request to stay small next to that.
+        static const uint64_t ADAPTIVE_PART_MILLISECONDS = 500;
+
+        uint64_t TransferManager::GetAdaptiveDownloadPartSize(uint64_t objectSize) const
+        {
+            uint64_t partSize = m_transferConfig.bufferSize;
+            uint64_t throughput = m_downloadThroughput.load();
+            if (throughput > 0)
+            {
+                partSize = (std::min)(partSize, throughput * ADAPTIVE_PART_MILLISECONDS / 1000);
+            }
+            if (objectSize > 0)
+            {
+                // small enough for every part in flight to be busy with this object.
+                uint64_t maxPartsInFlight = GetMaxPartsInFlight(m_transferConfig);
+                partSize = (std::min)(partSize, (objectSize + maxPartsInFlight - 1) / maxPartsInFlight);
+            }
+            return (std::min)((std::max)(partSize, MIN_ADAPTIVE_PART_SIZE), m_transferConfig.bufferSize);
+        }
+
+        void TransferManager::UpdateDownloadThroughput(uint64_t bytes, std::chrono::steady_clock::duration elapsed)
+        {
+            auto elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            // a small part is over too quickly to be timed.
+            if (!m_transferConfig.useAdaptiveDownloadParts || elapsedMicroseconds <= 0 || bytes < MIN_ADAPTIVE_PART_SIZE / 4)
+            {
+                return;
+            }
+
+            uint64_t sample = bytes * 1000000 / static_cast<uint64_t>(elapsedMicroseconds);
+            uint64_t average = m_downloadThroughput.load();
+            // concurrent updates may lose a sample, which an average can afford.
+            m_downloadThroughput.store(average == 0 ? sample : (average * 3 + sample) / 4);
+        }
+
+        Aws::S3::Model::GetObjectOutcome TransferManager::DownloadFirstPart(const std::shared_ptr<TransferHandle>& handle, const PartPointer& firstPart)
+        {
+            unsigned char* buffer = AcquireBuffer();
+            firstPart->SetDownloadBuffer(buffer);
+            uint64_t partSize = firstPart->GetSizeInBytes();
+
+            auto request = m_transferConfig.getObjectTemplate;
+            request.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
+            request.SetContinueRequestHandler([handle](const Aws::Http::HttpRequest*) { return handle->ShouldContinue(); });
+            request.WithBucket(handle->GetBucketName())
+                   .WithKey(handle->GetKey());
+            request.SetRange(FormatRangeSpecifier(0, partSize - 1));
+            if (!handle->GetVersionId().empty())
+            {
+                request.SetVersionId(handle->GetVersionId());
+            }
+
+            request.SetResponseStreamFactory([buffer, partSize]()
+            {
+                return Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                        Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, partSize));
+            });
+
+            // progress is only reported once the part is received: the body of an error, e.g. for the range of an empty object, is not part of it.
+            std::chrono::steady_clock::time_point firstDataReceived;
+            request.SetDataReceivedEventHandler([&firstDataReceived](const Aws::Http::HttpRequest*, Aws::Http::HttpResponse*, long long)
+            {
+                if (firstDataReceived == std::chrono::steady_clock::time_point())
+                {
+                    firstDataReceived = std::chrono::steady_clock::now();
+                }
+            });
+
+            request.SetRequestRetryHandler([&firstDataReceived](const Aws::AmazonWebServiceRequest&)
+            {
+                firstDataReceived = std::chrono::steady_clock::time_point();
+            });
+
+            auto getObjectOutcome = m_transferConfig.s3Client->GetObject(request);
+            if (!getObjectOutcome.IsSuccess())
+            {
+                m_bufferManager.Release(buffer);
+                firstPart->SetDownloadBuffer(nullptr);
+                return getObjectOutcome;
+            }
+
+            auto receivedBytes = static_cast<uint64_t>(getObjectOutcome.GetResult().GetContentLength());
+            if (firstDataReceived != std::chrono::steady_clock::time_point())
+            {
+                UpdateDownloadThroughput(receivedBytes, std::chrono::steady_clock::now() - firstDataReceived);
+            }
+            firstPart->OnDataTransferred(receivedBytes, handle);
+            TriggerDownloadProgressCallback(handle);
+            return getObjectOutcome;
+        }
+
+        bool TransferManager::StoreDownloadPart(const std::shared_ptr<TransferHandle>& handle, const PartPointer& partState)
+        {
+            bool isWritten = true;
+            for (const auto& writtenPart : handle->WritePartToDownloadStream(partState, isWritten))
+            {
+                m_bufferManager.Release(writtenPart->GetDownloadBuffer());
+                writtenPart->SetDownloadBuffer(nullptr);
+                if (isWritten)
+                {
+                    handle->ChangePartToCompleted(writtenPart, writtenPart->GetETag());
+                }
+                else
+                {
+                    handle->ChangePartToFailed(writtenPart);
+                }
+            }
+
+            if (!isWritten)
+            {
+                Aws::Client::AWSError<Aws::S3::S3Errors> error(Aws::S3::S3Errors::INTERNAL_FAILURE, "DownloadStreamWriteFailed",
+                        "Downloaded parts could not be written to the download stream.", false);
+                handle->SetError(error);
+                TriggerErrorCallback(handle, error);
+            }
+            return isWritten;
+        }
+
+        bool TransferManager::InitializePartsForDownload(const std::shared_ptr<TransferHandle>& handle, PartPointer& firstPart)
         {
             bool isRetry = handle->HasParts();
-            uint64_t bufferSize = m_transferConfig.bufferSize;
+            if (!isRetry && m_transferConfig.useAdaptiveDownloadParts && handle->GetBytesTotalSize() == 0)
+            {
+                // the first part tells the size of the object, no need for a HeadObject.
+                auto partState = Aws::MakeShared<PartState>(CLASS_TAG, 1, 0, GetAdaptiveDownloadPartSize(0));
+                auto getObjectOutcome = DownloadFirstPart(handle, partState);
+                if (getObjectOutcome.IsSuccess())
+                {
+                    const auto& result = getObjectOutcome.GetResult();
+                    uint64_t partSize = static_cast<uint64_t>(result.GetContentLength());
+                    // e.g. "bytes 0-1048575/8388608"
+                    uint64_t downloadSize = partSize;
+                    auto totalSizeBegin = result.GetContentRange().find_last_of('/');
+                    if (totalSizeBegin != Aws::String::npos)
+                    {
+                        auto totalSize = Aws::Utils::StringUtils::ConvertToInt64(result.GetContentRange().c_str() + totalSizeBegin + 1);
+                        downloadSize = (std::max)(static_cast<uint64_t>((std::max)(totalSize, static_cast<long long>(0))), partSize);
+                    }
+
+                    handle->SetBytesTotalSize(downloadSize);
+                    handle->SetContentType(result.GetContentType());
+                    handle->SetMetadata(result.GetMetadata());
+                    if(handle->GetVersionId().empty() && result.GetVersionId() != "null")
+                    {
+                        handle->SetVersionId(result.GetVersionId());
+                    }
+
+                    partState->SetSizeInBytes(partSize);
+                    partState->SetETag(result.GetETag());
+                    handle->AddQueuedPart(partState);
+                    handle->AddPendingPart(partState);
+                    firstPart = partState;
+
+                    uint64_t restPartSize = GetAdaptiveDownloadPartSize(downloadSize - partSize);
+                    int partId = 2;
+                    for (uint64_t rangeBegin = partSize; rangeBegin < downloadSize; rangeBegin += restPartSize, ++partId)
+                    {
+                        uint64_t nextPartSize = (std::min)(restPartSize, downloadSize - rangeBegin);
+                        auto nextPartState = Aws::MakeShared<PartState>(CLASS_TAG, partId, 0, nextPartSize, rangeBegin + nextPartSize == downloadSize);
+                        nextPartState->SetRangeBegin(rangeBegin);
+                        handle->AddQueuedPart(nextPartState);
+                    }
+                    if (partId == 2)
+                    {
+                        partState->SetLastPart();
+                    }
+                    handle->SetIsMultipart(partId > 2);
+                    BeginTransferJournal(handle, result.GetETag());
+                    return true;
+                }
+
+                // an empty object has no range to get, it is downloaded as below.
+                if (getObjectOutcome.GetError().GetResponseCode() != Aws::Http::HttpResponseCode::REQUESTED_RANGE_NOT_SATISFIABLE)
+                {
+                    AWS_LOGSTREAM_ERROR(CLASS_TAG, "Transfer handle [" << handle->GetId()
+                            << "] Failed to get the first part of object in Bucket: ["
+                            << handle->GetBucketName() << "] with Key: [" << handle->GetKey()
+                            << "] " << getObjectOutcome.GetError());
+                    handle->UpdateStatus(DetermineIfFailedOrCanceled(*handle));
+                    handle->SetError(getObjectOutcome.GetError());
+                    TriggerErrorCallback(handle, getObjectOutcome.GetError());
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    return false;
+                }
+            }
+
             if (!isRetry)
             {
                 Aws::S3::Model::HeadObjectRequest headObjectRequest;
@@ -768,6 +1625,7 @@ namespace Aws
                     handle->SetVersionId(headObjectOutcome.GetResult().GetVersionId());
                 }
 
+                uint64_t bufferSize = m_transferConfig.useAdaptiveDownloadParts ? GetAdaptiveDownloadPartSize(downloadSize) : m_transferConfig.bufferSize;
                 // For empty file, we create 1 part here to make downloading behaviors consistent for files with different size.
                 std::size_t partCount = (std::max)((downloadSize + bufferSize - 1) / bufferSize, static_cast<uint64_t>(1));
                 handle->SetIsMultipart(partCount > 1);    // doesn't make a difference but let's be accurate
@@ -780,6 +1638,7 @@ namespace Aws
                     partState->SetRangeBegin(i * bufferSize);
                     handle->AddQueuedPart(partState);
                 }
+                BeginTransferJournal(handle, headObjectOutcome.GetResult().GetETag());
             }
             else
             {
@@ -794,7 +1653,8 @@ namespace Aws
 
         void TransferManager::DoDownload(const std::shared_ptr<TransferHandle>& handle)
         {
-            if (!InitializePartsForDownload(handle))
+            PartPointer firstPart;
+            if (!InitializePartsForDownload(handle, firstPart))
             {
                 return;
             }
@@ -802,36 +1662,85 @@ namespace Aws
             TriggerTransferStatusUpdatedCallback(handle);
 
             bool isMultipart = handle->IsMultipart();
-            uint64_t bufferSize = m_transferConfig.bufferSize;
 
-            if(!isMultipart)
+            std::shared_ptr<Aws::FileSystem::MappedFile> mappedFile;
+            if (handle->IsDownloadToMappedFile() && handle->GetBytesTotalSize() > 0)
+            {
+                // parts already downloaded by a failed attempt are kept.
+                mappedFile = Aws::FileSystem::MapFile(handle->GetTargetFilePath(), Aws::FileSystem::MappedFileAccess::ReadWrite, handle->GetBytesTotalSize());
+                if (!mappedFile)
+                {
+                    AWS_LOGSTREAM_WARN(CLASS_TAG, "Transfer handle [" << handle->GetId() << "] Could not map file: "
+                            << handle->GetTargetFilePath() << ", downloading it through the download stream.");
+                }
+            }
+
+            if(!isMultipart && !mappedFile && !firstPart)
             {
                 // Special case this for performance (avoid the intermediate buffer write)
                 DoSinglePartDownload(handle);
                 return;
             }
 
+            if (firstPart)
+            {
+                if (mappedFile)
+                {
+                    memcpy(mappedFile->GetData(), firstPart->GetDownloadBuffer(), static_cast<size_t>(firstPart->GetSizeInBytes()));
+                    m_bufferManager.Release(firstPart->GetDownloadBuffer());
+                    firstPart->SetDownloadBuffer(nullptr);
+                    handle->ChangePartToCompleted(firstPart, firstPart->GetETag());
+                }
+                else if (!StoreDownloadPart(handle, firstPart))
+                {
+                    handle->UpdateStatus(TransferStatus::FAILED);
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    return;
+                }
+
+                if (!handle->HasQueuedParts())
+                {
+                    handle->UpdateStatus(TransferStatus::COMPLETED);
+                    TriggerTransferStatusUpdatedCallback(handle);
+                    return;
+                }
+            }
+
             auto queuedParts = handle->GetQueuedParts();
             auto queuedPartIter = queuedParts.begin();
             while(queuedPartIter != queuedParts.end() && handle->ShouldContinue())
             {
                 const auto& partState = queuedPartIter->second;
-                uint64_t rangeStart = handle->GetBytesOffset() + ( partState->GetPartId() - 1 ) * bufferSize;
+                uint64_t rangeStart = handle->GetBytesOffset() + partState->GetRangeBegin();
                 uint64_t rangeEnd = rangeStart + partState->GetSizeInBytes() - 1;
-                auto buffer = m_bufferManager.Acquire();
-                partState->SetDownloadBuffer(buffer);
-
-                CreateDownloadStreamCallback responseStreamFunction = [partState, buffer, rangeEnd, rangeStart]()
+                unsigned char* buffer = nullptr;
+                CreateDownloadStreamCallback responseStreamFunction;
+                if (mappedFile)
                 {
-                    auto bufferStream = Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
-                            Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, rangeEnd - rangeStart + 1));
-                    partState->SetDownloadPartStream(bufferStream);
-                    return bufferStream;
-                };
+                    m_mappedPartSlots.WaitOne();
+                    unsigned char* partData = mappedFile->GetData() + partState->GetRangeBegin();
+                    responseStreamFunction = [partData, rangeEnd, rangeStart]()
+                    {
+                        return Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                                Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, partData, rangeEnd - rangeStart + 1));
+                    };
+                }
+                else
+                {
+                    buffer = AcquireBuffer();
+                    partState->SetDownloadBuffer(buffer);
+
+                    responseStreamFunction = [partState, buffer, rangeEnd, rangeStart]()
+                    {
+                        auto bufferStream = Aws::New<Aws::Utils::Stream::DefaultUnderlyingStream>(CLASS_TAG,
+                                Aws::MakeUnique<Aws::Utils::Stream::PreallocatedStreamBuf>(CLASS_TAG, buffer, rangeEnd - rangeStart + 1));
+                        partState->SetDownloadPartStream(bufferStream);
+                        return bufferStream;
+                    };
+                }
 
                 if(handle->ShouldContinue())
                 {
-                    partState->SetDownloadBuffer(buffer);
 
                     auto getObjectRangeRequest = m_transferConfig.getObjectTemplate;
                     getObjectRangeRequest.SetCustomizedAccessLogTag(m_transferConfig.customizedAccessLogTag);
@@ -847,22 +1756,28 @@ namespace Aws
 
                     auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
 
-                    getObjectRangeRequest.SetDataReceivedEventHandler([self, partState, handle](const Aws::Http::HttpRequest*, Aws::Http::HttpResponse*, long long progress)
+                    auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
+                    asyncContext->handle = handle;
+                    asyncContext->partState = partState;
+                    asyncContext->mappedFile = mappedFile;
+
+                    getObjectRangeRequest.SetDataReceivedEventHandler([self, partState, handle, asyncContext](const Aws::Http::HttpRequest*, Aws::Http::HttpResponse*, long long progress)
                     {
+                        if (asyncContext->firstDataReceived == std::chrono::steady_clock::time_point())
+                        {
+                            asyncContext->firstDataReceived = std::chrono::steady_clock::now();
+                        }
                         partState->OnDataTransferred(progress, handle);
                         self->TriggerDownloadProgressCallback(handle);
                     });
 
-                    getObjectRangeRequest.SetRequestRetryHandler([self, partState, handle](const Aws::AmazonWebServiceRequest&)
+                    getObjectRangeRequest.SetRequestRetryHandler([self, partState, handle, asyncContext](const Aws::AmazonWebServiceRequest&)
                     {
+                        asyncContext->firstDataReceived = std::chrono::steady_clock::time_point();
                         partState->Reset();
                         self->TriggerDownloadProgressCallback(handle);
                     });
 
-                    auto asyncContext = Aws::MakeShared<TransferHandleAsyncContext>(CLASS_TAG);
-                    asyncContext->handle = handle;
-                    asyncContext->partState = partState;
-
                     auto callback = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::GetObjectRequest& request,
                         const Aws::S3::Model::GetObjectOutcome& outcome, const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
                     {
@@ -874,6 +1789,11 @@ namespace Aws
                     m_transferConfig.s3Client->GetObjectAsync(getObjectRangeRequest, callback, asyncContext);
                     ++queuedPartIter;
                 }
+                else if (mappedFile)
+                {
+                    m_mappedPartSlots.Release();
+                    break;
+                }
                 else if(buffer)
                 {
                     m_bufferManager.Release(buffer);
@@ -907,6 +1827,7 @@ namespace Aws
                 std::const_pointer_cast<TransferHandleAsyncContext>(std::static_pointer_cast<const TransferHandleAsyncContext>(context));
             const auto& handle = transferContext->handle;
             const auto& partState = transferContext->partState;
+            bool isStored = false;
 
             if (!outcome.IsSuccess())
             {
@@ -922,10 +1843,23 @@ namespace Aws
             {
                 if(handle->ShouldContinue())
                 {
-                    Aws::IOStream* bufferStream = partState->GetDownloadPartStream();
-                    assert(bufferStream);
-                    handle->WritePartToDownloadStream(bufferStream, partState->GetRangeBegin());
-                    handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                    if (transferContext->firstDataReceived != std::chrono::steady_clock::time_point())
+                    {
+                        UpdateDownloadThroughput(partState->GetSizeInBytes(), std::chrono::steady_clock::now() - transferContext->firstDataReceived);
+                    }
+
+                    // a part of a mapped file was received in place.
+                    if (transferContext->mappedFile)
+                    {
+                        handle->ChangePartToCompleted(partState, outcome.GetResult().GetETag());
+                    }
+                    else
+                    {
+                        // gives its buffer back once written, which may have to wait for the parts before it.
+                        partState->SetETag(outcome.GetResult().GetETag());
+                        StoreDownloadPart(handle, partState);
+                        isStored = true;
+                    }
                 }
                 else
                 {
@@ -934,11 +1868,26 @@ namespace Aws
             }
 
             // buffer cleanup
-            if(partState->GetDownloadBuffer())
+            if(partState->GetDownloadBuffer() && !isStored)
             {
                 m_bufferManager.Release(partState->GetDownloadBuffer());
                 partState->SetDownloadBuffer(nullptr);
             }
+            if (transferContext->mappedFile)
+            {
+                transferContext->mappedFile = nullptr;
+                m_mappedPartSlots.Release();
+            }
+            // parts held for a part that failed are downloaded again on retry.
+            if (handle->HasFailedParts() || !handle->ShouldContinue())
+            {
+                for (const auto& heldPart : handle->ReleaseHeldDownloadParts())
+                {
+                    m_bufferManager.Release(heldPart->GetDownloadBuffer());
+                    heldPart->SetDownloadBuffer(nullptr);
+                    handle->ChangePartToFailed(heldPart);
+                }
+            }
 
             TriggerTransferStatusUpdatedCallback(handle);
 
@@ -1012,66 +1961,6 @@ namespace Aws
             }
         }
 
-        void TransferManager::HandleListObjectsResponse(const Aws::S3::S3Client*, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-            const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context)
-        {
-            auto self = shared_from_this(); // keep transfer manager alive until all callbacks are finished.
-            auto handler = [self](const Aws::S3::S3Client* client, const Aws::S3::Model::ListObjectsV2Request& request, const Aws::S3::Model::ListObjectsV2Outcome& outcome,
-                const std::shared_ptr<const Aws::Client::AsyncCallerContext>& context) { self->HandleListObjectsResponse(client, request, outcome, context); };
-
-            auto downloadContext = std::static_pointer_cast<const DownloadDirectoryContext>(context);
-            const auto& directory = downloadContext->rootDirectory;
-            const auto& prefix = downloadContext->prefix;
-
-            if (outcome.IsSuccess())
-            {
-                Aws::S3::Model::ListObjectsV2Request requestCpy = request;
-
-                auto& result = outcome.GetResult();
-
-                AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects succeeded for bucket: " << directory <<
-                        " with prefix: " << prefix << ". Number of keys received: " << result.GetContents().size());
-
-                //if it was truncated, we don't care on this pass anyways. Just go ahead and kick off another list objects and will handle it when it finishes.
-                if (result.GetIsTruncated())
-                {
-                    AWS_LOGSTREAM_TRACE(CLASS_TAG, "Listing objects response has a continuation token for bucket: "
-                            << directory << " with prefix: " << prefix << ". Getting the next set of results.");
-                    requestCpy.SetContinuationToken(result.GetNextContinuationToken());
-                    m_transferConfig.s3Client->ListObjectsV2Async(requestCpy, handler, context);
-                }
-
-                //this can contain matching directories or actual objects to download. If it's a directory, go ahead and create a local directory then
-                // take the new prefix and call list again. if it's an object key, go ahead and initiate download.
-                for (auto& content : result.GetContents())
-                {
-                    if (!IsS3KeyPrefix(content.GetKey()))
-                    {
-                        Aws::String fileName = DetermineFilePath(downloadContext->rootDirectory, downloadContext->prefix, content.GetKey());
-                        auto lastDelimter = fileName.find_last_of(Aws::FileSystem::PATH_DELIM);
-                        if (lastDelimter != std::string::npos)
-                        {
-                            Aws::FileSystem::CreateDirectoryIfNotExists(fileName.substr(0, lastDelimter).c_str(), true/*create parent dirs*/);
-                        }
-                        AWS_LOGSTREAM_INFO(CLASS_TAG, "Initiating download of key: [" << content.GetKey() <<
-                                "] in bucket: [" << directory << "] to destination file: [" << fileName << "]");
-                        m_transferConfig.transferInitiatedCallback(this, DownloadFile(request.GetBucket(), content.GetKey(), fileName));
-                    }
-                }
-            }
-            else
-            {
-                AWS_LOGSTREAM_ERROR(CLASS_TAG, "Listing objects failed for bucket: " << directory << " with prefix: "
-                        << prefix << ". Error message: " << outcome.GetError());
-                //notify user if list objects failed.
-                if (m_transferConfig.errorCallback)
-                {
-                    auto handle = Aws::MakeShared<TransferHandle>(CLASS_TAG, request.GetBucket(), "");
-                    m_transferConfig.errorCallback(this, handle, outcome.GetError());
-                }
-            }
-        }
-
         Aws::String TransferManager::DetermineFilePath(const Aws::String& directory, const Aws::String& prefix, const Aws::String& keyName)
         {
             Aws::String shortenedFileName = keyName;
@@ -1234,6 +2123,7 @@ namespace Aws
             auto fileStream = Aws::MakeShared<Aws::FStream>(CLASS_TAG, fileName.c_str(), std::ios_base::in | std::ios_base::binary);
 #endif
             auto handle = CreateUploadFileHandle(fileStream.get(), bucketName, keyName, contentType, metadata, context, fileName);
+            AttachTransferJournal(handle);
             return SubmitUpload(handle);
         }
     }
@@ -84,6 +84,18 @@ else()
     set(ENABLE_VIRTUAL_OPERATIONS_ARG "")
 endif()
 
+if(ENABLE_JSON_PULL_DESERIALIZATION)
+    set(ENABLE_JSON_PULL_DESERIALIZATION_ARG "--enableJsonPullDeserialization")
+else()
+    set(ENABLE_JSON_PULL_DESERIALIZATION_ARG "")
+endif()
+
+if(ENABLE_XML_PULL_DESERIALIZATION)
+    set(ENABLE_XML_PULL_DESERIALIZATION_ARG "--enableXmlPullDeserialization")
+else()
+    set(ENABLE_XML_PULL_DESERIALIZATION_ARG "")
+endif()
+
 if(REGENERATE_CLIENTS)
     message(STATUS "Regenerating clients that have been selected for build.")
     set(MERGED_BUILD_LIST ${SDK_BUILD_LIST})
@@ -100,7 +112,7 @@ if(REGENERATE_CLIENTS)
             file(REMOVE_RECURSE "${CMAKE_CURRENT_SOURCE_DIR}/aws-cpp-sdk-${SDK}")
 
             execute_process(
-                COMMAND ${PYTHON_CMD} scripts/generate_sdks.py --serviceName ${SDK} --apiVersion ${C2J_DATE} ${ENABLE_VIRTUAL_OPERATIONS_ARG} --outputLocation ./
+                COMMAND ${PYTHON_CMD} scripts/generate_sdks.py --serviceName ${SDK} --apiVersion ${C2J_DATE} ${ENABLE_VIRTUAL_OPERATIONS_ARG} ${ENABLE_JSON_PULL_DESERIALIZATION_ARG} ${ENABLE_XML_PULL_DESERIALIZATION_ARG} --outputLocation ./
                 WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
             )
             message(STATUS "Generated service: ${SDK}, version: ${C2J_DATE}")
@@ -129,7 +141,7 @@ foreach(custom_client ${ADD_CUSTOM_CLIENTS})
         file(REMOVE_RECURSE "${CMAKE_CURRENT_SOURCE_DIR}/aws-cpp-sdk-${C_SERVICE_NAME}")
         message(STATUS "generating client for ${C_SERVICE_NAME} version ${C_VERSION}")
         execute_process(
-            COMMAND ${PYTHON_CMD} scripts/generate_sdks.py --serviceName ${C_SERVICE_NAME} --apiVersion ${C_VERSION} ${ENABLE_VIRTUAL_OPERATIONS_ARG} --outputLocation ./
+            COMMAND ${PYTHON_CMD} scripts/generate_sdks.py --serviceName ${C_SERVICE_NAME} --apiVersion ${C_VERSION} ${ENABLE_VIRTUAL_OPERATIONS_ARG} ${ENABLE_JSON_PULL_DESERIALIZATION_ARG} ${ENABLE_XML_PULL_DESERIALIZATION_ARG} --outputLocation ./
             WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
         )
         LIST(APPEND SDK_BUILD_LIST ${C_SERVICE_NAME})
@@ -27,6 +27,8 @@ public class ServiceModel {
     Map<String, Shape> shapes;
     Map<String, Operation> operations;
     boolean enableVirtualOperations;
+    boolean enableJsonPullDeserialization;
+    boolean enableXmlPullDeserialization;
     Collection<Error> serviceErrors;
 
     @Getter(AccessLevel.PRIVATE)
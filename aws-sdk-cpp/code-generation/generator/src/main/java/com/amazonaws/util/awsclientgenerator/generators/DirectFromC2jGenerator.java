@@ -20,12 +20,12 @@ public class DirectFromC2jGenerator {
        this.mainClientGenerator = mainClientGenerator;
     }
 
-    public File generateSourceFromJson(String rawJson, String languageBinding, String serviceName, String namespace, String licenseText, boolean generateStandalonePackage, boolean enableVirtualOperations) throws Exception {
+    public File generateSourceFromJson(String rawJson, String languageBinding, String serviceName, String namespace, String licenseText, boolean generateStandalonePackage, boolean enableVirtualOperations, boolean enableJsonPullDeserialization, boolean enableXmlPullDeserialization) throws Exception {
         GsonBuilder gsonBuilder = new GsonBuilder();
         Gson gson = gsonBuilder.create();
 
         C2jServiceModel c2jServiceModel = gson.fromJson(rawJson, C2jServiceModel.class);
         c2jServiceModel.setServiceName(serviceName);
-        return mainClientGenerator.generateSourceFromC2jModel(c2jServiceModel, serviceName, languageBinding, namespace, licenseText, generateStandalonePackage, enableVirtualOperations);
+        return mainClientGenerator.generateSourceFromC2jModel(c2jServiceModel, serviceName, languageBinding, namespace, licenseText, generateStandalonePackage, enableVirtualOperations, enableJsonPullDeserialization, enableXmlPullDeserialization);
     }
 }
@@ -21,7 +21,7 @@ import java.util.zip.ZipOutputStream;
 
 public class MainClientGenerator {
 
-    public File generateSourceFromC2jModel(C2jServiceModel c2jModel, String serviceName, String languageBinding, String namespace, String licenseText, boolean generateStandalonePackage, boolean enableVirtualOperations) throws Exception {
+    public File generateSourceFromC2jModel(C2jServiceModel c2jModel, String serviceName, String languageBinding, String namespace, String licenseText, boolean generateStandalonePackage, boolean enableVirtualOperations, boolean enableJsonPullDeserialization, boolean enableXmlPullDeserialization) throws Exception {
 
         SdkSpec spec = new SdkSpec(languageBinding, serviceName, null);
         // Transform to ServiceModel
@@ -33,6 +33,8 @@ public class MainClientGenerator {
         serviceModel.setNamespace(namespace);
         serviceModel.setLicenseText(licenseText);
         serviceModel.setEnableVirtualOperations(enableVirtualOperations);
+        serviceModel.setEnableJsonPullDeserialization(enableJsonPullDeserialization);
+        serviceModel.setEnableXmlPullDeserialization(enableXmlPullDeserialization);
 
         spec.setVersion(serviceModel.getMetadata().getApiVersion());
 
@@ -24,6 +24,8 @@ public class main {
     static final String LICENSE_TEXT = "license-text";
     static final String STANDALONE_OPTION = "standalone";
     static final String ENABLE_VIRTUAL_OPERATIONS = "enable-virtual-operations";
+    static final String ENABLE_JSON_PULL_DESERIALIZATION = "enable-json-pull-deserialization";
+    static final String ENABLE_XML_PULL_DESERIALIZATION = "enable-xml-pull-deserialization";
 
     public static void main(String[] args) throws IOException {
 
@@ -61,6 +63,8 @@ public class main {
             String languageBinding = argPairs.get(LANGUAGE_BINDING_OPTION);
             String serviceName = argPairs.get(SERVICE_OPTION);
             boolean enableVirtualOperations = argPairs.containsKey(ENABLE_VIRTUAL_OPERATIONS);
+            boolean enableJsonPullDeserialization = argPairs.containsKey(ENABLE_JSON_PULL_DESERIALIZATION);
+            boolean enableXmlPullDeserialization = argPairs.containsKey(ENABLE_XML_PULL_DESERIALIZATION);
 
             //read from the piped input
             try (InputStream stream = getInputStreamReader(argPairs)) {
@@ -84,7 +88,9 @@ public class main {
                             namespace,
                             licenseText,
                             generateStandalonePakckage,
-                            enableVirtualOperations);
+                            enableVirtualOperations,
+                            enableJsonPullDeserialization,
+                            enableXmlPullDeserialization);
                     System.out.println(outputLib.getAbsolutePath());
                 } catch (GeneratorNotImplementedException e) {
                     e.printStackTrace();
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+Very simple HTTP/2 server for the HTTP/2 tests of the curl multi http client.
+Usage:
+    ./dummy_h2_web_server.py -l localhost -p 8779
+TLS connections that negotiate "h2" and cleartext connections that start with the HTTP/2 connection preface (prior
+knowledge) are served over HTTP/2, every stream is answered after a short delay so that concurrent requests are in flight
+together. Any other connection is served over HTTP/1.1, ignoring "Upgrade: h2c", like an endpoint that doesn't support
+HTTP/2. TLS uses a self-signed certificate made with openssl unless --cert and --key are given.
+Every response carries an "x-connection-id" header numbering the connection it was served on, HTTP/1.1 responses also
+carry an "x-upgrade" header with the Upgrade header of the request, "none" when there wasn't any.
+Send a request:
+    curl -k --http2 -i https://localhost:8779
+    curl --http2-prior-knowledge -i http://localhost:8779
+    curl --http2 -i http://localhost:8779
+"""
+import argparse
+import itertools
+import os
+import select
+import socket
+import socketserver
+import ssl
+import struct
+import subprocess
+import tempfile
+import time
+
+PREFACE = b"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+BODY = b"<html><body><h1>hi!</h1></body></html>"
+
+DATA, HEADERS, RST_STREAM, SETTINGS, PING, GOAWAY, WINDOW_UPDATE, CONTINUATION = 0x0, 0x1, 0x3, 0x4, 0x6, 0x7, 0x8, 0x9
+END_STREAM, ACK, END_HEADERS = 0x1, 0x1, 0x4
+SETTINGS_MAX_CONCURRENT_STREAMS = 0x3
+
+connectionIds = itertools.count(1)
+
+
+def frame(frameType, flags, streamId, payload=b""):
+    return struct.pack(">I", len(payload))[1:] + struct.pack(">BBI", frameType, flags, streamId) + payload
+
+
+def literalHeader(name, value):
+    """HPACK literal header field without indexing, with a new name and no huffman coding."""
+    name = name.encode("ascii")
+    value = value.encode("ascii")
+    return b"\x00" + bytes([len(name)]) + name + bytes([len(value)]) + value
+
+
+class Handler(socketserver.BaseRequestHandler):
+
+    def setup(self):
+        self.connectionId = next(connectionIds)
+        self.buffer = b""
+
+    def read(self, size):
+        while len(self.buffer) < size:
+            data = self.request.recv(65536)
+            if not data:
+                return None
+            self.buffer += data
+        data, self.buffer = self.buffer[:size], self.buffer[size:]
+        return data
+
+    def handle(self):
+        # a TLS handshake starts with a handshake record
+        if self.request.recv(1, socket.MSG_PEEK) == b"\x16":
+            try:
+                self.request = tlsContext.wrap_socket(self.request, server_side=True)
+            except (ssl.SSLError, OSError):
+                return
+            if self.request.selected_alpn_protocol() == "h2":
+                if self.read(len(PREFACE)) == PREFACE:
+                    self.handle_h2()
+            else:
+                self.handle_http1()
+            return
+
+        while len(self.buffer) < len(PREFACE) and PREFACE.startswith(self.buffer):
+            data = self.request.recv(65536)
+            if not data:
+                return
+            self.buffer += data
+        if self.buffer.startswith(PREFACE):
+            self.buffer = self.buffer[len(PREFACE):]
+            self.handle_h2()
+        else:
+            self.handle_http1()
+
+    def handle_http1(self):
+        while True:
+            while b"\r\n\r\n" not in self.buffer:
+                data = self.request.recv(65536)
+                if not data:
+                    return
+                self.buffer += data
+            head, self.buffer = self.buffer.split(b"\r\n\r\n", 1)
+            headers = {}
+            for line in head.decode("latin-1").split("\r\n")[1:]:
+                name, _, value = line.partition(":")
+                headers[name.strip().lower()] = value.strip()
+            if self.read(int(headers.get("content-length", 0))) is None:
+                return
+            response = ("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: {}\r\n"
+                        "x-connection-id: {}\r\nx-upgrade: {}\r\n\r\n").format(
+                len(BODY), self.connectionId, headers.get("upgrade", "none"))
+            self.request.sendall(response.encode("ascii") + BODY)
+
+    def handle_h2(self):
+        # streams whose request is complete, with the time to answer them
+        pendingStreams = {}
+        self.request.sendall(frame(SETTINGS, 0, 0, struct.pack(">HI", SETTINGS_MAX_CONCURRENT_STREAMS, 100)))
+        while True:
+            now = time.time()
+            for streamId in [streamId for streamId, due in pendingStreams.items() if due <= now]:
+                del pendingStreams[streamId]
+                headerBlock = (b"\x88" + literalHeader("content-type", "text/html")
+                               + literalHeader("content-length", str(len(BODY)))
+                               + literalHeader("x-connection-id", str(self.connectionId)))
+                self.request.sendall(frame(HEADERS, END_HEADERS, streamId, headerBlock)
+                                     + frame(DATA, END_STREAM, streamId, BODY))
+            timeout = None
+            if pendingStreams:
+                timeout = max(0, min(pendingStreams.values()) - now)
+            pendingBytes = self.buffer or (isinstance(self.request, ssl.SSLSocket) and self.request.pending())
+            if not pendingBytes and not select.select([self.request], [], [], timeout)[0]:
+                continue
+
+            header = self.read(9)
+            if header is None:
+                return
+            length = struct.unpack(">I", b"\x00" + header[:3])[0]
+            frameType, flags, streamId = struct.unpack(">BBI", header[3:])
+            streamId &= 0x7fffffff
+            payload = self.read(length)
+            if payload is None:
+                return
+
+            if frameType == SETTINGS and not flags & ACK:
+                self.request.sendall(frame(SETTINGS, ACK, 0))
+            elif frameType == PING and not flags & ACK:
+                self.request.sendall(frame(PING, ACK, 0, payload))
+            elif frameType == GOAWAY:
+                return
+            elif frameType == RST_STREAM:
+                pendingStreams.pop(streamId, None)
+            elif frameType == DATA and length:
+                increment = struct.pack(">I", length)
+                self.request.sendall(frame(WINDOW_UPDATE, 0, 0, increment) + frame(WINDOW_UPDATE, 0, streamId, increment))
+            # request headers are not decoded, every request gets the same answer
+            if frameType in (HEADERS, DATA, CONTINUATION) and flags & END_STREAM:
+                pendingStreams[streamId] = time.time() + args.wait
+
+
+class Server(socketserver.ThreadingTCPServer):
+    allow_reuse_address = True
+    daemon_threads = True
+
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser(description="Run a simple HTTP/2 server")
+    parser.add_argument(
+        "-l",
+        "--listen",
+        default="localhost",
+        help="Specify the IP address on which the server listens",
+    )
+    parser.add_argument(
+        "-p",
+        "--port",
+        type=int,
+        default=8779,
+        help="Specify the port on which the server listens",
+    )
+    parser.add_argument(
+        "-w",
+        "--wait",
+        type=float,
+        default=0.2,
+        help="Specify the seconds the server waits before answering an HTTP/2 stream",
+    )
+
+    parser.add_argument("--cert", help="Specify the certificate file of the server")
+    parser.add_argument("--key", help="Specify the private key file of the server")
+
+    args = parser.parse_args()
+    if not args.cert or not args.key:
+        certDir = tempfile.mkdtemp()
+        args.cert = os.path.join(certDir, "cert.pem")
+        args.key = os.path.join(certDir, "key.pem")
+        subprocess.check_call(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "1", "-subj", "/CN=localhost",
+                               "-keyout", args.key, "-out", args.cert], stderr=subprocess.DEVNULL)
+    tlsContext = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    tlsContext.load_cert_chain(args.cert, args.key)
+    tlsContext.set_alpn_protocols(["h2", "http/1.1"])
+
+    server = Server((args.listen, args.port), Handler)
+    print("Starting h2 server on {}:{}.".format(args.listen, args.port))
+    server.serve_forever()
@@ -29,6 +29,8 @@ def ParseArguments():
     parser.add_argument("--standalone", help="Build custom client as a separete package, with prebuilt C++ SDK as dependency", action="store_true")
     parser.add_argument("--listAll", help="Lists all available SDKs for generation.", action="store_true")
     parser.add_argument("--enableVirtualOperations", help ="Mark operation functions in service client as virtual functions.", action="store_true")
+    parser.add_argument("--enableJsonPullDeserialization", help ="Deserialize json results straight from the response stream instead of through a JsonValue.", action="store_true")
+    parser.add_argument("--enableXmlPullDeserialization", help ="Deserialize rest-xml results straight from the response stream instead of through an XmlDocument.", action="store_true")
 
     args = vars( parser.parse_args() )
     argMap[ "outputLocation" ] = args[ "outputLocation" ] or "./"
@@ -42,6 +44,8 @@ def ParseArguments():
     argMap[ "standalone" ] = args["standalone"]
     argMap[ "listAll" ] = args["listAll"]
     argMap[ "enableVirtualOperations" ] = args["enableVirtualOperations"]
+    argMap[ "enableJsonPullDeserialization" ] = args["enableJsonPullDeserialization"]
+    argMap[ "enableXmlPullDeserialization" ] = args["enableXmlPullDeserialization"]
 
     return argMap
 
@@ -80,12 +84,12 @@ def PrepareGenerator(generatorPath):
     process = subprocess.call('mvn package', shell=True)
     os.chdir(currentDir)
 
-def GenerateSdk(generatorPath, sdk, outputDir, namespace, licenseText, standalone, enableVirtualOperations):
+def GenerateSdk(generatorPath, sdk, outputDir, namespace, licenseText, standalone, enableVirtualOperations, enableJsonPullDeserialization, enableXmlPullDeserialization):
     try:
        with codecs.open(sdk['filePath'], 'rb', 'utf-8') as api_definition:
             api_content = api_definition.read()
             jar_path = join(generatorPath, 'target/aws-client-generator-1.0-SNAPSHOT-jar-with-dependencies.jar')
-            process = Popen(['java', '-jar', jar_path, '--service', sdk['serviceName'], '--version', sdk['apiVersion'], '--namespace', namespace, '--license-text', licenseText, '--language-binding', 'cpp', '--arbitrary', '--standalone' if standalone else '', '--enable-virtual-operations' if enableVirtualOperations else '' ], stdout=PIPE, stdin=PIPE)
+            process = Popen(['java', '-jar', jar_path, '--service', sdk['serviceName'], '--version', sdk['apiVersion'], '--namespace', namespace, '--license-text', licenseText, '--language-binding', 'cpp', '--arbitrary', '--standalone' if standalone else '', '--enable-virtual-operations' if enableVirtualOperations else '', '--enable-json-pull-deserialization' if enableJsonPullDeserialization else '', '--enable-xml-pull-deserialization' if enableXmlPullDeserialization else '' ], stdout=PIPE, stdin=PIPE)
             writer = codecs.getwriter('utf-8')
             stdInWriter = writer(process.stdin)
             stdInWriter.write(api_content)
@@ -112,6 +116,6 @@ def Main():
     if arguments['serviceName']:
         print('Generating {} api version {}.'.format(arguments['serviceName'], arguments['apiVersion']))
         key = '{}-{}'.format(arguments['serviceName'], arguments['apiVersion'])
-        GenerateSdk(arguments['pathToGenerator'], sdks[key], arguments['outputLocation'], arguments['namespace'], arguments['licenseText'], arguments['standalone'], arguments['enableVirtualOperations'])
+        GenerateSdk(arguments['pathToGenerator'], sdks[key], arguments['outputLocation'], arguments['namespace'], arguments['licenseText'], arguments['standalone'], arguments['enableVirtualOperations'], arguments['enableJsonPullDeserialization'], arguments['enableXmlPullDeserialization'])
 
 Main()
@@ -33,12 +33,13 @@ public:
         UNKNOWN
     };
 
-    MockEventStreamHandler() : EventStreamHandler(),
+    MockEventStreamHandler(bool borrowMessages = false) : EventStreamHandler(),
         m_onPayloadSegmentCount(0), m_onCompletePayloadCount(0), m_onPreludeReceivedCount(0),
         m_onHeaderReceivedCount(0), m_requestLevelErrorsCount(0), m_requestLevelExceptionsCount(0), m_onRecordsCount(0),
         m_onContCount(0), m_onProgressCount(0), m_onStatsCount(0),  m_onEndCount(0), m_internalErrorsCount(0),
-        m_error(Aws::Utils::Event::EventStreamErrors::EVENT_STREAM_NO_ERROR), m_errorMessage("")
+        m_error(Aws::Utils::Event::EventStreamErrors::EVENT_STREAM_NO_ERROR), m_errorMessage(""), m_lastPayloadData(nullptr)
     {
+        SetBorrowMessages(borrowMessages);
     }
 
     void OnEvent() override
@@ -49,22 +50,26 @@ public:
             m_errorMessage = GetEventPayloadAsString();
         }
 
-        auto headers = GetEventHeaders();
-        if (headers.find(Aws::Utils::Event::MESSAGE_TYPE_HEADER) == headers.end())
+        Aws::String messageType;
+        if (!GetEventHeaderValueAsString(Aws::Utils::Event::MESSAGE_TYPE_HEADER, messageType))
         {
             AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Header: " << Aws::Utils::Event::MESSAGE_TYPE_HEADER << " not found in the message.");
             return;
         }
 
-        switch (Aws::Utils::Event::Message::GetMessageTypeForName(headers[Aws::Utils::Event::MESSAGE_TYPE_HEADER].GetEventHeaderValueAsString()))
+        m_lastPayload = GetEventPayloadAsString();
+        m_lastPayloadData = IsBorrowingMessages() ? GetEventMessageView().GetPayload() : nullptr;
+
+        Aws::String eventType;
+        switch (Aws::Utils::Event::Message::GetMessageTypeForName(messageType))
         {
         case Aws::Utils::Event::Message::MessageType::EVENT:
-            if (headers.find(Aws::Utils::Event::EVENT_TYPE_HEADER) == headers.end())
+            if (!GetEventHeaderValueAsString(Aws::Utils::Event::EVENT_TYPE_HEADER, eventType))
             {
                 AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Header: " << Aws::Utils::Event::EVENT_TYPE_HEADER << " not found in the message.");
                 return;
             }
-            switch (GetEventTypeForName(headers[Aws::Utils::Event::EVENT_TYPE_HEADER].GetEventHeaderValueAsString()))
+            switch (GetEventTypeForName(eventType))
             {
             case EventType::RECORDS:
                 m_onRecordsCount++;
@@ -82,7 +87,7 @@ public:
                 m_onEndCount++;
                 break;
             default:
-                AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Unexpected event type: " << headers[Aws::Utils::Event::EVENT_TYPE_HEADER].GetEventHeaderValueAsString());
+                AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Unexpected event type: " << eventType);
                 break;
             }
             break;
@@ -93,11 +98,34 @@ public:
             m_requestLevelExceptionsCount++;
             break;
         default:
-            AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Unexpected message type: " << headers[Aws::Utils::Event::MESSAGE_TYPE_HEADER].GetEventHeaderValueAsString());
+            AWS_LOGSTREAM_WARN(MOCK_EVENT_STREAM_HANDLER_CLASS_TAG, "Unexpected message type: " << messageType);
             break;
         }
     }
 
+    bool GetEventHeaderValueAsString(const char* name, Aws::String& value)
+    {
+        if (IsBorrowingMessages())
+        {
+            const auto* header = GetEventMessageView().FindHeader(name);
+            if (!header)
+            {
+                return false;
+            }
+            value = header->GetValueAsString();
+            return true;
+        }
+
+        const auto& headers = GetEventHeaders();
+        auto iter = headers.find(name);
+        if (iter == headers.end())
+        {
+            return false;
+        }
+        value = iter->second.GetEventHeaderValueAsString();
+        return true;
+    }
+
     static EventType GetEventTypeForName(const Aws::String& name)
     {
         int hashCode = Aws::Utils::HashingUtils::HashString(name.c_str());
@@ -162,4 +190,8 @@ public:
     size_t m_internalErrorsCount;
     Aws::Utils::Event::EventStreamErrors m_error;
     Aws::String m_errorMessage;
+
+    Aws::String m_lastPayload;
+    // Where the payload of the last message was read from, only recorded when borrowing messages.
+    const unsigned char* m_lastPayloadData;
 };